@@ -0,0 +1,44 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief ARM Cortex-M sampling profiler support
+ */
+
+#include <kernel.h>
+#include <arch/arm/aarch32/cortex_m/cmsis.h>
+
+/* Position of registers in the basic exception stack frame */
+#define FRAME_LR 5
+#define FRAME_PC 6
+
+int arch_sampling_profiler_backtrace(uintptr_t *addrs, int max_depth)
+{
+	const uint32_t *frame;
+
+	/* Only an interrupted thread can be sampled: it has its frame on the
+	 * process stack, while other exceptions have their frame somewhere
+	 * on the main stack.
+	 */
+	if ((SCB->ICSR & SCB_ICSR_RETTOBASE_Msk) == 0U) {
+		return 0;
+	}
+
+	frame = (const uint32_t *)__get_PSP();
+
+	addrs[0] = frame[FRAME_PC];
+	if (max_depth < 2) {
+		return 1;
+	}
+
+	/* The link register holds the return address of the sampled
+	 * function until it calls another function.
+	 */
+	addrs[1] = frame[FRAME_LR];
+
+	return 2;
+}
@@ -0,0 +1,51 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief POSIX arch sampling profiler support
+ */
+
+#include <kernel.h>
+
+BUILD_ASSERT(IS_ENABLED(CONFIG_SAMPLING_PROFILER_FRAME_POINTER),
+	     "The POSIX arch needs frame pointers to sample callers");
+
+/* Zephyr threads run on the stacks of host threads, which are not
+ * described by their stack_info, so the frame chain is only checked to be
+ * sane: frames are aligned, at increasing addresses and close to each other.
+ */
+#define MAX_FRAME_SIZE (1024 * 1024)
+
+static bool frame_is_next(uintptr_t *fp, uintptr_t *next)
+{
+	return (next != NULL) &&
+	       (((uintptr_t)next & (sizeof(uintptr_t) - 1)) == 0) &&
+	       (next > fp) &&
+	       ((uintptr_t)next - (uintptr_t)fp < MAX_FRAME_SIZE);
+}
+
+int arch_sampling_profiler_backtrace(uintptr_t *addrs, int max_depth)
+{
+	uintptr_t *fp = __builtin_frame_address(0);
+	int depth = 0;
+
+	/* Interrupts are handled on the stack of the interrupted thread, so
+	 * the chain starts with the frames of the interrupt handling code,
+	 * from posix_irq_handler() down to this function. They are recorded
+	 * too and skipped when the samples are symbolized on the host.
+	 */
+	while (depth < max_depth) {
+		addrs[depth++] = fp[1];
+
+		if (!frame_is_next(fp, (uintptr_t *)fp[0])) {
+			break;
+		}
+		fp = (uintptr_t *)fp[0];
+	}
+
+	return depth;
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief IA-32 sampling profiler support
+ */
+
+#include <kernel.h>
+#include <kernel_internal.h>
+
+/* Position of registers on the stack of an interrupted thread, as saved
+ * by _interrupt_enter after the ones pushed by the CPU.
+ */
+#define FRAME_EIP 4
+
+#ifdef CONFIG_SAMPLING_PROFILER_FRAME_POINTER
+static bool in_range(uintptr_t *fp, uintptr_t start, uintptr_t end)
+{
+	return ((uintptr_t)fp >= start) &&
+	       ((uintptr_t)fp <= end - 2 * sizeof(uintptr_t));
+}
+
+static int callers_get(struct _cpu *cpu, uintptr_t *addrs, int max_depth)
+{
+	uintptr_t irq_stack_end = (uintptr_t)cpu->irq_stack;
+	uintptr_t irq_stack_start =
+		irq_stack_end - K_KERNEL_STACK_SIZEOF(z_interrupt_stacks[0]);
+	uintptr_t stack_start = _current->stack_info.start;
+	uintptr_t stack_end = stack_start + _current->stack_info.size;
+	uintptr_t *fp = __builtin_frame_address(0);
+	int depth = 0;
+
+	/* Interrupt handlers have their frames on the interrupt stack. The
+	 * outermost one saved the frame pointer of the interrupted function,
+	 * which is the first one pointing out of the interrupt stack.
+	 */
+	while (in_range(fp, irq_stack_start, irq_stack_end)) {
+		fp = (uintptr_t *)fp[0];
+	}
+
+	while ((depth < max_depth) && in_range(fp, stack_start, stack_end)) {
+		addrs[depth++] = fp[1];
+
+		/* Frames are at increasing addresses */
+		if ((uintptr_t *)fp[0] <= fp) {
+			break;
+		}
+		fp = (uintptr_t *)fp[0];
+	}
+
+	return depth;
+}
+#endif
+
+int arch_sampling_profiler_backtrace(uintptr_t *addrs, int max_depth)
+{
+	struct _cpu *cpu = arch_curr_cpu();
+	uintptr_t *esp;
+
+	/* Only an interrupted thread can be sampled. Its stack pointer is
+	 * saved at the base of the interrupt stack.
+	 */
+	if (cpu->nested != 1U) {
+		return 0;
+	}
+
+	esp = ((uintptr_t **)cpu->irq_stack)[-1];
+	addrs[0] = esp[FRAME_EIP];
+
+#ifdef CONFIG_SAMPLING_PROFILER_FRAME_POINTER
+	return 1 + callers_get(cpu, &addrs[1], max_depth - 1);
+#else
+	return 1;
+#endif
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/*
+ * Simulated time, and so the cycle counter, does not advance while the
+ * CPU is busy, so the timing functions read the host's monotonic clock,
+ * in nanoseconds.
+ */
+
+#include <stdint.h>
+#include <time.h>
+#include <timing/timing.h>
+
+#define HOST_NSEC_PER_SEC 1000000000ULL
+
+void board_timing_init(void)
+{
+}
+
+void board_timing_start(void)
+{
+}
+
+void board_timing_stop(void)
+{
+}
+
+timing_t board_timing_counter_get(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (timing_t)ts.tv_sec * HOST_NSEC_PER_SEC + ts.tv_nsec;
+}
+
+uint64_t board_timing_cycles_get(volatile timing_t *const start,
+				 volatile timing_t *const end)
+{
+	return (*end - *start);
+}
+
+uint64_t board_timing_freq_get(void)
+{
+	return HOST_NSEC_PER_SEC;
+}
+
+uint64_t board_timing_cycles_to_ns(uint64_t cycles)
+{
+	return cycles;
+}
+
+uint64_t board_timing_cycles_to_ns_avg(uint64_t cycles, uint32_t count)
+{
+	return cycles / count;
+}
+
+uint32_t board_timing_freq_get_mhz(void)
+{
+	return (uint32_t)(HOST_NSEC_PER_SEC / 1000000U);
+}
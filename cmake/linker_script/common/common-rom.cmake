@@ -142,6 +142,10 @@ endif()
 
 zephyr_iterable_section(NAME k_p4wq_initparam KVMA RAM_REGION GROUP RODATA_REGION SUBALIGN 4)
 
+if(CONFIG_WORK_POOL)
+  zephyr_iterable_section(NAME k_work_pool_initparam KVMA RAM_REGION GROUP RODATA_REGION SUBALIGN 4)
+endif()
+
 if(CONFIG_EMUL)
   zephyr_linker_section(NAME emulators_section GROUP RODATA_REGION)
   zephyr_linker_section_configure(SECTION emulators_section INPUT ".emulators" KEEP SORT NAME ${XIP_ALIGN_WITH_INPUT})
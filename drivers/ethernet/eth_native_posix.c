@@ -201,6 +201,29 @@ static int eth_send(const struct device *dev, struct net_pkt *pkt)
 	return ret < 0 ? ret : 0;
 }
 
+#if defined(CONFIG_NET_BURST)
+/* The TAP device takes one frame per write(), so this just loops over
+ * eth_send(). The gain is in the queueing done before the driver.
+ */
+static int eth_send_burst(const struct device *dev, struct net_pkt **pkts,
+			  size_t count)
+{
+	int sent = 0;
+	int ret;
+
+	while ((size_t)sent < count) {
+		ret = eth_send(dev, pkts[sent]);
+		if (ret < 0) {
+			return sent ? sent : ret;
+		}
+
+		sent++;
+	}
+
+	return sent;
+}
+#endif
+
 static int eth_init(const struct device *dev)
 {
 	ARG_UNUSED(dev);
@@ -319,17 +342,18 @@ static struct net_pkt *prepare_non_vlan_pkt(struct eth_context *ctx,
 	return pkt;
 }
 
-static int read_data(struct eth_context *ctx, int fd)
+static struct net_pkt *read_pkt(struct eth_context *ctx, int fd,
+				struct net_if **iface, int *status)
 {
 	uint16_t vlan_tag = NET_VLAN_TAG_UNSPEC;
-	struct net_if *iface;
 	struct net_pkt *pkt = NULL;
-	int status;
 	int count;
 
+	*status = 0;
+
 	count = eth_read_data(fd, ctx->recv, sizeof(ctx->recv));
 	if (count <= 0) {
-		return 0;
+		return NULL;
 	}
 
 #if defined(CONFIG_NET_VLAN)
@@ -337,14 +361,14 @@ static int read_data(struct eth_context *ctx, int fd)
 		struct net_eth_hdr *hdr = (struct net_eth_hdr *)(ctx->recv);
 
 		if (ntohs(hdr->type) == NET_ETH_PTYPE_VLAN) {
-			pkt = prepare_vlan_pkt(ctx, count, &vlan_tag, &status);
+			pkt = prepare_vlan_pkt(ctx, count, &vlan_tag, status);
 			if (!pkt) {
-				return status;
+				return NULL;
 			}
 		} else {
-			pkt = prepare_non_vlan_pkt(ctx, count, &status);
+			pkt = prepare_non_vlan_pkt(ctx, count, status);
 			if (!pkt) {
-				return status;
+				return NULL;
 			}
 
 			net_pkt_set_vlan_tci(pkt, 0);
@@ -352,16 +376,75 @@ static int read_data(struct eth_context *ctx, int fd)
 	}
 #else
 	{
-		pkt = prepare_non_vlan_pkt(ctx, count, &status);
+		pkt = prepare_non_vlan_pkt(ctx, count, status);
 		if (!pkt) {
-			return status;
+			return NULL;
 		}
 	}
 #endif
 
-	iface = get_iface(ctx, vlan_tag);
+	*iface = get_iface(ctx, vlan_tag);
 
-	update_gptp(iface, pkt, false);
+	update_gptp(*iface, pkt, false);
+
+	return pkt;
+}
+
+#if defined(CONFIG_NET_BURST)
+static void recv_burst(struct net_if *iface, struct net_pkt **pkts, int count)
+{
+	int ret;
+
+	ret = net_recv_data_burst(iface, pkts, count);
+
+	for (int i = MAX(ret, 0); i < count; i++) {
+		net_pkt_unref(pkts[i]);
+	}
+}
+
+/* Read what is pending on the TAP device, up to a burst, and pass it up
+ * with one call per interface.
+ */
+static void read_burst(struct eth_context *ctx, int fd)
+{
+	struct net_pkt *pkts[CONFIG_NET_BURST_SIZE];
+	struct net_if *burst_iface = NULL;
+	int count = 0;
+
+	do {
+		struct net_if *iface;
+		struct net_pkt *pkt;
+		int status;
+
+		pkt = read_pkt(ctx, fd, &iface, &status);
+		if (!pkt) {
+			continue;
+		}
+
+		if (count && iface != burst_iface) {
+			recv_burst(burst_iface, pkts, count);
+			count = 0;
+		}
+
+		burst_iface = iface;
+		pkts[count++] = pkt;
+	} while (count < ARRAY_SIZE(pkts) && !eth_wait_data(fd));
+
+	if (count) {
+		recv_burst(burst_iface, pkts, count);
+	}
+}
+#else
+static int read_data(struct eth_context *ctx, int fd)
+{
+	struct net_if *iface;
+	struct net_pkt *pkt;
+	int status;
+
+	pkt = read_pkt(ctx, fd, &iface, &status);
+	if (!pkt) {
+		return status;
+	}
 
 	if (net_recv_data(iface, pkt) < 0) {
 		net_pkt_unref(pkt);
@@ -369,6 +452,7 @@ static int read_data(struct eth_context *ctx, int fd)
 
 	return 0;
 }
+#endif /* CONFIG_NET_BURST */
 
 static void eth_rx(struct eth_context *ctx)
 {
@@ -377,7 +461,11 @@ static void eth_rx(struct eth_context *ctx)
 	while (1) {
 		if (net_if_is_up(ctx->iface)) {
 			while (!eth_wait_data(ctx->dev_fd)) {
+#if defined(CONFIG_NET_BURST)
+				read_burst(ctx, ctx->dev_fd);
+#else
 				read_data(ctx, ctx->dev_fd);
+#endif
 				k_yield();
 			}
 		}
@@ -609,6 +697,9 @@ static const struct ethernet_api eth_if_api = {
 	.start = eth_start_device,
 	.stop = eth_stop_device,
 	.send = eth_send,
+#if defined(CONFIG_NET_BURST)
+	.send_burst = eth_send_burst,
+#endif
 
 #if defined(CONFIG_NET_VLAN)
 	.vlan_setup = vlan_setup,
@@ -60,18 +60,8 @@ static void loopback_init(struct net_if *iface)
 	}
 }
 
-static int loopback_send(const struct device *dev, struct net_pkt *pkt)
+static struct net_pkt *loopback_clone(struct net_pkt *pkt)
 {
-	struct net_pkt *cloned;
-	int res;
-
-	ARG_UNUSED(dev);
-
-	if (!pkt->frags) {
-		LOG_ERR("No data to send");
-		return -ENODATA;
-	}
-
 	/* We need to swap the IP addresses because otherwise
 	 * the packet will be dropped.
 	 */
@@ -97,7 +87,22 @@ static int loopback_send(const struct device *dev, struct net_pkt *pkt)
 	 * must be dropped. This is very much needed for TCP packets where
 	 * the packet is reference counted in various stages of sending.
 	 */
-	cloned = net_pkt_clone(pkt, K_MSEC(100));
+	return net_pkt_clone(pkt, K_MSEC(100));
+}
+
+static int loopback_send(const struct device *dev, struct net_pkt *pkt)
+{
+	struct net_pkt *cloned;
+	int res;
+
+	ARG_UNUSED(dev);
+
+	if (!pkt->frags) {
+		LOG_ERR("No data to send");
+		return -ENODATA;
+	}
+
+	cloned = loopback_clone(pkt);
 	if (!cloned) {
 		res = -ENOMEM;
 		goto out;
@@ -115,10 +120,57 @@ out:
 	return res;
 }
 
+#if defined(CONFIG_NET_BURST)
+static int loopback_send_burst(const struct device *dev,
+			       struct net_pkt **pkts, size_t count)
+{
+	struct net_pkt *cloned[CONFIG_NET_BURST_SIZE];
+	int sent = 0;
+	int res;
+
+	ARG_UNUSED(dev);
+
+	count = MIN(count, ARRAY_SIZE(cloned));
+
+	while ((size_t)sent < count && pkts[sent]->frags) {
+		cloned[sent] = loopback_clone(pkts[sent]);
+		if (!cloned[sent]) {
+			break;
+		}
+
+		sent++;
+	}
+
+	if (sent == 0) {
+		return -ENOMEM;
+	}
+
+	/* All the packets loop back in one go, which is what gives the
+	 * receive side a burst as well.
+	 */
+	res = net_recv_data_burst(net_pkt_iface(cloned[0]), cloned, sent);
+	if (res < sent) {
+		LOG_ERR("Data receive failed.");
+
+		for (int i = MAX(res, 0); i < sent; i++) {
+			net_pkt_unref(cloned[i]);
+		}
+	}
+
+	/* Let the receiving thread run now */
+	k_yield();
+
+	return sent;
+}
+#endif
+
 static struct dummy_api loopback_api = {
 	.iface_api.init = loopback_init,
 
 	.send = loopback_send,
+#if defined(CONFIG_NET_BURST)
+	.send_burst = loopback_send_burst,
+#endif
 };
 
 NET_DEVICE_INIT(loopback, "lo",
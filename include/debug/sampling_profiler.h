@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#ifndef ZEPHYR_INCLUDE_DEBUG_SAMPLING_PROFILER_H_
+#define ZEPHYR_INCLUDE_DEBUG_SAMPLING_PROFILER_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/** @defgroup sampling_profiler Sampling profiler
+ *  @brief Statistical profiler sampling the running code
+ *
+ *  The profiler periodically records, from the system timer interrupt, the
+ *  program counter of the interrupted code and, depending on the
+ *  architecture and configuration, the return addresses of its callers.
+ *  Samples are symbolized on the host.
+ *  @{
+ */
+
+/** @brief Sampling profiler statistics */
+struct sampling_profiler_stats {
+	/** Number of stored samples */
+	uint32_t samples;
+	/** Number of samples dropped because the buffer was full */
+	uint32_t dropped;
+	/** Number of samples which could not be taken, e.g. because the
+	 *  timer interrupted another interrupt.
+	 */
+	uint32_t missed;
+};
+
+/** @brief Sample callback function
+ *
+ *  @param cpu CPU which was sampled.
+ *  @param addrs Program counter followed by return addresses of the callers.
+ *  @param depth Number of addresses.
+ *  @param user_data User data.
+ */
+typedef void (*sampling_profiler_cb_t)(unsigned int cpu,
+				       const uintptr_t *addrs, int depth,
+				       void *user_data);
+
+/** @brief Start sampling
+ *
+ *  Samples are added to the ones already stored.
+ *
+ *  @param period_us Sampling period in microseconds. It is rounded up to
+ *		     the system tick.
+ *
+ *  @retval 0 on success.
+ *  @retval -EINVAL if the period is 0.
+ *  @retval -EALREADY if sampling is already started.
+ */
+int sampling_profiler_start(uint32_t period_us);
+
+/** @brief Stop sampling
+ *
+ *  @retval 0 on success.
+ *  @retval -EALREADY if sampling is not started.
+ */
+int sampling_profiler_stop(void);
+
+/** @brief Discard stored samples and clear statistics
+ *
+ *  @retval 0 on success.
+ *  @retval -EBUSY if sampling is started.
+ */
+int sampling_profiler_reset(void);
+
+/** @brief Get statistics
+ *
+ *  @param stats Location where statistics are written.
+ */
+void sampling_profiler_stats_get(struct sampling_profiler_stats *stats);
+
+/** @brief Call a function for each stored sample
+ *
+ *  @param cb Function called for each sample.
+ *  @param user_data User data passed to the function.
+ *
+ *  @retval 0 on success.
+ *  @retval -EBUSY if sampling is started.
+ */
+int sampling_profiler_foreach(sampling_profiler_cb_t cb, void *user_data);
+
+/** @} */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_INCLUDE_DEBUG_SAMPLING_PROFILER_H_ */
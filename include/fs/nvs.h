@@ -30,6 +30,23 @@ extern "C" {
  * @{
  */
 
+/**
+ * @brief Non-volatile Storage garbage collection state
+ *
+ * @param sec_addr Address of the sector being garbage collected
+ * @param addr Address of the next allocation table entry to process
+ * @param stop_addr Address of the last allocation table entry to process
+ * @param reserve Space in the write sector kept free to complete the copy
+ * @param pending Flag indicating a garbage collection is in progress
+ */
+struct nvs_gc_state {
+	uint32_t sec_addr;
+	uint32_t addr;
+	uint32_t stop_addr;
+	uint32_t reserve;
+	bool pending;
+};
+
 /**
  * @brief Non-volatile Storage File system structure
  *
@@ -43,6 +60,10 @@ extern "C" {
  * @param nvs_lock Mutex
  * @param flash_device Flash Device runtime structure
  * @param flash_parameters Flash memory parameters structure
+ * @param lookup_cache Address of the most recent allocation table entry
+ * for each group of ids sharing a cache slot
+ * @param gc Incremental garbage collection state
+ * @param gc_work Work item completing garbage collection in the background
  */
 struct nvs_fs {
 	off_t offset;
@@ -54,6 +75,15 @@ struct nvs_fs {
 	struct k_mutex nvs_lock;
 	const struct device *flash_device;
 	const struct flash_parameters *flash_parameters;
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	uint32_t lookup_cache[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+#endif
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	struct nvs_gc_state gc;
+#ifdef CONFIG_NVS_GC_WORKQUEUE
+	struct k_work gc_work;
+#endif
+#endif
 };
 
 /**
@@ -165,6 +195,22 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len, ui
  */
 ssize_t nvs_calc_free_space(struct nvs_fs *fs);
 
+/**
+ * @brief nvs_gc_step
+ *
+ * Perform part of a pending garbage collection. With CONFIG_NVS_GC_INCREMENTAL
+ * a write that fills a sector only starts the garbage collection of the oldest
+ * sector, which is then completed in steps by subsequent writes, by the system
+ * workqueue (CONFIG_NVS_GC_WORKQUEUE) or by calling this function.
+ *
+ * @param fs Pointer to file system
+ * @param budget Maximum number of allocation table entries to process
+ *
+ * @return 0 if no garbage collection is pending, 1 if more steps are needed.
+ * On error, returns negative value of errno.h defined error codes.
+ */
+int nvs_gc_step(struct nvs_fs *fs, size_t budget);
+
 /**
  * @}
  */
@@ -761,6 +761,49 @@ __syscall void k_thread_priority_set(k_tid_t thread, int prio);
 __syscall void k_thread_deadline_set(k_tid_t thread, int deadline);
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+/**
+ * @brief Reserve a share of the CPU for a deadline thread
+ *
+ * This gives the thread a budget of @a runtime_us microseconds of CPU
+ * time in every period of @a period_us microseconds, in the style of a
+ * constant bandwidth server:
+ *
+ * - The thread's deadline is kept at the end of its current period, so
+ *   among threads of the same static priority it is scheduled earliest
+ *   deadline first.  k_thread_deadline_set() has no effect on it.
+ * - When it has run for its whole budget, it is throttled: it does not
+ *   run again until the period ends, when the budget is refilled.  The
+ *   same goes for a thread waking up with no budget left.
+ * - When it wakes up with more budget left than it could use at its
+ *   reserved rate before the end of the period, a new period starts.
+ *
+ * So a thread that runs longer than it should cannot take CPU time
+ * reserved by other threads, provided all reserving threads share the
+ * same static priority and no thread at a higher priority hogs the CPU.
+ *
+ * Budgets are enforced with kernel timeouts, so a thread may overrun its
+ * budget by up to a couple of ticks; the overrun is taken from its next
+ * period.  Runtimes and periods should be several ticks long.
+ *
+ * @note You should enable @kconfig{CONFIG_SCHED_DEADLINE_RESERVATION} in
+ * your project configuration.
+ *
+ * @param thread The thread to reserve CPU time for
+ * @param runtime_us Budget per period, in microseconds, or 0 to remove
+ *                   the reservation
+ * @param period_us Period, in microseconds
+ *
+ * @retval 0 on success
+ * @retval -EINVAL if the budget is longer than the period, or the period
+ *                 is longer than 2^31 cycles
+ * @retval -EBUSY if the total reserved utilization would exceed
+ *                @kconfig{CONFIG_SCHED_DEADLINE_RESERVATION_MAX_UTIL}
+ */
+__syscall int k_thread_reservation_set(k_tid_t thread, uint32_t runtime_us,
+				       uint32_t period_us);
+#endif
+
 #ifdef CONFIG_SCHED_CPU_MASK
 /**
  * @brief Sets all CPU enable masks to zero
@@ -1539,6 +1582,39 @@ static inline void *z_impl_k_timer_user_data_get(const struct k_timer *timer)
 	return timer->user_data;
 }
 
+/**
+ * @brief Let a timer's expiry be delayed to save timer interrupts.
+ *
+ * With @kconfig{CONFIG_TIMEOUT_SLACK}, each later expiry of the timer,
+ * periodic ones included, may happen up to @a slack after it is due,
+ * so that it can share a timer interrupt with other timeouts.  Periodic
+ * expiries are still due one period after the previous one was due,
+ * so the delays don't accumulate.  This
+ * is meant for timers that are re-armed at a high rate and whose
+ * precision does not matter much.  Without that option, this
+ * function does nothing.
+ *
+ * Takes effect the next time the timer is started.
+ *
+ * @param timer     Address of timer.
+ * @param slack     Maximum delay, relative.  K_NO_WAIT makes the timer
+ *                  exact again.
+ *
+ * @return N/A
+ */
+__syscall void k_timer_slack_set(struct k_timer *timer, k_timeout_t slack);
+
+static inline void z_impl_k_timer_slack_set(struct k_timer *timer,
+					    k_timeout_t slack)
+{
+#ifdef CONFIG_TIMEOUT_SLACK
+	timer->timeout.slack = (uint32_t)CLAMP(slack.ticks, 0, INT32_MAX);
+#else
+	ARG_UNUSED(timer);
+	ARG_UNUSED(slack);
+#endif
+}
+
 /** @} */
 
 /**
@@ -2705,17 +2781,32 @@ struct k_mutex {
 
 	/** Original thread priority */
 	int owner_orig_prio;
+
+#ifdef CONFIG_MUTEX_CEILING_PROTOCOL
+	/** Priority ceiling, or K_MUTEX_NO_CEILING */
+	int ceiling;
+#endif
 };
 
+/** Value of the priority ceiling of a mutex that has none */
+#define K_MUTEX_NO_CEILING INT32_MAX
+
 /**
  * @cond INTERNAL_HIDDEN
  */
+#ifdef CONFIG_MUTEX_CEILING_PROTOCOL
+#define Z_MUTEX_CEILING_INIT .ceiling = K_MUTEX_NO_CEILING,
+#else
+#define Z_MUTEX_CEILING_INIT
+#endif
+
 #define Z_MUTEX_INITIALIZER(obj) \
 	{ \
 	.wait_q = Z_WAIT_Q_INIT(&obj.wait_q), \
 	.owner = NULL, \
 	.lock_count = 0, \
 	.owner_orig_prio = K_LOWEST_APPLICATION_THREAD_PRIO, \
+	Z_MUTEX_CEILING_INIT \
 	}
 
 /**
@@ -2762,6 +2853,10 @@ __syscall int k_mutex_init(struct k_mutex *mutex);
  *
  * Mutexes may not be locked in ISRs.
  *
+ * With CONFIG_MUTEX_ADAPTIVE_SPIN, a thread finding the mutex locked by
+ * a thread running on another CPU busy-waits for it for up to
+ * CONFIG_MUTEX_SPIN_BUDGET_NS before waiting like otherwise.
+ *
  * @param mutex Address of the mutex.
  * @param timeout Waiting period to lock the mutex,
  *                or one of the special values K_NO_WAIT and
@@ -2770,6 +2865,9 @@ __syscall int k_mutex_init(struct k_mutex *mutex);
  * @retval 0 Mutex locked.
  * @retval -EBUSY Returned without waiting.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EINVAL The calling thread has a higher priority than the
+ *                 priority ceiling of the mutex, not counting the boosts
+ *                 from other mutexes it holds.
  */
 __syscall int k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout);
 
@@ -2795,6 +2893,30 @@ __syscall int k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout);
  */
 __syscall int k_mutex_unlock(struct k_mutex *mutex);
 
+#ifdef CONFIG_MUTEX_CEILING_PROTOCOL
+/**
+ * @brief Set the priority ceiling of a mutex.
+ *
+ * A thread locking a mutex with a priority ceiling runs at least at the
+ * ceiling priority until it unlocks it, and gets its previous priority
+ * back then.  The ceiling should be the priority of the highest
+ * priority thread using the mutex: threads of a higher priority get an
+ * error when trying to lock it.  Priority inheritance still applies on
+ * top of the ceiling.
+ *
+ * The ceiling may only be changed while the mutex is not locked.  A user
+ * thread may not set a ceiling higher than its own priority.
+ *
+ * @param mutex Address of the mutex.
+ * @param prio Ceiling priority, or K_MUTEX_NO_CEILING to remove it.
+ *
+ * @retval 0 Priority ceiling set.
+ * @retval -EBUSY The mutex is locked.
+ * @retval -EINVAL Invalid priority.
+ */
+__syscall int k_mutex_ceiling_set(struct k_mutex *mutex, int prio);
+#endif
+
 /**
  * @}
  */
@@ -3386,6 +3508,27 @@ static inline k_ticks_t k_work_delayable_expires_get(
 static inline k_ticks_t k_work_delayable_remaining_get(
 	const struct k_work_delayable *dwork);
 
+/** @brief Let a delayable work item be submitted late to save timer
+ * interrupts.
+ *
+ * With @kconfig{CONFIG_TIMEOUT_SLACK}, the work item may be submitted up
+ * to @p slack after its delay has elapsed, so that its timeout can share
+ * a timer interrupt with other ones.  Without that option, this function
+ * does nothing.
+ *
+ * Must be called after k_work_init_delayable(), and takes effect the next
+ * time the work item is scheduled.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param dwork pointer to the delayable work item.
+ *
+ * @param slack the maximum extra delay, relative.  @c K_NO_WAIT makes the
+ * delay exact again.
+ */
+static inline void k_work_delayable_slack_set(struct k_work_delayable *dwork,
+					      k_timeout_t slack);
+
 /** @brief Submit an idle work item to a queue after a delay.
  *
  * Unlike k_work_reschedule_for_queue() this is a no-op if the work item is
@@ -3836,6 +3979,17 @@ static inline k_ticks_t k_work_delayable_remaining_get(
 	return z_timeout_remaining(&dwork->timeout);
 }
 
+static inline void k_work_delayable_slack_set(struct k_work_delayable *dwork,
+					      k_timeout_t slack)
+{
+#ifdef CONFIG_TIMEOUT_SLACK
+	dwork->timeout.slack = (uint32_t)CLAMP(slack.ticks, 0, INT32_MAX);
+#else
+	ARG_UNUSED(dwork);
+	ARG_UNUSED(slack);
+#endif
+}
+
 static inline k_tid_t k_work_queue_thread_get(struct k_work_q *queue)
 {
 	return &queue->thread;
@@ -4354,6 +4508,14 @@ struct k_msgq {
 
 #define K_MSGQ_FLAG_ALLOC	BIT(0)
 
+/* Claim flags: the put or get end is owned by a thread waiting for or
+ * holding a claim, and the claim was granted.
+ */
+#define K_MSGQ_FLAG_PUT_CLAIM	BIT(1)
+#define K_MSGQ_FLAG_PUT_CLAIMED	BIT(2)
+#define K_MSGQ_FLAG_GET_CLAIM	BIT(3)
+#define K_MSGQ_FLAG_GET_CLAIMED	BIT(4)
+
 /**
  * @brief Message Queue Attributes
  */
@@ -4469,6 +4631,7 @@ int k_msgq_cleanup(struct k_msgq *msgq);
  * @retval 0 Message sent.
  * @retval -ENOMSG Returned without waiting or queue purged.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY A message slot is claimed with k_msgq_put_claim().
  */
 __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout);
 
@@ -4491,9 +4654,105 @@ __syscall int k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t time
  * @retval 0 Message received.
  * @retval -ENOMSG Returned without waiting.
  * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY A message is claimed with k_msgq_get_claim().
  */
 __syscall int k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout);
 
+/**
+ * @brief Claim a message slot of a message queue.
+ *
+ * This routine reserves the next free message slot of message queue
+ * @a msgq, so that the message can be written in place rather than
+ * copied in by k_msgq_put(). The message is sent by
+ * k_msgq_put_commit(). Only one slot can be claimed at a time; while
+ * it is, k_msgq_put() fails with -EBUSY.
+ *
+ * When the queue is full, the caller waits like k_msgq_put(), but only
+ * gets a slot once no thread waiting in k_msgq_put() is left.
+ *
+ * @note In user mode, the message buffer of @a msgq must be in a memory
+ * partition of the caller's domain, which a buffer allocated by
+ * k_msgq_alloc_init() is not.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of area to hold the address of the claimed slot.
+ * @param timeout Waiting period for a free slot, or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Slot claimed.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Another slot is already claimed or being waited for.
+ */
+__syscall int k_msgq_put_claim(struct k_msgq *msgq, void **data,
+			       k_timeout_t timeout);
+
+/**
+ * @brief Send a message written into a claimed slot.
+ *
+ * This routine sends the message written into the slot claimed with
+ * k_msgq_put_claim(), which the caller must no longer access. A thread
+ * waiting in k_msgq_get() gets a copy of the message, otherwise it is
+ * queued.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ *
+ * @retval 0 Message sent.
+ * @retval -EINVAL No slot is claimed.
+ */
+__syscall int k_msgq_put_commit(struct k_msgq *msgq);
+
+/**
+ * @brief Claim the first message of a message queue.
+ *
+ * This routine gets the address of the first message of message queue
+ * @a msgq, so that it can be read in place rather than copied out by
+ * k_msgq_get(). The message stays queued until it is released by
+ * k_msgq_get_commit(). Only one message can be claimed at a time;
+ * while it is, k_msgq_get() fails with -EBUSY.
+ *
+ * When the queue is empty, the caller waits like k_msgq_get(), but only
+ * gets a message once no thread waiting in k_msgq_get() is left.
+ *
+ * @note In user mode, the message buffer of @a msgq must be in a memory
+ * partition of the caller's domain, which a buffer allocated by
+ * k_msgq_alloc_init() is not.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ * @param data Address of area to hold the address of the message.
+ * @param timeout Waiting period for a message, or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Message claimed.
+ * @retval -ENOMSG Returned without waiting or queue purged.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Another message is already claimed or being waited for.
+ */
+__syscall int k_msgq_get_claim(struct k_msgq *msgq, void **data,
+			       k_timeout_t timeout);
+
+/**
+ * @brief Release a claimed message.
+ *
+ * This routine removes the message claimed with k_msgq_get_claim() from
+ * the queue. The caller must no longer access it, as its slot is handed
+ * to a thread waiting to send a message, if any.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param msgq Address of the message queue.
+ *
+ * @retval 0 Message released.
+ * @retval -EINVAL No message is claimed.
+ */
+__syscall int k_msgq_get_commit(struct k_msgq *msgq);
+
 /**
  * @brief Peek/read a message from a message queue.
  *
@@ -4517,6 +4776,10 @@ __syscall int k_msgq_peek(struct k_msgq *msgq, void *data);
  * buffer. Any threads that are blocked waiting to send a message to the
  * message queue are unblocked and see an -ENOMSG error code.
  *
+ * A message claimed with k_msgq_get_claim() is kept. When a message slot
+ * is claimed with k_msgq_put_claim() at the same time, no message is
+ * discarded.
+ *
  * @param msgq Address of the message queue.
  *
  * @return N/A
@@ -4572,6 +4835,199 @@ static inline uint32_t z_impl_k_msgq_num_used_get(struct k_msgq *msgq)
 
 /** @} */
 
+/**
+ * @defgroup mpmcq_apis MPMC Queue APIs
+ * @ingroup kernel_apis
+ * @{
+ */
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+/* The enqueue and dequeue positions are written by every put and get,
+ * so on SMP they get a cache line each to keep producers and consumers
+ * from bouncing a shared line between CPUs.
+ */
+#if defined(CONFIG_SMP) && defined(CONFIG_DCACHE_LINE_SIZE) && \
+	(CONFIG_DCACHE_LINE_SIZE > 0)
+#define Z_MPMCQ_ALIGN CONFIG_DCACHE_LINE_SIZE
+#elif defined(CONFIG_SMP)
+#define Z_MPMCQ_ALIGN 64
+#else
+#define Z_MPMCQ_ALIGN sizeof(atomic_t)
+#endif
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @brief MPMC Queue Slot
+ *
+ * Storage for one item of a multi-producer multi-consumer queue.
+ */
+struct k_mpmcq_slot {
+	/** Sequence number, relative to the slot index */
+	atomic_t seq;
+	/** Queued item */
+	void *data;
+};
+
+/**
+ * @brief MPMC Queue Structure
+ */
+struct k_mpmcq {
+	/** Slot array */
+	struct k_mpmcq_slot *slots;
+	/** Number of slots minus one */
+	uint32_t mask;
+	/** Lock, only taken to wait or to wake waiters */
+	struct k_spinlock lock;
+	/** Threads waiting for an item */
+	_wait_q_t get_wait_q;
+	/** Threads waiting for a free slot */
+	_wait_q_t put_wait_q;
+	/** Number of threads waiting for an item */
+	atomic_t get_waiters;
+	/** Number of threads waiting for a free slot */
+	atomic_t put_waiters;
+
+	_POLL_EVENT;
+
+	/** Next position to enqueue at */
+	atomic_t head __aligned(Z_MPMCQ_ALIGN);
+	/** Next position to dequeue from */
+	atomic_t tail __aligned(Z_MPMCQ_ALIGN);
+};
+
+/**
+ * @cond INTERNAL_HIDDEN
+ */
+
+#define Z_MPMCQ_INITIALIZER(obj, q_slots, q_max_items) \
+	{ \
+	.slots = q_slots, \
+	.mask = (q_max_items) - 1, \
+	.get_wait_q = Z_WAIT_Q_INIT(&obj.get_wait_q), \
+	.put_wait_q = Z_WAIT_Q_INIT(&obj.put_wait_q), \
+	_POLL_EVENT_OBJ_INIT(obj) \
+	}
+
+/**
+ * INTERNAL_HIDDEN @endcond
+ */
+
+/**
+ * @brief Statically define and initialize an MPMC queue.
+ *
+ * The queue can hold up to @a q_max_items pointers, which must be a power
+ * of 2.
+ *
+ * The queue can be accessed outside the module where it is defined using:
+ *
+ * @code extern struct k_mpmcq <name>; @endcode
+ *
+ * @param q_name Name of the queue.
+ * @param q_max_items Maximum number of items that can be queued.
+ */
+#define K_MPMCQ_DEFINE(q_name, q_max_items)				\
+	BUILD_ASSERT(((q_max_items) & ((q_max_items) - 1)) == 0 &&	\
+		     (q_max_items) > 0,					\
+		     "MPMC queue size must be a power of 2");		\
+	static struct k_mpmcq_slot _k_mpmcq_slots_##q_name[q_max_items]; \
+	struct k_mpmcq q_name =						\
+		Z_MPMCQ_INITIALIZER(q_name, _k_mpmcq_slots_##q_name,	\
+				    q_max_items)
+
+/**
+ * @brief Initialize an MPMC queue.
+ *
+ * This routine initializes a bounded multi-producer multi-consumer queue
+ * of pointers, prior to its first use. Items are added and removed
+ * without taking a lock; the lock is only used when a thread has to wait
+ * for an item or a free slot, or when a waiting thread or a k_poll() has
+ * to be woken up.
+ *
+ * MPMC queues are not kernel objects and cannot be used from user mode.
+ *
+ * @param q Address of the queue.
+ * @param slots Array of @a max_items slots holding the queued items.
+ * @param max_items Maximum number of items that can be queued, a power
+ *                  of 2.
+ *
+ * @return N/A
+ */
+void k_mpmcq_init(struct k_mpmcq *q, struct k_mpmcq_slot *slots,
+		  uint32_t max_items);
+
+/**
+ * @brief Add an item to an MPMC queue.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param q Address of the queue.
+ * @param data Item to add, must not be NULL.
+ * @param timeout Waiting period to add the item, or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Item added.
+ * @retval -ENOMSG Returned without waiting.
+ * @retval -EAGAIN Waiting period timed out.
+ */
+int k_mpmcq_put(struct k_mpmcq *q, void *data, k_timeout_t timeout);
+
+/**
+ * @brief Get an item from an MPMC queue.
+ *
+ * Items are returned in the order they were added, as far as the order
+ * of concurrent k_mpmcq_put() calls is defined.
+ *
+ * @note @a timeout must be set to K_NO_WAIT if called from ISR.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param q Address of the queue.
+ * @param timeout Waiting period to get an item, or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @return Address of the item if successful; NULL if returned without
+ *         waiting, or waiting period timed out.
+ */
+void *k_mpmcq_get(struct k_mpmcq *q, k_timeout_t timeout);
+
+/**
+ * @brief Query an MPMC queue to see if it has data available.
+ *
+ * The result is only a snapshot when other threads or ISRs use the queue
+ * concurrently.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param q Address of the queue.
+ *
+ * @return true if the queue is empty, false otherwise.
+ */
+bool k_mpmcq_is_empty(struct k_mpmcq *q);
+
+/**
+ * @brief Get the number of items in an MPMC queue.
+ *
+ * The result is only a snapshot when other threads or ISRs use the queue
+ * concurrently.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param q Address of the queue.
+ *
+ * @return Number of queued items.
+ */
+uint32_t k_mpmcq_num_used_get(struct k_mpmcq *q);
+
+/** @} */
+
 /**
  * @defgroup mailbox_apis Mailbox APIs
  * @ingroup kernel_apis
@@ -4756,12 +5212,17 @@ struct k_pipe {
 	} wait_q;			/** Wait queue */
 
 	uint8_t	       flags;		/**< Flags */
+
+	size_t         put_claimed;     /**< # bytes claimed for writing */
+	size_t         get_claimed;     /**< # bytes claimed for reading */
 };
 
 /**
  * @cond INTERNAL_HIDDEN
  */
 #define K_PIPE_FLAG_ALLOC	BIT(0)	/** Buffer was allocated */
+#define K_PIPE_FLAG_PUT_CLAIM	BIT(1)	/** Put end owned by a claimer */
+#define K_PIPE_FLAG_GET_CLAIM	BIT(2)	/** Get end owned by a claimer */
 
 #define Z_PIPE_INITIALIZER(obj, pipe_buffer, pipe_buffer_size)     \
 	{                                                           \
@@ -4775,7 +5236,9 @@ struct k_pipe {
 		.readers = Z_WAIT_Q_INIT(&obj.wait_q.readers),       \
 		.writers = Z_WAIT_Q_INIT(&obj.wait_q.writers)        \
 	},                                                          \
-	.flags = 0                                                  \
+	.flags = 0,                                                 \
+	.put_claimed = 0,                                           \
+	.get_claimed = 0                                            \
 	}
 
 /**
@@ -4863,6 +5326,7 @@ __syscall int k_pipe_alloc_init(struct k_pipe *pipe, size_t size);
  * @retval -EIO Returned without waiting; zero data bytes were written.
  * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
  *                 minus one data bytes were written.
+ * @retval -EBUSY Buffer space is claimed with k_pipe_put_claim().
  */
 __syscall int k_pipe_put(struct k_pipe *pipe, void *data,
 			 size_t bytes_to_write, size_t *bytes_written,
@@ -4886,6 +5350,7 @@ __syscall int k_pipe_put(struct k_pipe *pipe, void *data,
  * @retval -EIO Returned without waiting; zero data bytes were read.
  * @retval -EAGAIN Waiting period timed out; between zero and @a min_xfer
  *                 minus one data bytes were read.
+ * @retval -EBUSY Data is claimed with k_pipe_get_claim().
  */
 __syscall int k_pipe_get(struct k_pipe *pipe, void *data,
 			 size_t bytes_to_read, size_t *bytes_read,
@@ -4911,12 +5376,120 @@ __syscall size_t k_pipe_read_avail(struct k_pipe *pipe);
  */
 __syscall size_t k_pipe_write_avail(struct k_pipe *pipe);
 
+/**
+ * @brief Claim contiguous free space in a pipe's buffer.
+ *
+ * This routine reserves up to @a size bytes of free space in the ring
+ * buffer of @a pipe, so that data can be written in place rather than
+ * copied in by k_pipe_put(). The data is added to the pipe by
+ * k_pipe_put_commit(). Only one claim can be held at a time; while it
+ * is, k_pipe_put() fails with -EBUSY.
+ *
+ * The claimed space is contiguous, so less than requested may be
+ * claimed even though more is free, when the free space wraps around
+ * the end of the buffer. When the buffer is full, the caller waits for
+ * a reader to make room.
+ *
+ * @note In user mode, the buffer of @a pipe must be in a memory partition
+ * of the caller's domain, which a buffer allocated by k_pipe_alloc_init()
+ * is not.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of area to hold the address of the claimed space.
+ * @param size Address of the requested number of bytes, updated with the
+ *             number of bytes claimed.
+ * @param timeout Waiting period for free space, or one of the special
+ *                values K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Space claimed.
+ * @retval -EINVAL Unbuffered pipe or zero bytes requested.
+ * @retval -EIO Returned without waiting; the buffer is full.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Space is already claimed or being waited for.
+ */
+__syscall int k_pipe_put_claim(struct k_pipe *pipe, void **data, size_t *size,
+			       k_timeout_t timeout);
+
+/**
+ * @brief Add data written into claimed space to a pipe.
+ *
+ * This routine adds the first @a size bytes of the space claimed with
+ * k_pipe_put_claim() to the data in @a pipe and releases the claim.
+ * Threads waiting in k_pipe_get() receive the data. A @a size of zero
+ * cancels the claim.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes written, at most the number claimed.
+ *
+ * @retval 0 Data added.
+ * @retval -EINVAL No space claimed, or @a size larger than claimed.
+ */
+__syscall int k_pipe_put_commit(struct k_pipe *pipe, size_t size);
+
+/**
+ * @brief Claim contiguous data in a pipe's buffer.
+ *
+ * This routine gets up to @a size bytes of data from the ring buffer of
+ * @a pipe, so that they can be read in place rather than copied out by
+ * k_pipe_get(). The data stays in the pipe until it is released by
+ * k_pipe_get_commit(). Only one claim can be held at a time; while it
+ * is, k_pipe_get() fails with -EBUSY.
+ *
+ * The claimed data is contiguous, so less than requested may be claimed
+ * even though more is available, when the data wraps around the end of
+ * the buffer. When the buffer is empty, the caller waits for a writer.
+ *
+ * @note In user mode, the buffer of @a pipe must be in a memory partition
+ * of the caller's domain, which a buffer allocated by k_pipe_alloc_init()
+ * is not.
+ *
+ * @param pipe Address of the pipe.
+ * @param data Address of area to hold the address of the claimed data.
+ * @param size Address of the requested number of bytes, updated with the
+ *             number of bytes claimed.
+ * @param timeout Waiting period for data, or one of the special values
+ *                K_NO_WAIT and K_FOREVER.
+ *
+ * @retval 0 Data claimed.
+ * @retval -EINVAL Unbuffered pipe or zero bytes requested.
+ * @retval -EIO Returned without waiting; the buffer is empty.
+ * @retval -EAGAIN Waiting period timed out.
+ * @retval -EBUSY Data is already claimed or being waited for.
+ */
+__syscall int k_pipe_get_claim(struct k_pipe *pipe, void **data, size_t *size,
+			       k_timeout_t timeout);
+
+/**
+ * @brief Release data claimed from a pipe.
+ *
+ * This routine removes the first @a size bytes of the data claimed with
+ * k_pipe_get_claim() from @a pipe and releases the claim. The freed
+ * space is filled with data of threads waiting in k_pipe_put(). A
+ * @a size of zero leaves all claimed data in the pipe.
+ *
+ * @param pipe Address of the pipe.
+ * @param size Number of bytes consumed, at most the number claimed.
+ *
+ * @retval 0 Data released.
+ * @retval -EINVAL No data claimed, or @a size larger than claimed.
+ */
+__syscall int k_pipe_get_commit(struct k_pipe *pipe, size_t size);
+
 /** @} */
 
 /**
  * @cond INTERNAL_HIDDEN
  */
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+/* Per-CPU cache of free blocks, linked like the slab's own free list */
+struct k_mem_slab_cpu_cache {
+	struct k_spinlock lock;
+	char *free_list;
+	uint32_t count;
+};
+#endif
+
 struct k_mem_slab {
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
@@ -4924,10 +5497,20 @@ struct k_mem_slab {
 	size_t block_size;
 	char *buffer;
 	char *free_list;
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	/* Updated outside the slab lock by the per-CPU caches */
+	atomic_t num_used;
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	atomic_t max_used;
+#endif
+	atomic_t waiters;
+	struct k_mem_slab_cpu_cache cache[CONFIG_MP_NUM_CPUS];
+#else
 	uint32_t num_used;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	uint32_t max_used;
 #endif
+#endif
 
 };
 
@@ -5069,6 +5652,57 @@ extern int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem,
  */
 extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
 
+/**
+ * @brief Allocate several memory blocks from a memory slab.
+ *
+ * This routine allocates @a count memory blocks from a memory slab, taking
+ * the slab's lock at most once in the common case. Either all blocks are
+ * allocated or none is. It never waits for blocks to be freed.
+ *
+ * @funcprops \isr_ok
+ *
+ * @param slab Address of the memory slab.
+ * @param mem Array of @a count block addresses, set on success.
+ * @param count Number of memory blocks to allocate.
+ *
+ * @retval 0 Memory allocated.
+ * @retval -ENOMEM Fewer than @a count blocks are free, none was allocated.
+ */
+extern int k_mem_slab_alloc_n(struct k_mem_slab *slab, void **mem,
+			      uint32_t count);
+
+/**
+ * @brief Free several memory blocks allocated from a memory slab.
+ *
+ * This routine releases @a count memory blocks back to their memory slab,
+ * taking the slab's lock at most once.
+ *
+ * @param slab Address of the memory slab.
+ * @param mem Array of @a count block addresses (as set by
+ *            k_mem_slab_alloc() or k_mem_slab_alloc_n()).
+ * @param count Number of memory blocks to free.
+ *
+ * @return N/A
+ */
+extern void k_mem_slab_free_n(struct k_mem_slab *slab, void **mem,
+			      uint32_t count);
+
+#if defined(CONFIG_MEM_SLAB_CPU_CACHE) || defined(__DOXYGEN__)
+/**
+ * @brief Return the blocks cached by all CPUs to a memory slab.
+ *
+ * Blocks sitting in a CPU's cache are free, but can only be allocated
+ * from that CPU until they are returned to the slab. The slab does this
+ * by itself before it fails an allocation or makes it wait, so calling
+ * this is never needed for correctness.
+ *
+ * Has effect only with CONFIG_MEM_SLAB_CPU_CACHE.
+ *
+ * @param slab Address of the memory slab.
+ */
+extern void k_mem_slab_cache_flush(struct k_mem_slab *slab);
+#endif
+
 /**
  * @brief Get the number of used blocks in a memory slab.
  *
@@ -5081,7 +5715,11 @@ extern void k_mem_slab_free(struct k_mem_slab *slab, void **mem);
  */
 static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
 {
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	return (uint32_t)atomic_get(&slab->num_used);
+#else
 	return slab->num_used;
+#endif
 }
 
 /**
@@ -5096,7 +5734,10 @@ static inline uint32_t k_mem_slab_num_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
 {
-#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+#if defined(CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION) && \
+	defined(CONFIG_MEM_SLAB_CPU_CACHE)
+	return (uint32_t)atomic_get(&slab->max_used);
+#elif defined(CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION)
 	return slab->max_used;
 #else
 	ARG_UNUSED(slab);
@@ -5116,7 +5757,7 @@ static inline uint32_t k_mem_slab_max_used_get(struct k_mem_slab *slab)
  */
 static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
 {
-	return slab->num_blocks - slab->num_used;
+	return slab->num_blocks - k_mem_slab_num_used_get(slab);
 }
 
 /** @} */
@@ -5126,12 +5767,53 @@ static inline uint32_t k_mem_slab_num_free_get(struct k_mem_slab *slab)
  * @{
  */
 
+/**
+ * @brief Use per-CPU magazine caches for small allocations
+ *
+ * Has effect only with CONFIG_HEAP_MAGAZINES.
+ */
+#define K_HEAP_MAGAZINES BIT(0)
+
+#ifdef CONFIG_HEAP_MAGAZINES
+/* Per-CPU cache of free blocks, one stack per size class */
+struct k_heap_magazine {
+	struct k_spinlock lock;
+	uint8_t count[CONFIG_HEAP_MAGAZINE_CLASSES];
+	void *blocks[CONFIG_HEAP_MAGAZINE_CLASSES][CONFIG_HEAP_MAGAZINE_DEPTH];
+	uint32_t hits;
+	uint32_t misses;
+	uint32_t refills;
+	uint32_t flushes;
+};
+
+/**
+ * @brief k_heap magazine statistics, summed over all CPUs
+ */
+struct k_heap_magazine_stats {
+	/** Allocations served from a magazine without refilling */
+	uint32_t hits;
+	/** Allocations that found their magazine empty */
+	uint32_t misses;
+	/** Batch refills of a magazine from the heap */
+	uint32_t refills;
+	/** Batch returns of blocks from a magazine to the heap */
+	uint32_t flushes;
+	/** Blocks currently sitting in magazines */
+	uint32_t cached_blocks;
+};
+#endif
+
 /* kernel synchronized heap struct */
 
 struct k_heap {
 	struct sys_heap heap;
 	_wait_q_t wait_q;
 	struct k_spinlock lock;
+#ifdef CONFIG_HEAP_MAGAZINES
+	uint32_t flags;
+	atomic_t mag_waiters;
+	struct k_heap_magazine magazines[CONFIG_MP_NUM_CPUS];
+#endif
 };
 
 /**
@@ -5149,6 +5831,21 @@ struct k_heap {
  */
 void k_heap_init(struct k_heap *h, void *mem, size_t bytes);
 
+/**
+ * @brief Initialize a k_heap with flags
+ *
+ * Like k_heap_init(), but allows selecting optional behavior such
+ * as K_HEAP_MAGAZINES.  Flags that are not supported by the kernel
+ * configuration are ignored.
+ *
+ * @param h Heap struct to initialize
+ * @param mem Pointer to memory.
+ * @param bytes Size of memory region, in bytes
+ * @param flags Bitmask of K_HEAP_* flags
+ */
+void k_heap_init_flags(struct k_heap *h, void *mem, size_t bytes,
+		       uint32_t flags);
+
 /** @brief Allocate aligned memory from a k_heap
  *
  * Behaves in all ways like k_heap_alloc(), except that the returned
@@ -5206,6 +5903,29 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes,
  */
 void k_heap_free(struct k_heap *h, void *mem);
 
+#if defined(CONFIG_HEAP_MAGAZINES) || defined(__DOXYGEN__)
+/**
+ * @brief Return all magazine-cached blocks of a k_heap to the heap
+ *
+ * Blocks cached in per-CPU magazines are counted as allocated by the
+ * underlying sys_heap.  This makes them available again for
+ * allocations of any size, e.g. before inspecting heap statistics.
+ *
+ * @param h Heap to flush
+ */
+void k_heap_magazine_flush(struct k_heap *h);
+
+/**
+ * @brief Get the magazine statistics of a k_heap
+ *
+ * @param h Heap to query
+ * @param stats Pointer to struct to copy statistics into
+ * @return -EINVAL if null pointers, otherwise 0
+ */
+int k_heap_magazine_stats_get(struct k_heap *h,
+			      struct k_heap_magazine_stats *stats);
+#endif
+
 /* Hand-calculated minimum heap sizes needed to return a successful
  * 1-byte allocation.  See details in lib/os/heap.[ch]
  */
@@ -5228,6 +5948,9 @@ void k_heap_free(struct k_heap *h, void *mem);
  * @param in_section __attribute__((section(name))
  */
 #define Z_HEAP_DEFINE_IN_SECT(name, bytes, in_section)		\
+	Z_HEAP_DEFINE_IN_SECT_FLAGS(name, bytes, in_section, 0)
+
+#define Z_HEAP_DEFINE_IN_SECT_FLAGS(name, bytes, in_section, f)	\
 	char in_section						\
 	     __aligned(8) /* CHUNK_UNIT */			\
 	     kheap_##name[MAX(bytes, Z_HEAP_MIN_SIZE)];		\
@@ -5236,6 +5959,7 @@ void k_heap_free(struct k_heap *h, void *mem);
 			.init_mem = kheap_##name,		\
 			.init_bytes = MAX(bytes, Z_HEAP_MIN_SIZE), \
 		 },						\
+		IF_ENABLED(CONFIG_HEAP_MAGAZINES, (.flags = (f),)) \
 	}
 
 /**
@@ -5256,6 +5980,20 @@ void k_heap_free(struct k_heap *h, void *mem);
 	Z_HEAP_DEFINE_IN_SECT(name, bytes,			\
 			      __noinit_named(kheap_buf_##name))
 
+/**
+ * @brief Define a static k_heap with flags
+ *
+ * Like K_HEAP_DEFINE(), but the heap is initialized as if by
+ * k_heap_init_flags() with the given flags.
+ *
+ * @param name Symbol name for the struct k_heap object
+ * @param bytes Size of memory region, in bytes
+ * @param flags Bitmask of K_HEAP_* flags
+ */
+#define K_HEAP_DEFINE_FLAGS(name, bytes, flags)			\
+	Z_HEAP_DEFINE_IN_SECT_FLAGS(name, bytes,		\
+				    __noinit_named(kheap_buf_##name), flags)
+
 /**
  * @brief Define a static k_heap in uncached memory
  *
@@ -5370,6 +6108,9 @@ enum _poll_types_bits {
 	/* msgq data availability */
 	_POLL_TYPE_MSGQ_DATA_AVAILABLE,
 
+	/* MPMC queue data availability */
+	_POLL_TYPE_MPMCQ_DATA_AVAILABLE,
+
 	_POLL_NUM_TYPES
 };
 
@@ -5395,6 +6136,9 @@ enum _poll_states_bits {
 	/* data is available to read on a message queue */
 	_POLL_STATE_MSGQ_DATA_AVAILABLE,
 
+	/* data is available to read on an MPMC queue */
+	_POLL_STATE_MPMCQ_DATA_AVAILABLE,
+
 	_POLL_NUM_STATES
 };
 
@@ -5426,6 +6170,7 @@ enum _poll_states_bits {
 #define K_POLL_TYPE_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_DATA_AVAILABLE)
 #define K_POLL_TYPE_FIFO_DATA_AVAILABLE K_POLL_TYPE_DATA_AVAILABLE
 #define K_POLL_TYPE_MSGQ_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_MSGQ_DATA_AVAILABLE)
+#define K_POLL_TYPE_MPMCQ_DATA_AVAILABLE Z_POLL_TYPE_BIT(_POLL_TYPE_MPMCQ_DATA_AVAILABLE)
 
 /* public - polling modes */
 enum k_poll_modes {
@@ -5442,6 +6187,7 @@ enum k_poll_modes {
 #define K_POLL_STATE_DATA_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_DATA_AVAILABLE)
 #define K_POLL_STATE_FIFO_DATA_AVAILABLE K_POLL_STATE_DATA_AVAILABLE
 #define K_POLL_STATE_MSGQ_DATA_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_MSGQ_DATA_AVAILABLE)
+#define K_POLL_STATE_MPMCQ_DATA_AVAILABLE Z_POLL_STATE_BIT(_POLL_STATE_MPMCQ_DATA_AVAILABLE)
 #define K_POLL_STATE_CANCELLED Z_POLL_STATE_BIT(_POLL_STATE_CANCELLED)
 
 /* public - poll signal object */
@@ -5499,6 +6245,7 @@ struct k_poll_event {
 		struct k_fifo *fifo;
 		struct k_queue *queue;
 		struct k_msgq *msgq;
+		struct k_mpmcq *mpmcq;
 	};
 };
 
@@ -5888,6 +6635,38 @@ int k_thread_runtime_stats_get(k_tid_t thread,
  */
 int k_thread_runtime_stats_all_get(k_thread_runtime_stats_t *stats);
 
+#ifdef CONFIG_SCHED_THREAD_STATS
+/**
+ * @brief Get the scheduler statistics of a thread
+ *
+ * @param thread ID of thread.
+ * @param stats Pointer to struct to copy statistics into.
+ * @return -EINVAL if null pointers, otherwise 0
+ */
+int k_thread_sched_stats_get(k_tid_t thread,
+			     struct k_thread_sched_stats *stats);
+
+/**
+ * @brief Reset the scheduler statistics of a thread
+ *
+ * @param thread ID of thread.
+ */
+void k_thread_sched_stats_reset(k_tid_t thread);
+
+/**
+ * @brief Get the run queue statistics of a CPU
+ *
+ * The statistics are updated and copied under the scheduler lock, so the
+ * copy is consistent.
+ *
+ * @param cpu CPU index.
+ * @param stats Pointer to struct to copy statistics into.
+ * @return -EINVAL if @a cpu is not a valid CPU index or @a stats is
+ *         NULL, otherwise 0
+ */
+int k_cpu_sched_stats_get(int cpu, struct k_cpu_sched_stats *stats);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
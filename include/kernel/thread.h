@@ -39,6 +39,73 @@ struct __thread_entry {
 };
 #endif
 
+#ifdef CONFIG_SCHED_THREAD_STATS
+/**
+ * @brief Scheduler statistics of a thread
+ *
+ * A wakeup is a switch into the thread after it was made ready, by being
+ * started, resumed or woken up from a wait or a sleep. Its latency is the
+ * time from being made ready to being switched in.
+ */
+struct k_thread_sched_stats {
+	/** Number of wakeups */
+	uint32_t wakeups;
+	/** Number of switches away from the thread while it was ready to
+	 * run, i.e. preemptions, time slice expirations and yields
+	 */
+	uint32_t preemptions;
+	/** Longest wakeup latency, in microseconds */
+	uint32_t wakeup_latency_max_us;
+	/** Wakeup latency histogram: bucket 0 counts wakeups within 1 us,
+	 * bucket N those within [2^(N-1), 2^N) us, the last bucket all the
+	 * longer ones
+	 */
+	uint32_t wakeup_latency_hist[CONFIG_SCHED_THREAD_STATS_BUCKETS];
+};
+
+/**
+ * @brief Run queue statistics of a CPU
+ *
+ * The length of the run queue is sampled each time the CPU switches to
+ * another thread. The thread switched to is not counted, even on
+ * uniprocessor builds where the running thread stays queued. With a
+ * single run queue shared by all CPUs, each CPU samples the shared queue.
+ */
+struct k_cpu_sched_stats {
+	/** Number of samples */
+	uint32_t runq_len_samples;
+	/** Longest sampled run queue */
+	uint32_t runq_len_max;
+	/** Sum of the sampled lengths */
+	uint64_t runq_len_sum;
+};
+#endif
+
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+/* CPU budget reservation, see k_thread_reservation_set().  Times are
+ * in k_cycle_get_32() units, runtime is zero without a reservation.
+ */
+struct _thread_resv {
+	uint32_t runtime;
+	uint32_t period;
+
+	/* reserved share of the CPU, in parts per million */
+	uint32_t util;
+
+	/* budget left in the current period, negative when overrun */
+	int32_t budget;
+
+	/* end of the current period */
+	uint32_t deadline;
+
+	/* cycle count the budget was last charged at while running */
+	uint32_t start;
+
+	/* end of throttling, armed when the budget is used up */
+	struct _timeout replenish;
+};
+#endif
+
 /* can be used for creating 'dummy' threads, e.g. for pending on objects */
 struct _thread_base {
 
@@ -120,6 +187,25 @@ struct _thread_base {
 #ifdef CONFIG_SCHED_THREAD_USAGE
 	uint64_t usage;
 #endif
+
+#ifdef CONFIG_SCHED_THREAD_STATS
+	struct k_thread_sched_stats sched_stats;
+
+	/* cycle count when made ready, 0 when not waiting to run */
+	uint32_t ready_stamp;
+#endif
+
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+	struct _thread_resv resv;
+#endif
+
+#ifdef CONFIG_MUTEX_CEILING_PROTOCOL
+	/* number of k_mutex objects held */
+	uint16_t mutexes_held;
+
+	/* priority before taking the first of them, i.e. unboosted */
+	int8_t mutex_base_prio;
+#endif
 };
 
 typedef struct _thread_base _thread_base_t;
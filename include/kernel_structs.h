@@ -61,6 +61,9 @@ extern "C" {
 /* Thread is being aborted */
 #define _THREAD_ABORTING (BIT(5))
 
+/* Thread has used up its CPU budget reservation */
+#define _THREAD_THROTTLED (BIT(6))
+
 /* Thread is present in the ready queue */
 #define _THREAD_QUEUED (BIT(7))
 
@@ -92,6 +95,11 @@ struct _ready_q {
 #elif defined(CONFIG_SCHED_MULTIQ)
 	struct _priq_mq runq;
 #endif
+
+#ifdef CONFIG_SCHED_THREAD_STATS
+	/* number of threads in runq */
+	uint32_t len;
+#endif
 };
 
 typedef struct _ready_q _ready_q_t;
@@ -134,6 +142,13 @@ struct _cpu {
 	uint32_t usage0;
 #endif
 
+#ifdef CONFIG_SCHED_THREAD_STATS
+	/* run queue length samples taken at context switches */
+	uint64_t runq_len_sum;
+	uint32_t runq_len_samples;
+	uint32_t runq_len_max;
+#endif
+
 	/* Per CPU architecture specifics */
 	struct _cpu_arch arch;
 };
@@ -229,12 +244,21 @@ typedef void (*_timeout_func_t)(struct _timeout *t);
 struct _timeout {
 	sys_dnode_t node;
 	_timeout_func_t fn;
+	/* Ticks after the previous queue entry, or the absolute expiry
+	 * tick with CONFIG_TIMEOUT_WHEEL
+	 */
 #ifdef CONFIG_TIMEOUT_64BIT
 	/* Can't use k_ticks_t for header dependency reasons */
 	int64_t dticks;
 #else
 	int32_t dticks;
 #endif
+#ifdef CONFIG_TIMEOUT_SLACK
+	/* Ticks the expiry may be delayed by to share a timer interrupt */
+	uint32_t slack;
+	/* Ticks the expiry was actually delayed by when last added */
+	uint32_t slack_delay;
+#endif
 };
 
 #ifdef __cplusplus
@@ -0,0 +1,50 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_LOG_BACKEND_FS_H_
+#define ZEPHYR_LOG_BACKEND_FS_H_
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @brief File system logger backend
+ * @defgroup log_backend_fs File system logger backend
+ * @ingroup logger
+ * @{
+ */
+
+/** @brief Log file write statistics. */
+struct log_backend_fs_stats {
+	/** Number of bytes written to log files. */
+	uint32_t bytes;
+
+	/** Number of writes to log files. */
+	uint32_t writes;
+
+	/** Number of log file synchronizations. */
+	uint32_t syncs;
+};
+
+/** @brief Get log file write statistics.
+ *
+ * Requires CONFIG_LOG_BACKEND_FS_STATS.
+ *
+ * @param stats Location where statistics are written.
+ */
+void log_backend_fs_stats_get(struct log_backend_fs_stats *stats);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* ZEPHYR_LOG_BACKEND_FS_H_ */
@@ -65,6 +65,14 @@ static inline uint32_t z_log_sources_count(void)
 	return log_const_source_id(__log_const_end);
 }
 
+/** @brief Check if address is in read only section.
+ *
+ * @param addr Address.
+ *
+ * @return True if address identified within read only section.
+ */
+bool z_log_is_rodata(const void *addr);
+
 /** @brief Initialize module for handling logging message. */
 void z_log_msg2_init(void);
 
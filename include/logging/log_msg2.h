@@ -118,6 +118,13 @@ enum z_log_msg2_mode {
 	 */
 	Z_LOG_MSG2_MODE_ZERO_COPY,
 
+	/* Mode used with CONFIG_LOG2_FMT_ID for messages with string
+	 * arguments. String package is created statically on stack, together
+	 * with positions of string arguments, and strings which are not in
+	 * read only memory are appended in the function creating a message.
+	 */
+	Z_LOG_MSG2_MODE_FROM_STACK_STR,
+
 	/* Mode used when synchronous logging is enabled. */
 	Z_LOG_MSG2_MODE_SYNC
 };
@@ -260,6 +267,30 @@ do { \
 #define Z_LOG_MSG2_SIMPLE_CREATE(...)
 #endif
 
+#if CONFIG_LOG2_FMT_ID
+#define Z_LOG_MSG2_STR_CREATE(_domain_id, _source, _level, _data, _dlen, ...) \
+do { \
+	int _plen; \
+	CBPRINTF_STATIC_PACKAGE(NULL, 0, _plen, Z_LOG_MSG2_ALIGN_OFFSET, \
+				CBPRINTF_PACKAGE_ADD_STRING_IDXS, __VA_ARGS__); \
+	struct log_msg2 *_msg; \
+	Z_LOG_MSG2_ON_STACK_ALLOC(_msg, Z_LOG_MSG2_LEN(_plen, 0)); \
+	CBPRINTF_STATIC_PACKAGE(_msg->data, _plen, _plen, \
+				Z_LOG_MSG2_ALIGN_OFFSET, \
+				CBPRINTF_PACKAGE_ADD_STRING_IDXS, __VA_ARGS__); \
+	struct log_msg2_desc _desc = \
+		Z_LOG_MSG_DESC_INITIALIZER(_domain_id, _level, \
+					   (uint32_t)_plen, _dlen); \
+	LOG_MSG2_DBG("creating message with strings: package len: %d\n", \
+			_plen); \
+	z_log_msg2_static_str_create((void *)_source, _desc, _msg->data, \
+				     _data); \
+} while (0)
+#else
+/* Alternative empty macro used when LOG2_FMT_ID is disabled (default). */
+#define Z_LOG_MSG2_STR_CREATE(...)
+#endif
+
 /* Macro handles case when local variable with log message string is created.It
  * replaces origing string literal with that variable.
  */
@@ -375,7 +406,13 @@ do { \
 			  _level, _data, _dlen, ...) \
 do { \
 	Z_LOG_MSG2_STR_VAR(_fmt, ##__VA_ARGS__); \
-	if (CBPRINTF_MUST_RUNTIME_PACKAGE(_cstr_cnt, __VA_ARGS__)) { \
+	if (IS_ENABLED(CONFIG_LOG2_FMT_ID) && \
+	    CBPRINTF_MUST_RUNTIME_PACKAGE(_cstr_cnt, __VA_ARGS__)) { \
+		LOG_MSG2_DBG("create message with strings\n");\
+		Z_LOG_MSG2_STR_CREATE(_domain_id, _source, _level, _data, \
+				      _dlen, Z_LOG_FMT_ARGS(_fmt, ##__VA_ARGS__)); \
+		_mode = Z_LOG_MSG2_MODE_FROM_STACK_STR; \
+	} else if (CBPRINTF_MUST_RUNTIME_PACKAGE(_cstr_cnt, __VA_ARGS__)) { \
 		LOG_MSG2_DBG("create runtime message\n");\
 		z_log_msg2_runtime_create(_domain_id, (void *)_source, \
 					  _level, (uint8_t *)_data, _dlen,\
@@ -440,6 +477,24 @@ __syscall void z_log_msg2_static_create(const void *source,
 					const struct log_msg2_desc desc,
 					uint8_t *package, const void *data);
 
+/** @brief Create message from a string package with string positions.
+ *
+ * Package must be created with @ref CBPRINTF_PACKAGE_ADD_STRING_IDXS. Strings
+ * which are not in read only memory are appended to the message, without
+ * parsing the format string.
+ *
+ * @param source Source.
+ *
+ * @param desc Message descriptor.
+ *
+ * @param package Package.
+ *
+ * @param data Data.
+ */
+void z_log_msg2_static_str_create(const void *source,
+				  const struct log_msg2_desc desc,
+				  uint8_t *package, const void *data);
+
 /** @brief Create message at runtime.
  *
  * Function allows to build any log message based on input data. Processing
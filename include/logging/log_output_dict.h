@@ -23,6 +23,7 @@ extern "C" {
 enum log_dict_output_msg_type {
 	MSG_NORMAL = 0,
 	MSG_DROPPED_MSG = 1,
+	MSG_FMT_ID = 2,
 };
 
 /**
@@ -38,6 +39,25 @@ struct log_dict_output_normal_msg_hdr_t {
 	log_timestamp_t timestamp;
 } __packed;
 
+/**
+ * Output header for one dictionary based log message whose format string
+ * is identified by its offset in the log strings section. It is followed
+ * by the arguments after the format string and the strings appended to the
+ * package, which together are package_len bytes long, and the data.
+ */
+struct log_dict_output_fmt_id_msg_hdr_t {
+	uint8_t type;
+	uint32_t domain:3;
+	uint32_t level:3;
+	uint32_t package_len:10;
+	uint32_t data_len:12;
+	uint16_t source;
+	uint32_t fmt_id;
+	log_timestamp_t timestamp;
+	uint8_t args_wlen;
+	uint8_t str_cnt;
+} __packed;
+
 /**
  * Output for one dictionary based log message about
  * dropped messages.
@@ -31,6 +31,15 @@ struct dummy_api {
 
 	/** Send a network packet */
 	int (*send)(const struct device *dev, struct net_pkt *pkt);
+
+#if defined(CONFIG_NET_BURST)
+	/** Send several network packets. Optional, used instead of send()
+	 * for TX bursts if set. Returns the number of packets sent, which
+	 * are the first ones in the array.
+	 */
+	int (*send_burst)(const struct device *dev, struct net_pkt **pkts,
+			  size_t count);
+#endif
 };
 
 /* Make sure that the network interface API is properly setup inside
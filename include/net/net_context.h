@@ -965,6 +965,36 @@ int net_context_sendto(struct net_context *context,
 		       k_timeout_t timeout,
 		       void *user_data);
 
+/**
+ * @brief Send a buffer chain to a peer without copying it.
+ *
+ * @details This works like net_context_sendto() but the payload is
+ * not copied: the network packet is built around the given buffer
+ * chain, which is then owned by the network stack if this function
+ * succeeds. If it fails, the buffer still belongs to the caller. The
+ * buffer must not be modified after a successful call, and must fit
+ * in the MTU unless IPv6 fragmentation is enabled.
+ * Only UDP contexts are supported.
+ *
+ * @param context The network context to use.
+ * @param buf The buffer chain holding the data to send
+ * @param dst_addr Destination address, or NULL to use the address set
+ *        by net_context_connect().
+ * @param addrlen Length of the address.
+ * @param cb Caller-supplied callback function.
+ * @param timeout Currently this value is not used.
+ * @param user_data Caller-supplied user data.
+ *
+ * @return numbers of bytes sent on success, a negative errno otherwise
+ */
+int net_context_sendto_buf(struct net_context *context,
+			   struct net_buf *buf,
+			   const struct sockaddr *dst_addr,
+			   socklen_t addrlen,
+			   net_context_send_cb_t cb,
+			   k_timeout_t timeout,
+			   void *user_data);
+
 /**
  * @brief Send data in iovec to a peer specified in msghdr struct.
  *
@@ -117,6 +117,23 @@ enum net_verdict {
  */
 int net_recv_data(struct net_if *iface, struct net_pkt *pkt);
 
+/**
+ * @brief Called by network device driver when several network packets
+ * have been received. Same as net_recv_data() but the packets are queued
+ * to the RX traffic class queues in runs, with one queue operation and
+ * thread wakeup for each run of packets with the same traffic class.
+ *
+ * @param iface Network interface where the packets were received.
+ * @param pkts Array of received network packets.
+ * @param count Number of packets in the array.
+ *
+ * @return Number of packets taken by the stack (the first ones in the
+ * array), the caller still owns the rest. <0 if error, in which case none
+ * of the packets were taken.
+ */
+int net_recv_data_burst(struct net_if *iface, struct net_pkt **pkts,
+			size_t count);
+
 /**
  * @brief Send data to network.
  *
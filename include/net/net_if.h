@@ -452,6 +452,24 @@ struct net_if_dev {
 	/** The hardware MTU */
 	uint16_t mtu;
 
+#if defined(CONFIG_NET_BURST)
+	/** Packets held back for a batched driver send */
+	struct {
+		/** Thread sending the burst */
+		atomic_ptr_t owner;
+
+		/** L2 function sending the held back packets */
+		void (*flush)(struct net_if *iface, struct net_pkt **pkts,
+			      size_t count);
+
+		/** Held back packets */
+		struct net_pkt *pkts[CONFIG_NET_BURST_SIZE];
+
+		/** Number of held back packets */
+		uint8_t count;
+	} tx_burst;
+#endif /* CONFIG_NET_BURST */
+
 #if defined(CONFIG_NET_SOCKETS_OFFLOAD)
 	/** Indicate whether interface is offloaded at socket level. */
 	bool offloaded;
@@ -616,6 +634,52 @@ static inline const struct device *net_if_get_device(struct net_if *iface)
  */
 void net_if_queue_tx(struct net_if *iface, struct net_pkt *pkt);
 
+/**
+ * @brief Queue several packets to the net interface TX queue
+ *
+ * @details Same as calling net_if_queue_tx() for each packet, but
+ * consecutive packets with the same traffic class are queued with one
+ * queue operation and thread wakeup.
+ *
+ * @param iface Pointer to a network interface structure
+ * @param pkts Array of net packets to queue
+ * @param count Number of packets in the array
+ */
+void net_if_queue_tx_burst(struct net_if *iface, struct net_pkt **pkts,
+			   size_t count);
+
+#if defined(CONFIG_NET_BURST)
+/** @cond INTERNAL_HIDDEN */
+/**
+ * @brief Send packets held back by net_if_tx_burst_add() to the driver
+ *
+ * @param iface Network interface of the first packet
+ * @param pkts Held back packets
+ * @param count Number of packets
+ */
+typedef void (*net_if_tx_burst_flush_t)(struct net_if *iface,
+					struct net_pkt **pkts, size_t count);
+
+/**
+ * @brief Hold back a packet in the L2 send path of a TX burst
+ *
+ * @details Called by an L2 instead of handing the packet to the driver.
+ * If the calling thread is sending a burst to the device of @p iface,
+ * the packet is kept and @p flush is called with all the packets kept
+ * when the burst ends. The caller must then not touch the packet any
+ * more, and should report it as sent.
+ *
+ * @param iface Network interface
+ * @param pkt Network packet with the L2 header filled in
+ * @param flush L2 function that sends the held back packets
+ *
+ * @return True if the packet was kept, false if the L2 must send it now.
+ */
+bool net_if_tx_burst_add(struct net_if *iface, struct net_pkt *pkt,
+			 net_if_tx_burst_flush_t flush);
+/** @endcond */
+#endif /* CONFIG_NET_BURST */
+
 /**
  * @brief Return the IP offload status
  *
@@ -192,6 +192,12 @@ struct net_pkt {
 				 * defined(CONFIG_NET_ETHERNET_BRIDGE).
 				 */
 
+#if defined(CONFIG_NET_UDP_CHECKSUM_ON_COPY)
+	uint8_t payload_chksum_valid : 1; /* payload_chksum holds the sum of
+					   * the payload.
+					   */
+#endif
+
 	union {
 		/* IPv6 hop limit or IPv4 ttl for this network packet.
 		 * The value is shared between IPv6 and IPv4.
@@ -214,6 +220,13 @@ struct net_pkt {
 	 */
 	uint8_t priority;
 
+#if defined(CONFIG_NET_UDP_CHECKSUM_ON_COPY)
+	/* One's complement sum of the payload, computed when it was
+	 * written, see net_pkt_write_chksum().
+	 */
+	uint16_t payload_chksum;
+#endif
+
 #if defined(CONFIG_NET_VLAN)
 	/* VLAN TCI (Tag Control Information). This contains the Priority
 	 * Code Point (PCP), Drop Eligible Indicator (DEI) and VLAN
@@ -1212,6 +1225,45 @@ static inline bool net_pkt_is_being_overwritten(struct net_pkt *pkt)
 	return pkt->overwrite;
 }
 
+#if defined(CONFIG_NET_UDP_CHECKSUM_ON_COPY)
+static inline bool net_pkt_payload_chksum(struct net_pkt *pkt, uint16_t *sum)
+{
+	*sum = pkt->payload_chksum;
+
+	return pkt->payload_chksum_valid;
+}
+
+static inline void net_pkt_set_payload_chksum(struct net_pkt *pkt, uint16_t sum)
+{
+	pkt->payload_chksum = sum;
+	pkt->payload_chksum_valid = 1U;
+}
+
+static inline void net_pkt_clear_payload_chksum(struct net_pkt *pkt)
+{
+	pkt->payload_chksum_valid = 0U;
+}
+#else
+static inline bool net_pkt_payload_chksum(struct net_pkt *pkt, uint16_t *sum)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(sum);
+
+	return false;
+}
+
+static inline void net_pkt_set_payload_chksum(struct net_pkt *pkt, uint16_t sum)
+{
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(sum);
+}
+
+static inline void net_pkt_clear_payload_chksum(struct net_pkt *pkt)
+{
+	ARG_UNUSED(pkt);
+}
+#endif /* CONFIG_NET_UDP_CHECKSUM_ON_COPY */
+
 /* @endcond */
 
 /**
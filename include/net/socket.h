@@ -63,6 +63,8 @@ struct zsock_pollfd {
 #define ZSOCK_MSG_DONTWAIT 0x40
 /** zsock_recv: block until the full amount of data can be returned */
 #define ZSOCK_MSG_WAITALL 0x100
+/** zsock_recvmmsg: only block for the first message */
+#define ZSOCK_MSG_WAITFORONE 0x10000
 
 /* Well-known values, e.g. from Linux man 2 shutdown:
  * "The constants SHUT_RD, SHUT_WR, SHUT_RDWR have the value 0, 1, 2,
@@ -370,6 +372,26 @@ static inline ssize_t zsock_send(int sock, const void *buf, size_t len,
 __syscall ssize_t zsock_sendmsg(int sock, const struct msghdr *msg,
 				int flags);
 
+/**
+ * @brief Send multiple messages on a socket
+ *
+ * @details
+ * @rst
+ * Works like calling zsock_sendmsg() for each of the @p vlen messages
+ * in @p msgvec, but with a single system call and socket lookup. See
+ * `Linux man page <https://man7.org/linux/man-pages/man2/sendmmsg.2.html>`__
+ * for a description.
+ * This function is also exposed as ``sendmmsg()``
+ * if :kconfig:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return Number of messages sent, with the ``msg_len`` field of each
+ *         updated to the number of bytes sent, or -1 with errno set if
+ *         the first message could not be sent.
+ */
+__syscall int zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags);
+
 /**
  * @brief Receive data from an arbitrary network address
  *
@@ -386,6 +408,32 @@ __syscall ssize_t zsock_recvfrom(int sock, void *buf, size_t max_len,
 				 int flags, struct sockaddr *src_addr,
 				 socklen_t *addrlen);
 
+/**
+ * @brief Receive multiple datagrams from a socket
+ *
+ * @details
+ * @rst
+ * Receives up to @p vlen datagrams into the scatter/gather buffers of
+ * the messages in @p msgvec with a single system call. See
+ * `Linux man page <https://man7.org/linux/man-pages/man2/recvmmsg.2.html>`__
+ * for a description. Each datagram is waited for as by
+ * zsock_recvfrom(); with ZSOCK_MSG_WAITFORONE only the first one is.
+ * Unlike on Linux, @p timeout is a ``zsock_timeval`` and bounds the
+ * total time spent waiting; a negative field fails with EINVAL.
+ * Ancillary data is not returned.
+ * Only datagram sockets are supported.
+ * This function is also exposed as ``recvmmsg()``
+ * if :kconfig:`CONFIG_NET_SOCKETS_POSIX_NAMES` is defined.
+ * @endrst
+ *
+ * @return Number of datagrams received, with the ``msg_len`` field of
+ *         each set to its length, or -1 with errno set if no datagram
+ *         could be received.
+ */
+__syscall int zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			     unsigned int vlen, int flags,
+			     struct zsock_timeval *timeout);
+
 /**
  * @brief Receive data from a connected peer
  *
@@ -404,6 +452,77 @@ static inline ssize_t zsock_recv(int sock, void *buf, size_t max_len,
 	return zsock_recvfrom(sock, buf, max_len, flags, NULL, NULL);
 }
 
+struct net_buf;
+
+/**
+ * @brief Send a buffer chain to an arbitrary network address without
+ *        copying it
+ *
+ * @details
+ * Works like zsock_sendto(), but the network packet is built around
+ * the given buffer chain instead of copying the data. On success the
+ * network stack takes over the caller's reference to @p buf, which
+ * must not be modified afterwards; on error it still belongs to the
+ * caller. Only UDP sockets are supported, other sockets fail with
+ * EOPNOTSUPP. Not available to user mode threads.
+ *
+ * @param sock Socket descriptor
+ * @param buf Buffer chain holding the datagram
+ * @param flags Send flags, as for zsock_sendto()
+ * @param dest_addr Destination address, or NULL for a connected socket
+ * @param addrlen Length of the destination address
+ *
+ * @return Number of bytes sent, or -1 with errno set on error.
+ */
+ssize_t zsock_sendto_buf(int sock, struct net_buf *buf, int flags,
+			 const struct sockaddr *dest_addr, socklen_t addrlen);
+
+/**
+ * @brief Send a buffer chain to a connected peer without copying it
+ *
+ * @details
+ * See zsock_sendto_buf().
+ */
+static inline ssize_t zsock_send_buf(int sock, struct net_buf *buf, int flags)
+{
+	return zsock_sendto_buf(sock, buf, flags, NULL, 0);
+}
+
+/**
+ * @brief Receive a datagram without copying it
+ *
+ * @details
+ * Works like zsock_recvfrom(), but instead of copying the data, the
+ * buffer chain holding it is handed over to the caller, who must
+ * release it with net_buf_unref(). The chain comes from the network
+ * RX buffer pool, so it should not be held for long. ZSOCK_MSG_PEEK is
+ * not supported. Only datagram sockets are supported, other sockets
+ * fail with EOPNOTSUPP. Not available to user mode threads.
+ *
+ * @param sock Socket descriptor
+ * @param buf Set to the buffer chain holding the datagram, or to NULL
+ *        for an empty datagram
+ * @param flags Receive flags, as for zsock_recvfrom()
+ * @param src_addr Set to the source address if not NULL
+ * @param addrlen Length of src_addr, updated to the actual length
+ *
+ * @return Length of the datagram, or -1 with errno set on error.
+ */
+ssize_t zsock_recvfrom_buf(int sock, struct net_buf **buf, int flags,
+			   struct sockaddr *src_addr, socklen_t *addrlen);
+
+/**
+ * @brief Receive a datagram from a connected peer without copying it
+ *
+ * @details
+ * See zsock_recvfrom_buf().
+ */
+static inline ssize_t zsock_recv_buf(int sock, struct net_buf **buf,
+				     int flags)
+{
+	return zsock_recvfrom_buf(sock, buf, flags, NULL, NULL);
+}
+
 /**
  * @brief Control blocking/non-blocking mode of a socket
  *
@@ -718,12 +837,25 @@ static inline ssize_t sendmsg(int sock, const struct msghdr *message,
 	return zsock_sendmsg(sock, message, flags);
 }
 
+static inline int sendmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags)
+{
+	return zsock_sendmmsg(sock, msgvec, vlen, flags);
+}
+
 static inline ssize_t recvfrom(int sock, void *buf, size_t max_len, int flags,
 			       struct sockaddr *src_addr, socklen_t *addrlen)
 {
 	return zsock_recvfrom(sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+static inline int recvmmsg(int sock, struct mmsghdr *msgvec,
+			   unsigned int vlen, int flags,
+			   struct zsock_timeval *timeout)
+{
+	return zsock_recvmmsg(sock, msgvec, vlen, flags, timeout);
+}
+
 static inline int poll(struct zsock_pollfd *fds, int nfds, int timeout)
 {
 	return zsock_poll(fds, nfds, timeout);
@@ -800,6 +932,7 @@ static inline char *inet_ntop(sa_family_t family, const void *src, char *dst,
 #define MSG_TRUNC ZSOCK_MSG_TRUNC
 #define MSG_DONTWAIT ZSOCK_MSG_DONTWAIT
 #define MSG_WAITALL ZSOCK_MSG_WAITALL
+#define MSG_WAITFORONE ZSOCK_MSG_WAITFORONE
 
 #define SHUT_RD ZSOCK_SHUT_RD
 #define SHUT_WR ZSOCK_SHUT_WR
@@ -836,6 +836,30 @@ void arch_gdb_step(void);
 #endif
 /** @} */
 
+/**
+ * @defgroup arch-sampling-profiler Architecture-specific sampling profiler APIs
+ * @ingroup arch-interface
+ * @{
+ */
+
+#ifdef CONFIG_SAMPLING_PROFILER
+/**
+ * @brief Get the call chain of the interrupted context
+ *
+ * Called by the sampling profiler from the system timer interrupt. The
+ * first address is the program counter of the context which was running
+ * when the interrupt was taken. The following ones, if any, are return
+ * addresses of its callers, innermost first.
+ *
+ * @param addrs Array where the addresses are stored
+ * @param max_depth Maximum number of addresses to store
+ * @return Number of addresses stored, 0 if the interrupted context cannot
+ *         be sampled (e.g. it is another interrupt)
+ */
+int arch_sampling_profiler_backtrace(uintptr_t *addrs, int max_depth);
+#endif /* CONFIG_SAMPLING_PROFILER */
+/** @} */
+
 /**
  * @defgroup arch_cache Architecture-specific cache functions
  * @ingroup arch-interface
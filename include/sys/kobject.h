@@ -123,6 +123,8 @@ struct z_object_assignment {
 #define K_OBJ_FLAG_ALLOC	BIT(2)
 /** Driver Object */
 #define K_OBJ_FLAG_DRIVER	BIT(3)
+/** Object created at runtime, see z_dynamic_object_aligned_create() */
+#define K_OBJ_FLAG_DYNAMIC	BIT(4)
 
 /**
  * Lookup a kernel object and init its metadata if it exists
@@ -11,8 +11,8 @@
  * sys_mutex behaves almost exactly like k_mutex, with the added advantage
  * that a sys_mutex instance can reside in user memory.
  *
- * Further enhancements will support locking/unlocking uncontended sys_mutexes
- * with simple atomic ops instead of syscalls, similar to Linux's
+ * With CONFIG_SYS_MUTEX_FAST, uncontended sys_mutexes are locked and
+ * unlocked with simple atomic ops instead of syscalls, similar to Linux's
  * FUTEX_LOCK_PI and FUTEX_UNLOCK_PI
  */
 
@@ -25,12 +25,23 @@ extern "C" {
 #include <zephyr/types.h>
 #include <sys_clock.h>
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+#include <kernel.h>
+#include <errno.h>
+
+/* Set in the mutex value while threads wait for it in the kernel */
+#define Z_SYS_MUTEX_WAITERS BIT(0)
+#endif
+
 struct sys_mutex {
-	/* Currently unused, but will be used to store state for fast mutexes
-	 * that can be locked/unlocked with atomic ops if there is no
-	 * contention
+	/* With CONFIG_SYS_MUTEX_FAST, the owner thread ID, possibly with
+	 * Z_SYS_MUTEX_WAITERS set, or 0 when unlocked. Otherwise unused.
 	 */
 	atomic_t val;
+#ifdef CONFIG_SYS_MUTEX_FAST
+	/* Lock count, only accessed by the owner */
+	uint32_t count;
+#endif
 };
 
 /**
@@ -69,10 +80,15 @@ struct sys_mutex {
  */
 static inline void sys_mutex_init(struct sys_mutex *mutex)
 {
+#ifdef CONFIG_SYS_MUTEX_FAST
+	atomic_clear(&mutex->val);
+	mutex->count = 0U;
+#else
 	ARG_UNUSED(mutex);
+#endif
 
-	/* Nothing to do, kernel-side data structures are initialized at
-	 * boot
+	/* Nothing else to do, kernel-side data structures are initialized
+	 * at boot
 	 */
 }
 
@@ -100,10 +116,33 @@ __syscall int z_sys_mutex_kernel_unlock(struct sys_mutex *mutex);
  * @retval -EAGAIN Waiting period timed out.
  * @retval -EACCES Caller has no access to provided mutex address
  * @retval -EINVAL Provided mutex not recognized by the kernel
+ *
+ * With CONFIG_SYS_MUTEX_FAST, user mode threads access the mutex memory
+ * directly, so using a mutex outside of their memory domain faults instead
+ * of returning -EACCES, and the mutex is only checked to be known to the
+ * kernel when it is contended.
  */
 static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FAST
+	/* Supervisor threads always use the kernel side, which also checks
+	 * that the mutex is valid
+	 */
+	if (k_is_user_context()) {
+		atomic_val_t self = (atomic_val_t)k_current_get();
+		atomic_val_t val = atomic_get(&mutex->val);
+
+		if ((val & ~Z_SYS_MUTEX_WAITERS) == self) {
+			mutex->count++;
+			return 0;
+		}
+
+		if (val == 0 && atomic_cas(&mutex->val, 0, self)) {
+			mutex->count = 1U;
+			return 0;
+		}
+	}
+#endif
 	return z_sys_mutex_kernel_lock(mutex, timeout);
 }
 
@@ -126,7 +165,27 @@ static inline int sys_mutex_lock(struct sys_mutex *mutex, k_timeout_t timeout)
  */
 static inline int sys_mutex_unlock(struct sys_mutex *mutex)
 {
-	/* For now, make the syscall unconditionally */
+#ifdef CONFIG_SYS_MUTEX_FAST
+	if (k_is_user_context()) {
+		atomic_val_t self = (atomic_val_t)k_current_get();
+		atomic_val_t val = atomic_get(&mutex->val);
+
+		if ((val & ~Z_SYS_MUTEX_WAITERS) == self) {
+			if (mutex->count > 1U) {
+				mutex->count--;
+				return 0;
+			}
+
+			/* Must be done while the mutex is still held */
+			mutex->count = 0U;
+
+			/* Waiters are handed the mutex by the kernel */
+			if (val == self && atomic_cas(&mutex->val, self, 0)) {
+				return 0;
+			}
+		}
+	}
+#endif
 	return z_sys_mutex_kernel_unlock(mutex);
 }
 
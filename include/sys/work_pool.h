@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#ifndef ZEPHYR_INCLUDE_SYS_WORK_POOL_H_
+#define ZEPHYR_INCLUDE_SYS_WORK_POOL_H_
+
+#include <kernel.h>
+
+/* Zephyr Work-Stealing Thread Pool */
+
+struct k_work_pool_task;
+
+/**
+ * Work pool task handler callback
+ */
+typedef void (*k_work_pool_handler_t)(struct k_work_pool_task *task);
+
+/**
+ * Work pool range callback, see k_work_pool_parallel_for()
+ */
+typedef void (*k_work_pool_range_fn_t)(void *arg, size_t begin, size_t end);
+
+/**
+ * @brief Work Pool Task
+ *
+ * User-populated struct representing a single task.  Tasks are
+ * usually embedded in a larger struct holding their arguments, which
+ * the handler can get with CONTAINER_OF().
+ */
+struct k_work_pool_task {
+	/* Filled out by submitting code */
+	k_work_pool_handler_t handler;
+
+	/* reserved for implementation */
+	sys_snode_t node;
+	atomic_t state;
+	struct k_sem done_sem;
+};
+
+/**
+ * @brief Work pool worker
+ *
+ * One worker thread with its own task deque.  The owning worker
+ * pushes and pops tasks at the bottom of the deque, other workers
+ * steal the oldest ones from the top.
+ */
+struct k_work_pool_worker {
+	atomic_t top;
+	atomic_t bottom;
+	atomic_ptr_t tasks[CONFIG_WORK_POOL_DEQUE_SIZE];
+
+	struct k_thread thread;
+	struct k_work_pool *pool;
+	uint32_t rand;
+};
+
+/**
+ * @brief Work Pool
+ *
+ * Pool of worker threads executing independent tasks, each worker
+ * queueing the tasks it spawns itself and stealing from the others
+ * when it runs out of them.
+ */
+struct k_work_pool {
+	struct k_spinlock lock;
+
+	/* Tasks submitted from outside of the pool */
+	sys_slist_t injected;
+
+	/* Idle workers wait here for new tasks */
+	struct k_sem wake;
+	atomic_t idle;
+
+	struct k_work_pool_worker *workers;
+	uint32_t num_workers;
+};
+
+struct k_work_pool_initparam {
+	uint32_t num;
+	uintptr_t stack_size;
+	int prio;
+	struct k_work_pool *pool;
+	struct k_work_pool_worker *workers;
+	struct z_thread_stack_element *stacks;
+};
+
+/**
+ * @brief Statically initialize a Work Pool
+ *
+ * Statically defines a struct k_work_pool object with the specified
+ * number of worker threads which will be initialized at boot and
+ * ready for use on entry to main().  On SMP systems, worker N is
+ * pinned to CPU N when CONFIG_SCHED_CPU_MASK is enabled, so a pool
+ * of CONFIG_MP_NUM_CPUS workers has one task deque per CPU.
+ *
+ * @param name Symbol name of the struct k_work_pool that will be defined
+ * @param n_workers Number of worker threads in the pool
+ * @param stack_sz Requested stack size of each worker thread, in bytes
+ * @param thread_prio Priority of the worker threads
+ */
+#define K_WORK_POOL_DEFINE(name, n_workers, stack_sz, thread_prio)	\
+	static K_THREAD_STACK_ARRAY_DEFINE(_wpstacks_##name,		\
+					   n_workers, stack_sz);	\
+	static struct k_work_pool_worker _wpworkers_##name[n_workers];	\
+	static struct k_work_pool name;					\
+	static const STRUCT_SECTION_ITERABLE(k_work_pool_initparam,	\
+					     _init_##name) = {		\
+		.num = n_workers,					\
+		.stack_size = stack_sz,					\
+		.prio = thread_prio,					\
+		.pool = &name,						\
+		.workers = _wpworkers_##name,				\
+		.stacks = &(_wpstacks_##name[0][0]),			\
+	}
+
+/**
+ * @brief Initialize a Work Pool
+ *
+ * Initializes a work pool and starts its worker threads.  These
+ * objects must be initialized via this function (or statically using
+ * K_WORK_POOL_DEFINE) before any other API calls are made on them.
+ *
+ * @param pool Work pool to initialize
+ * @param workers Array of @a num uninitialized worker objects
+ * @param stacks Array of @a num thread stacks
+ * @param num Number of worker threads
+ * @param stack_size Size of each thread stack, as passed to
+ *                   K_THREAD_STACK_ARRAY_DEFINE()
+ * @param prio Priority of the worker threads
+ */
+void k_work_pool_init(struct k_work_pool *pool,
+		      struct k_work_pool_worker *workers,
+		      k_thread_stack_t *stacks, uint32_t num,
+		      size_t stack_size, int prio);
+
+/**
+ * @brief Submit a task to a work pool
+ *
+ * Submits the specified task to the pool.  The caller must have set
+ * the handler of the task.  When called from a worker thread of the
+ * pool, the task is pushed on that worker's own deque, where it is
+ * picked up again by the same worker unless an idle worker steals it
+ * first.  Otherwise it is queued for any worker to take.
+ *
+ * The caller must not mutate the struct until k_work_pool_join()
+ * returned for it.
+ *
+ * @param pool Work pool to which to submit
+ * @param task Task to be submitted
+ */
+void k_work_pool_submit(struct k_work_pool *pool,
+			struct k_work_pool_task *task);
+
+/**
+ * @brief Wait for a submitted task to complete
+ *
+ * Waits until the handler of @a task has returned.  Worker threads of
+ * the pool don't block here, but run other tasks of the pool until the
+ * task is done, so that they can join the tasks they spawned.  Other
+ * threads sleep until the task is done.
+ *
+ * @param pool Work pool the task was submitted to
+ * @param task Submitted task
+ */
+void k_work_pool_join(struct k_work_pool *pool,
+		      struct k_work_pool_task *task);
+
+/**
+ * @brief Run a function over a range in parallel
+ *
+ * Calls @a fn on disjoint subranges covering [@a begin, @a end), in
+ * parallel on the workers of @a pool, and returns when all calls have
+ * returned.  The range is split in halves recursively, spawning a task
+ * for one half and processing the other, until subranges are no larger
+ * than @a grain, so idle workers steal the largest remaining pieces of
+ * work.
+ *
+ * May be called from any thread, including from a task of the same
+ * pool for nested parallelism.
+ *
+ * @param pool Work pool on which to run
+ * @param begin Start of the range
+ * @param end End of the range, exclusive
+ * @param grain Largest subrange passed to @a fn, at least 1
+ * @param fn Function called on each subrange
+ * @param arg Argument passed to @a fn
+ */
+void k_work_pool_parallel_for(struct k_work_pool *pool, size_t begin,
+			      size_t end, size_t grain,
+			      k_work_pool_range_fn_t fn, void *arg);
+
+#endif /* ZEPHYR_INCLUDE_SYS_WORK_POOL_H_ */
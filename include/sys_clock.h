@@ -189,6 +189,34 @@ int64_t sys_clock_tick_get(void);
 
 uint64_t sys_clock_timeout_end_calc(k_timeout_t timeout);
 
+#ifdef CONFIG_TIMEOUT_SLACK
+/**
+ * @brief Timeout coalescing statistics
+ *
+ * Counts of timeouts added with a nonzero slack, see
+ * @kconfig{CONFIG_TIMEOUT_SLACK}.
+ */
+struct sys_clock_slack_stats {
+	/** Timeouts whose expiry was moved onto an already pending one */
+	uint32_t coalesced;
+	/** Timeouts added as the earliest pending one, so that the timer
+	 *  driver had to be reprogrammed
+	 */
+	uint32_t reprograms;
+	/** Timeouts that would have been the earliest pending one but for
+	 *  their slack, so that no reprogramming was needed
+	 */
+	uint32_t reprograms_saved;
+};
+
+/**
+ * @brief Get the timeout coalescing statistics
+ *
+ * @param stats Filled with the counts since boot
+ */
+void sys_clock_slack_stats_get(struct sys_clock_slack_stats *stats);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -109,6 +109,9 @@ typedef void (*_wordlist_cb_func_t)(struct z_object *ko, void *context);
 /**
  * Iterate over all the kernel object metadata in the system
  *
+ * Dynamically allocated objects are visited with the object list locked,
+ * so @a func must not grant or revoke permissions on them, nor free them.
+ *
  * @param func function to run on each struct z_object
  * @param context Context pointer to pass to each invocation
  */
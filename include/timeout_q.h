@@ -25,12 +25,24 @@ extern "C" {
 static inline void z_init_timeout(struct _timeout *to)
 {
 	sys_dnode_init(&to->node);
+#ifdef CONFIG_TIMEOUT_SLACK
+	to->slack = 0U;
+	to->slack_delay = 0U;
+#endif
 }
 
 void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 		   k_timeout_t timeout);
 
-int z_abort_timeout(struct _timeout *to);
+/* Aborts count timeouts under a single acquisition of the timeout
+ * lock, returns how many of them were pending.
+ */
+int z_abort_timeouts(struct _timeout *const *to, size_t count);
+
+static inline int z_abort_timeout(struct _timeout *to)
+{
+	return z_abort_timeouts(&to, 1) == 1 ? 0 : -EINVAL;
+}
 
 static inline bool z_is_inactive_timeout(const struct _timeout *to)
 {
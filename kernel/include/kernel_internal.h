@@ -143,6 +143,13 @@ extern void smp_timer_init(void);
 
 extern void z_early_boot_rand_get(uint8_t *buf, size_t length);
 
+#ifdef CONFIG_POLL
+/* Called by k_poll() after registering on an MPMC queue, returns true if
+ * an item was added before the registration became visible to producers.
+ */
+extern bool z_mpmcq_poll_recheck(struct k_mpmcq *q);
+#endif
+
 #if CONFIG_STACK_POINTER_RANDOM
 extern int z_stack_adjust_initialized;
 #endif
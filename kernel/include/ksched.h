@@ -108,7 +108,8 @@ static inline bool z_is_thread_prevented_from_running(struct k_thread *thread)
 	uint8_t state = thread->base.thread_state;
 
 	return (state & (_THREAD_PENDING | _THREAD_PRESTART | _THREAD_DEAD |
-			 _THREAD_DUMMY | _THREAD_SUSPENDED)) != 0U;
+			 _THREAD_DUMMY | _THREAD_SUSPENDED |
+			 _THREAD_THROTTLED)) != 0U;
 
 }
 
@@ -387,6 +388,18 @@ void z_sched_usage_start(struct k_thread *thread);
 
 uint64_t z_sched_thread_usage(struct k_thread *thread);
 
+/* Scheduler statistics hooks, called like the usage ones above with
+ * _current switched out and the new thread switched in.
+ */
+void z_sched_stats_switch_out(struct k_thread *thread);
+
+void z_sched_stats_switch_in(struct k_thread *thread);
+
+/* CPU budget reservation hooks, called the same way */
+void z_sched_resv_switch_out(struct k_thread *thread);
+
+void z_sched_resv_switch_in(struct k_thread *thread);
+
 static inline void z_sched_usage_switch(struct k_thread *thread)
 {
 	ARG_UNUSED(thread);
@@ -394,6 +407,18 @@ static inline void z_sched_usage_switch(struct k_thread *thread)
 	z_sched_usage_stop();
 	z_sched_usage_start(thread);
 #endif
+#if defined(CONFIG_SCHED_THREAD_STATS) && defined(CONFIG_USE_SWITCH)
+	if (thread != _current) {
+		z_sched_stats_switch_out(_current);
+		z_sched_stats_switch_in(thread);
+	}
+#endif
+#if defined(CONFIG_SCHED_DEADLINE_RESERVATION) && defined(CONFIG_USE_SWITCH)
+	if (thread != _current) {
+		z_sched_resv_switch_out(_current);
+		z_sched_resv_switch_in(thread);
+	}
+#endif
 }
 
 #endif /* ZEPHYR_KERNEL_INCLUDE_KSCHED_H_ */
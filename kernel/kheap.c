@@ -9,15 +9,46 @@
 #include <wait_q.h>
 #include <init.h>
 #include <linker/linker-defs.h>
+#include <string.h>
 
-void k_heap_init(struct k_heap *h, void *mem, size_t bytes)
+static void heap_init(struct k_heap *h, void *mem, size_t bytes,
+		      uint32_t flags)
 {
 	z_waitq_init(&h->wait_q);
 	sys_heap_init(&h->heap, mem, bytes);
 
+#ifdef CONFIG_HEAP_MAGAZINES
+	h->flags = flags;
+	atomic_set(&h->mag_waiters, 0);
+	(void)memset(h->magazines, 0, sizeof(h->magazines));
+#else
+	ARG_UNUSED(flags);
+#endif
+
 	SYS_PORT_TRACING_OBJ_INIT(k_heap, h);
 }
 
+void k_heap_init(struct k_heap *h, void *mem, size_t bytes)
+{
+	heap_init(h, mem, bytes, 0);
+}
+
+void k_heap_init_flags(struct k_heap *h, void *mem, size_t bytes,
+		       uint32_t flags)
+{
+	heap_init(h, mem, bytes, flags);
+}
+
+static uint32_t heap_flags(struct k_heap *h)
+{
+#ifdef CONFIG_HEAP_MAGAZINES
+	return h->flags;
+#else
+	ARG_UNUSED(h);
+	return 0;
+#endif
+}
+
 static int statics_init(const struct device *unused)
 {
 	ARG_UNUSED(unused);
@@ -46,7 +77,8 @@ static int statics_init(const struct device *unused)
 		if (do_clear)
 #endif /* CONFIG_DEMAND_PAGING && !CONFIG_LINKER_GENERIC_SECTIONS_PRESENT_AT_BOOT */
 		{
-			k_heap_init(h, h->heap.init_mem, h->heap.init_bytes);
+			heap_init(h, h->heap.init_mem, h->heap.init_bytes,
+				  heap_flags(h));
 		}
 	}
 	return 0;
@@ -61,11 +93,217 @@ SYS_INIT(statics_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
 SYS_INIT(statics_init, POST_KERNEL, 0);
 #endif /* CONFIG_DEMAND_PAGING && !CONFIG_LINKER_GENERIC_SECTIONS_PRESENT_AT_BOOT */
 
+#ifdef CONFIG_HEAP_MAGAZINES
+/* Size classes are powers of two from MAG_MIN_SIZE bytes up.  Blocks
+ * in a magazine were allocated (by this layer or by a caller) with a
+ * usable size of at least their class size, so any request up to
+ * that size can be served from it.
+ */
+#define MAG_MIN_SHIFT 4
+#define MAG_MIN_SIZE BIT(MAG_MIN_SHIFT)
+#define MAG_MAX_SIZE (MAG_MIN_SIZE << (CONFIG_HEAP_MAGAZINE_CLASSES - 1))
+#define MAG_BATCH (CONFIG_HEAP_MAGAZINE_DEPTH / 2)
+
+/* Smallest class that can hold @bytes, or -1 */
+static int mag_alloc_class(size_t bytes)
+{
+	if (bytes == 0U || bytes > MAG_MAX_SIZE) {
+		return -1;
+	}
+
+	return bytes <= MAG_MIN_SIZE ? 0
+		: (32 - __builtin_clz((uint32_t)bytes - 1U)) - MAG_MIN_SHIFT;
+}
+
+/* Largest class a block of @usable bytes can serve, or -1 for
+ * blocks too small or big enough to be worth returning to the heap
+ */
+static int mag_free_class(size_t usable)
+{
+	if (usable < MAG_MIN_SIZE || usable >= 2 * MAG_MAX_SIZE) {
+		return -1;
+	}
+
+	return (31 - __builtin_clz((uint32_t)usable)) - MAG_MIN_SHIFT;
+}
+
+static inline struct k_heap_magazine *local_magazine(struct k_heap *h)
+{
+	/* Only a locality hint: every magazine has its own lock, so
+	 * it doesn't matter if we migrate right after reading this.
+	 */
+#ifdef CONFIG_SMP
+	return &h->magazines[arch_curr_cpu()->id];
+#else
+	return &h->magazines[0];
+#endif
+}
+
+/* Called with m->lock held, takes the heap lock inside it */
+static void mag_refill(struct k_heap *h, struct k_heap_magazine *m, int cls)
+{
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+
+	while (m->count[cls] < MAG_BATCH) {
+		void *mem = sys_heap_alloc(&h->heap, MAG_MIN_SIZE << cls);
+
+		if (mem == NULL) {
+			break;
+		}
+		m->blocks[cls][m->count[cls]++] = mem;
+	}
+
+	k_spin_unlock(&h->lock, key);
+	m->refills++;
+}
+
+/* Called with m->lock held, takes the heap lock inside it */
+static void mag_drain(struct k_heap *h, struct k_heap_magazine *m, int cls,
+		      int keep)
+{
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+
+	while (m->count[cls] > keep) {
+		sys_heap_free(&h->heap, m->blocks[cls][--m->count[cls]]);
+	}
+
+	k_spin_unlock(&h->lock, key);
+	m->flushes++;
+}
+
+static void *mag_alloc(struct k_heap *h, size_t align, size_t bytes)
+{
+	int cls = mag_alloc_class(bytes);
+	void *ret = NULL;
+
+	/* Magazine blocks come from sys_heap_alloc(), so only requests
+	 * it would satisfy itself (no rewind, pointer alignment) qualify
+	 */
+	if (cls < 0 || (align & (align - 1)) != 0U || align > sizeof(void *)) {
+		return NULL;
+	}
+
+	struct k_heap_magazine *m = local_magazine(h);
+	k_spinlock_key_t key = k_spin_lock(&m->lock);
+
+	if (m->count[cls] != 0U) {
+		m->hits++;
+	} else {
+		m->misses++;
+		mag_refill(h, m, cls);
+	}
+
+	if (m->count[cls] != 0U) {
+		ret = m->blocks[cls][--m->count[cls]];
+	}
+
+	k_spin_unlock(&m->lock, key);
+	return ret;
+}
+
+static bool mag_free(struct k_heap *h, void *mem)
+{
+	/* The size field of an allocated chunk is only ever written
+	 * by its owner, so this is safe without the heap lock.
+	 */
+	int cls = mag_free_class(sys_heap_usable_size(&h->heap, mem));
+
+	if (cls < 0) {
+		return false;
+	}
+
+	struct k_heap_magazine *m = local_magazine(h);
+	k_spinlock_key_t key = k_spin_lock(&m->lock);
+
+	if (m->count[cls] == CONFIG_HEAP_MAGAZINE_DEPTH) {
+		mag_drain(h, m, cls, MAG_BATCH);
+	}
+	m->blocks[cls][m->count[cls]++] = mem;
+
+	k_spin_unlock(&m->lock, key);
+
+	/* A thread may have started waiting for memory after draining
+	 * the magazines, hand everything back so it gets woken.  This
+	 * must be checked after the push, see k_heap_aligned_alloc().
+	 */
+	if (atomic_get(&h->mag_waiters) != 0) {
+		k_heap_magazine_flush(h);
+	}
+
+	return true;
+}
+
+void k_heap_magazine_flush(struct k_heap *h)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_heap_magazine *m = &h->magazines[i];
+		k_spinlock_key_t key = k_spin_lock(&m->lock);
+
+		for (int cls = 0; cls < CONFIG_HEAP_MAGAZINE_CLASSES; cls++) {
+			if (m->count[cls] != 0U) {
+				mag_drain(h, m, cls, 0);
+			}
+		}
+
+		k_spin_unlock(&m->lock, key);
+	}
+
+	k_spinlock_key_t key = k_spin_lock(&h->lock);
+
+	if (IS_ENABLED(CONFIG_MULTITHREADING) && z_unpend_all(&h->wait_q) != 0) {
+		z_reschedule(&h->lock, key);
+	} else {
+		k_spin_unlock(&h->lock, key);
+	}
+}
+
+int k_heap_magazine_stats_get(struct k_heap *h,
+			      struct k_heap_magazine_stats *stats)
+{
+	if ((h == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	(void)memset(stats, 0, sizeof(*stats));
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_heap_magazine *m = &h->magazines[i];
+		k_spinlock_key_t key = k_spin_lock(&m->lock);
+
+		stats->hits += m->hits;
+		stats->misses += m->misses;
+		stats->refills += m->refills;
+		stats->flushes += m->flushes;
+		for (int cls = 0; cls < CONFIG_HEAP_MAGAZINE_CLASSES; cls++) {
+			stats->cached_blocks += m->count[cls];
+		}
+
+		k_spin_unlock(&m->lock, key);
+	}
+
+	return 0;
+}
+#endif /* CONFIG_HEAP_MAGAZINES */
+
 void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 			k_timeout_t timeout)
 {
 	int64_t now, end = sys_clock_timeout_end_calc(timeout);
 	void *ret = NULL;
+
+#ifdef CONFIG_HEAP_MAGAZINES
+	bool use_mag = (h->flags & K_HEAP_MAGAZINES) != 0U;
+
+	if (use_mag) {
+		ret = mag_alloc(h, align, bytes);
+		if (ret != NULL) {
+			SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, h, timeout);
+			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
+			return ret;
+		}
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_heap, aligned_alloc, h, timeout);
@@ -77,6 +315,24 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 	while (ret == NULL) {
 		ret = sys_heap_aligned_alloc(&h->heap, align, bytes);
 
+#ifdef CONFIG_HEAP_MAGAZINES
+		if ((ret == NULL) && use_mag) {
+			/* Blocks cached in magazines might satisfy
+			 * this.  Announce ourselves as a waiter
+			 * first, so that any block freed into a
+			 * magazine from now on is flushed back to the
+			 * heap (and wakes us) rather than stranded.
+			 * Lock order is magazine, then heap.
+			 */
+			use_mag = false;
+			atomic_inc(&h->mag_waiters);
+			k_spin_unlock(&h->lock, key);
+			k_heap_magazine_flush(h);
+			key = k_spin_lock(&h->lock);
+			continue;
+		}
+#endif
+
 		now = sys_clock_tick_get();
 		if (!IS_ENABLED(CONFIG_MULTITHREADING) ||
 		    (ret != NULL) || ((end - now) <= 0)) {
@@ -101,6 +357,13 @@ void *k_heap_aligned_alloc(struct k_heap *h, size_t align, size_t bytes,
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_heap, aligned_alloc, h, timeout, ret);
 
 	k_spin_unlock(&h->lock, key);
+
+#ifdef CONFIG_HEAP_MAGAZINES
+	if (((h->flags & K_HEAP_MAGAZINES) != 0U) && !use_mag) {
+		atomic_dec(&h->mag_waiters);
+	}
+#endif
+
 	return ret;
 }
 
@@ -117,6 +380,14 @@ void *k_heap_alloc(struct k_heap *h, size_t bytes, k_timeout_t timeout)
 
 void k_heap_free(struct k_heap *h, void *mem)
 {
+#ifdef CONFIG_HEAP_MAGAZINES
+	if ((mem != NULL) && ((h->flags & K_HEAP_MAGAZINES) != 0U) &&
+	    mag_free(h, mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC(k_heap, free, h);
+		return;
+	}
+#endif
+
 	k_spinlock_key_t key = k_spin_lock(&h->lock);
 
 	sys_heap_free(&h->heap, mem);
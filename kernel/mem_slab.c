@@ -14,6 +14,7 @@
 #include <ksched.h>
 #include <init.h>
 #include <sys/check.h>
+#include <string.h>
 
 /**
  * @brief Initialize kernel memory slab subsystem.
@@ -80,11 +81,20 @@ int k_mem_slab_init(struct k_mem_slab *slab, void *buffer,
 	slab->num_blocks = num_blocks;
 	slab->block_size = block_size;
 	slab->buffer = buffer;
-	slab->num_used = 0U;
 	slab->lock = (struct k_spinlock) {};
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	atomic_set(&slab->num_used, 0);
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	atomic_set(&slab->max_used, 0);
+#endif
+	atomic_set(&slab->waiters, 0);
+	(void)memset(slab->cache, 0, sizeof(slab->cache));
+#else
+	slab->num_used = 0U;
 #ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
 	slab->max_used = 0U;
+#endif
 #endif
 
 	rc = create_free_list(slab);
@@ -100,23 +110,277 @@ out:
 	return rc;
 }
 
-int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+static void used_add(struct k_mem_slab *slab, uint32_t count)
+{
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	atomic_val_t used = atomic_add(&slab->num_used, count) + count;
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	atomic_val_t max;
+
+	do {
+		max = atomic_get(&slab->max_used);
+	} while ((used > max) && !atomic_cas(&slab->max_used, max, used));
+#else
+	ARG_UNUSED(used);
+#endif
+#else
+	slab->num_used += count;
+
+#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
+	slab->max_used = MAX(slab->num_used, slab->max_used);
+#endif
+#endif
+}
+
+static void used_sub(struct k_mem_slab *slab, uint32_t count)
+{
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	(void)atomic_sub(&slab->num_used, count);
+#else
+	slab->num_used -= count;
+#endif
+}
+
+/* Called with the slab lock held.  Takes @count blocks off the free
+ * list if it has that many, or none.
+ */
+static bool take_locked(struct k_mem_slab *slab, void **mem, uint32_t count)
+{
+	char *block = slab->free_list;
+	uint32_t i;
+
+	for (i = 0U; i < count; i++) {
+		if (block == NULL) {
+			return false;
+		}
+		block = *(char **)block;
+	}
+
+	for (i = 0U; i < count; i++) {
+		mem[i] = slab->free_list;
+		slab->free_list = *(char **)(slab->free_list);
+	}
+
+	return true;
+}
+
+/* Called with the slab lock held.  Hands @block over to the first
+ * thread waiting for one, or puts it on the free list.  Returns true
+ * if a thread was readied.  Accounting is left to the caller.
+ */
+static bool put_locked(struct k_mem_slab *slab, char *block)
+{
+	if (slab->free_list == NULL && IS_ENABLED(CONFIG_MULTITHREADING)) {
+		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
+
+		if (pending_thread != NULL) {
+			z_thread_return_value_set_with_data(pending_thread, 0,
+							    block);
+			z_ready_thread(pending_thread);
+			return true;
+		}
+	}
+
+	*(char **)block = slab->free_list;
+	slab->free_list = block;
+
+	return false;
+}
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+#define CACHE_BATCH (CONFIG_MEM_SLAB_CPU_CACHE_DEPTH / 2)
+
+static inline struct k_mem_slab_cpu_cache *local_cache(struct k_mem_slab *slab)
+{
+	/* Only a locality hint: every cache has its own lock, so it
+	 * doesn't matter if we migrate right after reading this.
+	 */
+#ifdef CONFIG_SMP
+	return &slab->cache[arch_curr_cpu()->id];
+#else
+	return &slab->cache[0];
+#endif
+}
+
+static inline char *cache_pop(struct k_mem_slab_cpu_cache *c)
+{
+	char *block = c->free_list;
+
+	c->free_list = *(char **)block;
+	c->count--;
+
+	return block;
+}
+
+static inline void cache_push(struct k_mem_slab_cpu_cache *c, char *block)
+{
+	*(char **)block = c->free_list;
+	c->free_list = block;
+	c->count++;
+}
+
+/* Called with c->lock held, takes the slab lock inside it */
+static void cache_refill(struct k_mem_slab *slab,
+			 struct k_mem_slab_cpu_cache *c)
 {
 	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+
+	while ((c->count < CACHE_BATCH) && (slab->free_list != NULL)) {
+		char *block = slab->free_list;
+
+		slab->free_list = *(char **)block;
+		cache_push(c, block);
+	}
+
+	k_spin_unlock(&slab->lock, key);
+}
+
+/* Called with c->lock held, takes the slab lock inside it.  Returns
+ * true if a waiting thread was readied.
+ */
+static bool cache_drain(struct k_mem_slab *slab,
+			struct k_mem_slab_cpu_cache *c, uint32_t keep)
+{
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	bool woken = false;
+
+	while (c->count > keep) {
+		if (put_locked(slab, cache_pop(c))) {
+			/* Went straight back into use */
+			used_add(slab, 1U);
+			woken = true;
+		}
+	}
+
+	k_spin_unlock(&slab->lock, key);
+
+	return woken;
+}
+
+static bool cache_flush(struct k_mem_slab *slab)
+{
+	bool woken = false;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		struct k_mem_slab_cpu_cache *c = &slab->cache[i];
+		k_spinlock_key_t key = k_spin_lock(&c->lock);
+
+		if (c->count != 0U) {
+			woken = cache_drain(slab, c, 0U) || woken;
+		}
+
+		k_spin_unlock(&c->lock, key);
+	}
+
+	return woken;
+}
+
+void k_mem_slab_cache_flush(struct k_mem_slab *slab)
+{
+	if (cache_flush(slab) && IS_ENABLED(CONFIG_MULTITHREADING)) {
+		z_reschedule_unlocked();
+	}
+}
+
+static bool cache_alloc(struct k_mem_slab *slab, void **mem, uint32_t count)
+{
+	struct k_mem_slab_cpu_cache *c = local_cache(slab);
+	k_spinlock_key_t key = k_spin_lock(&c->lock);
+	bool ok = true;
+	uint32_t i = 0U;
+
+	if (c->count == 0U) {
+		cache_refill(slab, c);
+	}
+
+	if (c->count < count) {
+		/* Take the rest from the slab, then the cache can't fail */
+		k_spinlock_key_t skey = k_spin_lock(&slab->lock);
+
+		ok = take_locked(slab, mem, count - c->count);
+		k_spin_unlock(&slab->lock, skey);
+		i = count - c->count;
+	}
+
+	if (ok) {
+		for (; i < count; i++) {
+			mem[i] = cache_pop(c);
+		}
+		used_add(slab, count);
+	}
+
+	k_spin_unlock(&c->lock, key);
+
+	return ok;
+}
+
+static void cache_free(struct k_mem_slab *slab, void **mem, uint32_t count)
+{
+	struct k_mem_slab_cpu_cache *c = local_cache(slab);
+	k_spinlock_key_t key;
+	bool woken = false;
+
+	/* Before the blocks can be handed to a waiter, which counts
+	 * them as used again, so the maximum is never overstated
+	 */
+	used_sub(slab, count);
+
+	key = k_spin_lock(&c->lock);
+
+	for (uint32_t i = 0U; i < count; i++) {
+		cache_push(c, mem[i]);
+	}
+
+	if (c->count > CONFIG_MEM_SLAB_CPU_CACHE_DEPTH) {
+		woken = cache_drain(slab, c, CACHE_BATCH);
+	}
+
+	k_spin_unlock(&c->lock, key);
+
+	/* A thread may have started waiting for a block after flushing
+	 * the caches, hand everything back so it gets woken.  This must
+	 * be checked after the push, see k_mem_slab_alloc().
+	 */
+	if (atomic_get(&slab->waiters) != 0) {
+		woken = cache_flush(slab) || woken;
+	}
+
+	if (woken && IS_ENABLED(CONFIG_MULTITHREADING)) {
+		z_reschedule_unlocked();
+	}
+}
+#endif /* CONFIG_MEM_SLAB_CPU_CACHE */
+
+int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
+{
+	k_spinlock_key_t key;
 	int result;
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, alloc, slab, timeout);
 
-	if (slab->free_list != NULL) {
-		/* take a free block */
-		*mem = slab->free_list;
-		slab->free_list = *(char **)(slab->free_list);
-		slab->num_used++;
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (cache_alloc(slab, mem, 1U)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, 0);
 
-#ifdef CONFIG_MEM_SLAB_TRACE_MAX_UTILIZATION
-		slab->max_used = MAX(slab->num_used, slab->max_used);
+		return 0;
+	}
+
+	/* Blocks cached by other CPUs might satisfy this.  Announce
+	 * ourselves as a waiter first, so that any block freed into a
+	 * cache from now on is flushed back to the slab (and handed to
+	 * us) rather than stranded.  Lock order is cache, then slab.
+	 */
+	atomic_inc(&slab->waiters);
+	if (cache_flush(slab) && IS_ENABLED(CONFIG_MULTITHREADING)) {
+		z_reschedule_unlocked();
+	}
 #endif
 
+	key = k_spin_lock(&slab->lock);
+
+	if (take_locked(slab, mem, 1U)) {
+		used_add(slab, 1U);
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) ||
 		   !IS_ENABLED(CONFIG_MULTITHREADING)) {
@@ -134,6 +398,10 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, alloc, slab, timeout, result);
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+		atomic_dec(&slab->waiters);
+#endif
+
 		return result;
 	}
 
@@ -141,31 +409,86 @@ int k_mem_slab_alloc(struct k_mem_slab *slab, void **mem, k_timeout_t timeout)
 
 	k_spin_unlock(&slab->lock, key);
 
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	atomic_dec(&slab->waiters);
+#endif
+
 	return result;
 }
 
 void k_mem_slab_free(struct k_mem_slab *slab, void **mem)
 {
-	k_spinlock_key_t key = k_spin_lock(&slab->lock);
-
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_mem_slab, free, slab);
-	if (slab->free_list == NULL && IS_ENABLED(CONFIG_MULTITHREADING)) {
-		struct k_thread *pending_thread = z_unpend_first_thread(&slab->wait_q);
 
-		if (pending_thread != NULL) {
-			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	cache_free(slab, mem, 1U);
 
-			z_thread_return_value_set_with_data(pending_thread, 0, *mem);
-			z_ready_thread(pending_thread);
-			z_reschedule(&slab->lock, key);
-			return;
-		}
+	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+#else
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+
+	if (put_locked(slab, *mem)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
+
+		z_reschedule(&slab->lock, key);
+		return;
 	}
-	**(char ***) mem = slab->free_list;
-	slab->free_list = *(char **) mem;
-	slab->num_used--;
+	used_sub(slab, 1U);
 
 	SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mem_slab, free, slab);
 
 	k_spin_unlock(&slab->lock, key);
+#endif
+}
+
+int k_mem_slab_alloc_n(struct k_mem_slab *slab, void **mem, uint32_t count)
+{
+	k_spinlock_key_t key;
+	bool ok;
+
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	if (cache_alloc(slab, mem, count)) {
+		return 0;
+	}
+
+	/* Only fail once the blocks cached by other CPUs are back */
+	if (cache_flush(slab) && IS_ENABLED(CONFIG_MULTITHREADING)) {
+		z_reschedule_unlocked();
+	}
+#endif
+
+	key = k_spin_lock(&slab->lock);
+
+	ok = take_locked(slab, mem, count);
+	if (ok) {
+		used_add(slab, count);
+	}
+
+	k_spin_unlock(&slab->lock, key);
+
+	return ok ? 0 : -ENOMEM;
+}
+
+void k_mem_slab_free_n(struct k_mem_slab *slab, void **mem, uint32_t count)
+{
+#ifdef CONFIG_MEM_SLAB_CPU_CACHE
+	cache_free(slab, mem, count);
+#else
+	k_spinlock_key_t key = k_spin_lock(&slab->lock);
+	bool woken = false;
+
+	for (uint32_t i = 0U; i < count; i++) {
+		if (put_locked(slab, mem[i])) {
+			woken = true;
+		} else {
+			used_sub(slab, 1U);
+		}
+	}
+
+	if (woken) {
+		z_reschedule(&slab->lock, key);
+	} else {
+		k_spin_unlock(&slab->lock, key);
+	}
+#endif
 }
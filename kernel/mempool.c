@@ -58,7 +58,9 @@ void k_free(void *ptr)
 
 #if (CONFIG_HEAP_MEM_POOL_SIZE > 0)
 
-K_HEAP_DEFINE(_system_heap, CONFIG_HEAP_MEM_POOL_SIZE);
+K_HEAP_DEFINE_FLAGS(_system_heap, CONFIG_HEAP_MEM_POOL_SIZE,
+		    COND_CODE_1(CONFIG_HEAP_MEM_POOL_MAGAZINES,
+				(K_HEAP_MAGAZINES), (0)));
 #define _SYSTEM_HEAP (&_system_heap)
 
 void *k_aligned_alloc(size_t align, size_t size)
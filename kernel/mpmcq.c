@@ -0,0 +1,294 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/**
+ * @file
+ * @brief Bounded multi-producer multi-consumer queues.
+ *
+ * Items are stored in a ring of slots, each tagged with a sequence
+ * number (D. Vyukov's bounded MPMC queue).  A producer claims the slot at
+ * the enqueue position with a compare-and-swap on the position, stores
+ * the item and then publishes it by advancing the slot's sequence number;
+ * consumers do the same on the dequeue position.  Neither side takes a
+ * lock, so puts and gets on different CPUs or from ISRs never spin on
+ * each other.
+ *
+ * The queue lock is only taken by threads that have to wait, and by puts
+ * and gets that find such a thread or a k_poll() registration to wake up.
+ */
+
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <kernel_internal.h>
+#include <ksched.h>
+#include <wait_q.h>
+#include <sys/dlist.h>
+#include <sys/__assert.h>
+
+/* Positions and sequence numbers are free running and compared through
+ * their signed difference, so they may wrap.  Slot sequence numbers are
+ * kept relative to the slot index, so that a zeroed slot array is an
+ * empty queue and K_MPMCQ_DEFINE() needs no runtime initialization.
+ */
+static inline long seq_diff(atomic_val_t a, atomic_val_t b)
+{
+	return (long)((unsigned long)a - (unsigned long)b);
+}
+
+static inline atomic_val_t seq_add(atomic_val_t a, unsigned long n)
+{
+	return (atomic_val_t)((unsigned long)a + n);
+}
+
+static inline atomic_val_t slot_seq(struct k_mpmcq *q, atomic_val_t pos)
+{
+	uint32_t idx = (unsigned long)pos & q->mask;
+
+	return seq_add(atomic_get(&q->slots[idx].seq), idx);
+}
+
+static inline void slot_seq_set(struct k_mpmcq *q, atomic_val_t pos,
+				atomic_val_t seq)
+{
+	uint32_t idx = (unsigned long)pos & q->mask;
+
+	/* A full barrier: the item is visible before the slot is, and the
+	 * slot is visible before the caller looks for waiters.
+	 */
+	(void)atomic_set(&q->slots[idx].seq, seq_add(seq, -(unsigned long)idx));
+}
+
+static bool try_put(struct k_mpmcq *q, void *data)
+{
+	atomic_val_t pos = atomic_get(&q->head);
+	long diff;
+
+	while (true) {
+		diff = seq_diff(slot_seq(q, pos), pos);
+		if (diff == 0) {
+			if (atomic_cas(&q->head, pos, seq_add(pos, 1))) {
+				break;
+			}
+			pos = atomic_get(&q->head);
+		} else if (diff < 0) {
+			/* The slot still holds the item from one lap ago */
+			return false;
+		} else {
+			pos = atomic_get(&q->head);
+		}
+	}
+
+	q->slots[(unsigned long)pos & q->mask].data = data;
+	slot_seq_set(q, pos, seq_add(pos, 1));
+
+	return true;
+}
+
+static void *try_get(struct k_mpmcq *q)
+{
+	atomic_val_t pos = atomic_get(&q->tail);
+	long diff;
+	void *data;
+
+	while (true) {
+		diff = seq_diff(slot_seq(q, pos), seq_add(pos, 1));
+		if (diff == 0) {
+			if (atomic_cas(&q->tail, pos, seq_add(pos, 1))) {
+				break;
+			}
+			pos = atomic_get(&q->tail);
+		} else if (diff < 0) {
+			/* Nothing published at the dequeue position yet */
+			return NULL;
+		} else {
+			pos = atomic_get(&q->tail);
+		}
+	}
+
+	data = q->slots[(unsigned long)pos & q->mask].data;
+	slot_seq_set(q, pos, seq_add(pos, q->mask + 1UL));
+
+	return data;
+}
+
+/* Wake up the first waiter of one side of the queue after an item or a
+ * slot was made available.  Waiters announce themselves in the waiter
+ * count before their last attempt, so either they see the update or we
+ * see them here.
+ */
+static void wake_waiter(struct k_mpmcq *q, atomic_t *waiters,
+			_wait_q_t *wait_q, bool data_available)
+{
+	bool pollers = false;
+	struct k_thread *thread;
+	k_spinlock_key_t key;
+
+#ifdef CONFIG_POLL
+	pollers = data_available && !sys_dlist_is_empty(&q->poll_events);
+#else
+	ARG_UNUSED(data_available);
+#endif
+
+	if ((atomic_get(waiters) == 0) && !pollers) {
+		return;
+	}
+
+	key = k_spin_lock(&q->lock);
+
+	thread = z_unpend_first_thread(wait_q);
+	if (thread != NULL) {
+		arch_thread_return_value_set(thread, 0);
+		z_ready_thread(thread);
+	}
+
+#ifdef CONFIG_POLL
+	if (pollers) {
+		z_handle_obj_poll_events(&q->poll_events,
+					 K_POLL_STATE_MPMCQ_DATA_AVAILABLE);
+	}
+#endif
+
+	z_reschedule(&q->lock, key);
+}
+
+static bool try_op(struct k_mpmcq *q, bool put, void **data)
+{
+	if (put) {
+		return try_put(q, *data);
+	}
+
+	*data = try_get(q);
+
+	return *data != NULL;
+}
+
+static int wait_op(struct k_mpmcq *q, bool put, void **data,
+		   k_timeout_t timeout)
+{
+	atomic_t *waiters = put ? &q->put_waiters : &q->get_waiters;
+	_wait_q_t *wait_q = put ? &q->put_wait_q : &q->get_wait_q;
+	uint64_t end = sys_clock_timeout_end_calc(timeout);
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	key = k_spin_lock(&q->lock);
+	atomic_inc(waiters);
+
+	while (!try_op(q, put, data)) {
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+			int64_t remaining = end - sys_clock_tick_get();
+
+			if (remaining <= 0) {
+				ret = -EAGAIN;
+				break;
+			}
+
+			timeout = Z_TIMEOUT_TICKS(remaining);
+		}
+
+		(void)z_pend_curr(&q->lock, key, wait_q, timeout);
+		key = k_spin_lock(&q->lock);
+	}
+
+	atomic_dec(waiters);
+	k_spin_unlock(&q->lock, key);
+
+	return ret;
+}
+
+void k_mpmcq_init(struct k_mpmcq *q, struct k_mpmcq_slot *slots,
+		  uint32_t max_items)
+{
+	__ASSERT((max_items != 0U) && ((max_items & (max_items - 1U)) == 0U),
+		 "MPMC queue size must be a power of 2");
+
+	for (uint32_t i = 0; i < max_items; i++) {
+		atomic_clear(&slots[i].seq);
+		slots[i].data = NULL;
+	}
+
+	q->slots = slots;
+	q->mask = max_items - 1U;
+	q->lock = (struct k_spinlock) {};
+	z_waitq_init(&q->get_wait_q);
+	z_waitq_init(&q->put_wait_q);
+	atomic_clear(&q->get_waiters);
+	atomic_clear(&q->put_waiters);
+	atomic_clear(&q->head);
+	atomic_clear(&q->tail);
+#ifdef CONFIG_POLL
+	sys_dlist_init(&q->poll_events);
+#endif
+}
+
+int k_mpmcq_put(struct k_mpmcq *q, void *data, k_timeout_t timeout)
+{
+	__ASSERT(data != NULL, "NULL cannot be queued");
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	if (!try_put(q, data)) {
+		int ret;
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			return -ENOMSG;
+		}
+
+		ret = wait_op(q, true, &data, timeout);
+		if (ret != 0) {
+			return ret;
+		}
+	}
+
+	wake_waiter(q, &q->get_waiters, &q->get_wait_q, true);
+
+	return 0;
+}
+
+void *k_mpmcq_get(struct k_mpmcq *q, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	void *data = try_get(q);
+
+	if (data == NULL) {
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT) ||
+		    (wait_op(q, false, &data, timeout) != 0)) {
+			return NULL;
+		}
+	}
+
+	wake_waiter(q, &q->put_waiters, &q->put_wait_q, false);
+
+	return data;
+}
+
+bool k_mpmcq_is_empty(struct k_mpmcq *q)
+{
+	atomic_val_t pos = atomic_get(&q->tail);
+
+	return seq_diff(slot_seq(q, pos), seq_add(pos, 1)) < 0;
+}
+
+uint32_t k_mpmcq_num_used_get(struct k_mpmcq *q)
+{
+	atomic_val_t tail = atomic_get(&q->tail);
+	long used = seq_diff(atomic_get(&q->head), tail);
+
+	/* Both positions move while we read them */
+	return CLAMP(used, 0, (long)q->mask + 1);
+}
+
+#ifdef CONFIG_POLL
+bool z_mpmcq_poll_recheck(struct k_mpmcq *q)
+{
+	/* Full barrier, pairs with the one in slot_seq_set(): the caller's
+	 * registration is visible before we look at the queue.
+	 */
+	(void)atomic_or(&q->get_waiters, 0);
+
+	return !k_mpmcq_is_empty(q);
+}
+#endif
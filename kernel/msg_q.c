@@ -113,11 +113,111 @@ int k_msgq_cleanup(struct k_msgq *msgq)
 }
 
 
+/*
+ * Threads waiting for a claim have no message buffer.  Threads waiting in
+ * k_msgq_put() or k_msgq_get() are served first, and a claim is granted
+ * only to a claimer left waiting alone, so that the queue never has both
+ * an outstanding claim and threads waiting behind it.
+ */
+static struct k_thread *unpend_waiter(struct k_msgq *msgq)
+{
+	struct k_thread *thread;
+	struct k_thread *found = NULL;
+
+	_WAIT_Q_FOR_EACH(&msgq->wait_q, thread) {
+		if (thread->base.swap_data != NULL) {
+			found = thread;
+			break;
+		}
+	}
+
+	if (found == NULL) {
+		found = z_waitq_head(&msgq->wait_q);
+	}
+
+	if (found != NULL) {
+		z_unpend_thread(found);
+	}
+
+	return found;
+}
+
+/* Hand a new message to a waiting receiver, or queue it */
+static bool msgq_put_msg(struct k_msgq *msgq, const void *data)
+{
+	struct k_thread *pending_thread = unpend_waiter(msgq);
+
+	if (pending_thread != NULL && pending_thread->base.swap_data != NULL) {
+		/* give message to waiting thread */
+		(void)memcpy(pending_thread->base.swap_data, data,
+		       msgq->msg_size);
+	} else {
+		/* put message in queue, unless written there in place */
+		if (data != msgq->write_ptr) {
+			(void)memcpy(msgq->write_ptr, data, msgq->msg_size);
+		}
+		msgq->write_ptr += msgq->msg_size;
+		if (msgq->write_ptr == msgq->buffer_end) {
+			msgq->write_ptr = msgq->buffer_start;
+		}
+		msgq->used_msgs++;
+
+		if (pending_thread != NULL) {
+			/* the waiting claimer gets the queued message */
+			msgq->flags |= K_MSGQ_FLAG_GET_CLAIMED;
+		} else {
+#ifdef CONFIG_POLL
+			handle_poll_events(msgq,
+					   K_POLL_STATE_MSGQ_DATA_AVAILABLE);
+#endif /* CONFIG_POLL */
+		}
+	}
+
+	if (pending_thread == NULL) {
+		return false;
+	}
+
+	/* wake up waiting thread */
+	arch_thread_return_value_set(pending_thread, 0);
+	z_ready_thread(pending_thread);
+
+	return true;
+}
+
+/* Hand a freed slot to a waiting sender */
+static bool msgq_free_slot(struct k_msgq *msgq)
+{
+	struct k_thread *pending_thread = unpend_waiter(msgq);
+
+	if (pending_thread == NULL) {
+		return false;
+	}
+
+	if (pending_thread->base.swap_data != NULL) {
+		/* add thread's message to queue */
+		(void)memcpy(msgq->write_ptr, pending_thread->base.swap_data,
+		       msgq->msg_size);
+		msgq->write_ptr += msgq->msg_size;
+		if (msgq->write_ptr == msgq->buffer_end) {
+			msgq->write_ptr = msgq->buffer_start;
+		}
+		msgq->used_msgs++;
+	} else {
+		/* the waiting claimer gets the slot at the write pointer */
+		msgq->flags |= K_MSGQ_FLAG_PUT_CLAIMED;
+	}
+
+	/* wake up waiting thread */
+	arch_thread_return_value_set(pending_thread, 0);
+	z_ready_thread(pending_thread);
+
+	return true;
+}
+
 int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout)
 {
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
 
-	struct k_thread *pending_thread;
 	k_spinlock_key_t key;
 	int result;
 
@@ -125,31 +225,16 @@ int z_impl_k_msgq_put(struct k_msgq *msgq, const void *data, k_timeout_t timeout
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, put, msgq, timeout);
 
-	if (msgq->used_msgs < msgq->max_msgs) {
+	if ((msgq->flags & K_MSGQ_FLAG_PUT_CLAIMED) != 0U) {
+		/* the next slot is being written in place */
+		result = -EBUSY;
+	} else if (msgq->used_msgs < msgq->max_msgs) {
 		/* message queue isn't full */
-		pending_thread = z_unpend_first_thread(&msgq->wait_q);
-		if (pending_thread != NULL) {
+		if (msgq_put_msg(msgq, data)) {
 			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, put, msgq, timeout, 0);
 
-			/* give message to waiting thread */
-			(void)memcpy(pending_thread->base.swap_data, data,
-			       msgq->msg_size);
-			/* wake up waiting thread */
-			arch_thread_return_value_set(pending_thread, 0);
-			z_ready_thread(pending_thread);
 			z_reschedule(&msgq->lock, key);
 			return 0;
-		} else {
-			/* put message in queue */
-			(void)memcpy(msgq->write_ptr, data, msgq->msg_size);
-			msgq->write_ptr += msgq->msg_size;
-			if (msgq->write_ptr == msgq->buffer_end) {
-				msgq->write_ptr = msgq->buffer_start;
-			}
-			msgq->used_msgs++;
-#ifdef CONFIG_POLL
-			handle_poll_events(msgq, K_POLL_STATE_MSGQ_DATA_AVAILABLE);
-#endif /* CONFIG_POLL */
 		}
 		result = 0;
 	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
@@ -208,14 +293,16 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
 
 	k_spinlock_key_t key;
-	struct k_thread *pending_thread;
 	int result;
 
 	key = k_spin_lock(&msgq->lock);
 
 	SYS_PORT_TRACING_OBJ_FUNC_ENTER(k_msgq, get, msgq, timeout);
 
-	if (msgq->used_msgs > 0U) {
+	if ((msgq->flags & K_MSGQ_FLAG_GET_CLAIMED) != 0U) {
+		/* the first message is being read in place */
+		result = -EBUSY;
+	} else if (msgq->used_msgs > 0U) {
 		/* take first available message from queue */
 		(void)memcpy(data, msgq->read_ptr, msgq->msg_size);
 		msgq->read_ptr += msgq->msg_size;
@@ -225,22 +312,9 @@ int z_impl_k_msgq_get(struct k_msgq *msgq, void *data, k_timeout_t timeout)
 		msgq->used_msgs--;
 
 		/* handle first thread waiting to write (if any) */
-		pending_thread = z_unpend_first_thread(&msgq->wait_q);
-		if (pending_thread != NULL) {
+		if (msgq_free_slot(msgq)) {
 			SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_msgq, get, msgq, timeout);
 
-			/* add thread's message to queue */
-			(void)memcpy(msgq->write_ptr, pending_thread->base.swap_data,
-			       msgq->msg_size);
-			msgq->write_ptr += msgq->msg_size;
-			if (msgq->write_ptr == msgq->buffer_end) {
-				msgq->write_ptr = msgq->buffer_start;
-			}
-			msgq->used_msgs++;
-
-			/* wake up waiting thread */
-			arch_thread_return_value_set(pending_thread, 0);
-			z_ready_thread(pending_thread);
 			z_reschedule(&msgq->lock, key);
 
 			SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_msgq, get, msgq, timeout, 0);
@@ -281,6 +355,164 @@ static inline int z_vrfy_k_msgq_get(struct k_msgq *msgq, void *data,
 #include <syscalls/k_msgq_get_mrsh.c>
 #endif
 
+/*
+ * A claimer owns its end of the queue from the call until the commit, or
+ * until it gives up waiting.  Waiting claimers have no message buffer,
+ * see unpend_waiter().
+ */
+static int msgq_claim(struct k_msgq *msgq, k_spinlock_key_t key,
+		      uint8_t claim, uint8_t claimed, bool available,
+		      void **data, k_timeout_t timeout)
+{
+	int result;
+
+	if ((msgq->flags & claim) != 0U) {
+		result = -EBUSY;
+	} else if (available) {
+		msgq->flags |= claim | claimed;
+		result = 0;
+	} else if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		result = -ENOMSG;
+	} else {
+		msgq->flags |= claim;
+		_current->base.swap_data = NULL;
+
+		result = z_pend_curr(&msgq->lock, key, &msgq->wait_q, timeout);
+
+		key = k_spin_lock(&msgq->lock);
+		if (result != 0) {
+			msgq->flags &= ~claim;
+		}
+	}
+
+	if (result == 0) {
+		*data = (claim == K_MSGQ_FLAG_PUT_CLAIM) ?
+			msgq->write_ptr : msgq->read_ptr;
+	}
+
+	k_spin_unlock(&msgq->lock, key);
+
+	return result;
+}
+
+int z_impl_k_msgq_put_claim(struct k_msgq *msgq, void **data,
+			    k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+
+	return msgq_claim(msgq, key, K_MSGQ_FLAG_PUT_CLAIM,
+			  K_MSGQ_FLAG_PUT_CLAIMED,
+			  msgq->used_msgs < msgq->max_msgs, data, timeout);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_claim(struct k_msgq *msgq, void **data,
+					  k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(msgq->buffer_start,
+				      msgq->buffer_end - msgq->buffer_start));
+
+	return z_impl_k_msgq_put_claim(msgq, data, timeout);
+}
+#include <syscalls/k_msgq_put_claim_mrsh.c>
+#endif
+
+int z_impl_k_msgq_put_commit(struct k_msgq *msgq)
+{
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->flags & K_MSGQ_FLAG_PUT_CLAIMED) == 0U) {
+		k_spin_unlock(&msgq->lock, key);
+		return -EINVAL;
+	}
+
+	msgq->flags &= ~(K_MSGQ_FLAG_PUT_CLAIM | K_MSGQ_FLAG_PUT_CLAIMED);
+
+	if (msgq_put_msg(msgq, msgq->write_ptr)) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_put_commit(struct k_msgq *msgq)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+
+	return z_impl_k_msgq_put_commit(msgq);
+}
+#include <syscalls/k_msgq_put_commit_mrsh.c>
+#endif
+
+int z_impl_k_msgq_get_claim(struct k_msgq *msgq, void **data,
+			    k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+
+	return msgq_claim(msgq, key, K_MSGQ_FLAG_GET_CLAIM,
+			  K_MSGQ_FLAG_GET_CLAIMED, msgq->used_msgs > 0U,
+			  data, timeout);
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_claim(struct k_msgq *msgq, void **data,
+					  k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	Z_OOPS(Z_SYSCALL_MEMORY_READ(msgq->buffer_start,
+				     msgq->buffer_end - msgq->buffer_start));
+
+	return z_impl_k_msgq_get_claim(msgq, data, timeout);
+}
+#include <syscalls/k_msgq_get_claim_mrsh.c>
+#endif
+
+int z_impl_k_msgq_get_commit(struct k_msgq *msgq)
+{
+	k_spinlock_key_t key = k_spin_lock(&msgq->lock);
+
+	if ((msgq->flags & K_MSGQ_FLAG_GET_CLAIMED) == 0U) {
+		k_spin_unlock(&msgq->lock, key);
+		return -EINVAL;
+	}
+
+	msgq->flags &= ~(K_MSGQ_FLAG_GET_CLAIM | K_MSGQ_FLAG_GET_CLAIMED);
+
+	msgq->read_ptr += msgq->msg_size;
+	if (msgq->read_ptr == msgq->buffer_end) {
+		msgq->read_ptr = msgq->buffer_start;
+	}
+	msgq->used_msgs--;
+
+	if (msgq_free_slot(msgq)) {
+		z_reschedule(&msgq->lock, key);
+	} else {
+		k_spin_unlock(&msgq->lock, key);
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_msgq_get_commit(struct k_msgq *msgq)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(msgq, K_OBJ_MSGQ));
+
+	return z_impl_k_msgq_get_commit(msgq);
+}
+#include <syscalls/k_msgq_get_commit_mrsh.c>
+#endif
+
 int z_impl_k_msgq_peek(struct k_msgq *msgq, void *data)
 {
 	k_spinlock_key_t key;
@@ -330,8 +562,20 @@ void z_impl_k_msgq_purge(struct k_msgq *msgq)
 		z_ready_thread(pending_thread);
 	}
 
-	msgq->used_msgs = 0;
-	msgq->read_ptr = msgq->write_ptr;
+	if ((msgq->flags & K_MSGQ_FLAG_GET_CLAIMED) == 0U) {
+		msgq->used_msgs = 0;
+		msgq->read_ptr = msgq->write_ptr;
+	} else if ((msgq->flags & K_MSGQ_FLAG_PUT_CLAIMED) == 0U) {
+		/* keep the message being read in place */
+		msgq->used_msgs = 1;
+		msgq->write_ptr = msgq->read_ptr + msgq->msg_size;
+		if (msgq->write_ptr == msgq->buffer_end) {
+			msgq->write_ptr = msgq->buffer_start;
+		}
+	} else {
+		/* both ends are claimed, so no slot in between can be freed */
+		__ASSERT_NO_MSG(msgq->used_msgs > 0U);
+	}
 
 	z_reschedule(&msgq->lock, key);
 }
@@ -24,6 +24,11 @@
  * When releasing the mutex, thread A must release M2 before it releases M1.
  * Failure to follow this nested model may result in threads running at
  * unexpected priority levels (too high, or too low).
+ *
+ * With CONFIG_MUTEX_CEILING_PROTOCOL, a mutex may also have a priority
+ * ceiling, which its owner is raised to as soon as it locks it.  With
+ * CONFIG_MUTEX_ADAPTIVE_SPIN, a thread busy-waits for a mutex held by a
+ * thread running on another CPU for a short while before sleeping.
  */
 
 #include <kernel.h>
@@ -50,6 +55,9 @@ int z_impl_k_mutex_init(struct k_mutex *mutex)
 {
 	mutex->owner = NULL;
 	mutex->lock_count = 0U;
+#ifdef CONFIG_MUTEX_CEILING_PROTOCOL
+	mutex->ceiling = K_MUTEX_NO_CEILING;
+#endif
 
 	z_waitq_init(&mutex->wait_q);
 
@@ -92,6 +100,149 @@ static bool adjust_owner_prio(struct k_mutex *mutex, int32_t new_prio)
 	return false;
 }
 
+#ifdef CONFIG_MUTEX_CEILING_PROTOCOL
+/* The ceiling is checked against the priority of the thread before any
+ * mutex it holds boosted it, or a thread raised to the ceiling of one
+ * mutex could not lock a nested one with a lower ceiling.
+ */
+static inline bool above_ceiling(struct k_mutex *mutex,
+				 struct k_thread *thread)
+{
+	int32_t prio = (thread->base.mutexes_held != 0U) ?
+		       thread->base.mutex_base_prio : thread->base.prio;
+
+	return (mutex->ceiling != K_MUTEX_NO_CEILING) &&
+	       z_is_prio_higher(prio, mutex->ceiling);
+}
+
+/* Must be called before the new owner is raised to the ceiling */
+static inline void mutex_acquired(struct k_thread *thread)
+{
+	if (thread->base.mutexes_held++ == 0U) {
+		thread->base.mutex_base_prio = thread->base.prio;
+	}
+}
+
+static inline void mutex_released(struct k_thread *thread)
+{
+	thread->base.mutexes_held--;
+}
+
+/* Priority of the owner when no waiter boosts it */
+static int32_t owner_base_prio(struct k_mutex *mutex)
+{
+	if ((mutex->ceiling != K_MUTEX_NO_CEILING) &&
+	    z_is_prio_higher(mutex->ceiling, mutex->owner_orig_prio)) {
+		return mutex->ceiling;
+	}
+
+	return mutex->owner_orig_prio;
+}
+#else
+static inline bool above_ceiling(struct k_mutex *mutex,
+				 struct k_thread *thread)
+{
+	return false;
+}
+
+static inline void mutex_acquired(struct k_thread *thread)
+{
+}
+
+static inline void mutex_released(struct k_thread *thread)
+{
+}
+
+static inline int32_t owner_base_prio(struct k_mutex *mutex)
+{
+	return mutex->owner_orig_prio;
+}
+#endif
+
+/* Must be called with the lock held, the mutex not locked by another
+ * thread and the current thread within its priority ceiling
+ */
+static void mutex_take(struct k_mutex *mutex)
+{
+	mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
+				_current->base.prio :
+				mutex->owner_orig_prio;
+
+	mutex->lock_count++;
+	mutex->owner = _current;
+
+#ifdef CONFIG_MUTEX_CEILING_PROTOCOL
+	if (mutex->lock_count == 1U) {
+		mutex_acquired(_current);
+
+		/* Raising the running thread never calls for a reschedule */
+		(void)adjust_owner_prio(mutex, owner_base_prio(mutex));
+	}
+#endif
+
+	LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
+		_current, mutex, mutex->lock_count,
+		mutex->owner_orig_prio);
+}
+
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+/* The current thread never is the owner, so the owner is running on
+ * another CPU if it is running at all
+ */
+static bool owner_running(struct k_thread *owner)
+{
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (_kernel.cpus[i].current == owner) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/*
+ * Busy-wait for the mutex while its owner is running, for up to
+ * CONFIG_MUTEX_SPIN_BUDGET_NS.  Must be called with the lock held.
+ * Returns true with the mutex taken and the lock released, or false
+ * with the lock held again.
+ */
+static bool mutex_spin(struct k_mutex *mutex, k_spinlock_key_t *key)
+{
+	volatile struct k_mutex *vmutex = mutex;
+	uint32_t budget = k_ns_to_cyc_ceil32(CONFIG_MUTEX_SPIN_BUDGET_NS);
+	uint32_t start = k_cycle_get_32();
+	struct k_thread *owner = mutex->owner;
+
+	while (owner_running(owner)) {
+		k_spin_unlock(&lock, *key);
+
+		/* Don't hold the lock while spinning, the owner needs it
+		 * to unlock the mutex
+		 */
+		while ((vmutex->owner == owner) && owner_running(owner) &&
+		       ((k_cycle_get_32() - start) < budget)) {
+		}
+
+		*key = k_spin_lock(&lock);
+
+		if (mutex->lock_count == 0U) {
+			mutex_take(mutex);
+			k_spin_unlock(&lock, *key);
+			return true;
+		}
+
+		if ((k_cycle_get_32() - start) >= budget) {
+			break;
+		}
+
+		/* Handed over to a waiter, or stolen by another spinner */
+		owner = mutex->owner;
+	}
+
+	return false;
+}
+#endif
+
 int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 {
 	int new_prio;
@@ -104,18 +255,18 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 
 	key = k_spin_lock(&lock);
 
-	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
+	if (unlikely((mutex->owner != _current) &&
+		     above_ceiling(mutex, _current))) {
+		k_spin_unlock(&lock, key);
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, -EINVAL);
 
-		mutex->owner_orig_prio = (mutex->lock_count == 0U) ?
-					_current->base.prio :
-					mutex->owner_orig_prio;
+		return -EINVAL;
+	}
 
-		mutex->lock_count++;
-		mutex->owner = _current;
+	if (likely((mutex->lock_count == 0U) || (mutex->owner == _current))) {
 
-		LOG_DBG("%p took mutex %p, count: %d, orig prio: %d",
-			_current, mutex, mutex->lock_count,
-			mutex->owner_orig_prio);
+		mutex_take(mutex);
 
 		k_spin_unlock(&lock, key);
 
@@ -132,6 +283,14 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 		return -EBUSY;
 	}
 
+#ifdef CONFIG_MUTEX_ADAPTIVE_SPIN
+	if (mutex_spin(mutex, &key)) {
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_mutex, lock, mutex, timeout, 0);
+
+		return 0;
+	}
+#endif
+
 	SYS_PORT_TRACING_OBJ_FUNC_BLOCKING(k_mutex, lock, mutex, timeout);
 
 	new_prio = new_prio_for_inheritance(_current->base.prio,
@@ -164,8 +323,8 @@ int z_impl_k_mutex_lock(struct k_mutex *mutex, k_timeout_t timeout)
 	struct k_thread *waiter = z_waitq_head(&mutex->wait_q);
 
 	new_prio = (waiter != NULL) ?
-		new_prio_for_inheritance(waiter->base.prio, mutex->owner_orig_prio) :
-		mutex->owner_orig_prio;
+		new_prio_for_inheritance(waiter->base.prio, owner_base_prio(mutex)) :
+		owner_base_prio(mutex);
 
 	LOG_DBG("adjusting prio down on mutex %p", mutex);
 
@@ -238,6 +397,7 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 	k_spinlock_key_t key = k_spin_lock(&lock);
 
 	adjust_owner_prio(mutex, mutex->owner_orig_prio);
+	mutex_released(_current);
 
 	/* Get the new owner, if any */
 	new_owner = z_unpend_first_thread(&mutex->wait_q);
@@ -254,8 +414,13 @@ int z_impl_k_mutex_unlock(struct k_mutex *mutex)
 		 * ajust its priority
 		 */
 		mutex->owner_orig_prio = new_owner->base.prio;
+		mutex_acquired(new_owner);
 		arch_thread_return_value_set(new_owner, 0);
 		z_ready_thread(new_owner);
+#ifdef CONFIG_MUTEX_CEILING_PROTOCOL
+		/* Only once queued again, so that it is requeued */
+		(void)adjust_owner_prio(mutex, owner_base_prio(mutex));
+#endif
 		z_reschedule(&lock, key);
 	} else {
 		mutex->lock_count = 0U;
@@ -279,3 +444,40 @@ static inline int z_vrfy_k_mutex_unlock(struct k_mutex *mutex)
 }
 #include <syscalls/k_mutex_unlock_mrsh.c>
 #endif
+
+#ifdef CONFIG_MUTEX_CEILING_PROTOCOL
+int z_impl_k_mutex_ceiling_set(struct k_mutex *mutex, int prio)
+{
+	k_spinlock_key_t key;
+	int ret = 0;
+
+	if ((prio != K_MUTEX_NO_CEILING) && !_is_valid_prio(prio, NULL)) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&lock);
+
+	if (mutex->lock_count != 0U) {
+		ret = -EBUSY;
+	} else {
+		mutex->ceiling = prio;
+	}
+
+	k_spin_unlock(&lock, key);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_mutex_ceiling_set(struct k_mutex *mutex, int prio)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(mutex, K_OBJ_MUTEX));
+	Z_OOPS(Z_SYSCALL_VERIFY_MSG((prio == K_MUTEX_NO_CEILING) ||
+				    (prio >= _current->base.prio),
+				    "mutex ceiling may not be above caller priority (%d < %d)",
+				    prio, _current->base.prio));
+	return z_impl_k_mutex_ceiling_set(mutex, prio);
+}
+#include <syscalls/k_mutex_ceiling_set_mrsh.c>
+#endif
+#endif /* CONFIG_MUTEX_CEILING_PROTOCOL */
@@ -98,6 +98,8 @@ void k_pipe_init(struct k_pipe *pipe, unsigned char *buffer, size_t size)
 	SYS_PORT_TRACING_OBJ_INIT(k_pipe, pipe);
 
 	pipe->flags = 0;
+	pipe->put_claimed = 0;
+	pipe->get_claimed = 0;
 	z_object_init(pipe);
 }
 
@@ -420,6 +422,16 @@ int z_pipe_put_internal(struct k_pipe *pipe, struct k_pipe_async *async_desc,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	if (pipe->put_claimed != 0U) {
+		/* The write index is owned by the claimer */
+		k_spin_unlock(&pipe->lock, key);
+		*bytes_written = 0;
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, put, pipe, timeout, -EBUSY);
+
+		return -EBUSY;
+	}
+
 	/*
 	 * Create a list of "working readers" into which the data will be
 	 * directly copied.
@@ -563,6 +575,16 @@ int z_impl_k_pipe_get(struct k_pipe *pipe, void *data, size_t bytes_to_read,
 
 	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
 
+	if (pipe->get_claimed != 0U) {
+		/* The read index is owned by the claimer */
+		k_spin_unlock(&pipe->lock, key);
+		*bytes_read = 0;
+
+		SYS_PORT_TRACING_OBJ_FUNC_EXIT(k_pipe, get, pipe, timeout, -EBUSY);
+
+		return -EBUSY;
+	}
+
 	/*
 	 * Create a list of "working readers" into which the data will be
 	 * directly copied.
@@ -752,6 +774,276 @@ int z_vrfy_k_pipe_put(struct k_pipe *pipe, void *data, size_t bytes_to_write,
 #include <syscalls/k_pipe_put_mrsh.c>
 #endif
 
+/*
+ * Claims give direct access to the pipe's circular buffer.  A claimer
+ * owns its end of the pipe from the call until the commit, or until it
+ * gives up waiting.  While waiting it pends with an empty request, which
+ * the transfers above complete right away, and looks at the buffer again
+ * once woken up.  This keeps the rules of pipe_xfer_prepare(): when the
+ * buffer is full a claimer waits among the writers, when it is empty
+ * among the readers.
+ */
+static size_t pipe_put_contig(struct k_pipe *pipe)
+{
+	if (pipe->bytes_used == 0U) {
+		/* Start over to offer as much contiguous space as possible */
+		pipe->read_index = 0;
+		pipe->write_index = 0;
+	}
+
+	return MIN(pipe->size - pipe->bytes_used,
+		   pipe->size - pipe->write_index);
+}
+
+static size_t pipe_get_contig(struct k_pipe *pipe)
+{
+	return MIN(pipe->bytes_used, pipe->size - pipe->read_index);
+}
+
+static int pipe_claim_pend(struct k_pipe *pipe, k_spinlock_key_t *key,
+			   _wait_q_t *wait_q, k_timeout_t timeout,
+			   uint64_t end)
+{
+	struct k_pipe_desc pipe_desc = {
+		.buffer = NULL,
+		.bytes_to_xfer = 0,
+	};
+
+	if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		return -EIO;
+	}
+
+	if (!K_TIMEOUT_EQ(timeout, K_FOREVER)) {
+		int64_t remaining = end - sys_clock_tick_get();
+
+		if (remaining <= 0) {
+			return -EAGAIN;
+		}
+
+		timeout = Z_TIMEOUT_TICKS(remaining);
+	}
+
+	_current->base.swap_data = &pipe_desc;
+	(void)z_pend_curr(&pipe->lock, *key, wait_q, timeout);
+	*key = k_spin_lock(&pipe->lock);
+
+	return 0;
+}
+
+static int pipe_claim(struct k_pipe *pipe, bool put, void **data,
+		      size_t *size, k_timeout_t timeout)
+{
+	__ASSERT(!arch_is_in_isr() || K_TIMEOUT_EQ(timeout, K_NO_WAIT), "");
+
+	uint8_t flag = put ? K_PIPE_FLAG_PUT_CLAIM : K_PIPE_FLAG_GET_CLAIM;
+	_wait_q_t *wait_q = put ? &pipe->wait_q.writers : &pipe->wait_q.readers;
+	uint64_t end = sys_clock_timeout_end_calc(timeout);
+	k_spinlock_key_t key;
+	size_t avail;
+	int ret;
+
+	CHECKIF(pipe->buffer == NULL || pipe->size == 0U || *size == 0U) {
+		return -EINVAL;
+	}
+
+	key = k_spin_lock(&pipe->lock);
+
+	if ((pipe->flags & flag) != 0U) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EBUSY;
+	}
+
+	pipe->flags |= flag;
+
+	while (true) {
+		avail = put ? pipe_put_contig(pipe) : pipe_get_contig(pipe);
+		if (avail != 0U) {
+			break;
+		}
+
+		ret = pipe_claim_pend(pipe, &key, wait_q, timeout, end);
+		if (ret != 0) {
+			pipe->flags &= ~flag;
+			k_spin_unlock(&pipe->lock, key);
+			return ret;
+		}
+	}
+
+	avail = MIN(avail, *size);
+	if (put) {
+		pipe->put_claimed = avail;
+		*data = pipe->buffer + pipe->write_index;
+	} else {
+		pipe->get_claimed = avail;
+		*data = pipe->buffer + pipe->read_index;
+	}
+	*size = avail;
+
+	k_spin_unlock(&pipe->lock, key);
+
+	return 0;
+}
+
+int z_impl_k_pipe_put_claim(struct k_pipe *pipe, void **data, size_t *size,
+			    k_timeout_t timeout)
+{
+	return pipe_claim(pipe, true, data, size, timeout);
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_pipe_put_claim(struct k_pipe *pipe, void **data, size_t *size,
+			    k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(size, sizeof(*size)));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(pipe->buffer, pipe->size));
+
+	return z_impl_k_pipe_put_claim(pipe, data, size, timeout);
+}
+#include <syscalls/k_pipe_put_claim_mrsh.c>
+#endif
+
+int z_impl_k_pipe_put_commit(struct k_pipe *pipe, size_t size)
+{
+	struct k_thread *reader;
+	struct k_pipe_desc *desc;
+	size_t bytes_copied;
+	bool woken = false;
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if (pipe->put_claimed == 0U || size > pipe->put_claimed) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->put_claimed = 0;
+	pipe->flags &= ~K_PIPE_FLAG_PUT_CLAIM;
+
+	pipe->bytes_used += size;
+	pipe->write_index += size;
+	if (pipe->write_index == pipe->size) {
+		pipe->write_index = 0;
+	}
+
+	/* Waiting readers found the buffer empty, pass the data on */
+	while (pipe->bytes_used != 0U &&
+	       (reader = z_waitq_head(&pipe->wait_q.readers)) != NULL) {
+		desc = (struct k_pipe_desc *)reader->base.swap_data;
+		bytes_copied = pipe_buffer_get(pipe, desc->buffer,
+					       desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		if (desc->bytes_to_xfer != 0U) {
+			break;
+		}
+
+		z_unpend_thread(reader);
+		z_ready_thread(reader);
+		woken = true;
+	}
+
+	if (woken) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_pipe_put_commit(struct k_pipe *pipe, size_t size)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+
+	return z_impl_k_pipe_put_commit(pipe, size);
+}
+#include <syscalls/k_pipe_put_commit_mrsh.c>
+#endif
+
+int z_impl_k_pipe_get_claim(struct k_pipe *pipe, void **data, size_t *size,
+			    k_timeout_t timeout)
+{
+	return pipe_claim(pipe, false, data, size, timeout);
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_pipe_get_claim(struct k_pipe *pipe, void **data, size_t *size,
+			    k_timeout_t timeout)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(data, sizeof(*data)));
+	Z_OOPS(Z_SYSCALL_MEMORY_WRITE(size, sizeof(*size)));
+	Z_OOPS(Z_SYSCALL_MEMORY_READ(pipe->buffer, pipe->size));
+
+	return z_impl_k_pipe_get_claim(pipe, data, size, timeout);
+}
+#include <syscalls/k_pipe_get_claim_mrsh.c>
+#endif
+
+int z_impl_k_pipe_get_commit(struct k_pipe *pipe, size_t size)
+{
+	struct k_thread *writer;
+	struct k_pipe_desc *desc;
+	size_t bytes_copied;
+	bool woken = false;
+	k_spinlock_key_t key = k_spin_lock(&pipe->lock);
+
+	if (pipe->get_claimed == 0U || size > pipe->get_claimed) {
+		k_spin_unlock(&pipe->lock, key);
+		return -EINVAL;
+	}
+
+	pipe->get_claimed = 0;
+	pipe->flags &= ~K_PIPE_FLAG_GET_CLAIM;
+
+	pipe->bytes_used -= size;
+	pipe->read_index += size;
+	if (pipe->read_index == pipe->size) {
+		pipe->read_index = 0;
+	}
+
+	/* Waiting writers found the buffer full, take their data in */
+	while (pipe->bytes_used != pipe->size &&
+	       (writer = z_waitq_head(&pipe->wait_q.writers)) != NULL) {
+		desc = (struct k_pipe_desc *)writer->base.swap_data;
+		bytes_copied = pipe_buffer_put(pipe, desc->buffer,
+					       desc->bytes_to_xfer);
+
+		desc->buffer        += bytes_copied;
+		desc->bytes_to_xfer -= bytes_copied;
+
+		if (desc->bytes_to_xfer != 0U) {
+			break;
+		}
+
+		z_unpend_thread(writer);
+		pipe_thread_ready(writer);
+		woken = true;
+	}
+
+	if (woken) {
+		z_reschedule(&pipe->lock, key);
+	} else {
+		k_spin_unlock(&pipe->lock, key);
+	}
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+int z_vrfy_k_pipe_get_commit(struct k_pipe *pipe, size_t size)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(pipe, K_OBJ_PIPE));
+
+	return z_impl_k_pipe_get_commit(pipe, size);
+}
+#include <syscalls/k_pipe_get_commit_mrsh.c>
+#endif
+
 size_t z_impl_k_pipe_read_avail(struct k_pipe *pipe)
 {
 	size_t res;
@@ -86,6 +86,12 @@ static inline bool is_condition_met(struct k_poll_event *event, uint32_t *state)
 			return true;
 		}
 		break;
+	case K_POLL_TYPE_MPMCQ_DATA_AVAILABLE:
+		if (!k_mpmcq_is_empty(event->mpmcq)) {
+			*state = K_POLL_STATE_MPMCQ_DATA_AVAILABLE;
+			return true;
+		}
+		break;
 	case K_POLL_TYPE_IGNORE:
 		break;
 	default:
@@ -146,6 +152,10 @@ static inline void register_event(struct k_poll_event *event,
 		__ASSERT(event->msgq != NULL, "invalid message queue\n");
 		add_event(&event->msgq->poll_events, event, poller);
 		break;
+	case K_POLL_TYPE_MPMCQ_DATA_AVAILABLE:
+		__ASSERT(event->mpmcq != NULL, "invalid MPMC queue\n");
+		add_event(&event->mpmcq->poll_events, event, poller);
+		break;
 	case K_POLL_TYPE_IGNORE:
 		/* nothing to do */
 		break;
@@ -181,6 +191,10 @@ static inline void clear_event_registration(struct k_poll_event *event)
 		__ASSERT(event->msgq != NULL, "invalid message queue\n");
 		remove_event = true;
 		break;
+	case K_POLL_TYPE_MPMCQ_DATA_AVAILABLE:
+		__ASSERT(event->mpmcq != NULL, "invalid MPMC queue\n");
+		remove_event = true;
+		break;
 	case K_POLL_TYPE_IGNORE:
 		/* nothing to do */
 		break;
@@ -229,6 +243,16 @@ static inline int register_events(struct k_poll_event *events,
 		} else if (!just_check && poller->is_polling) {
 			register_event(&events[ii], poller);
 			events_registered += 1;
+
+			/* MPMC queues are filled without taking any lock,
+			 * so look again now that producers can see us.
+			 */
+			if ((events[ii].type == K_POLL_TYPE_MPMCQ_DATA_AVAILABLE) &&
+			    z_mpmcq_poll_recheck(events[ii].mpmcq)) {
+				set_event_ready(&events[ii],
+						K_POLL_STATE_MPMCQ_DATA_AVAILABLE);
+				poller->is_polling = false;
+			}
 		} else {
 			/* Event is not one of those identified in is_condition_met()
 			 * catching non-polling events, or is marked for just check,
@@ -218,14 +218,27 @@ static ALWAYS_INLINE void *curr_cpu_runq(void)
 #endif
 }
 
+#ifdef CONFIG_SCHED_THREAD_STATS
+static ALWAYS_INLINE struct _ready_q *runq_ready_q(void *runq)
+{
+	return CONTAINER_OF(runq, struct _ready_q, runq);
+}
+#endif
+
 static ALWAYS_INLINE void runq_add(struct k_thread *thread)
 {
 	_priq_run_add(thread_runq(thread), thread);
+#ifdef CONFIG_SCHED_THREAD_STATS
+	runq_ready_q(thread_runq(thread))->len++;
+#endif
 }
 
 static ALWAYS_INLINE void runq_remove(struct k_thread *thread)
 {
 	_priq_run_remove(thread_runq(thread), thread);
+#ifdef CONFIG_SCHED_THREAD_STATS
+	runq_ready_q(thread_runq(thread))->len--;
+#endif
 }
 
 static ALWAYS_INLINE struct k_thread *runq_best(void)
@@ -523,6 +536,58 @@ static bool thread_active_elsewhere(struct k_thread *thread)
 	return false;
 }
 
+#ifdef CONFIG_SCHED_THREAD_STATS
+static uint32_t stats_now(void)
+{
+	uint32_t now = k_cycle_get_32();
+
+	/* Zero means "not waiting to run" in ready_stamp */
+	return (now == 0) ? 1 : now;
+}
+#endif
+
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+static inline bool is_reserved(struct k_thread *thread)
+{
+	return thread->base.resv.runtime != 0U;
+}
+
+static void resv_replenish(struct _timeout *t);
+
+/* Constant bandwidth server wakeup rule: the thread keeps its deadline
+ * only if it could not use up the budget it has left before it at the
+ * reserved rate.  Otherwise it starts a new period with a full budget,
+ * less any overrun.  A thread left without budget is throttled until
+ * its deadline rather than run on credit, and false is returned.
+ * Must be called with sched_spinlock held, the thread not queued.
+ */
+static bool resv_wakeup(struct k_thread *thread)
+{
+	struct _thread_resv *resv = &thread->base.resv;
+	uint32_t now = k_cycle_get_32();
+	int32_t left = (int32_t)(resv->deadline - now);
+
+	if ((left <= 0) ||
+	    ((resv->budget > 0) &&
+	     ((uint64_t)resv->budget * resv->period >=
+	      (uint64_t)left * resv->runtime))) {
+		resv->deadline = now + resv->period;
+		resv->budget = MIN(resv->budget, 0) + (int32_t)resv->runtime;
+		left = (int32_t)resv->period;
+	}
+
+	thread->base.prio_deadline = resv->deadline;
+
+	if (resv->budget <= 0) {
+		thread->base.thread_state |= _THREAD_THROTTLED;
+		z_add_timeout(&resv->replenish, resv_replenish, K_CYC(left));
+		return false;
+	}
+
+	return true;
+}
+#endif
+
 static void ready_thread(struct k_thread *thread)
 {
 #ifdef CONFIG_KERNEL_COHERENCE
@@ -535,6 +600,17 @@ static void ready_thread(struct k_thread *thread)
 	if (!z_is_thread_queued(thread) && z_is_thread_ready(thread)) {
 		SYS_PORT_TRACING_OBJ_FUNC(k_thread, sched_ready, thread);
 
+#ifdef CONFIG_SCHED_THREAD_STATS
+		if (thread != _current) {
+			thread->base.ready_stamp = stats_now();
+		}
+#endif
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+		if (is_reserved(thread) && (thread != _current) &&
+		    !resv_wakeup(thread)) {
+			return;
+		}
+#endif
 		queue_thread(thread);
 		update_cache(0);
 #if defined(CONFIG_SMP) &&  defined(CONFIG_SCHED_IPI_SUPPORTED)
@@ -1134,7 +1210,7 @@ void init_ready_q(struct _ready_q *rq)
 		}
 	};
 #elif defined(CONFIG_SCHED_MULTIQ)
-	for (int i = 0; i < ARRAY_SIZE(_kernel.ready_q.runq.queues); i++) {
+	for (int i = 0; i < ARRAY_SIZE(rq->runq.queues); i++) {
 		sys_dlist_init(&rq->runq.queues[i]);
 	}
 #else
@@ -1206,6 +1282,13 @@ void z_impl_k_thread_deadline_set(k_tid_t tid, int deadline)
 {
 	struct k_thread *thread = tid;
 
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+	if (is_reserved(thread)) {
+		/* Deadline is owned by the reservation */
+		return;
+	}
+#endif
+
 	LOCKED(&sched_spinlock) {
 		thread->base.prio_deadline = k_cycle_get_32() + deadline;
 		if (z_is_thread_queued(thread)) {
@@ -1231,6 +1314,190 @@ static inline void z_vrfy_k_thread_deadline_set(k_tid_t tid, int deadline)
 #endif
 #endif
 
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+
+/* Budget enforcement for _current, armed while a reserving thread runs */
+static struct _timeout resv_timeout;
+
+/* Sum of the reserved utilizations, in parts per million */
+static uint32_t resv_util;
+
+static void resv_budget_expired(struct _timeout *t);
+
+static void resv_arm(struct k_thread *thread)
+{
+	(void)z_abort_timeout(&resv_timeout);
+	z_add_timeout(&resv_timeout, resv_budget_expired,
+		      K_CYC(thread->base.resv.budget));
+}
+
+/* Charges a running thread for the time since it was last charged */
+static void resv_charge(struct k_thread *thread)
+{
+	struct _thread_resv *resv = &thread->base.resv;
+	uint32_t now = k_cycle_get_32();
+
+	resv->budget -= (int32_t)(now - resv->start);
+	resv->start = now;
+}
+
+static void resv_replenish(struct _timeout *t)
+{
+	struct _thread_base *base = CONTAINER_OF(t, struct _thread_base,
+						 resv.replenish);
+	struct k_thread *thread = CONTAINER_OF(base, struct k_thread, base);
+
+	LOCKED(&sched_spinlock) {
+		/* The wakeup rule starts the new period */
+		thread->base.thread_state &= ~_THREAD_THROTTLED;
+		ready_thread(thread);
+	}
+}
+
+/* Throttles a thread that used up its budget until the end of its
+ * period, or starts its next period right away if that has ended and
+ * it is enough to pay off the overrun.  Must be called with
+ * sched_spinlock held.
+ */
+static void resv_exhausted(struct k_thread *thread)
+{
+	bool queued = z_is_thread_queued(thread);
+
+	if (queued) {
+		dequeue_thread(thread);
+	}
+
+	if (resv_wakeup(thread) && queued) {
+		queue_thread(thread);
+	}
+
+	update_cache(thread == _current);
+}
+
+static void resv_budget_expired(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+
+	LOCKED(&sched_spinlock) {
+		struct k_thread *thread = _current;
+
+		if (is_reserved(thread)) {
+			resv_charge(thread);
+			if (thread->base.resv.budget <= 0) {
+				resv_exhausted(thread);
+			}
+			if (!z_is_thread_state_set(thread, _THREAD_THROTTLED)) {
+				resv_arm(thread);
+			}
+		}
+	}
+}
+
+void z_sched_resv_switch_out(struct k_thread *thread)
+{
+	if (is_reserved(thread)) {
+		resv_charge(thread);
+		(void)z_abort_timeout(&resv_timeout);
+	}
+}
+
+void z_sched_resv_switch_in(struct k_thread *thread)
+{
+	if (is_reserved(thread)) {
+		thread->base.resv.start = k_cycle_get_32();
+		resv_arm(thread);
+	}
+}
+
+/* Drops the reservation of a thread, with sched_spinlock held */
+static void resv_release(struct k_thread *thread)
+{
+	struct _thread_resv *resv = &thread->base.resv;
+
+	if (thread == _current) {
+		(void)z_abort_timeout(&resv_timeout);
+	}
+	if (z_abort_timeout(&resv->replenish) == 0) {
+		thread->base.thread_state &= ~_THREAD_THROTTLED;
+	}
+
+	resv_util -= resv->util;
+	resv->util = 0U;
+	resv->runtime = 0U;
+}
+
+int z_impl_k_thread_reservation_set(k_tid_t thread, uint32_t runtime_us,
+				    uint32_t period_us)
+{
+	struct _thread_resv *resv = &thread->base.resv;
+	uint64_t runtime = k_us_to_cyc_ceil64(runtime_us);
+	uint64_t period = k_us_to_cyc_floor64(period_us);
+	uint32_t util = 0U;
+	k_spinlock_key_t key;
+
+	if (runtime_us != 0U) {
+		if ((runtime_us > period_us) || (period > INT32_MAX)) {
+			return -EINVAL;
+		}
+		util = (uint32_t)((uint64_t)runtime_us * USEC_PER_SEC /
+				  period_us);
+	}
+
+	key = k_spin_lock(&sched_spinlock);
+
+	if ((resv_util - resv->util + util) >
+	    CONFIG_SCHED_DEADLINE_RESERVATION_MAX_UTIL * 10000U) {
+		k_spin_unlock(&sched_spinlock, key);
+		return -EBUSY;
+	}
+
+	resv_release(thread);
+
+	if (util != 0U) {
+		resv_util += util;
+		resv->util = util;
+		resv->runtime = (uint32_t)MIN(runtime, period);
+		resv->period = (uint32_t)period;
+		resv->budget = (int32_t)resv->runtime;
+		resv->start = k_cycle_get_32();
+		resv->deadline = resv->start + resv->period;
+		thread->base.prio_deadline = resv->deadline;
+
+		if (thread == _current) {
+			resv_arm(thread);
+		}
+	}
+
+	/* Sort it by its new deadline, or let it run if it was throttled */
+	if (z_is_thread_queued(thread)) {
+		dequeue_thread(thread);
+		queue_thread(thread);
+		update_cache(thread == _current);
+	} else {
+		ready_thread(thread);
+	}
+
+	z_reschedule(&sched_spinlock, key);
+
+	return 0;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_k_thread_reservation_set(k_tid_t thread,
+						  uint32_t runtime_us,
+						  uint32_t period_us)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(thread, K_OBJ_THREAD));
+	Z_OOPS(Z_SYSCALL_VERIFY_MSG(thread != _current,
+				    "a thread may not change its own reservation"));
+
+	return z_impl_k_thread_reservation_set(thread, runtime_us, period_us);
+}
+#include <syscalls/k_thread_reservation_set_mrsh.c>
+#endif
+
+#endif /* CONFIG_SCHED_DEADLINE_RESERVATION */
+
 void z_impl_k_yield(void)
 {
 	__ASSERT(!arch_is_in_isr(), "");
@@ -1537,6 +1804,9 @@ static void end_thread(struct k_thread *thread)
 			unpend_thread_no_timeout(thread);
 		}
 		(void)z_abort_thread_timeout(thread);
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+		resv_release(thread);
+#endif
 		unpend_all(&thread->join_queue);
 		update_cache(1);
 
@@ -1818,3 +2088,88 @@ uint64_t z_sched_thread_usage(struct k_thread *thread)
 }
 
 #endif /* CONFIG_SCHED_THREAD_USAGE */
+
+#ifdef CONFIG_SCHED_THREAD_STATS
+
+void z_sched_stats_switch_out(struct k_thread *thread)
+{
+	/* Still queued means still ready: preempted, sliced or yielded */
+	if (z_is_thread_queued(thread)) {
+		thread->base.sched_stats.preemptions++;
+	}
+}
+
+/* Called with sched_spinlock held, or on uniprocessor arch_swap() builds
+ * with interrupts locked, which is all sched_spinlock amounts to there:
+ * SMP requires CONFIG_USE_SWITCH.  So the readers below, which take
+ * sched_spinlock, always see consistent statistics.
+ */
+void z_sched_stats_switch_in(struct k_thread *thread)
+{
+	struct k_thread_sched_stats *stats = &thread->base.sched_stats;
+	struct _cpu *cpu = _current_cpu;
+	uint32_t len = runq_ready_q(curr_cpu_runq())->len;
+	uint32_t us;
+	int bucket;
+
+	/* Without SMP the running thread stays queued */
+	if (z_is_thread_queued(thread)) {
+		len--;
+	}
+
+	cpu->runq_len_sum += len;
+	cpu->runq_len_samples++;
+	cpu->runq_len_max = MAX(cpu->runq_len_max, len);
+
+	if (thread->base.ready_stamp == 0U) {
+		return;
+	}
+
+	us = k_cyc_to_us_floor32(k_cycle_get_32() - thread->base.ready_stamp);
+	thread->base.ready_stamp = 0U;
+
+	bucket = (us == 0U) ? 0 : (32 - u32_count_leading_zeros(us));
+	bucket = MIN(bucket, CONFIG_SCHED_THREAD_STATS_BUCKETS - 1);
+
+	stats->wakeups++;
+	stats->wakeup_latency_hist[bucket]++;
+	stats->wakeup_latency_max_us = MAX(stats->wakeup_latency_max_us, us);
+}
+
+int k_thread_sched_stats_get(k_tid_t thread,
+			     struct k_thread_sched_stats *stats)
+{
+	if ((thread == NULL) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	LOCKED(&sched_spinlock) {
+		*stats = thread->base.sched_stats;
+	}
+
+	return 0;
+}
+
+void k_thread_sched_stats_reset(k_tid_t thread)
+{
+	LOCKED(&sched_spinlock) {
+		thread->base.sched_stats = (struct k_thread_sched_stats) {};
+	}
+}
+
+int k_cpu_sched_stats_get(int cpu, struct k_cpu_sched_stats *stats)
+{
+	if ((cpu < 0) || (cpu >= CONFIG_MP_NUM_CPUS) || (stats == NULL)) {
+		return -EINVAL;
+	}
+
+	LOCKED(&sched_spinlock) {
+		stats->runq_len_samples = _kernel.cpus[cpu].runq_len_samples;
+		stats->runq_len_max = _kernel.cpus[cpu].runq_len_max;
+		stats->runq_len_sum = _kernel.cpus[cpu].runq_len_sum;
+	}
+
+	return 0;
+}
+
+#endif /* CONFIG_SCHED_THREAD_STATS */
@@ -275,6 +275,8 @@ const char *k_thread_state_str(k_tid_t thread_id)
 		return "suspended";
 	case _THREAD_ABORTING:
 		return "aborting";
+	case _THREAD_THROTTLED:
+		return "throttled";
 	case _THREAD_QUEUED:
 		return "queued";
 	default:
@@ -776,6 +778,16 @@ void z_init_thread_base(struct _thread_base *thread_base, int priority,
 	/* swap_data does not need to be initialized */
 
 	z_init_thread_timeout(thread_base);
+
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+	thread_base->resv.runtime = 0U;
+	thread_base->resv.util = 0U;
+	z_init_timeout(&thread_base->resv.replenish);
+#endif
+
+#ifdef CONFIG_MUTEX_CEILING_PROTOCOL
+	thread_base->mutexes_held = 0U;
+#endif
 }
 
 FUNC_NORETURN void k_thread_user_mode_enter(k_thread_entry_t entry,
@@ -1002,6 +1014,14 @@ void z_thread_mark_switched_in(void)
 	z_sched_usage_start(_current);
 #endif
 
+#if defined(CONFIG_SCHED_THREAD_STATS) && !defined(CONFIG_USE_SWITCH)
+	z_sched_stats_switch_in(_current);
+#endif
+
+#if defined(CONFIG_SCHED_DEADLINE_RESERVATION) && !defined(CONFIG_USE_SWITCH)
+	z_sched_resv_switch_in(_current);
+#endif
+
 #ifdef CONFIG_TRACING
 	SYS_PORT_TRACING_FUNC(k_thread, switched_in);
 #endif
@@ -1013,6 +1033,14 @@ void z_thread_mark_switched_out(void)
 	z_sched_usage_stop();
 #endif
 
+#if defined(CONFIG_SCHED_THREAD_STATS) && !defined(CONFIG_USE_SWITCH)
+	z_sched_stats_switch_out(_current);
+#endif
+
+#if defined(CONFIG_SCHED_DEADLINE_RESERVATION) && !defined(CONFIG_USE_SWITCH)
+	z_sched_resv_switch_out(_current);
+#endif
+
 #ifdef CONFIG_TRACING
 	SYS_PORT_TRACING_FUNC(k_thread, switched_out);
 #endif
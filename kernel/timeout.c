@@ -14,7 +14,9 @@
 
 static uint64_t curr_tick;
 
+#ifndef CONFIG_TIMEOUT_WHEEL
 static sys_dlist_t timeout_list = SYS_DLIST_STATIC_INIT(&timeout_list);
+#endif
 
 static struct k_spinlock timeout_lock;
 
@@ -36,6 +38,191 @@ static inline int z_vrfy_sys_clock_hw_cycles_per_sec_runtime_get(void)
 #endif /* CONFIG_USERSPACE */
 #endif /* CONFIG_TIMER_READS_ITS_FREQUENCY_AT_RUNTIME */
 
+#ifdef CONFIG_TIMEOUT_WHEEL
+/* Hierarchical hashed timing wheel.  Level L has WHEEL_SLOTS slots
+ * each covering WHEEL_SPAN(L) ticks.  A timeout lives at the lowest
+ * level whose range covers its distance from curr_tick, and when
+ * curr_tick reaches the start of a higher level slot ("boundary"),
+ * that slot is cascaded: its timeouts are re-inserted at lower
+ * levels.  Insert and cancel are O(1) and nothing is ever sorted.
+ *
+ * While queued, the dticks field holds the absolute expiry tick
+ * (truncated to the field width) rather than a delta.
+ *
+ * The pending bitmaps are allowed to be stale: cancellation only
+ * unlinks the node, and a slot found empty while scanning gets its
+ * bit cleared then.  A slot list is (re)initialized when its bit
+ * goes from clear to set, so no boot-time initialization is needed.
+ */
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS BIT(WHEEL_BITS)
+#define WHEEL_MASK (WHEEL_SLOTS - 1)
+#define WHEEL_LEVELS CONFIG_TIMEOUT_WHEEL_LEVELS
+#define WHEEL_SHIFT(l) (WHEEL_BITS * (l))
+#define WHEEL_SPAN(l) (1ULL << WHEEL_SHIFT(l))
+
+static sys_dlist_t wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+static uint64_t wheel_pending[WHEEL_LEVELS];
+
+static inline uint64_t expiry(const struct _timeout *t)
+{
+#ifdef CONFIG_TIMEOUT_64BIT
+	return (uint64_t)t->dticks;
+#else
+	/* Queued timeouts are always within INT32_MAX ticks of now */
+	return curr_tick + (int32_t)((uint32_t)t->dticks - (uint32_t)curr_tick);
+#endif
+}
+
+static void wheel_insert(struct _timeout *to)
+{
+	uint64_t when = expiry(to);
+	int level = 0;
+
+	while ((level < WHEEL_LEVELS - 1) &&
+	       ((when - curr_tick) >= WHEEL_SPAN(level + 1))) {
+		level++;
+	}
+
+	/* Beyond the top level's range: park it in the last slot we
+	 * can reach, it gets re-inserted from there when cascaded.
+	 */
+	when = MIN(when, curr_tick + WHEEL_SPAN(WHEEL_LEVELS) - 1);
+
+	int slot = (when >> WHEEL_SHIFT(level)) & WHEEL_MASK;
+
+	if ((wheel_pending[level] & BIT64(slot)) == 0U) {
+		wheel_pending[level] |= BIT64(slot);
+		sys_dlist_init(&wheel[level][slot]);
+	}
+	sys_dlist_append(&wheel[level][slot], &to->node);
+}
+
+/* Absolute tick of the next point where the wheel has work to do
+ * (an expiry at level 0 or a non-empty slot to cascade), or
+ * UINT64_MAX if nothing is queued.  For higher levels this is a
+ * lower bound on the expiry of their contents.
+ */
+static uint64_t wheel_next_event(void)
+{
+	uint64_t ret = UINT64_MAX;
+
+	for (int l = 0; l < WHEEL_LEVELS; l++) {
+		uint64_t base = curr_tick >> WHEEL_SHIFT(l);
+
+		while (wheel_pending[l] != 0U) {
+			/* Bit i of rot is the slot i + 1 slots ahead */
+			unsigned int cur = (base + 1) & WHEEL_MASK;
+			uint64_t rot = (wheel_pending[l] >> cur) |
+				       (wheel_pending[l] << ((WHEEL_SLOTS - cur) & WHEEL_MASK));
+			unsigned int d = __builtin_ctzll(rot) + 1;
+			unsigned int slot = (base + d) & WHEEL_MASK;
+
+			if (sys_dlist_is_empty(&wheel[l][slot])) {
+				wheel_pending[l] &= ~BIT64(slot);
+				continue;
+			}
+
+			ret = MIN(ret, (base + d) << WHEEL_SHIFT(l));
+			break;
+		}
+	}
+
+	return ret;
+}
+
+static void wheel_cascade(void)
+{
+	for (int l = WHEEL_LEVELS - 1; l > 0; l--) {
+		if ((curr_tick & (WHEEL_SPAN(l) - 1)) != 0U) {
+			continue;
+		}
+
+		int slot = (curr_tick >> WHEEL_SHIFT(l)) & WHEEL_MASK;
+		sys_dnode_t *node;
+
+		if ((wheel_pending[l] & BIT64(slot)) == 0U) {
+			continue;
+		}
+
+		wheel_pending[l] &= ~BIT64(slot);
+		while ((node = sys_dlist_get(&wheel[l][slot])) != NULL) {
+			wheel_insert(CONTAINER_OF(node, struct _timeout, node));
+		}
+	}
+}
+
+/* Queues a timeout expiring to->dticks ticks after curr_tick,
+ * returns true if it became the earliest pending event.
+ */
+static bool insert_timeout(struct _timeout *to)
+{
+	uint64_t prev = wheel_next_event();
+
+	to->dticks = curr_tick + to->dticks;
+	wheel_insert(to);
+
+	return expiry(to) < prev;
+}
+
+static void remove_timeout(struct _timeout *t)
+{
+	sys_dlist_remove(&t->node);
+}
+
+/* Ticks from curr_tick to the next event, or -1 if none */
+static k_ticks_t next_event_ticks(void)
+{
+	uint64_t ev = wheel_next_event();
+
+	return ev == UINT64_MAX ? -1 : (k_ticks_t)(ev - curr_tick);
+}
+
+/* Ticks from curr_tick until the timeout expires */
+static k_ticks_t expiry_ticks(const struct _timeout *timeout)
+{
+	return (k_ticks_t)(expiry(timeout) - curr_tick);
+}
+
+/* Dequeues the next timeout due within announce_remaining ticks,
+ * advancing curr_tick to its expiry, or returns NULL.
+ */
+static struct _timeout *pop_expired(void)
+{
+	while (true) {
+		int slot = curr_tick & WHEEL_MASK;
+		sys_dnode_t *node = NULL;
+
+		if ((wheel_pending[0] & BIT64(slot)) != 0U) {
+			node = sys_dlist_get(&wheel[0][slot]);
+			if (node == NULL) {
+				wheel_pending[0] &= ~BIT64(slot);
+			}
+		}
+
+		if (node != NULL) {
+			return CONTAINER_OF(node, struct _timeout, node);
+		}
+
+		uint64_t ev = wheel_next_event();
+
+		if ((ev == UINT64_MAX) ||
+		    ((ev - curr_tick) > (uint64_t)announce_remaining)) {
+			return NULL;
+		}
+
+		announce_remaining -= ev - curr_tick;
+		curr_tick = ev;
+		wheel_cascade();
+	}
+}
+
+static void finish_announce(void)
+{
+}
+
+#else /* !CONFIG_TIMEOUT_WHEEL */
+
 static struct _timeout *first(void)
 {
 	sys_dnode_t *t = sys_dlist_peek_head(&timeout_list);
@@ -59,17 +246,129 @@ static void remove_timeout(struct _timeout *t)
 	sys_dlist_remove(&t->node);
 }
 
+static bool insert_timeout(struct _timeout *to)
+{
+	struct _timeout *t;
+
+	for (t = first(); t != NULL; t = next(t)) {
+		if (t->dticks > to->dticks) {
+			t->dticks -= to->dticks;
+			sys_dlist_insert(&t->node, &to->node);
+			break;
+		}
+		to->dticks -= t->dticks;
+	}
+
+	if (t == NULL) {
+		sys_dlist_append(&timeout_list, &to->node);
+	}
+
+	return to == first();
+}
+
+static k_ticks_t next_event_ticks(void)
+{
+	struct _timeout *to = first();
+
+	return to == NULL ? -1 : to->dticks;
+}
+
+static k_ticks_t expiry_ticks(const struct _timeout *timeout)
+{
+	k_ticks_t ticks = 0;
+
+	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
+		ticks += t->dticks;
+		if (timeout == t) {
+			break;
+		}
+	}
+
+	return ticks;
+}
+
+static struct _timeout *pop_expired(void)
+{
+	struct _timeout *t = first();
+
+	if (t == NULL || t->dticks > announce_remaining) {
+		return NULL;
+	}
+
+	int dt = t->dticks;
+
+	curr_tick += dt;
+	announce_remaining -= dt;
+	t->dticks = 0;
+	remove_timeout(t);
+
+	return t;
+}
+
+static void finish_announce(void)
+{
+	if (first() != NULL) {
+		first()->dticks -= announce_remaining;
+	}
+}
+
+#endif /* CONFIG_TIMEOUT_WHEEL */
+
 static int32_t elapsed(void)
 {
 	return announce_remaining == 0 ? sys_clock_elapsed() : 0U;
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+static struct sys_clock_slack_stats slack_stats;
+
+/* Picks the expiry, dticks to dticks + slack ticks from curr_tick, of
+ * a timeout being added.  The next pending event is taken if it is in
+ * the window: it already has a timer interrupt programmed.  Otherwise
+ * the tick in the window with the most trailing zero bits is taken,
+ * so that timeouts with overlapping windows tend to agree on it.
+ */
+static k_ticks_t apply_slack(const struct _timeout *to, k_ticks_t dticks,
+			     k_ticks_t next)
+{
+	k_ticks_t slack = to->slack;
+	uint64_t when, limit;
+
+	if (!IS_ENABLED(CONFIG_TIMEOUT_64BIT)) {
+		/* Keep the expiry within a 32 bit dticks */
+		slack = MIN(slack, INT32_MAX - dticks);
+	}
+
+	if (slack == 0) {
+		return dticks;
+	}
+
+	if ((next >= dticks) && (next - dticks <= slack)) {
+		slack_stats.coalesced++;
+		return next;
+	}
+
+	when = curr_tick + dticks;
+	limit = when + slack;
+	limit &= ~(BIT64(63 - __builtin_clzll(when ^ limit)) - 1U);
+
+	return (k_ticks_t)(limit - curr_tick);
+}
+
+void sys_clock_slack_stats_get(struct sys_clock_slack_stats *stats)
+{
+	LOCKED(&timeout_lock) {
+		*stats = slack_stats;
+	}
+}
+#endif /* CONFIG_TIMEOUT_SLACK */
+
 static int32_t next_timeout(void)
 {
-	struct _timeout *to = first();
+	k_ticks_t ticks = next_event_ticks();
 	int32_t ticks_elapsed = elapsed();
-	int32_t ret = to == NULL ? MAX_WAIT
-		: CLAMP(to->dticks - ticks_elapsed, 0, MAX_WAIT);
+	int32_t ret = ticks < 0 ? MAX_WAIT
+		: CLAMP(ticks - ticks_elapsed, 0, MAX_WAIT);
 
 #ifdef CONFIG_TIMESLICING
 	if (_current_cpu->slice_ticks && _current_cpu->slice_ticks < ret) {
@@ -94,8 +393,6 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	to->fn = fn;
 
 	LOCKED(&timeout_lock) {
-		struct _timeout *t;
-
 		if (IS_ENABLED(CONFIG_TIMEOUT_64BIT) &&
 		    Z_TICK_ABS(timeout.ticks) >= 0) {
 			k_ticks_t ticks = Z_TICK_ABS(timeout.ticks) - curr_tick;
@@ -105,20 +402,20 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 			to->dticks = timeout.ticks + 1 + elapsed();
 		}
 
-		for (t = first(); t != NULL; t = next(t)) {
-			if (t->dticks > to->dticks) {
-				t->dticks -= to->dticks;
-				sys_dlist_insert(&t->node, &to->node);
-				break;
-			}
-			to->dticks -= t->dticks;
-		}
+#ifdef CONFIG_TIMEOUT_SLACK
+		k_ticks_t next = next_event_ticks();
+		k_ticks_t ticks = apply_slack(to, to->dticks, next);
 
-		if (t == NULL) {
-			sys_dlist_append(&timeout_list, &to->node);
+		if ((next < 0) || (ticks < next)) {
+			slack_stats.reprograms++;
+		} else if (to->dticks < next) {
+			slack_stats.reprograms_saved++;
 		}
+		to->slack_delay = (uint32_t)(ticks - to->dticks);
+		to->dticks = ticks;
+#endif
 
-		if (to == first()) {
+		if (insert_timeout(to)) {
 #if CONFIG_TIMESLICING
 			/*
 			 * This is not ideal, since it does not
@@ -141,14 +438,16 @@ void z_add_timeout(struct _timeout *to, _timeout_func_t fn,
 	}
 }
 
-int z_abort_timeout(struct _timeout *to)
+int z_abort_timeouts(struct _timeout *const *to, size_t count)
 {
-	int ret = -EINVAL;
+	int ret = 0;
 
 	LOCKED(&timeout_lock) {
-		if (sys_dnode_is_linked(&to->node)) {
-			remove_timeout(to);
-			ret = 0;
+		for (size_t i = 0; i < count; i++) {
+			if (sys_dnode_is_linked(&to[i]->node)) {
+				remove_timeout(to[i]);
+				ret++;
+			}
 		}
 	}
 
@@ -158,20 +457,11 @@ int z_abort_timeout(struct _timeout *to)
 /* must be locked */
 static k_ticks_t timeout_rem(const struct _timeout *timeout)
 {
-	k_ticks_t ticks = 0;
-
 	if (z_is_inactive_timeout(timeout)) {
 		return 0;
 	}
 
-	for (struct _timeout *t = first(); t != NULL; t = next(t)) {
-		ticks += t->dticks;
-		if (timeout == t) {
-			break;
-		}
-	}
-
-	return ticks - elapsed();
+	return expiry_ticks(timeout) - elapsed();
 }
 
 k_ticks_t z_timeout_remaining(const struct _timeout *timeout)
@@ -240,23 +530,13 @@ void sys_clock_announce(int32_t ticks)
 
 	announce_remaining = ticks;
 
-	while (first() != NULL && first()->dticks <= announce_remaining) {
-		struct _timeout *t = first();
-		int dt = t->dticks;
-
-		curr_tick += dt;
-		announce_remaining -= dt;
-		t->dticks = 0;
-		remove_timeout(t);
-
+	for (struct _timeout *t = pop_expired(); t != NULL; t = pop_expired()) {
 		k_spin_unlock(&timeout_lock, key);
 		t->fn(t);
 		key = k_spin_lock(&timeout_lock);
 	}
 
-	if (first() != NULL) {
-		first()->dticks -= announce_remaining;
-	}
+	finish_announce();
 
 	curr_tick += announce_remaining;
 	announce_remaining = 0;
@@ -34,8 +34,20 @@ void z_timer_expiration_handler(struct _timeout *t)
 	 */
 	if (!K_TIMEOUT_EQ(timer->period, K_NO_WAIT) &&
 	    !K_TIMEOUT_EQ(timer->period, K_FOREVER)) {
+		k_timeout_t period = timer->period;
+
+#ifdef CONFIG_TIMEOUT_SLACK
+		/* Count the period from when this expiry was due, not from
+		 * when the slack let it happen, or the delays would add up
+		 */
+		if (Z_TICK_ABS(period.ticks) < 0) {
+			period.ticks = MAX(period.ticks -
+					   (k_ticks_t)t->slack_delay, 0);
+		}
+#endif
+
 		z_add_timeout(&timer->timeout, z_timer_expiration_handler,
-			     timer->period);
+			     period);
 	}
 
 	/* update timer's status */
@@ -293,4 +305,12 @@ static inline void z_vrfy_k_timer_user_data_set(struct k_timer *timer,
 }
 #include <syscalls/k_timer_user_data_set_mrsh.c>
 
+static inline void z_vrfy_k_timer_slack_set(struct k_timer *timer,
+					    k_timeout_t slack)
+{
+	Z_OOPS(Z_SYSCALL_OBJ(timer, K_OBJ_TIMER));
+	z_impl_k_timer_slack_set(timer, slack);
+}
+#include <syscalls/k_timer_slack_set_mrsh.c>
+
 #endif
@@ -8,7 +8,6 @@
 #include <kernel.h>
 #include <string.h>
 #include <sys/math_extras.h>
-#include <sys/rb.h>
 #include <kernel_structs.h>
 #include <sys/sys_io.h>
 #include <ksched.h>
@@ -47,8 +46,7 @@ LOG_MODULE_DECLARE(os, CONFIG_KERNEL_LOG_LEVEL);
  * not.
  */
 #ifdef CONFIG_DYNAMIC_OBJECTS
-static struct k_spinlock lists_lock;       /* kobj rbtree/dlist */
-static struct k_spinlock objfree_lock;     /* k_object_free */
+static struct k_spinlock lists_lock;       /* kobj hash table/dlist */
 #endif
 static struct k_spinlock obj_lock;         /* kobj struct data */
 
@@ -59,6 +57,7 @@ extern uint8_t _thread_idx_map[CONFIG_MAX_THREAD_BYTES];
 #endif
 
 static void clear_perms_cb(struct z_object *ko, void *ctx_ptr);
+static void perms_index_clear(uintptr_t index);
 
 const char *otype_to_str(enum k_objects otype)
 {
@@ -136,36 +135,82 @@ uint8_t *z_priv_stack_find(k_thread_stack_t *stack)
 struct dyn_obj {
 	struct z_object kobj;
 	sys_dnode_t dobj_list;
-	struct rbnode node; /* must be immediately before data member */
+	/* Next object in the same hash bucket */
+	atomic_ptr_t hash_next;
+	/* Permission links of the threads granted access, see perm_link */
+	sys_slist_t perm_links;
 
 	/* The object itself */
 	uint8_t data[] __aligned(DYN_OBJ_DATA_ALIGN_K_THREAD);
 };
 
-extern struct z_object *z_object_gperf_find(const void *obj);
-extern void z_object_gperf_wordlist_foreach(_wordlist_cb_func_t func,
-					     void *context);
+/*
+ * Hash table of allocated kernel objects, keyed by their address.
+ *
+ * Lookups don't take any lock: the buckets and chain links are only
+ * updated with single atomic stores, under lists_lock, so that readers
+ * always see a consistent chain.  Memory that a reader may still be
+ * walking is not freed right away: readers are counted, and objects or
+ * tables removed while any reader is active are queued and freed by the
+ * last reader to leave.
+ *
+ * The table doubles in size, and never shrinks, whenever there are as
+ * many objects as buckets.  Rehashing moves the objects to the new
+ * table one at a time, so a lookup overlapping with it may miss; it is
+ * retried when dyn_table_seq shows that a rehash was in progress.
+ */
+struct dyn_table {
+	/* Freed table queued for reclaim */
+	sys_snode_t node;
+	uint8_t bits;
+	atomic_ptr_t buckets[];
+};
+
+#define DYN_TABLE_MIN_BITS	4
+
+static atomic_ptr_t dyn_table;
+static atomic_t dyn_table_seq;
+static atomic_t dyn_readers;
+static size_t dyn_count;
 
-static bool node_lessthan(struct rbnode *a, struct rbnode *b);
+/* Removed objects and tables waiting for the readers to leave */
+static sys_dlist_t dead_objs = SYS_DLIST_STATIC_INIT(&dead_objs);
+static sys_slist_t dead_tables;
 
 /*
- * Red/black tree of allocated kernel objects, for reasonably fast lookups
- * based on object pointer values.
+ * Per-thread permission index.  Every permission bit set on a dynamic
+ * object for some thread index is mirrored by a perm_link, which is on
+ * both the list of that object and the list of that thread index.  This
+ * lets thread exit and permission inheritance visit only the objects
+ * the thread was granted, instead of every allocated object.
+ *
+ * A thread index whose link could not be allocated, because the
+ * kernel heap was exhausted, is marked in perm_overflow, so that the
+ * next clear of that index falls back to scanning all objects.
+ *
+ * The links and index lists are protected by obj_lock, which is always
+ * taken before lists_lock.
  */
-static struct rbtree obj_rb_tree = {
-	.lessthan_fn = node_lessthan
+struct perm_link {
+	sys_dnode_t thread_node;
+	sys_snode_t obj_node;
+	struct dyn_obj *dyn;
+	uintptr_t index;
 };
 
+static sys_dlist_t perm_lists[MAX_THREAD_BITS];
+static uint8_t perm_overflow[CONFIG_MAX_THREAD_BYTES];
+
 /*
  * Linked list of allocated kernel objects, for iteration over all allocated
- * objects (and potentially deleting them during iteration).
+ * objects (and potentially deleting them during iteration).  Modified with
+ * both obj_lock and lists_lock held.
  */
 static sys_dlist_t obj_list = SYS_DLIST_STATIC_INIT(&obj_list);
 
-/*
- * TODO: Write some hash table code that will replace both obj_rb_tree
- * and obj_list.
- */
+extern struct z_object *z_object_gperf_find(const void *obj);
+extern void z_object_gperf_wordlist_foreach(_wordlist_cb_func_t func,
+					     void *context);
 
 static size_t obj_size_get(enum k_objects otype)
 {
@@ -201,44 +246,338 @@ static size_t obj_align_get(enum k_objects otype)
 	return ret;
 }
 
-static bool node_lessthan(struct rbnode *a, struct rbnode *b)
+static inline size_t dyn_hash(const struct dyn_obj *dyn, uint8_t bits)
+{
+	uint64_t key = (uintptr_t)dyn;
+
+	/* Fibonacci hashing, the top bits of the product depend on all
+	 * bits of the address
+	 */
+	return ((uint32_t)(key ^ (key >> 32)) * 2654435769U) >> (32U - bits);
+}
+
+static void dyn_reclaim(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&lists_lock);
+	sys_dnode_t *dnode;
+	sys_snode_t *snode;
+
+	/* A reader may have arrived since we left */
+	if (atomic_get(&dyn_readers) == 0) {
+		while ((dnode = sys_dlist_get(&dead_objs)) != NULL) {
+			k_free(CONTAINER_OF(dnode, struct dyn_obj, dobj_list));
+		}
+
+		while ((snode = sys_slist_get(&dead_tables)) != NULL) {
+			k_free(CONTAINER_OF(snode, struct dyn_table, node));
+		}
+	}
+	k_spin_unlock(&lists_lock, key);
+}
+
+static inline void dyn_reader_enter(void)
 {
-	return a < b;
+	atomic_inc(&dyn_readers);
 }
 
-static inline struct dyn_obj *node_to_dyn_obj(struct rbnode *node)
+static inline void dyn_reader_exit(void)
 {
-	return CONTAINER_OF(node, struct dyn_obj, node);
+	/* Unlocked peek, the next reader to leave gets anything missed */
+	if ((atomic_dec(&dyn_readers) == 1) &&
+	    (!sys_dlist_is_empty(&dead_objs) ||
+	     !sys_slist_is_empty(&dead_tables))) {
+		dyn_reclaim();
+	}
 }
 
-static inline struct rbnode *dyn_obj_to_node(void *obj)
+static struct dyn_obj *dyn_table_lookup(struct dyn_obj *dyn)
 {
-	struct dyn_obj *dobj = CONTAINER_OF(obj, struct dyn_obj, data);
+	struct dyn_table *table = atomic_ptr_get(&dyn_table);
+	struct dyn_obj *node;
+
+	if (table == NULL) {
+		return NULL;
+	}
 
-	return &dobj->node;
+	/* Only compare addresses, dyn is not known to be valid yet */
+	node = atomic_ptr_get(&table->buckets[dyn_hash(dyn, table->bits)]);
+	while ((node != NULL) && (node != dyn)) {
+		node = atomic_ptr_get(&node->hash_next);
+	}
+
+	return node;
 }
 
 static struct dyn_obj *dyn_object_find(void *obj)
 {
-	struct rbnode *node;
 	struct dyn_obj *ret;
+	atomic_val_t seq;
 
 	/* For any dynamically allocated kernel object, the object
 	 * pointer is just a member of the containing struct dyn_obj,
 	 * so just a little arithmetic is necessary to locate the
-	 * corresponding struct rbnode
+	 * corresponding hash table entry
 	 */
-	node = dyn_obj_to_node(obj);
+	struct dyn_obj *dyn = CONTAINER_OF(obj, struct dyn_obj, data);
 
-	k_spinlock_key_t key = k_spin_lock(&lists_lock);
-	if (rb_contains(&obj_rb_tree, node)) {
-		ret = node_to_dyn_obj(node);
+	dyn_reader_enter();
+	do {
+		seq = atomic_get(&dyn_table_seq);
+		ret = dyn_table_lookup(dyn);
+	} while ((ret == NULL) &&
+		 (((seq & 1) != 0) || (seq != atomic_get(&dyn_table_seq))));
+	dyn_reader_exit();
+
+	return ret;
+}
+
+/* The hash table and the permission links are kernel bookkeeping, taken
+ * from the system heap so that they are neither charged to nor limited
+ * by the resource pool of whichever thread happens to allocate an object
+ * or grant a permission. Without a system heap the caller's pool is the
+ * only one there is.
+ */
+static void *dyn_meta_alloc(size_t size)
+{
+#if (CONFIG_HEAP_MEM_POOL_SIZE > 0)
+	return k_malloc(size);
+#else
+	return z_thread_malloc(size);
+#endif
+}
+
+/* Must be called with lists_lock held */
+static void dyn_free_deferred(struct dyn_obj *dyn, struct dyn_table *table)
+{
+	if (atomic_get(&dyn_readers) == 0) {
+		k_free(dyn);
+		k_free(table);
 	} else {
-		ret = NULL;
+		if (dyn != NULL) {
+			sys_dlist_append(&dead_objs, &dyn->dobj_list);
+		}
+		if (table != NULL) {
+			sys_slist_append(&dead_tables, &table->node);
+		}
+	}
+}
+
+/* Must be called with lists_lock held */
+static void dyn_table_grow(void)
+{
+	struct dyn_table *old = atomic_ptr_get(&dyn_table);
+	struct dyn_table *new;
+	struct dyn_obj *node;
+	uint8_t bits;
+	size_t h;
+
+	bits = (old == NULL) ? DYN_TABLE_MIN_BITS : (old->bits + 1U);
+	if (bits > 31U) {
+		return;
+	}
+
+	new = dyn_meta_alloc(sizeof(*new) + BIT(bits) * sizeof(atomic_ptr_t));
+	if (new == NULL) {
+		/* Keep using the old table, with longer chains */
+		return;
+	}
+	(void)memset(new, 0, sizeof(*new) + BIT(bits) * sizeof(atomic_ptr_t));
+	new->bits = bits;
+
+	if (old == NULL) {
+		atomic_ptr_set(&dyn_table, new);
+		return;
+	}
+
+	atomic_inc(&dyn_table_seq);
+	for (size_t i = 0; i < BIT(old->bits); i++) {
+		while ((node = atomic_ptr_get(&old->buckets[i])) != NULL) {
+			h = dyn_hash(node, bits);
+			atomic_ptr_set(&old->buckets[i],
+				       atomic_ptr_get(&node->hash_next));
+			atomic_ptr_set(&node->hash_next,
+				       atomic_ptr_get(&new->buckets[h]));
+			atomic_ptr_set(&new->buckets[h], node);
+		}
+	}
+	atomic_ptr_set(&dyn_table, new);
+	atomic_inc(&dyn_table_seq);
+
+	dyn_free_deferred(NULL, old);
+}
+
+/* Must be called with obj_lock held */
+static bool dyn_obj_link(struct dyn_obj *dyn)
+{
+	k_spinlock_key_t key = k_spin_lock(&lists_lock);
+	struct dyn_table *table = atomic_ptr_get(&dyn_table);
+	atomic_ptr_t *bucket;
+
+	if ((table == NULL) || (dyn_count >= BIT(table->bits))) {
+		dyn_table_grow();
+		table = atomic_ptr_get(&dyn_table);
+	}
+
+	if (table != NULL) {
+		bucket = &table->buckets[dyn_hash(dyn, table->bits)];
+		atomic_ptr_set(&dyn->hash_next, atomic_ptr_get(bucket));
+		atomic_ptr_set(bucket, dyn);
+		dyn_count++;
+		sys_dlist_append(&obj_list, &dyn->dobj_list);
 	}
 	k_spin_unlock(&lists_lock, key);
 
-	return ret;
+	return table != NULL;
+}
+
+static void perm_links_drop(struct dyn_obj *dyn);
+
+/* Must be called with obj_lock held, the object is freed once no reader
+ * can see it anymore
+ */
+static void dyn_obj_unlink_free(struct dyn_obj *dyn)
+{
+	struct dyn_table *table;
+	struct dyn_obj *node;
+	atomic_ptr_t *prev;
+	k_spinlock_key_t key;
+
+	perm_links_drop(dyn);
+
+	key = k_spin_lock(&lists_lock);
+	table = atomic_ptr_get(&dyn_table);
+	prev = &table->buckets[dyn_hash(dyn, table->bits)];
+	while ((node = atomic_ptr_get(prev)) != dyn) {
+		__ASSERT_NO_MSG(node != NULL);
+		prev = &node->hash_next;
+	}
+	atomic_ptr_set(prev, atomic_ptr_get(&dyn->hash_next));
+	dyn_count--;
+	sys_dlist_remove(&dyn->dobj_list);
+
+	dyn_free_deferred(dyn, NULL);
+	k_spin_unlock(&lists_lock, key);
+}
+
+static int perm_lists_init(const struct device *unused)
+{
+	ARG_UNUSED(unused);
+
+	for (int i = 0; i < MAX_THREAD_BITS; i++) {
+		sys_dlist_init(&perm_lists[i]);
+	}
+
+	return 0;
+}
+
+SYS_INIT(perm_lists_init, PRE_KERNEL_1, CONFIG_KERNEL_INIT_PRIORITY_OBJECTS);
+
+/* Must be called with obj_lock held */
+static void perm_link_add(struct dyn_obj *dyn, uintptr_t index)
+{
+	struct perm_link *link = dyn_meta_alloc(sizeof(*link));
+
+	if (link == NULL) {
+		sys_bitfield_set_bit((mem_addr_t)perm_overflow, index);
+		return;
+	}
+
+	link->dyn = dyn;
+	link->index = index;
+	sys_slist_prepend(&dyn->perm_links, &link->obj_node);
+	sys_dlist_append(&perm_lists[index], &link->thread_node);
+}
+
+/* Must be called with obj_lock held */
+static void perm_link_remove(struct dyn_obj *dyn, uintptr_t index)
+{
+	struct perm_link *link;
+	sys_snode_t *prev = NULL;
+
+	SYS_SLIST_FOR_EACH_CONTAINER(&dyn->perm_links, link, obj_node) {
+		if (link->index == index) {
+			sys_slist_remove(&dyn->perm_links, prev,
+					 &link->obj_node);
+			sys_dlist_remove(&link->thread_node);
+			k_free(link);
+			break;
+		}
+		prev = &link->obj_node;
+	}
+}
+
+/* Must be called with obj_lock held */
+static void perm_links_drop(struct dyn_obj *dyn)
+{
+	struct perm_link *link;
+	sys_snode_t *node;
+
+	while ((node = sys_slist_get(&dyn->perm_links)) != NULL) {
+		link = CONTAINER_OF(node, struct perm_link, obj_node);
+		sys_dlist_remove(&link->thread_node);
+		k_free(link);
+	}
+}
+
+/* Must be called with obj_lock held */
+static void dyn_perms_set(struct dyn_obj *dyn, uintptr_t index)
+{
+	if (!sys_bitfield_test_bit((mem_addr_t)&dyn->kobj.perms, index)) {
+		sys_bitfield_set_bit((mem_addr_t)&dyn->kobj.perms, index);
+		perm_link_add(dyn, index);
+	}
+}
+
+static void unref_check_locked(struct z_object *ko, uintptr_t index);
+
+/* Must be called with obj_lock held */
+static void dyn_perms_clear(uintptr_t index)
+{
+	struct dyn_obj *dyn, *next;
+	struct perm_link *link;
+	sys_dnode_t *node;
+
+	/* Each pass drops the link at the head of the list */
+	while ((node = sys_dlist_peek_head(&perm_lists[index])) != NULL) {
+		link = CONTAINER_OF(node, struct perm_link, thread_node);
+		unref_check_locked(&link->dyn->kobj, index);
+	}
+
+	if (sys_bitfield_test_bit((mem_addr_t)perm_overflow, index)) {
+		SYS_DLIST_FOR_EACH_CONTAINER_SAFE(&obj_list, dyn, next,
+						  dobj_list) {
+			if (sys_bitfield_test_bit((mem_addr_t)&dyn->kobj.perms,
+						  index)) {
+				unref_check_locked(&dyn->kobj, index);
+			}
+		}
+		sys_bitfield_clear_bit((mem_addr_t)perm_overflow, index);
+	}
+}
+
+/* Must be called with obj_lock held */
+static void dyn_perms_inherit(struct perm_ctx *ctx)
+{
+	struct perm_link *link;
+	struct dyn_obj *dyn;
+
+	if (sys_bitfield_test_bit((mem_addr_t)perm_overflow, ctx->parent_id)) {
+		SYS_DLIST_FOR_EACH_CONTAINER(&obj_list, dyn, dobj_list) {
+			if (sys_bitfield_test_bit((mem_addr_t)&dyn->kobj.perms,
+						  ctx->parent_id) &&
+			    (struct k_thread *)dyn->kobj.name != ctx->parent) {
+				dyn_perms_set(dyn, ctx->child_id);
+			}
+		}
+		return;
+	}
+
+	SYS_DLIST_FOR_EACH_CONTAINER(&perm_lists[ctx->parent_id], link,
+				     thread_node) {
+		if ((struct k_thread *)link->dyn->kobj.name != ctx->parent) {
+			dyn_perms_set(link->dyn, ctx->child_id);
+		}
+	}
 }
 
 /**
@@ -274,8 +613,7 @@ static bool thread_idx_alloc(uintptr_t *tidx)
 					       *tidx);
 
 			/* Clear permission from all objects */
-			z_object_wordlist_foreach(clear_perms_cb,
-						   (void *)*tidx);
+			perms_index_clear(*tidx);
 
 			return true;
 		}
@@ -299,7 +637,7 @@ static bool thread_idx_alloc(uintptr_t *tidx)
 static void thread_idx_free(uintptr_t tidx)
 {
 	/* To prevent leaked permission when index is recycled */
-	z_object_wordlist_foreach(clear_perms_cb, (void *)tidx);
+	perms_index_clear(tidx);
 
 	sys_bitfield_set_bit((mem_addr_t)_thread_idx_map, tidx);
 }
@@ -307,6 +645,8 @@ static void thread_idx_free(uintptr_t tidx)
 struct z_object *z_dynamic_object_aligned_create(size_t align, size_t size)
 {
 	struct dyn_obj *dyn;
+	k_spinlock_key_t key;
+	bool linked;
 
 	dyn = z_thread_aligned_alloc(align, sizeof(*dyn) + size);
 	if (dyn == NULL) {
@@ -316,14 +656,19 @@ struct z_object *z_dynamic_object_aligned_create(size_t align, size_t size)
 
 	dyn->kobj.name = &dyn->data;
 	dyn->kobj.type = K_OBJ_ANY;
-	dyn->kobj.flags = 0;
+	dyn->kobj.flags = K_OBJ_FLAG_DYNAMIC;
 	(void)memset(dyn->kobj.perms, 0, CONFIG_MAX_THREAD_BYTES);
+	sys_slist_init(&dyn->perm_links);
 
-	k_spinlock_key_t key = k_spin_lock(&lists_lock);
+	key = k_spin_lock(&obj_lock);
+	linked = dyn_obj_link(dyn);
+	k_spin_unlock(&obj_lock, key);
 
-	rb_insert(&obj_rb_tree, &dyn->node);
-	sys_dlist_append(&obj_list, &dyn->dobj_list);
-	k_spin_unlock(&lists_lock, key);
+	if (!linked) {
+		LOG_ERR("could not allocate object table, out of memory");
+		k_free(dyn);
+		return NULL;
+	}
 
 	return &dyn->kobj;
 }
@@ -391,21 +736,23 @@ void k_object_free(void *obj)
 	 * being used by some other thread
 	 */
 
-	k_spinlock_key_t key = k_spin_lock(&objfree_lock);
+	k_spinlock_key_t key = k_spin_lock(&obj_lock);
+	bool is_thread = false;
+	uintptr_t tidx = 0;
 
 	dyn = dyn_object_find(obj);
 	if (dyn != NULL) {
-		rb_remove(&obj_rb_tree, &dyn->node);
-		sys_dlist_remove(&dyn->dobj_list);
-
 		if (dyn->kobj.type == K_OBJ_THREAD) {
-			thread_idx_free(dyn->kobj.data.thread_id);
+			is_thread = true;
+			tidx = dyn->kobj.data.thread_id;
 		}
+
+		dyn_obj_unlink_free(dyn);
 	}
-	k_spin_unlock(&objfree_lock, key);
+	k_spin_unlock(&obj_lock, key);
 
-	if (dyn != NULL) {
-		k_free(dyn);
+	if (is_thread) {
+		thread_idx_free(tidx);
 	}
 }
 
@@ -459,23 +806,28 @@ static unsigned int thread_index_get(struct k_thread *thread)
 	return ko->data.thread_id;
 }
 
-static void unref_check(struct z_object *ko, uintptr_t index)
+/* Must be called with obj_lock held */
+static void unref_check_locked(struct z_object *ko, uintptr_t index)
 {
-	k_spinlock_key_t key = k_spin_lock(&obj_lock);
-
 	sys_bitfield_clear_bit((mem_addr_t)&ko->perms, index);
 
 #ifdef CONFIG_DYNAMIC_OBJECTS
 	struct dyn_obj *dyn =
 			CONTAINER_OF(ko, struct dyn_obj, kobj);
 
+	if ((ko->flags & K_OBJ_FLAG_DYNAMIC) == 0U) {
+		return;
+	}
+
+	perm_link_remove(dyn, index);
+
 	if ((ko->flags & K_OBJ_FLAG_ALLOC) == 0U) {
-		goto out;
+		return;
 	}
 
 	for (int i = 0; i < CONFIG_MAX_THREAD_BYTES; i++) {
 		if (ko->perms[i] != 0U) {
-			goto out;
+			return;
 		}
 	}
 
@@ -499,14 +851,30 @@ static void unref_check(struct z_object *ko, uintptr_t index)
 		break;
 	}
 
-	rb_remove(&obj_rb_tree, &dyn->node);
-	sys_dlist_remove(&dyn->dobj_list);
-	k_free(dyn);
-out:
+	dyn_obj_unlink_free(dyn);
 #endif
+}
+
+static void unref_check(struct z_object *ko, uintptr_t index)
+{
+	k_spinlock_key_t key = k_spin_lock(&obj_lock);
+
+	unref_check_locked(ko, index);
 	k_spin_unlock(&obj_lock, key);
 }
 
+/* Dynamic objects are visited through the per-thread permission index
+ * instead, see perm_link
+ */
+static void static_objects_foreach(_wordlist_cb_func_t func, void *context)
+{
+#ifdef CONFIG_DYNAMIC_OBJECTS
+	z_object_gperf_wordlist_foreach(func, context);
+#else
+	z_object_wordlist_foreach(func, context);
+#endif
+}
+
 static void wordlist_cb(struct z_object *ko, void *ctx_ptr)
 {
 	struct perm_ctx *ctx = (struct perm_ctx *)ctx_ptr;
@@ -526,7 +894,13 @@ void z_thread_perms_inherit(struct k_thread *parent, struct k_thread *child)
 	};
 
 	if ((ctx.parent_id != -1) && (ctx.child_id != -1)) {
-		z_object_wordlist_foreach(wordlist_cb, &ctx);
+		static_objects_foreach(wordlist_cb, &ctx);
+#ifdef CONFIG_DYNAMIC_OBJECTS
+		k_spinlock_key_t key = k_spin_lock(&obj_lock);
+
+		dyn_perms_inherit(&ctx);
+		k_spin_unlock(&obj_lock, key);
+#endif
 	}
 }
 
@@ -534,9 +908,20 @@ void z_thread_perms_set(struct z_object *ko, struct k_thread *thread)
 {
 	int index = thread_index_get(thread);
 
-	if (index != -1) {
-		sys_bitfield_set_bit((mem_addr_t)&ko->perms, index);
+	if (index == -1) {
+		return;
+	}
+
+#ifdef CONFIG_DYNAMIC_OBJECTS
+	if ((ko->flags & K_OBJ_FLAG_DYNAMIC) != 0U) {
+		k_spinlock_key_t key = k_spin_lock(&obj_lock);
+
+		dyn_perms_set(CONTAINER_OF(ko, struct dyn_obj, kobj), index);
+		k_spin_unlock(&obj_lock, key);
+		return;
 	}
+#endif
+	sys_bitfield_set_bit((mem_addr_t)&ko->perms, index);
 }
 
 void z_thread_perms_clear(struct z_object *ko, struct k_thread *thread)
@@ -544,7 +929,6 @@ void z_thread_perms_clear(struct z_object *ko, struct k_thread *thread)
 	int index = thread_index_get(thread);
 
 	if (index != -1) {
-		sys_bitfield_clear_bit((mem_addr_t)&ko->perms, index);
 		unref_check(ko, index);
 	}
 }
@@ -556,12 +940,23 @@ static void clear_perms_cb(struct z_object *ko, void *ctx_ptr)
 	unref_check(ko, id);
 }
 
+static void perms_index_clear(uintptr_t index)
+{
+	static_objects_foreach(clear_perms_cb, (void *)index);
+#ifdef CONFIG_DYNAMIC_OBJECTS
+	k_spinlock_key_t key = k_spin_lock(&obj_lock);
+
+	dyn_perms_clear(index);
+	k_spin_unlock(&obj_lock, key);
+#endif
+}
+
 void z_thread_perms_all_clear(struct k_thread *thread)
 {
 	uintptr_t index = thread_index_get(thread);
 
 	if ((int)index != -1) {
-		z_object_wordlist_foreach(clear_perms_cb, (void *)index);
+		perms_index_clear(index);
 	}
 }
 
@@ -712,7 +1107,16 @@ void z_object_recycle(const void *obj)
 	struct z_object *ko = z_object_find(obj);
 
 	if (ko != NULL) {
+		k_spinlock_key_t key = k_spin_lock(&obj_lock);
+
+#ifdef CONFIG_DYNAMIC_OBJECTS
+		if ((ko->flags & K_OBJ_FLAG_DYNAMIC) != 0U) {
+			perm_links_drop(CONTAINER_OF(ko, struct dyn_obj, kobj));
+		}
+#endif
 		(void)memset(ko->perms, 0, sizeof(ko->perms));
+		k_spin_unlock(&obj_lock, key);
+
 		z_thread_perms_set(ko, k_current_get());
 		ko->flags |= K_OBJ_FLAG_INITIALIZED;
 	}
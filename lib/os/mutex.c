@@ -8,6 +8,15 @@
 #include <sys/mutex.h>
 #include <syscall_handler.h>
 #include <kernel_structs.h>
+#include <ksched.h>
+#include <wait_q.h>
+
+#ifdef CONFIG_SYS_MUTEX_FAST
+/* Serializes the contended paths of all sys_mutexes, which may also
+ * change thread priorities.
+ */
+static struct k_spinlock lock;
+#endif
 
 static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 {
@@ -23,13 +32,242 @@ static struct k_mutex *get_k_mutex(struct sys_mutex *mutex)
 
 static bool check_sys_mutex_addr(struct sys_mutex *addr)
 {
-	/* sys_mutex memory is never touched, just used to lookup the
-	 * underlying k_mutex, but we don't want threads using mutexes
-	 * that are outside their memory domain
+	/* sys_mutex memory is used to lookup the underlying k_mutex, and
+	 * with the fast path holds the owner, but we don't want threads
+	 * using mutexes that are outside their memory domain
 	 */
 	return Z_SYSCALL_MEMORY_WRITE(addr, sizeof(struct sys_mutex));
 }
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+/*
+ * With the fast path the mutex value, in user memory, is the only record
+ * of the owner. The kernel is only involved once a thread has to wait:
+ * it sets Z_SYS_MUTEX_WAITERS, so that the owner's unlock fails its
+ * atomic exchange and comes here, and pends on the wait queue of the
+ * backing k_mutex, whose owner fields are used for priority inheritance.
+ * Unlocking hands the mutex over to the highest priority waiter.
+ */
+
+static struct k_thread *value_owner(atomic_val_t val)
+{
+	return (struct k_thread *)(val & ~Z_SYS_MUTEX_WAITERS);
+}
+
+#ifdef CONFIG_SYS_MUTEX_PRIORITY_INHERITANCE
+/* The owner is read from user memory, where any thread of the domain can
+ * write the address of any other thread. A user thread only raises the
+ * priority of, and records as the owner, a live thread it has permission
+ * on, or a user thread of its own memory domain, which could take the
+ * mutex anyway. Returns -EINVAL if the owner is not a live thread, and
+ * -EPERM if the caller may not touch it, in which case the caller waits
+ * without inheritance.
+ */
+static int owner_check(struct k_thread *owner)
+{
+	struct z_object *ko = z_object_find(owner);
+
+	if (ko == NULL || ko->type != K_OBJ_THREAD ||
+	    (ko->flags & K_OBJ_FLAG_INITIALIZED) == 0U) {
+		return -EINVAL;
+	}
+
+	if (!z_is_in_user_syscall()) {
+		return 0;
+	}
+
+	if ((owner->base.user_options & K_USER) != 0U &&
+	    owner->mem_domain_info.mem_domain ==
+	    _current->mem_domain_info.mem_domain) {
+		return 0;
+	}
+
+	return z_object_validate(ko, K_OBJ_THREAD, _OBJ_INIT_TRUE) == 0 ?
+	       0 : -EPERM;
+}
+
+static bool adjust_owner_prio(struct k_mutex *kernel_mutex, int new_prio)
+{
+	if (kernel_mutex->owner->base.prio != new_prio) {
+		return z_set_prio(kernel_mutex->owner, new_prio);
+	}
+
+	return false;
+}
+
+static int prio_for_inheritance(int target, int limit)
+{
+	int new_prio = z_is_prio_higher(target, limit) ? target : limit;
+
+	return z_get_new_prio_with_ceiling(new_prio);
+}
+#endif
+
+static int fast_mutex_lock(struct sys_mutex *mutex,
+			   struct k_mutex *kernel_mutex, k_timeout_t timeout)
+{
+	atomic_val_t self = (atomic_val_t)_current;
+	k_spinlock_key_t key;
+	struct k_thread *owner;
+	atomic_val_t val;
+	bool resched = false;
+	int ret;
+
+	key = k_spin_lock(&lock);
+
+	for (;;) {
+		val = atomic_get(&mutex->val);
+		if (val == 0) {
+			if (atomic_cas(&mutex->val, 0, self)) {
+				mutex->count = 1U;
+				k_spin_unlock(&lock, key);
+				return 0;
+			}
+
+			continue;
+		}
+
+		owner = value_owner(val);
+		if (owner == _current) {
+			mutex->count++;
+			k_spin_unlock(&lock, key);
+			return 0;
+		}
+
+		if (K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+			k_spin_unlock(&lock, key);
+			return -EBUSY;
+		}
+
+		/* The owner may unlock concurrently, retry if it did */
+		if ((val & Z_SYS_MUTEX_WAITERS) != 0U ||
+		    atomic_cas(&mutex->val, val, val | Z_SYS_MUTEX_WAITERS)) {
+			break;
+		}
+	}
+
+#ifdef CONFIG_SYS_MUTEX_PRIORITY_INHERITANCE
+	ret = owner_check(owner);
+	if (ret == -EINVAL) {
+		k_spin_unlock(&lock, key);
+		return -EINVAL;
+	}
+
+	/* Earlier waiters may not have been allowed to record the owner */
+	if (ret == 0 && kernel_mutex->owner == NULL) {
+		kernel_mutex->owner = owner;
+		kernel_mutex->owner_orig_prio = owner->base.prio;
+	}
+
+	if (kernel_mutex->owner != NULL) {
+		owner = kernel_mutex->owner;
+		ret = prio_for_inheritance(_current->base.prio,
+					   owner->base.prio);
+		if (z_is_prio_higher(ret, owner->base.prio)) {
+			resched = adjust_owner_prio(kernel_mutex, ret);
+		}
+	}
+#endif
+
+	ret = z_pend_curr(&lock, key, &kernel_mutex->wait_q, timeout);
+	if (ret == 0) {
+		/* The mutex was handed over */
+		mutex->count = 1U;
+		return 0;
+	}
+
+	key = k_spin_lock(&lock);
+
+#ifdef CONFIG_SYS_MUTEX_PRIORITY_INHERITANCE
+	if (kernel_mutex->owner != NULL) {
+		struct k_thread *waiter = z_waitq_head(&kernel_mutex->wait_q);
+		int new_prio;
+
+		new_prio = (waiter != NULL) ?
+			prio_for_inheritance(waiter->base.prio,
+					     kernel_mutex->owner_orig_prio) :
+			kernel_mutex->owner_orig_prio;
+
+		resched = adjust_owner_prio(kernel_mutex, new_prio) || resched;
+
+		if (waiter == NULL) {
+			kernel_mutex->owner = NULL;
+		}
+	}
+#endif
+
+	/* Z_SYS_MUTEX_WAITERS may stay set without waiters, which only
+	 * sends the owner's unlock to the kernel.
+	 */
+	if (resched) {
+		z_reschedule(&lock, key);
+	} else {
+		k_spin_unlock(&lock, key);
+	}
+
+	return -EAGAIN;
+}
+
+static int fast_mutex_unlock(struct sys_mutex *mutex,
+			     struct k_mutex *kernel_mutex)
+{
+	struct k_thread *new_owner;
+	k_spinlock_key_t key;
+	atomic_val_t val;
+
+	key = k_spin_lock(&lock);
+
+	val = atomic_get(&mutex->val);
+	if (value_owner(val) != _current) {
+		k_spin_unlock(&lock, key);
+		return val == 0 ? -EINVAL : -EPERM;
+	}
+
+	if (mutex->count > 1U) {
+		mutex->count--;
+		k_spin_unlock(&lock, key);
+		return 0;
+	}
+
+	mutex->count = 0U;
+
+#ifdef CONFIG_SYS_MUTEX_PRIORITY_INHERITANCE
+	/* Only set while threads wait, see fast_mutex_lock() */
+	if (kernel_mutex->owner == _current) {
+		adjust_owner_prio(kernel_mutex, kernel_mutex->owner_orig_prio);
+	}
+#endif
+
+	kernel_mutex->owner = NULL;
+
+	new_owner = z_unpend_first_thread(&kernel_mutex->wait_q);
+	if (new_owner == NULL) {
+		atomic_clear(&mutex->val);
+		z_reschedule(&lock, key);
+		return 0;
+	}
+
+	val = (atomic_val_t)new_owner;
+
+	/* The new owner is the highest priority waiter, so the remaining
+	 * ones do not raise its priority.
+	 */
+	if (z_waitq_head(&kernel_mutex->wait_q) != NULL) {
+		val |= Z_SYS_MUTEX_WAITERS;
+		kernel_mutex->owner = new_owner;
+		kernel_mutex->owner_orig_prio = new_owner->base.prio;
+	}
+
+	atomic_set(&mutex->val, val);
+
+	arch_thread_return_value_set(new_owner, 0);
+	z_ready_thread(new_owner);
+	z_reschedule(&lock, key);
+
+	return 0;
+}
+#endif /* CONFIG_SYS_MUTEX_FAST */
+
 int z_impl_z_sys_mutex_kernel_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 {
 	struct k_mutex *kernel_mutex = get_k_mutex(mutex);
@@ -38,7 +276,11 @@ int z_impl_z_sys_mutex_kernel_lock(struct sys_mutex *mutex, k_timeout_t timeout)
 		return -EINVAL;
 	}
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+	return fast_mutex_lock(mutex, kernel_mutex, timeout);
+#else
 	return k_mutex_lock(kernel_mutex, timeout);
+#endif
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_lock(struct sys_mutex *mutex,
@@ -56,11 +298,19 @@ int z_impl_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
 {
 	struct k_mutex *kernel_mutex = get_k_mutex(mutex);
 
+#ifdef CONFIG_SYS_MUTEX_FAST
+	if (kernel_mutex == NULL) {
+		return -EINVAL;
+	}
+
+	return fast_mutex_unlock(mutex, kernel_mutex);
+#else
 	if (kernel_mutex == NULL || kernel_mutex->lock_count == 0) {
 		return -EINVAL;
 	}
 
 	return k_mutex_unlock(kernel_mutex);
+#endif
 }
 
 static inline int z_vrfy_z_sys_mutex_kernel_unlock(struct sys_mutex *mutex)
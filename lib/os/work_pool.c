@@ -0,0 +1,394 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <kernel.h>
+#include <kernel_structs.h>
+#include <sys/work_pool.h>
+#include <init.h>
+#include <string.h>
+
+#define DEQUE_MASK (CONFIG_WORK_POOL_DEQUE_SIZE - 1)
+
+BUILD_ASSERT((CONFIG_WORK_POOL_DEQUE_SIZE & DEQUE_MASK) == 0,
+	     "CONFIG_WORK_POOL_DEQUE_SIZE must be a power of two");
+
+/* Task states, a joining thread that is not a worker sets WAITING
+ * and sleeps on the done semaphore
+ */
+#define TASK_QUEUED 0
+#define TASK_WAITING 1
+#define TASK_DONE 2
+
+struct range_spec {
+	k_work_pool_range_fn_t fn;
+	void *arg;
+	size_t grain;
+};
+
+struct range_task {
+	struct k_work_pool_task task;
+	struct k_work_pool *pool;
+	const struct range_spec *spec;
+	size_t begin;
+	size_t end;
+};
+
+static void range_handler(struct k_work_pool_task *task);
+
+/*
+ * Chase-Lev work-stealing deque.  Only the owning worker moves the
+ * bottom index, pushing and popping tasks there, while thieves take
+ * tasks from the top with a compare-and-swap.  The owner competes with
+ * the thieves through the same compare-and-swap only for the last task.
+ * Indexes only ever increase and are compared by their difference, so
+ * that they can wrap around.
+ */
+
+static long deque_len(unsigned long top, unsigned long bottom)
+{
+	return (long)(bottom - top);
+}
+
+static bool deque_push(struct k_work_pool_worker *w,
+		       struct k_work_pool_task *task)
+{
+	unsigned long b = atomic_get(&w->bottom);
+	unsigned long t = atomic_get(&w->top);
+
+	if (deque_len(t, b) >= CONFIG_WORK_POOL_DEQUE_SIZE) {
+		return false;
+	}
+
+	atomic_ptr_set(&w->tasks[b & DEQUE_MASK], task);
+	atomic_set(&w->bottom, b + 1);
+
+	return true;
+}
+
+static struct k_work_pool_task *deque_pop(struct k_work_pool_worker *w)
+{
+	unsigned long b = atomic_get(&w->bottom);
+	unsigned long t = atomic_get(&w->top);
+	struct k_work_pool_task *task;
+
+	/* Only thieves can change the top, and only to empty the deque */
+	if (deque_len(t, b) <= 0) {
+		return NULL;
+	}
+
+	/* Claim the bottom task before checking for thieves */
+	atomic_set(&w->bottom, --b);
+	t = atomic_get(&w->top);
+
+	if (deque_len(t, b) < 0) {
+		/* Stolen meanwhile */
+		atomic_set(&w->bottom, b + 1);
+		return NULL;
+	}
+
+	task = atomic_ptr_get(&w->tasks[b & DEQUE_MASK]);
+
+	if (deque_len(t, b) == 0) {
+		/* Last task, race thieves for it */
+		if (!atomic_cas(&w->top, t, t + 1)) {
+			task = NULL;
+		}
+
+		atomic_set(&w->bottom, b + 1);
+	}
+
+	return task;
+}
+
+static struct k_work_pool_task *deque_steal(struct k_work_pool_worker *w)
+{
+	unsigned long t = atomic_get(&w->top);
+	unsigned long b = atomic_get(&w->bottom);
+	struct k_work_pool_task *task;
+
+	if (deque_len(t, b) <= 0) {
+		return NULL;
+	}
+
+	task = atomic_ptr_get(&w->tasks[t & DEQUE_MASK]);
+
+	return atomic_cas(&w->top, t, t + 1) ? task : NULL;
+}
+
+static struct k_work_pool_worker *current_worker(struct k_work_pool *pool)
+{
+	for (uint32_t i = 0; i < pool->num_workers; i++) {
+		if (&pool->workers[i].thread == _current) {
+			return &pool->workers[i];
+		}
+	}
+
+	return NULL;
+}
+
+static struct k_work_pool_task *steal(struct k_work_pool *pool,
+				      struct k_work_pool_worker *self)
+{
+	struct k_work_pool_task *task;
+	uint32_t n = pool->num_workers;
+	uint32_t start;
+
+	/* Start at a random victim so thieves spread out (xorshift32) */
+	self->rand ^= self->rand << 13;
+	self->rand ^= self->rand >> 17;
+	self->rand ^= self->rand << 5;
+	start = self->rand % n;
+
+	for (uint32_t i = 0; i < n; i++) {
+		struct k_work_pool_worker *victim =
+			&pool->workers[(start + i) % n];
+
+		if (victim == self) {
+			continue;
+		}
+
+		task = deque_steal(victim);
+		if (task != NULL) {
+			return task;
+		}
+	}
+
+	return NULL;
+}
+
+static struct k_work_pool_task *take_injected(struct k_work_pool *pool)
+{
+	k_spinlock_key_t key;
+	sys_snode_t *node;
+
+	/* Unlocked peek, submitters wake idle workers after queueing */
+	if (sys_slist_is_empty(&pool->injected)) {
+		return NULL;
+	}
+
+	key = k_spin_lock(&pool->lock);
+	node = sys_slist_get(&pool->injected);
+	k_spin_unlock(&pool->lock, key);
+
+	return node == NULL ? NULL :
+		CONTAINER_OF(node, struct k_work_pool_task, node);
+}
+
+static struct k_work_pool_task *find_task(struct k_work_pool *pool,
+					  struct k_work_pool_worker *self)
+{
+	struct k_work_pool_task *task;
+
+	task = deque_pop(self);
+	if (task == NULL) {
+		task = take_injected(pool);
+	}
+
+	if (task == NULL) {
+		task = steal(pool, self);
+	}
+
+	return task;
+}
+
+static void run_task(struct k_work_pool_task *task)
+{
+	task->handler(task);
+
+	/* The task may be reused as soon as it is marked done, unless
+	 * someone sleeps waiting for it
+	 */
+	if (atomic_set(&task->state, TASK_DONE) == TASK_WAITING) {
+		k_sem_give(&task->done_sem);
+	}
+}
+
+static void notify_idle(struct k_work_pool *pool)
+{
+	if (atomic_get(&pool->idle) > 0) {
+		k_sem_give(&pool->wake);
+	}
+}
+
+static FUNC_NORETURN void worker_loop(void *p0, void *p1, void *p2)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	struct k_work_pool_worker *self = p0;
+	struct k_work_pool *pool = self->pool;
+	struct k_work_pool_task *task;
+
+	while (true) {
+		task = find_task(pool, self);
+		if (task == NULL) {
+			/* Look again once counted as idle, so a task
+			 * queued meanwhile either is found here or its
+			 * submitter sees us idle and wakes us up.
+			 */
+			atomic_inc(&pool->idle);
+			task = find_task(pool, self);
+			if (task == NULL) {
+				k_sem_take(&pool->wake, K_FOREVER);
+			}
+			atomic_dec(&pool->idle);
+		}
+
+		if (task != NULL) {
+			run_task(task);
+		}
+	}
+}
+
+void k_work_pool_init(struct k_work_pool *pool,
+		      struct k_work_pool_worker *workers,
+		      k_thread_stack_t *stacks, uint32_t num,
+		      size_t stack_size, int prio)
+{
+	__ASSERT_NO_MSG(num > 0U);
+
+	memset(pool, 0, sizeof(*pool));
+	sys_slist_init(&pool->injected);
+	k_sem_init(&pool->wake, 0, num);
+	pool->workers = workers;
+	pool->num_workers = num;
+
+	for (uint32_t i = 0; i < num; i++) {
+		struct k_work_pool_worker *w = &workers[i];
+
+		memset(w, 0, sizeof(*w));
+		w->pool = pool;
+		w->rand = i + 1U;
+
+		k_thread_create(&w->thread,
+				&stacks[K_THREAD_STACK_LEN(stack_size) * i],
+				stack_size, worker_loop, w, NULL, NULL,
+				prio, 0, K_FOREVER);
+
+#if defined(CONFIG_SMP) && defined(CONFIG_SCHED_CPU_MASK)
+		k_thread_cpu_mask_clear(&w->thread);
+		k_thread_cpu_mask_enable(&w->thread, i % CONFIG_MP_NUM_CPUS);
+#endif
+
+		k_thread_start(&w->thread);
+	}
+}
+
+static int static_init(const struct device *dev)
+{
+	ARG_UNUSED(dev);
+
+	STRUCT_SECTION_FOREACH(k_work_pool_initparam, pp) {
+		k_work_pool_init(pp->pool, pp->workers, pp->stacks, pp->num,
+				 pp->stack_size, pp->prio);
+	}
+
+	return 0;
+}
+
+SYS_INIT(static_init, APPLICATION, 99);
+
+void k_work_pool_submit(struct k_work_pool *pool,
+			struct k_work_pool_task *task)
+{
+	struct k_work_pool_worker *self = current_worker(pool);
+	k_spinlock_key_t key;
+
+	atomic_set(&task->state, TASK_QUEUED);
+
+	if (self == NULL || !deque_push(self, task)) {
+		key = k_spin_lock(&pool->lock);
+		sys_slist_append(&pool->injected, &task->node);
+		k_spin_unlock(&pool->lock, key);
+	}
+
+	notify_idle(pool);
+}
+
+void k_work_pool_join(struct k_work_pool *pool,
+		      struct k_work_pool_task *task)
+{
+	struct k_work_pool_worker *self = current_worker(pool);
+	struct k_work_pool_task *other;
+
+	if (self == NULL) {
+		k_sem_init(&task->done_sem, 0, 1);
+		if (atomic_cas(&task->state, TASK_QUEUED, TASK_WAITING)) {
+			k_sem_take(&task->done_sem, K_FOREVER);
+		}
+
+		return;
+	}
+
+	/* Usually the task is still on our own deque and runs right
+	 * away.  If it was stolen, help with other tasks meanwhile.
+	 */
+	while (atomic_get(&task->state) != TASK_DONE) {
+		other = find_task(pool, self);
+		if (other != NULL) {
+			run_task(other);
+		} else {
+			k_yield();
+		}
+	}
+}
+
+static void split_range(struct k_work_pool *pool,
+			const struct range_spec *spec,
+			size_t begin, size_t end)
+{
+	struct range_task child;
+
+	if (end - begin <= spec->grain) {
+		spec->fn(spec->arg, begin, end);
+		return;
+	}
+
+	child.task.handler = range_handler;
+	child.pool = pool;
+	child.spec = spec;
+	child.begin = begin + (end - begin) / 2;
+	child.end = end;
+
+	/* Offer the upper half to thieves, keep splitting the lower one */
+	k_work_pool_submit(pool, &child.task);
+	split_range(pool, spec, begin, child.begin);
+	k_work_pool_join(pool, &child.task);
+}
+
+static void range_handler(struct k_work_pool_task *task)
+{
+	struct range_task *r = CONTAINER_OF(task, struct range_task, task);
+
+	split_range(r->pool, r->spec, r->begin, r->end);
+}
+
+void k_work_pool_parallel_for(struct k_work_pool *pool, size_t begin,
+			      size_t end, size_t grain,
+			      k_work_pool_range_fn_t fn, void *arg)
+{
+	const struct range_spec spec = {
+		.fn = fn,
+		.arg = arg,
+		.grain = MAX(grain, 1),
+	};
+	struct range_task root = {
+		.task.handler = range_handler,
+		.pool = pool,
+		.spec = &spec,
+		.begin = begin,
+		.end = end,
+	};
+
+	if (begin >= end) {
+		return;
+	}
+
+	if (current_worker(pool) != NULL) {
+		split_range(pool, &spec, begin, end);
+	} else {
+		k_work_pool_submit(pool, &root.task);
+		k_work_pool_join(pool, &root.task);
+	}
+}
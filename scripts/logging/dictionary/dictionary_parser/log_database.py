@@ -166,6 +166,16 @@ class LogDatabase():
         return len(self.database['sections']) != 0
 
 
+    def get_string_section_start(self, name):
+        """Return the start address of a static string section, or None
+        if there is no such section"""
+        sect = self.database['sections'].get(name)
+        if sect is None:
+            return None
+
+        return sect['start']
+
+
     def find_string(self, string_ptr):
         """Find string pointed by string_ptr from any static string section.
         Return None if not found."""
@@ -40,9 +40,33 @@ LOG_LEVELS = [('none', Fore.WHITE), ('err', Fore.RED), ('wrn', Fore.YELLOW), ('i
 FMT_MSG_HDR_32 = "II"
 FMT_MSG_HDR_64 = "IQ"
 
+# Need to keep sync with struct log_dict_output_fmt_id_msg_hdr_t in
+# include/logging/log_output_dict.h.
+#
+# struct log_dict_output_fmt_id_msg_hdr_t {
+#     uint8_t type;
+#     uint32_t domain:3;
+#     uint32_t level:3;
+#     uint32_t package_len:10;
+#     uint32_t data_len:12;
+#     uint16_t source;
+#     uint32_t fmt_id;
+#     log_timestamp_t timestamp;
+#     uint8_t args_wlen;
+#     uint8_t str_cnt;
+# } __packed;
+#
+# Note "type", "timestamp" and the last two fields are encoded separately.
+FMT_FMT_ID_MSG_HDR = "IHI"
+FMT_FMT_ID_MSG_CNTS = "BB"
+
+# Section holding the format strings identified by fmt_id
+FMT_ID_SECTION = "log_strings_sections"
+
 # Message type
 # 0: normal message
 # 1: number of dropped messages
+# 2: message with format string identified by its offset in FMT_ID_SECTION
 FMT_MSG_TYPE = "B"
 
 # Depends on CONFIG_LOG_TIMESTAMP_64BIT
@@ -52,6 +76,7 @@ FMT_MSG_TIMESTAMP_64 = "Q"
 # Keep message types in sync with include/logging/log_output_dict.h
 MSG_TYPE_NORMAL = 0
 MSG_TYPE_DROPPED = 1
+MSG_TYPE_FMT_ID = 2
 
 # Number of dropped messages
 FMT_DROPPED_CNT = "H"
@@ -169,6 +194,8 @@ class LogParserV1(LogParser):
 
         self.fmt_msg_type = endian + FMT_MSG_TYPE
         self.fmt_dropped_cnt = endian + FMT_DROPPED_CNT
+        self.fmt_fmt_id_msg_hdr = endian + FMT_FMT_ID_MSG_HDR
+        self.fmt_fmt_id_msg_cnts = endian + FMT_FMT_ID_MSG_CNTS
 
         if self.database.is_tgt_64bit():
             self.fmt_msg_hdr = endian + FMT_MSG_HDR_64
@@ -359,7 +386,6 @@ class LogParserV1(LogParser):
         pkg_len = (log_desc >> 6) & int(math.pow(2, 10) - 1)
         data_len = (log_desc >> 16) & int(math.pow(2, 12) - 1)
 
-        level_str, color = get_log_level_str_color(level)
         source_id_str = self.database.get_log_source_string(domain_id, source_id)
 
         # Skip over data to point to next message (save as return value)
@@ -405,22 +431,81 @@ class LogParserV1(LogParser):
 
         args = self.process_one_fmt_str(fmt_str, logdata[offset:offset_end_of_args], string_tbl)
 
+        self.print_one_msg(level, timestamp, source_id_str, fmt_str, args, extra_data)
+
+        # Point to next message
+        return next_msg_offset
+
+
+    def parse_one_fmt_id_msg(self, logdata, offset):
+        """Parse one log message with the format string identified by
+        its offset in the log strings section and print the encoded message"""
+        # Parse log message header
+        log_desc, source_id, fmt_id = struct.unpack_from(self.fmt_fmt_id_msg_hdr,
+                                                         logdata, offset)
+        offset += struct.calcsize(self.fmt_fmt_id_msg_hdr)
+
+        timestamp = struct.unpack_from(self.fmt_msg_timestamp, logdata, offset)[0]
+        offset += struct.calcsize(self.fmt_msg_timestamp)
+
+        args_wlen, num_packed_strings = struct.unpack_from(self.fmt_fmt_id_msg_cnts,
+                                                           logdata, offset)
+        offset += struct.calcsize(self.fmt_fmt_id_msg_cnts)
+
+        # domain_id, level, pkg_len, data_len
+        domain_id = log_desc & 0x07
+        level = (log_desc >> 3) & 0x07
+        pkg_len = (log_desc >> 6) & int(math.pow(2, 10) - 1)
+        data_len = (log_desc >> 16) & int(math.pow(2, 12) - 1)
+
+        source_id_str = self.database.get_log_source_string(domain_id, source_id)
+
+        # Package without the header and the format string: va_list
+        # arguments followed by the string table
+        next_msg_offset = offset + pkg_len + data_len
+        offset_end_of_args = offset + args_wlen * self.data_types.get_sizeof(DataTypes.INT)
+        extra_data = logdata[(offset + pkg_len):next_msg_offset]
+
+        string_tbl = self.extract_string_table(logdata[offset_end_of_args:(offset + pkg_len)])
+
+        if len(string_tbl) != num_packed_strings:
+            logger.error("------ Error extracting string table")
+            return None
+
+        sect_start = self.database.get_string_section_start(FMT_ID_SECTION)
+        fmt_str = None
+        if sect_start is not None:
+            fmt_str = self.database.find_string(sect_start + fmt_id)
+
+        if not fmt_str:
+            logger.error("------ Error getting format string with ID 0x%x", fmt_id)
+            return None
+
+        args = self.process_one_fmt_str(fmt_str, logdata[offset:offset_end_of_args], string_tbl)
+
+        self.print_one_msg(level, timestamp, source_id_str, fmt_str, args, extra_data)
+
+        # Point to next message
+        return next_msg_offset
+
+
+    def print_one_msg(self, level, timestamp, source_id_str, fmt_str, args, extra_data):
+        """Print one decoded log message and its hexdump data"""
+        level_str, color = get_log_level_str_color(level)
+        log_prefix = f"[{timestamp:>10}] <{level_str}> {source_id_str}: "
+
         fmt_str = formalize_fmt_string(fmt_str)
         log_msg = fmt_str % args
 
         if level == 0:
             print("%s" % log_msg, end='')
         else:
-            log_prefix = f"[{timestamp:>10}] <{level_str}> {source_id_str}: "
             print(f"{color}%s%s{Fore.RESET}" % (log_prefix, log_msg))
 
-        if data_len > 0:
+        if len(extra_data) > 0:
             # Has hexdump data
             self.print_hexdump(extra_data, len(log_prefix), color)
 
-        # Point to next message
-        return next_msg_offset
-
 
     def parse_log_data(self, logdata, debug=False):
         """Parse binary log data and print the encoded log messages"""
@@ -444,6 +529,13 @@ class LogParserV1(LogParser):
 
                 offset = ret
 
+            elif msg_type == MSG_TYPE_FMT_ID:
+                ret = self.parse_one_fmt_id_msg(logdata, offset)
+                if ret is None:
+                    return False
+
+                offset = ret
+
             else:
                 logger.error("------ Unknown message type: %s", msg_type)
                 return False
@@ -0,0 +1,235 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2021 Intel Corporation.
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Script to generate flat and call graph profiles from the samples taken by
+the sampling profiler (CONFIG_SAMPLING_PROFILER).
+
+Capture the console output of the "profiler dump" shell command, between
+the "profile begin" and "profile end" lines, and symbolize it against the
+image which produced it:
+
+    uart:~$ profiler start
+    uart:~$ profiler stop
+    uart:~$ profiler dump
+
+    ./scripts/profiling/sampling_report.py -e build/zephyr/zephyr.elf \\
+        -i console.log
+
+Each sample holds the program counter of the interrupted code followed by
+the return addresses of its callers. Where the interrupt is handled on the
+stack of the interrupted code, as on native_posix, the sample starts with
+the frames of the interrupt handling code instead; they are skipped up to
+the last function given with --skip.
+
+The flat profile counts, for each function, the samples taken in the
+function itself (self) and in the function or its callees (total). The call
+graph counts the samples in which a caller to callee edge was seen. With
+--folded, the samples are printed as folded stacks, as used by flame graph
+tools, instead.
+"""
+
+import argparse
+import bisect
+import collections
+import re
+import sys
+
+from elftools.elf.elffile import ELFFile
+from elftools.elf.sections import SymbolTableSection
+
+SAMPLE_RE = re.compile(r"sample (\d+)((?: 0x[0-9a-fA-F]+)+)")
+
+UNKNOWN = "[unknown]"
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("-e", "--elf", required=True,
+                        help="zephyr.elf (or zephyr.exe) of the sampled image")
+    parser.add_argument("-i", "--input", default="-",
+                        help="console output with the samples "
+                             "(default: standard input)")
+    parser.add_argument("-c", "--cpu", type=int, action="append",
+                        help="only use the samples of this CPU "
+                             "(may be repeated)")
+    parser.add_argument("-s", "--skip", action="append",
+                        help="interrupt entry function whose frames, and "
+                             "the ones before, are skipped (may be "
+                             "repeated, default: posix_irq_handler)")
+    parser.add_argument("-n", "--limit", type=int, default=30,
+                        help="number of functions and edges printed "
+                             "(default: 30, 0 for all)")
+    parser.add_argument("-f", "--folded", action="store_true",
+                        help="print folded stacks instead of profiles")
+    return parser.parse_args()
+
+
+class Symbols:
+    """Maps addresses to the functions of an ELF file."""
+
+    def __init__(self, path):
+        functions = {}
+
+        with open(path, "rb") as f:
+            elf = ELFFile(f)
+            thumb = elf["e_machine"] == "EM_ARM"
+
+            for section in elf.iter_sections():
+                if not isinstance(section, SymbolTableSection):
+                    continue
+
+                for sym in section.iter_symbols():
+                    if sym["st_info"]["type"] != "STT_FUNC":
+                        continue
+
+                    start = sym["st_value"]
+                    if thumb:
+                        start &= ~1
+                    if start == 0 or sym["st_size"] == 0:
+                        continue
+
+                    functions[start] = (start + sym["st_size"], sym.name)
+
+        self.starts = sorted(functions)
+        self.functions = [functions[start] for start in self.starts]
+
+    def lookup(self, addr):
+        """Return the name of the function holding addr, or None."""
+        i = bisect.bisect_right(self.starts, addr) - 1
+        if i < 0:
+            return None
+
+        end, name = self.functions[i]
+        if addr >= end:
+            return None
+
+        return name
+
+
+def read_samples(stream, cpus):
+    """Yield the address list of each sample of the dump."""
+    dumping = False
+
+    for line in stream:
+        if "profile begin" in line:
+            dumping = True
+            continue
+        if "profile end" in line:
+            dumping = False
+            continue
+        if not dumping:
+            continue
+
+        match = SAMPLE_RE.search(line)
+        if not match:
+            continue
+        if cpus and int(match.group(1)) not in cpus:
+            continue
+
+        yield [int(addr, 16) for addr in match.group(2).split()]
+
+
+def symbolize(symbols, addrs, skip):
+    """Return the functions of a sample, innermost first."""
+    # All addresses but the program counter are return addresses, which
+    # point after the call instruction and may be out of the caller if the
+    # call is its last instruction.
+    names = [symbols.lookup(addrs[0])]
+    names += [symbols.lookup(addr - 1) for addr in addrs[1:]]
+
+    # Drop the frames of the interrupt handling code. The interrupted code
+    # is then only known by return addresses, which is already accounted
+    # for above.
+    for i in range(len(names) - 1, -1, -1):
+        if names[i] in skip:
+            names = names[i + 1:]
+            break
+
+    if not names:
+        return []
+
+    # Past the program counter, unknown addresses, like an exception return
+    # value in the link register, are dropped. So is a caller equal to the
+    # sampled function, which comes from a link register that was not
+    # updated by the function yet.
+    functions = [names[0] or UNKNOWN]
+    for name in names[1:]:
+        if name is None or (len(functions) == 1 and name == functions[0]):
+            continue
+        functions.append(name)
+
+    return functions
+
+
+def print_flat(nsamples, self_counts, total_counts, limit):
+    print("Flat profile (%d samples):" % nsamples)
+    print()
+    print("%8s %7s %8s %7s  %s" % ("self", "%", "total", "%", "function"))
+
+    rows = sorted(total_counts, key=lambda f: (-self_counts[f],
+                                               -total_counts[f], f))
+    for function in rows[:limit or None]:
+        print("%8d %6.2f%% %8d %6.2f%%  %s" % (
+            self_counts[function], 100.0 * self_counts[function] / nsamples,
+            total_counts[function], 100.0 * total_counts[function] / nsamples,
+            function))
+
+
+def print_call_graph(nsamples, edges, limit):
+    print("Call graph (%d samples):" % nsamples)
+    print()
+    print("%8s %7s  %s" % ("samples", "%", "caller -> callee"))
+
+    rows = sorted(edges, key=lambda e: (-edges[e], e))
+    for caller, callee in rows[:limit or None]:
+        print("%8d %6.2f%%  %s -> %s" % (
+            edges[(caller, callee)], 100.0 * edges[(caller, callee)] / nsamples,
+            caller, callee))
+
+
+def main():
+    args = parse_args()
+    skip = set(args.skip or ["posix_irq_handler"])
+
+    symbols = Symbols(args.elf)
+
+    nsamples = 0
+    self_counts = collections.Counter()
+    total_counts = collections.Counter()
+    edges = collections.Counter()
+    stacks = collections.Counter()
+
+    stream = sys.stdin if args.input == "-" else open(args.input)
+    with stream:
+        for addrs in read_samples(stream, args.cpu):
+            functions = symbolize(symbols, addrs, skip)
+            if not functions:
+                continue
+
+            nsamples += 1
+            self_counts[functions[0]] += 1
+            # Recursive functions are only counted once per sample
+            total_counts.update(set(functions))
+            edges.update(set(zip(functions[1:], functions)))
+            stacks[";".join(reversed(functions))] += 1
+
+    if nsamples == 0:
+        sys.exit("No samples found in the input")
+
+    if args.folded:
+        for stack, count in sorted(stacks.items()):
+            print("%s %d" % (stack, count))
+        return
+
+    print_flat(nsamples, self_counts, total_counts, args.limit)
+    print()
+    print_call_graph(nsamples, edges, args.limit)
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,219 @@
+#!/usr/bin/env python3
+#
+# Copyright (c) 2021 Intel Corporation.
+#
+# SPDX-License-Identifier: Apache-2.0
+"""
+Script to merge CTF data captured with per-CPU tracing buffers
+(CONFIG_TRACING_PER_CPU_BUFFERS) into a single trace ordered by timestamp.
+
+With per-CPU buffers the tracing stream is a sequence of CTF packets, each
+holding the events of a single CPU, with the CPU id in the packet header.
+Events of different CPUs are therefore interleaved packet by packet and not
+in timestamp order. This script splits the stream by CPU, merges the events
+by timestamp and writes a CTF trace directory with the merged stream and
+the matching metadata, which can be read with babeltrace or parse_ctf.py:
+
+    cp build/channel0_0 .
+    ./scripts/tracing/merge_ctf_cpus.py -i channel0_0 -o ctf
+    ./scripts/tracing/parse_ctf.py -t ctf
+
+Event sizes are taken from the metadata, so it must match the firmware.
+Timestamps are 32 bit nanosecond values which wrap every ~4.3 s; a wrap is
+detected per CPU, so a CPU must emit at least one event per wrap period for
+its events to be ordered correctly.
+"""
+
+import argparse
+import heapq
+import os
+import re
+import struct
+import sys
+
+ZEPHYR_BASE = os.environ.get(
+    "ZEPHYR_BASE",
+    os.path.abspath(os.path.join(os.path.dirname(__file__), "..", "..")))
+
+CTF_MAGIC = 0xC1FC1FC1
+# uint32_t magic, uint8_t cpu_id, uint32_t content_size, uint32_t packet_size
+PACKET_HEADER = struct.Struct("<IBII")
+
+PACKET_DECLARATIONS = {
+    "trace": "\tpacket.header := struct {\n"
+             "\t\tuint32_t magic;\n"
+             "\t\tuint8_t cpu_id;\n"
+             "\t};\n",
+    "stream": "\tpacket.context := struct {\n"
+              "\t\tuint32_t content_size;\n"
+              "\t\tuint32_t packet_size;\n"
+              "\t};\n",
+}
+
+
+def parse_args():
+    parser = argparse.ArgumentParser(
+        description=__doc__,
+        formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("-i", "--input", required=True,
+                        help="tracing data captured from the target")
+    parser.add_argument("-o", "--output", required=True,
+                        help="output directory for the merged CTF trace")
+    parser.add_argument("-m", "--metadata",
+                        default=os.path.join(ZEPHYR_BASE, "subsys", "tracing",
+                                             "ctf", "tsdl", "metadata"),
+                        help="CTF metadata of the firmware")
+    return parser.parse_args()
+
+
+def strip_comments(text):
+    return re.sub(r"/\*.*?\*/", "", text, flags=re.S)
+
+
+def struct_size(body, sizes):
+    """Size in bytes of a struct body with fixed size fields."""
+    size = 0
+    for field in body.split(";"):
+        field = field.split()
+        if not field:
+            continue
+        if field[0] not in sizes:
+            sys.exit(f"Unsupported field type: {field[0]}")
+        count = 1
+        array = re.search(r"\[(\d+)\]", field[-1])
+        if array:
+            count = int(array.group(1))
+        size += sizes[field[0]] * count
+    return size
+
+
+def event_blocks(text):
+    """Yield the body of each top level event block."""
+    for m in re.finditer(r"^event\s*{", text, flags=re.M):
+        depth = 1
+        end = m.end()
+        while depth:
+            depth += {"{": 1, "}": -1}.get(text[end], 0)
+            end += 1
+        yield text[m.end():end - 1]
+
+
+def parse_metadata(text):
+    """Return the event header size and a map of event id to payload size."""
+    text = strip_comments(text)
+    sizes = {}
+
+    for m in re.finditer(r"typealias\s+integer\s*{([^}]*)}\s*:=\s*(\w+)\s*;",
+                         text):
+        bits = re.search(r"size\s*=\s*(\d+)", m.group(1))
+        sizes[m.group(2)] = int(bits.group(1)) // 8
+
+    for m in re.finditer(r"typealias\s+enum\s*:\s*(\w+)\s*{[^}]*}\s*:=\s*(\w+)",
+                         text):
+        sizes[m.group(2)] = sizes[m.group(1)]
+
+    header = re.search(r"struct\s+event_header\s*{([^}]*)}", text)
+    if header is None or "timestamp" not in header.group(1):
+        sys.exit("Metadata has no event header with a timestamp")
+    header_size = struct_size(header.group(1), sizes)
+
+    events = {}
+    for body in event_blocks(text):
+        event_id = re.search(r"\bid\s*=\s*(\w+)\s*;", body)
+        fields = re.search(r"fields\s*:=\s*struct\s*{([^}]*)}", body)
+        events[int(event_id.group(1), 0)] = struct_size(
+            fields.group(1) if fields else "", sizes)
+
+    return header_size, events
+
+
+def add_packet_declarations(text):
+    """Declare the per-CPU packet header and context in the metadata."""
+    for scope, declaration in PACKET_DECLARATIONS.items():
+        text, count = re.subn(r"^(%s\s*{\n)" % scope,
+                              lambda m: m.group(1) + declaration, text,
+                              count=1, flags=re.M)
+        if count != 1:
+            sys.exit(f"Metadata has no {scope} block")
+    return text
+
+
+def split_packets(data):
+    """Yield (cpu_id, event data) for each packet of the captured stream."""
+    offset = 0
+    while offset + PACKET_HEADER.size <= len(data):
+        magic, cpu_id, content_size, _ = PACKET_HEADER.unpack_from(data,
+                                                                   offset)
+        end = offset + content_size // 8
+        if magic != CTF_MAGIC or end > len(data):
+            sys.exit(f"Invalid packet at offset {offset}")
+        yield cpu_id, data[offset + PACKET_HEADER.size:end]
+        offset = end
+
+
+def cpu_events(cpu_id, chunks, header_size, events):
+    """Yield (timestamp, cpu_id, event) for the events of one CPU, with the
+    32 bit timestamps extended to 64 bit."""
+    base = 0
+    last = None
+    for chunk in chunks:
+        offset = 0
+        while offset < len(chunk):
+            timestamp, event_id = struct.unpack_from("<IB", chunk, offset)
+            if event_id not in events:
+                sys.exit(f"Unknown event id {event_id:#x} on CPU {cpu_id}")
+            end = offset + header_size + events[event_id]
+            if last is not None and timestamp < last:
+                base += 1 << 32
+            last = timestamp
+            yield base + timestamp, cpu_id, chunk[offset:end]
+            offset = end
+
+
+def main():
+    args = parse_args()
+
+    with open(args.metadata) as f:
+        metadata = f.read()
+    with open(args.input, "rb") as f:
+        data = f.read()
+
+    header_size, events = parse_metadata(metadata)
+
+    chunks = {}
+    for cpu_id, chunk in split_packets(data):
+        chunks.setdefault(cpu_id, []).append(chunk)
+
+    merged = heapq.merge(*(cpu_events(cpu_id, cpu_chunks, header_size, events)
+                           for cpu_id, cpu_chunks in chunks.items()))
+
+    os.makedirs(args.output, exist_ok=True)
+    with open(os.path.join(args.output, "metadata"), "w") as f:
+        f.write(add_packet_declarations(metadata))
+
+    # Consecutive events of the same CPU go to the same packet
+    count = 0
+    with open(os.path.join(args.output, "channel0_0"), "wb") as f:
+        run_cpu = None
+        run = []
+
+        def flush():
+            if run:
+                bits = (PACKET_HEADER.size + sum(map(len, run))) * 8
+                f.write(PACKET_HEADER.pack(CTF_MAGIC, run_cpu, bits, bits))
+                f.writelines(run)
+
+        for _, cpu_id, event in merged:
+            if cpu_id != run_cpu:
+                flush()
+                run_cpu = cpu_id
+                run = []
+            run.append(event)
+            count += 1
+        flush()
+
+    print(f"Merged {count} events from {len(chunks)} CPUs into {args.output}")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,150 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ *  @brief Sampling profiler implementation
+ */
+
+#include <kernel.h>
+#include <errno.h>
+#include <debug/sampling_profiler.h>
+
+struct sample {
+	uint8_t depth;
+	uintptr_t addrs[CONFIG_SAMPLING_PROFILER_DEPTH];
+};
+
+/* Each buffer is only written by its CPU, from the timer interrupt, and
+ * only read while sampling is stopped, so no locking is needed.
+ */
+struct cpu_samples {
+	uint32_t count;
+	uint32_t dropped;
+	uint32_t missed;
+	struct sample samples[CONFIG_SAMPLING_PROFILER_SAMPLES];
+};
+
+static struct cpu_samples cpu_samples[CONFIG_MP_NUM_CPUS];
+static bool running;
+static K_MUTEX_DEFINE(lock);
+
+static void sample_take(struct k_timer *timer)
+{
+	struct cpu_samples *cpu = &cpu_samples[arch_curr_cpu()->id];
+	struct sample *sample;
+	int depth;
+
+	ARG_UNUSED(timer);
+
+	if (cpu->count >= ARRAY_SIZE(cpu->samples)) {
+		cpu->dropped++;
+		return;
+	}
+
+	sample = &cpu->samples[cpu->count];
+	depth = arch_sampling_profiler_backtrace(sample->addrs,
+						 ARRAY_SIZE(sample->addrs));
+	if (depth == 0) {
+		cpu->missed++;
+		return;
+	}
+
+	sample->depth = depth;
+	cpu->count++;
+}
+
+static K_TIMER_DEFINE(sample_timer, sample_take, NULL);
+
+int sampling_profiler_start(uint32_t period_us)
+{
+	int ret = 0;
+
+	if (period_us == 0U) {
+		return -EINVAL;
+	}
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (running) {
+		ret = -EALREADY;
+	} else {
+		running = true;
+		k_timer_start(&sample_timer, K_USEC(period_us),
+			      K_USEC(period_us));
+	}
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
+
+int sampling_profiler_stop(void)
+{
+	int ret = 0;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (!running) {
+		ret = -EALREADY;
+	} else {
+		k_timer_stop(&sample_timer);
+		running = false;
+	}
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
+
+int sampling_profiler_reset(void)
+{
+	int ret = 0;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (running) {
+		ret = -EBUSY;
+	} else {
+		for (int i = 0; i < ARRAY_SIZE(cpu_samples); i++) {
+			cpu_samples[i].count = 0;
+			cpu_samples[i].dropped = 0;
+			cpu_samples[i].missed = 0;
+		}
+	}
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
+
+void sampling_profiler_stats_get(struct sampling_profiler_stats *stats)
+{
+	stats->samples = 0;
+	stats->dropped = 0;
+	stats->missed = 0;
+
+	for (int i = 0; i < ARRAY_SIZE(cpu_samples); i++) {
+		stats->samples += cpu_samples[i].count;
+		stats->dropped += cpu_samples[i].dropped;
+		stats->missed += cpu_samples[i].missed;
+	}
+}
+
+int sampling_profiler_foreach(sampling_profiler_cb_t cb, void *user_data)
+{
+	int ret = 0;
+
+	k_mutex_lock(&lock, K_FOREVER);
+	if (running) {
+		ret = -EBUSY;
+	} else {
+		for (int i = 0; i < ARRAY_SIZE(cpu_samples); i++) {
+			for (uint32_t j = 0; j < cpu_samples[i].count; j++) {
+				struct sample *sample =
+					&cpu_samples[i].samples[j];
+
+				cb(i, sample->addrs, sample->depth, user_data);
+			}
+		}
+	}
+	k_mutex_unlock(&lock);
+
+	return ret;
+}
@@ -0,0 +1,132 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+/** @file
+ *  @brief Sampling profiler shell commands
+ */
+
+#include <shell/shell.h>
+#include <stdlib.h>
+#include <sys/printk.h>
+#include <debug/sampling_profiler.h>
+
+/* Longest sample line: "sample" and CPU id, then the addresses */
+#define SAMPLE_LINE_LEN (16 + CONFIG_SAMPLING_PROFILER_DEPTH * \
+			 (sizeof(uintptr_t) * 2 + 3))
+
+static int cmd_start(const struct shell *shell, size_t argc, char **argv)
+{
+	uint32_t period_us = CONFIG_SAMPLING_PROFILER_PERIOD_US;
+	int ret;
+
+	if (argc > 1) {
+		period_us = strtoul(argv[1], NULL, 10);
+	}
+
+	ret = sampling_profiler_start(period_us);
+	if (ret) {
+		shell_error(shell, "Failed to start (%d)", ret);
+		return ret;
+	}
+
+	/* The timer rounds the period up to the system tick */
+	shell_print(shell, "Sampling every %u us",
+		    k_ticks_to_us_ceil32(k_us_to_ticks_ceil32(period_us)));
+
+	return 0;
+}
+
+static int cmd_stop(const struct shell *shell, size_t argc, char **argv)
+{
+	int ret;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	ret = sampling_profiler_stop();
+	if (ret) {
+		shell_error(shell, "Not started");
+	}
+
+	return ret;
+}
+
+static int cmd_reset(const struct shell *shell, size_t argc, char **argv)
+{
+	int ret;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	ret = sampling_profiler_reset();
+	if (ret) {
+		shell_error(shell, "Stop sampling first");
+	}
+
+	return ret;
+}
+
+static int cmd_status(const struct shell *shell, size_t argc, char **argv)
+{
+	struct sampling_profiler_stats stats;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	sampling_profiler_stats_get(&stats);
+	shell_print(shell, "samples %u dropped %u missed %u",
+		    stats.samples, stats.dropped, stats.missed);
+
+	return 0;
+}
+
+static void sample_print(unsigned int cpu, const uintptr_t *addrs, int depth,
+			 void *user_data)
+{
+	const struct shell *shell = user_data;
+	char line[SAMPLE_LINE_LEN];
+	int len;
+
+	len = snprintk(line, sizeof(line), "sample %u", cpu);
+	for (int i = 0; i < depth; i++) {
+		len += snprintk(&line[len], sizeof(line) - len, " 0x%lx",
+				(unsigned long)addrs[i]);
+	}
+
+	shell_print(shell, "%s", line);
+}
+
+static int cmd_dump(const struct shell *shell, size_t argc, char **argv)
+{
+	int ret;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(shell, "profile begin");
+	ret = sampling_profiler_foreach(sample_print, (void *)shell);
+	if (ret) {
+		shell_error(shell, "Stop sampling first");
+		return ret;
+	}
+	shell_print(shell, "profile end");
+
+	return 0;
+}
+
+SHELL_STATIC_SUBCMD_SET_CREATE(sub_profiler,
+	SHELL_CMD_ARG(start, NULL, "Start sampling [period in us].",
+		      cmd_start, 1, 1),
+	SHELL_CMD(stop, NULL, "Stop sampling.", cmd_stop),
+	SHELL_CMD(reset, NULL, "Discard samples.", cmd_reset),
+	SHELL_CMD(status, NULL, "Show sample counts.", cmd_status),
+	SHELL_CMD(dump, NULL, "Print samples for sampling_report.py.",
+		  cmd_dump),
+	SHELL_SUBCMD_SET_END /* Array terminated. */
+);
+
+SHELL_CMD_REGISTER(profiler, &sub_profiler, "Sampling profiler commands",
+		   NULL);
@@ -27,6 +27,32 @@ static inline size_t nvs_al_size(struct nvs_fs *fs, size_t len)
 	}
 	return (len + (write_block_size - 1U)) & ~(write_block_size - 1U);
 }
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+/* nvs_lookup_cache_pos returns the cache slot for id. Settings and most
+ * other users allocate ids consecutively, so a plain modulo spreads them
+ * evenly over the cache.
+ */
+static inline size_t nvs_lookup_cache_pos(uint16_t id)
+{
+	return id % CONFIG_NVS_LOOKUP_CACHE_SIZE;
+}
+
+/* nvs_lookup_cache_start returns the address to start walking from when
+ * looking for id, or NVS_LOOKUP_CACHE_NO_ADDR if no entry with that id
+ * exists. The slot holds the most recent ate of all ids mapping to it, so
+ * the latest ate for id is found at or after the returned address.
+ */
+static inline uint32_t nvs_lookup_cache_start(struct nvs_fs *fs, uint16_t id)
+{
+	/* 0xFFFF is used by close and gc done ate's, which are not cached */
+	if (id == 0xFFFF) {
+		return fs->ate_wra;
+	}
+
+	return fs->lookup_cache[nvs_lookup_cache_pos(id)];
+}
+#endif
 /* end basic routines */
 
 /* flash routines */
@@ -96,6 +122,11 @@ static int nvs_flash_ate_wrt(struct nvs_fs *fs, const struct nvs_ate *entry)
 
 	rc = nvs_flash_al_wrt(fs, fs->ate_wra, entry,
 			       sizeof(struct nvs_ate));
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	if (!rc && (entry->id != 0xFFFF)) {
+		fs->lookup_cache[nvs_lookup_cache_pos(entry->id)] = fs->ate_wra;
+	}
+#endif
 	fs->ate_wra -= nvs_al_size(fs, sizeof(struct nvs_ate));
 
 	return rc;
@@ -457,6 +488,57 @@ static void nvs_sector_advance(struct nvs_fs *fs, uint32_t *addr)
 	}
 }
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+/* rebuild the lookup cache by walking all ate's from newest to oldest, the
+ * first valid ate found for a slot is the most recent one.
+ */
+static int nvs_lookup_cache_rebuild(struct nvs_fs *fs)
+{
+	int rc;
+	uint32_t addr, ate_addr;
+	uint32_t *cache_entry;
+	struct nvs_ate ate;
+
+	(void)memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+	addr = fs->ate_wra;
+
+	while (1) {
+		/* nvs_prev_ate() moves addr to the previous ate */
+		ate_addr = addr;
+		rc = nvs_prev_ate(fs, &addr, &ate);
+		if (rc) {
+			return rc;
+		}
+
+		cache_entry = &fs->lookup_cache[nvs_lookup_cache_pos(ate.id)];
+
+		if ((ate.id != 0xFFFF) &&
+		    (*cache_entry == NVS_LOOKUP_CACHE_NO_ADDR) &&
+		    nvs_ate_valid(fs, &ate)) {
+			*cache_entry = ate_addr;
+		}
+
+		if (addr == fs->ate_wra) {
+			break;
+		}
+	}
+
+	return 0;
+}
+
+/* drop the cache entries that point into a sector that has been erased */
+static void nvs_lookup_cache_invalidate(struct nvs_fs *fs, uint32_t addr)
+{
+	uint32_t sector = addr >> ADDR_SECT_SHIFT;
+
+	for (size_t i = 0; i < CONFIG_NVS_LOOKUP_CACHE_SIZE; i++) {
+		if ((fs->lookup_cache[i] >> ADDR_SECT_SHIFT) == sector) {
+			fs->lookup_cache[i] = NVS_LOOKUP_CACHE_NO_ADDR;
+		}
+	}
+}
+#endif
+
 /* allocation entry close (this closes the current sector) by writing offset
  * of last ate to the sector end.
  */
@@ -500,24 +582,26 @@ static int nvs_add_gc_done_ate(struct nvs_fs *fs)
 }
 /* garbage collection: the address ate_wra has been updated to the new sector
  * that has just been started. The data to gc is in the sector after this new
- * sector.
+ * sector. nvs_gc_start() prepares the gc state, nvs_gc_run() then processes
+ * the ate's of the gc sector, newest first, copying the ones that are the
+ * latest for their id, and erases the sector when all have been processed.
  */
-static int nvs_gc(struct nvs_fs *fs)
+static int nvs_gc_start(struct nvs_fs *fs, struct nvs_gc_state *gc)
 {
 	int rc;
-	struct nvs_ate close_ate, gc_ate, wlk_ate;
-	uint32_t sec_addr, gc_addr, gc_prev_addr, wlk_addr, wlk_prev_addr,
-	      data_addr, stop_addr;
+	struct nvs_ate close_ate;
 	size_t ate_size;
 
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 
-	sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
-	nvs_sector_advance(fs, &sec_addr);
-	gc_addr = sec_addr + fs->sector_size - ate_size;
+	gc->sec_addr = (fs->ate_wra & ADDR_SECT_MASK);
+	nvs_sector_advance(fs, &gc->sec_addr);
+	gc->addr = gc->sec_addr + fs->sector_size - ate_size;
+	gc->reserve = 0U;
+	gc->pending = true;
 
 	/* if the sector is not closed don't do gc */
-	rc = nvs_flash_ate_rd(fs, gc_addr, &close_ate);
+	rc = nvs_flash_ate_rd(fs, gc->addr, &close_ate);
 	if (rc < 0) {
 		/* flash error */
 		return rc;
@@ -525,76 +609,170 @@ static int nvs_gc(struct nvs_fs *fs)
 
 	rc = nvs_ate_cmp_const(&close_ate, fs->flash_parameters->erase_value);
 	if (!rc) {
-		goto gc_done;
+		gc->addr = NVS_GC_COPY_DONE;
+		return 0;
 	}
 
-	stop_addr = gc_addr - ate_size;
+	gc->stop_addr = gc->addr - ate_size;
 
 	if (nvs_close_ate_valid(fs, &close_ate)) {
-		gc_addr &= ADDR_SECT_MASK;
-		gc_addr += close_ate.offset;
+		gc->addr &= ADDR_SECT_MASK;
+		gc->addr += close_ate.offset;
 	} else {
-		rc = nvs_recover_last_ate(fs, &gc_addr);
+		rc = nvs_recover_last_ate(fs, &gc->addr);
 		if (rc) {
 			return rc;
 		}
 	}
 
-	do {
-		gc_prev_addr = gc_addr;
-		rc = nvs_prev_ate(fs, &gc_addr, &gc_ate);
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	/* Writes are allowed while the gc is in progress as long as they
+	 * leave enough space to copy all entries that remain in the gc
+	 * sector. On top of that keep space for the largest entry, as a copy
+	 * interrupted by a power loss leaves unusable data behind and is
+	 * repeated when nvs_startup() resumes the gc.
+	 */
+	struct nvs_ate ate;
+	uint32_t entry_size, max_size = 0U;
+
+	for (uint32_t addr = gc->addr; addr <= gc->stop_addr;
+	     addr += ate_size) {
+		rc = nvs_flash_ate_rd(fs, addr, &ate);
 		if (rc) {
 			return rc;
 		}
-
-		if (!nvs_ate_valid(fs, &gc_ate)) {
+		if (!nvs_ate_valid(fs, &ate) || !ate.len) {
 			continue;
 		}
+		entry_size = nvs_al_size(fs, ate.len) + ate_size;
+		gc->reserve += entry_size;
+		max_size = MAX(max_size, entry_size);
+	}
+	gc->reserve += max_size;
+#endif
 
-		wlk_addr = fs->ate_wra;
-		do {
-			wlk_prev_addr = wlk_addr;
-			rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
-			if (rc) {
-				return rc;
-			}
-			/* if ate with same id is reached we might need to copy.
-			 * only consider valid wlk_ate's. Something wrong might
-			 * have been written that has the same ate but is
-			 * invalid, don't consider these as a match.
-			 */
-			if ((wlk_ate.id == gc_ate.id) &&
-			    (nvs_ate_valid(fs, &wlk_ate))) {
-				break;
-			}
-		} while (wlk_addr != fs->ate_wra);
+	return 0;
+}
+
+/* process a single ate of the gc sector, copying it when it is the latest
+ * entry for its id.
+ */
+static int nvs_gc_entry(struct nvs_fs *fs, uint32_t gc_prev_addr,
+			struct nvs_ate *gc_ate)
+{
+	int rc;
+	struct nvs_ate wlk_ate;
+	uint32_t wlk_addr, wlk_prev_addr, data_addr;
 
-		/* if walk has reached the same address as gc_addr copy is
-		 * needed unless it is a deleted item.
+	if (!nvs_ate_valid(fs, gc_ate)) {
+		return 0;
+	}
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	wlk_addr = nvs_lookup_cache_start(fs, gc_ate->id);
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		/* only while the cache is being rebuilt at startup */
+		wlk_addr = fs->ate_wra;
+	}
+#else
+	wlk_addr = fs->ate_wra;
+#endif
+	do {
+		wlk_prev_addr = wlk_addr;
+		rc = nvs_prev_ate(fs, &wlk_addr, &wlk_ate);
+		if (rc) {
+			return rc;
+		}
+		/* if ate with same id is reached we might need to copy.
+		 * only consider valid wlk_ate's. Something wrong might
+		 * have been written that has the same ate but is
+		 * invalid, don't consider these as a match.
 		 */
-		if ((wlk_prev_addr == gc_prev_addr) && gc_ate.len) {
-			/* copy needed */
-			LOG_DBG("Moving %d, len %d", gc_ate.id, gc_ate.len);
+		if ((wlk_ate.id == gc_ate->id) &&
+		    (nvs_ate_valid(fs, &wlk_ate))) {
+			break;
+		}
+	} while (wlk_addr != fs->ate_wra);
 
-			data_addr = (gc_prev_addr & ADDR_SECT_MASK);
-			data_addr += gc_ate.offset;
+	/* if walk has reached the same address as gc_addr copy is
+	 * needed unless it is a deleted item.
+	 */
+	if ((wlk_prev_addr != gc_prev_addr) || !gc_ate->len) {
+		return 0;
+	}
 
-			gc_ate.offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
-			nvs_ate_crc8_update(&gc_ate);
+	/* copy needed */
+	LOG_DBG("Moving %d, len %d", gc_ate->id, gc_ate->len);
 
-			rc = nvs_flash_block_move(fs, data_addr, gc_ate.len);
-			if (rc) {
-				return rc;
-			}
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	size_t entry_size = nvs_al_size(fs, gc_ate->len) +
+			    nvs_al_size(fs, sizeof(struct nvs_ate));
 
-			rc = nvs_flash_ate_wrt(fs, &gc_ate);
-			if (rc) {
-				return rc;
-			}
+	if (fs->ate_wra < (fs->data_wra + entry_size)) {
+		return -ENOSPC;
+	}
+#endif
+
+	data_addr = (gc_prev_addr & ADDR_SECT_MASK);
+	data_addr += gc_ate->offset;
+
+	gc_ate->offset = (uint16_t)(fs->data_wra & ADDR_OFFS_MASK);
+	nvs_ate_crc8_update(gc_ate);
+
+	rc = nvs_flash_block_move(fs, data_addr, gc_ate->len);
+	if (rc) {
+		return rc;
+	}
+
+	return nvs_flash_ate_wrt(fs, gc_ate);
+}
+
+/* process at most budget ate's of the gc sector, returns 1 if the gc is not
+ * finished yet.
+ */
+static int nvs_gc_run(struct nvs_fs *fs, struct nvs_gc_state *gc,
+		      size_t budget)
+{
+	int rc;
+	struct nvs_ate gc_ate;
+	uint32_t gc_addr, gc_prev_addr, entry_size;
+	size_t ate_size;
+
+	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
+
+	while ((gc->addr != NVS_GC_COPY_DONE) && budget) {
+		/* gc->addr only moves past an entry once it is processed, so
+		 * that an entry whose copy failed is retried by the next run
+		 * instead of being lost when the sector is erased.
+		 */
+		gc_prev_addr = gc->addr;
+		gc_addr = gc->addr;
+		rc = nvs_prev_ate(fs, &gc_addr, &gc_ate);
+		if (rc) {
+			return rc;
+		}
+
+		entry_size = 0U;
+		if (nvs_ate_valid(fs, &gc_ate) && gc_ate.len) {
+			entry_size = nvs_al_size(fs, gc_ate.len) + ate_size;
 		}
-	} while (gc_prev_addr != stop_addr);
 
-gc_done:
+		rc = nvs_gc_entry(fs, gc_prev_addr, &gc_ate);
+		if (rc) {
+			return rc;
+		}
+
+		gc->addr = gc_addr;
+		gc->reserve -= MIN(gc->reserve, entry_size);
+		if (gc_prev_addr == gc->stop_addr) {
+			gc->addr = NVS_GC_COPY_DONE;
+		}
+		budget--;
+	}
+
+	if (gc->addr != NVS_GC_COPY_DONE) {
+		return 1;
+	}
 
 	/* Make it possible to detect that gc has finished by writing a
 	 * gc done ate to the sector. In the field we might have nvs systems
@@ -610,10 +788,118 @@ gc_done:
 	}
 
 	/* Erase the gc'ed sector */
-	rc = nvs_flash_erase_sector(fs, sec_addr);
+	rc = nvs_flash_erase_sector(fs, gc->sec_addr);
 	if (rc) {
 		return rc;
 	}
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	nvs_lookup_cache_invalidate(fs, gc->sec_addr);
+#endif
+	gc->reserve = 0U;
+	gc->pending = false;
+	return 0;
+}
+
+static int nvs_gc(struct nvs_fs *fs)
+{
+	int rc;
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	struct nvs_gc_state *gc = &fs->gc;
+#else
+	struct nvs_gc_state gc_state;
+	struct nvs_gc_state *gc = &gc_state;
+#endif
+
+	rc = nvs_gc_start(fs, gc);
+	if (rc) {
+		return rc;
+	}
+
+	return nvs_gc_run(fs, gc, SIZE_MAX);
+}
+
+/* space in the write sector that writes have to leave free for the copies of
+ * a pending gc.
+ */
+static inline uint32_t nvs_gc_reserve(struct nvs_fs *fs)
+{
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	return fs->gc.pending ? fs->gc.reserve : 0U;
+#else
+	ARG_UNUSED(fs);
+
+	return 0U;
+#endif
+}
+
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+#ifdef CONFIG_NVS_GC_WORKQUEUE
+static void nvs_gc_work_handler(struct k_work *work)
+{
+	struct nvs_fs *fs = CONTAINER_OF(work, struct nvs_fs, gc_work);
+
+	if (nvs_gc_step(fs, CONFIG_NVS_GC_STEP_BUDGET) > 0) {
+		(void)k_work_submit(&fs->gc_work);
+	}
+}
+#endif
+#endif
+
+int nvs_gc_step(struct nvs_fs *fs, size_t budget)
+{
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	int rc = 0;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	if (fs->gc.pending) {
+		rc = nvs_gc_run(fs, &fs->gc, budget);
+	}
+	k_mutex_unlock(&fs->nvs_lock);
+
+	return rc;
+#else
+	ARG_UNUSED(budget);
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	/* garbage collection always completes within nvs_write() */
+	return 0;
+#endif
+}
+
+/* skip data written after the last ate write, e.g. when a write was
+ * interrupted before its ate was written.
+ */
+static int nvs_recover_data_wra(struct nvs_fs *fs)
+{
+	int rc;
+	size_t empty_len;
+	uint8_t erase_value = fs->flash_parameters->erase_value;
+
+	while (fs->ate_wra > fs->data_wra) {
+		empty_len = fs->ate_wra - fs->data_wra;
+
+		rc = nvs_flash_cmp_const(fs, fs->data_wra, erase_value,
+				empty_len);
+		if (rc < 0) {
+			return rc;
+		}
+		if (!rc) {
+			break;
+		}
+
+		fs->data_wra += fs->flash_parameters->write_block_size;
+	}
+
 	return 0;
 }
 
@@ -621,7 +907,7 @@ static int nvs_startup(struct nvs_fs *fs)
 {
 	int rc;
 	struct nvs_ate last_ate;
-	size_t ate_size, empty_len;
+	size_t ate_size;
 	/* Initialize addr to 0 for the case fs->sector_count == 0. This
 	 * should never happen as this is verified in nvs_init() but both
 	 * Coverity and GCC believe the contrary.
@@ -632,6 +918,14 @@ static int nvs_startup(struct nvs_fs *fs)
 
 	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	/* an interrupted gc may be restarted below, make it walk all ate's */
+	(void)memset(fs->lookup_cache, 0xff, sizeof(fs->lookup_cache));
+#endif
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	fs->gc.pending = false;
+#endif
+
 	ate_size = nvs_al_size(fs, sizeof(struct nvs_ate));
 	/* step through the sectors to find a open sector following
 	 * a closed sector, this is where NVS can to write.
@@ -769,6 +1063,20 @@ static int nvs_startup(struct nvs_fs *fs)
 			rc = nvs_flash_erase_sector(fs, addr);
 			goto end;
 		}
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+		/* The write sector may hold entries written while the gc
+		 * was in progress, so resume the gc instead of restarting
+		 * it. Entries that were already copied are newer than their
+		 * original and will be skipped.
+		 */
+		LOG_INF("No GC Done marker found: resuming gc");
+		rc = nvs_recover_data_wra(fs);
+		if (rc) {
+			goto end;
+		}
+		rc = nvs_gc(fs);
+		goto end;
+#endif
 		LOG_INF("No GC Done marker found: restarting gc");
 		rc = nvs_flash_erase_sector(fs, fs->ate_wra);
 		if (rc) {
@@ -782,19 +1090,9 @@ static int nvs_startup(struct nvs_fs *fs)
 	}
 
 	/* possible data write after last ate write, update data_wra */
-	while (fs->ate_wra > fs->data_wra) {
-		empty_len = fs->ate_wra - fs->data_wra;
-
-		rc = nvs_flash_cmp_const(fs, fs->data_wra, erase_value,
-				empty_len);
-		if (rc < 0) {
-			goto end;
-		}
-		if (!rc) {
-			break;
-		}
-
-		fs->data_wra += fs->flash_parameters->write_block_size;
+	rc = nvs_recover_data_wra(fs);
+	if (rc) {
+		goto end;
 	}
 
 	/* If the ate_wra is pointing to the first ate write location in a
@@ -819,6 +1117,12 @@ end:
 
 		rc = nvs_add_gc_done_ate(fs);
 	}
+
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	if (!rc) {
+		rc = nvs_lookup_cache_rebuild(fs);
+	}
+#endif
 	k_mutex_unlock(&fs->nvs_lock);
 	return rc;
 }
@@ -833,6 +1137,12 @@ int nvs_clear(struct nvs_fs *fs)
 		return -EACCES;
 	}
 
+#ifdef CONFIG_NVS_GC_WORKQUEUE
+	struct k_work_sync sync;
+
+	(void)k_work_cancel_sync(&fs->gc_work, &sync);
+#endif
+
 	for (uint16_t i = 0; i < fs->sector_count; i++) {
 		addr = i << ADDR_SECT_SHIFT;
 		rc = nvs_flash_erase_sector(fs, addr);
@@ -854,6 +1164,19 @@ int nvs_init(struct nvs_fs *fs, const char *dev_name)
 	struct flash_pages_info info;
 	size_t write_block_size;
 
+#ifdef CONFIG_NVS_GC_WORKQUEUE
+	struct k_work_sync sync;
+
+	/* the fs may be mounted again while a gc step is queued. Before the
+	 * first successful mount the work item is not initialized yet, and
+	 * nvs_clear() cancels it before clearing ready.
+	 */
+	if (fs->ready) {
+		(void)k_work_cancel_sync(&fs->gc_work, &sync);
+	}
+	k_work_init(&fs->gc_work, nvs_gc_work_handler);
+#endif
+
 	k_mutex_init(&fs->nvs_lock);
 
 	fs->flash_device = device_get_binding(dev_name);
@@ -912,7 +1235,8 @@ int nvs_init(struct nvs_fs *fs, const char *dev_name)
 	return 0;
 }
 
-ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
+static ssize_t nvs_do_write(struct nvs_fs *fs, uint16_t id, const void *data,
+			    size_t len)
 {
 	int rc, gc_count;
 	size_t ate_size, data_size;
@@ -939,7 +1263,14 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 	}
 
 	/* find latest entry with same id */
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	wlk_addr = nvs_lookup_cache_start(fs, id);
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		goto no_cached_entry;
+	}
+#else
 	wlk_addr = fs->ate_wra;
+#endif
 	rd_addr = wlk_addr;
 
 	while (1) {
@@ -957,6 +1288,9 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 		}
 	}
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+no_cached_entry:
+#endif
 	if (prev_found) {
 		/* previous entry found */
 		rd_addr &= ADDR_SECT_MASK;
@@ -1003,7 +1337,8 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 			goto end;
 		}
 
-		if (fs->ate_wra >= (fs->data_wra + required_space)) {
+		if (fs->ate_wra >= (fs->data_wra + required_space +
+				    nvs_gc_reserve(fs))) {
 
 			rc = nvs_flash_wrt_entry(fs, id, data, len);
 			if (rc) {
@@ -1012,31 +1347,85 @@ ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
 			break;
 		}
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+		if (fs->gc.pending) {
+			/* the entry only fits once the gc has progressed */
+			rc = nvs_gc_run(fs, &fs->gc, CONFIG_NVS_GC_STEP_BUDGET);
+			if (rc < 0) {
+				goto end;
+			}
+			continue;
+		}
+#endif
 
 		rc = nvs_sector_close(fs);
 		if (rc) {
 			goto end;
 		}
 
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+		rc = nvs_gc_start(fs, &fs->gc);
+#else
 		rc = nvs_gc(fs);
+#endif
 		if (rc) {
 			goto end;
 		}
 		gc_count++;
 	}
+
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	/* advance a pending gc with every write so that it completes before
+	 * the write sector fills up.
+	 */
+	if (fs->gc.pending) {
+		rc = nvs_gc_run(fs, &fs->gc, CONFIG_NVS_GC_STEP_BUDGET);
+		if (rc < 0) {
+			goto end;
+		}
+#ifdef CONFIG_NVS_GC_WORKQUEUE
+		if (rc) {
+			(void)k_work_submit(&fs->gc_work);
+		}
+#endif
+	}
+#endif
 	rc = len;
 end:
 	k_mutex_unlock(&fs->nvs_lock);
 	return rc;
 }
 
+ssize_t nvs_write(struct nvs_fs *fs, uint16_t id, const void *data, size_t len)
+{
+#ifdef CONFIG_NVS_GC_WORKQUEUE
+	ssize_t rc;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	/* keep a gc step on the workqueue from erasing the sector that is
+	 * being searched for the previous entry.
+	 */
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	rc = nvs_do_write(fs, id, data, len);
+	k_mutex_unlock(&fs->nvs_lock);
+
+	return rc;
+#else
+	return nvs_do_write(fs, id, data, len);
+#endif
+}
+
 int nvs_delete(struct nvs_fs *fs, uint16_t id)
 {
 	return nvs_write(fs, id, NULL, 0);
 }
 
-ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
-		      uint16_t cnt)
+static ssize_t nvs_do_read_hist(struct nvs_fs *fs, uint16_t id, void *data,
+				size_t len, uint16_t cnt)
 {
 	int rc;
 	uint32_t wlk_addr, rd_addr;
@@ -1057,7 +1446,15 @@ ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
 
 	cnt_his = 0U;
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	wlk_addr = nvs_lookup_cache_start(fs, id);
+	if (wlk_addr == NVS_LOOKUP_CACHE_NO_ADDR) {
+		rc = -ENOENT;
+		goto err;
+	}
+#else
 	wlk_addr = fs->ate_wra;
+#endif
 	rd_addr = wlk_addr;
 
 	while (cnt_his <= cnt) {
@@ -1092,6 +1489,30 @@ err:
 	return rc;
 }
 
+ssize_t nvs_read_hist(struct nvs_fs *fs, uint16_t id, void *data, size_t len,
+		      uint16_t cnt)
+{
+#ifdef CONFIG_NVS_GC_WORKQUEUE
+	ssize_t rc;
+
+	if (!fs->ready) {
+		LOG_ERR("NVS not initialized");
+		return -EACCES;
+	}
+
+	/* keep a gc step on the workqueue from erasing the sector that is
+	 * being read.
+	 */
+	k_mutex_lock(&fs->nvs_lock, K_FOREVER);
+	rc = nvs_do_read_hist(fs, id, data, len, cnt);
+	k_mutex_unlock(&fs->nvs_lock);
+
+	return rc;
+#else
+	return nvs_do_read_hist(fs, id, data, len, cnt);
+#endif
+}
+
 ssize_t nvs_read(struct nvs_fs *fs, uint16_t id, void *data, size_t len)
 {
 	int rc;
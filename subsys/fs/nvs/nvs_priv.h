@@ -28,6 +28,11 @@ extern "C" {
 
 #define NVS_BLOCK_SIZE 32
 
+#define NVS_LOOKUP_CACHE_NO_ADDR 0xFFFFFFFF
+
+/* gc state address once all ate's of the gc sector have been processed */
+#define NVS_GC_COPY_DONE 0xFFFFFFFF
+
 /* Allocation Table Entry */
 struct nvs_ate {
 	uint16_t id;	/* data id */
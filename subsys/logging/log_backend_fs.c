@@ -9,6 +9,7 @@
 #include <logging/log_backend.h>
 #include <logging/log_output_dict.h>
 #include <logging/log_backend_std.h>
+#include <logging/log_backend_fs.h>
 #include <assert.h>
 #include <fs/fs.h>
 
@@ -28,6 +29,15 @@ static struct fs_file_t file;
 static enum backend_fs_state backend_state = BACKEND_FS_NOT_INITIALIZED;
 static int file_ctr, newest, oldest;
 
+#ifdef CONFIG_LOG_BACKEND_FS_STATS
+static struct log_backend_fs_stats stats;
+
+void log_backend_fs_stats_get(struct log_backend_fs_stats *out)
+{
+	*out = stats;
+}
+#endif
+
 static int allocate_new_file(struct fs_file_t *file);
 static int del_oldest_log(void);
 static int get_log_file_id(struct fs_dirent *ent);
@@ -180,6 +190,10 @@ int write_log_to_file(uint8_t *data, size_t length, void *ctx)
 
 		rc = fs_write(f, data, length);
 		if (rc >= 0) {
+#ifdef CONFIG_LOG_BACKEND_FS_STATS
+			stats.bytes += rc;
+			stats.writes++;
+#endif
 			if (IS_ENABLED(CONFIG_LOG_BACKEND_FS_OVERWRITE) &&
 			    (rc != length)) {
 				del_oldest_log();
@@ -213,6 +227,9 @@ int write_log_to_file(uint8_t *data, size_t length, void *ctx)
 			/* Something is wrong */
 			goto on_error;
 		}
+#ifdef CONFIG_LOG_BACKEND_FS_STATS
+		stats.syncs++;
+#endif
 	}
 
 	return length;
@@ -428,13 +445,143 @@ BUILD_ASSERT(!IS_ENABLED(CONFIG_LOG_MODE_IMMEDIATE),
 
 #ifndef CONFIG_LOG_BACKEND_FS_TESTSUITE
 
+#ifdef CONFIG_LOG_BACKEND_FS_BATCH
+
+BUILD_ASSERT(CONFIG_LOG_BACKEND_FS_BATCH_SIZE <= CONFIG_LOG_BACKEND_FS_FILE_SIZE,
+	     "Batch must fit in a log file.");
+
+struct batch {
+	uint8_t __aligned(4) data[CONFIG_LOG_BACKEND_FS_BATCH_SIZE];
+	size_t len;
+};
+
+/* Log output is collected in fill_batch by the logging thread. A full batch
+ * is passed in write_batch to the writer thread, which writes it to the log
+ * file and then gives free_sem. Batch is never split in the middle of a
+ * message, unless the message does not fit in a batch.
+ */
+static struct batch batches[2];
+static struct batch *fill_batch = &batches[0];
+static struct batch *write_batch;
+static size_t msg_start;
+static K_MUTEX_DEFINE(batch_lock);
+static K_SEM_DEFINE(free_sem, 1, 1);
+static K_SEM_DEFINE(full_sem, 0, 1);
+
+/* Must be called with batch_lock held. */
+static int batch_submit(k_timeout_t timeout)
+{
+	struct batch *next;
+	size_t tail;
+
+	if (k_sem_take(&free_sem, timeout) != 0) {
+		return -EAGAIN;
+	}
+
+	next = (fill_batch == &batches[0]) ? &batches[1] : &batches[0];
+
+	/* Move beginning of the current message to the next batch. */
+	tail = (msg_start > 0) ? fill_batch->len - msg_start : 0;
+	memcpy(next->data, &fill_batch->data[msg_start], tail);
+	next->len = tail;
+	fill_batch->len -= tail;
+
+	write_batch = fill_batch;
+	fill_batch = next;
+	msg_start = 0;
+
+	k_sem_give(&full_sem);
+
+	return 0;
+}
+
+static int batch_out(uint8_t *data, size_t length, void *ctx)
+{
+	size_t len = MIN(length, sizeof(fill_batch->data) - fill_batch->len);
+
+	memcpy(&fill_batch->data[fill_batch->len], data, len);
+	fill_batch->len += len;
+
+	if (fill_batch->len == sizeof(fill_batch->data)) {
+		(void)batch_submit(K_FOREVER);
+	}
+
+	return len;
+}
+
+static void batch_writer(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (true) {
+		size_t offset = 0;
+
+		if (k_sem_take(&full_sem,
+			       K_MSEC(CONFIG_LOG_BACKEND_FS_BATCH_TIMEOUT_MS))) {
+			/* Write partially filled batch. It contains whole
+			 * messages only as messages are added with the lock
+			 * held. If the lock is taken, a message is being
+			 * added, which may be waiting for this thread.
+			 */
+			if (k_mutex_lock(&batch_lock, K_NO_WAIT) != 0) {
+				continue;
+			}
+			if (fill_batch->len > 0) {
+				msg_start = fill_batch->len;
+				(void)batch_submit(K_NO_WAIT);
+			}
+			k_mutex_unlock(&batch_lock);
+			continue;
+		}
+
+		while (offset < write_batch->len) {
+			offset += write_log_to_file(&write_batch->data[offset],
+						    write_batch->len - offset,
+						    NULL);
+		}
+
+		k_sem_give(&free_sem);
+	}
+}
+
+K_THREAD_DEFINE(log_backend_fs_thread, CONFIG_LOG_BACKEND_FS_THREAD_STACK_SIZE,
+		batch_writer, NULL, NULL, NULL,
+		K_LOWEST_APPLICATION_THREAD_PRIO, 0, 0);
+
+static uint8_t __aligned(4) buf[MAX_FLASH_WRITE_SIZE];
+LOG_OUTPUT_DEFINE(log_output, batch_out, buf, MAX_FLASH_WRITE_SIZE);
+
+static inline void msg_begin(void)
+{
+	k_mutex_lock(&batch_lock, K_FOREVER);
+	msg_start = fill_batch->len;
+}
+
+static inline void msg_end(void)
+{
+	k_mutex_unlock(&batch_lock);
+}
+#else
 static uint8_t __aligned(4) buf[MAX_FLASH_WRITE_SIZE];
 LOG_OUTPUT_DEFINE(log_output, write_log_to_file, buf, MAX_FLASH_WRITE_SIZE);
 
+static inline void msg_begin(void)
+{
+}
+
+static inline void msg_end(void)
+{
+}
+#endif /* CONFIG_LOG_BACKEND_FS_BATCH */
+
 static void put(const struct log_backend *const backend,
 		struct log_msg *msg)
 {
+	msg_begin();
 	log_backend_std_put(&log_output, 0, msg);
+	msg_end();
 }
 
 static void log_backend_fs_init(const struct log_backend *const backend)
@@ -453,11 +600,13 @@ static void dropped(const struct log_backend *const backend, uint32_t cnt)
 {
 	ARG_UNUSED(backend);
 
+	msg_begin();
 	if (IS_ENABLED(CONFIG_LOG_BACKEND_FS_OUTPUT_DICTIONARY)) {
 		log_dict_output_dropped_process(&log_output, cnt);
 	} else {
 		log_backend_std_dropped(&log_output, cnt);
 	}
+	msg_end();
 }
 
 static void process(const struct log_backend *const backend,
@@ -465,12 +614,14 @@ static void process(const struct log_backend *const backend,
 {
 	uint32_t flags = log_backend_std_get_flags();
 
+	msg_begin();
 	if (IS_ENABLED(CONFIG_LOG_BACKEND_FS_OUTPUT_DICTIONARY)) {
 		log_dict_output_msg2_process(&log_output,
 					     &msg->log, flags);
 	} else {
 		log_output_msg2_process(&log_output, &msg->log, flags);
 	}
+	msg_end();
 }
 
 static const struct log_backend_api log_backend_fs_api = {
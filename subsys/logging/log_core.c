@@ -93,16 +93,31 @@ static struct k_timer log_process_thread_timer;
 static log_timestamp_t dummy_timestamp(void);
 static log_timestamp_get_t timestamp_func = dummy_timestamp;
 
-struct mpsc_pbuf_buffer log_buffer;
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+#define LOG_BUFFER_COUNT CONFIG_MP_NUM_CPUS
+#else
+#define LOG_BUFFER_COUNT 1
+#endif
+
+struct mpsc_pbuf_buffer log_buffer[LOG_BUFFER_COUNT];
 static uint32_t __aligned(Z_LOG_MSG2_ALIGNMENT)
-	buf32[CONFIG_LOG_BUFFER_SIZE / sizeof(int)];
+	buf32[LOG_BUFFER_COUNT][CONFIG_LOG_BUFFER_SIZE / sizeof(int) /
+				LOG_BUFFER_COUNT];
+
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+/* Message claimed from each buffer and not yet handed out for processing,
+ * protected by claim_lock.
+ */
+static union log_msg2_generic *claimed[LOG_BUFFER_COUNT];
+static struct k_spinlock claim_lock;
+#endif
 
 static void notify_drop(const struct mpsc_pbuf_buffer *buffer,
 			const union mpsc_pbuf_generic *item);
 
 static const struct mpsc_pbuf_buffer_config mpsc_config = {
-	.buf = (uint32_t *)buf32,
-	.size = ARRAY_SIZE(buf32),
+	.buf = buf32[0],
+	.size = ARRAY_SIZE(buf32[0]),
 	.notify_drop = notify_drop,
 	.get_wlen = log_msg2_generic_get_wlen,
 	.flags = IS_ENABLED(CONFIG_LOG_MODE_OVERFLOW) ?
@@ -143,14 +158,7 @@ uint32_t z_log_get_s_mask(const char *str, uint32_t nargs)
 	return mask;
 }
 
-/**
- * @brief Check if address is in read only section.
- *
- * @param addr Address.
- *
- * @return True if address identified within read only section.
- */
-static bool is_rodata(const void *addr)
+bool z_log_is_rodata(const void *addr)
 {
 #if defined(CONFIG_ARM) || defined(CONFIG_ARC) || defined(CONFIG_X86) || \
 	defined(CONFIG_ARM64) || defined(CONFIG_NIOS2) || \
@@ -198,7 +206,7 @@ static void detect_missed_strdup(struct log_msg *msg)
 	while (mask) {
 		idx = 31 - __builtin_clz(mask);
 		str = (const char *)log_msg_arg_get(msg, idx);
-		if (!is_rodata(str) && !log_is_strdup(str) &&
+		if (!z_log_is_rodata(str) && !log_is_strdup(str) &&
 			(str != log_strdup_fail_msg)) {
 			const char *src_name =
 				log_source_name_get(CONFIG_LOG_DOMAIN_ID,
@@ -468,7 +476,7 @@ void log_generic(struct log_msg_ids src_level, const char *fmt, va_list ap,
 				uint32_t idx = 31 - __builtin_clz(mask);
 				const char *str = (const char *)args[idx];
 
-				/* is_rodata(str) is not checked,
+				/* z_log_is_rodata(str) is not checked,
 				 * because log_strdup does it.
 				 * Hence, we will do only optional check
 				 * if already not duplicated.
@@ -874,7 +882,7 @@ char *z_log_strdup(const char *str)
 	int err;
 
 	if (IS_ENABLED(CONFIG_LOG_IMMEDIATE) ||
-	    is_rodata(str) || k_is_user_context()) {
+	    z_log_is_rodata(str) || k_is_user_context()) {
 		return (char *)str;
 	}
 
@@ -1171,12 +1179,46 @@ void log_hexdump_from_user(struct log_msg_ids src_level, const char *metadata,
 
 void z_log_msg2_init(void)
 {
-	mpsc_pbuf_init(&log_buffer, &mpsc_config);
+	struct mpsc_pbuf_buffer_config config = mpsc_config;
+
+	for (int i = 0; i < LOG_BUFFER_COUNT; i++) {
+		config.buf = buf32[i];
+		mpsc_pbuf_init(&log_buffer[i], &config);
+	}
+}
+
+/* Buffer to allocate a new message from. */
+static inline struct mpsc_pbuf_buffer *local_buffer(void)
+{
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+	/* Only a locality hint, every buffer has its own lock so it does not
+	 * matter if the thread migrates right after reading this.
+	 */
+	return &log_buffer[arch_curr_cpu()->id];
+#else
+	return &log_buffer[0];
+#endif
+}
+
+/* Buffer a message was allocated from. */
+static inline struct mpsc_pbuf_buffer *msg_buffer(const void *msg)
+{
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+	size_t idx = ((uintptr_t)msg - (uintptr_t)buf32) / sizeof(buf32[0]);
+
+	__ASSERT_NO_MSG(idx < LOG_BUFFER_COUNT);
+
+	return &log_buffer[idx];
+#else
+	ARG_UNUSED(msg);
+
+	return &log_buffer[0];
+#endif
 }
 
 struct log_msg2 *z_log_msg2_alloc(uint32_t wlen)
 {
-	return (struct log_msg2 *)mpsc_pbuf_alloc(&log_buffer, wlen,
+	return (struct log_msg2 *)mpsc_pbuf_alloc(local_buffer(), wlen,
 				K_MSEC(CONFIG_LOG_BLOCK_IN_THREAD_TIMEOUT_MS));
 }
 
@@ -1194,27 +1236,92 @@ void z_log_msg2_commit(struct log_msg2 *msg)
 		return;
 	}
 
-	mpsc_pbuf_commit(&log_buffer, (union mpsc_pbuf_generic *)msg);
+	mpsc_pbuf_commit(msg_buffer(msg), (union mpsc_pbuf_generic *)msg);
 
 	if (IS_ENABLED(CONFIG_LOG2_MODE_DEFERRED)) {
 		z_log_msg_post_finalize();
 	}
 }
 
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+static inline bool timestamp_before(log_timestamp_t a, log_timestamp_t b)
+{
+	/* Wrap-around safe as long as messages are processed within half of
+	 * the timestamp range.
+	 */
+	if (sizeof(log_timestamp_t) > sizeof(int32_t)) {
+		return (int64_t)(a - b) < 0;
+	}
+
+	return (int32_t)(a - b) < 0;
+}
+
+/* Takes the oldest message out of the heads of all buffers. A message that
+ * was allocated but not committed yet holds back later messages of its own
+ * buffer only.
+ */
+static union log_msg2_generic *claim_oldest(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&claim_lock);
+	union log_msg2_generic *msg;
+	int oldest = -1;
+
+	for (int i = 0; i < LOG_BUFFER_COUNT; i++) {
+		if (claimed[i] == NULL) {
+			claimed[i] = (union log_msg2_generic *)
+				mpsc_pbuf_claim(&log_buffer[i]);
+		}
+
+		if ((claimed[i] != NULL) &&
+		    ((oldest < 0) ||
+		     timestamp_before(claimed[i]->log.hdr.timestamp,
+				      claimed[oldest]->log.hdr.timestamp))) {
+			oldest = i;
+		}
+	}
+
+	if (oldest < 0) {
+		msg = NULL;
+	} else {
+		msg = claimed[oldest];
+		claimed[oldest] = NULL;
+	}
+
+	k_spin_unlock(&claim_lock, key);
+
+	return msg;
+}
+#endif
+
 union log_msg2_generic *z_log_msg2_claim(void)
 {
-	return (union log_msg2_generic *)mpsc_pbuf_claim(&log_buffer);
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+	return claim_oldest();
+#else
+	return (union log_msg2_generic *)mpsc_pbuf_claim(&log_buffer[0]);
+#endif
 }
 
 void z_log_msg2_free(union log_msg2_generic *msg)
 {
-	mpsc_pbuf_free(&log_buffer, (union mpsc_pbuf_generic *)msg);
+	mpsc_pbuf_free(msg_buffer(msg), (union mpsc_pbuf_generic *)msg);
 }
 
 
 bool z_log_msg2_pending(void)
 {
-	return mpsc_pbuf_is_pending(&log_buffer);
+	for (int i = 0; i < LOG_BUFFER_COUNT; i++) {
+#ifdef CONFIG_LOG_BUFFER_PER_CPU
+		if (claimed[i] != NULL) {
+			return true;
+		}
+#endif
+		if (mpsc_pbuf_is_pending(&log_buffer[i])) {
+			return true;
+		}
+	}
+
+	return false;
 }
 
 static void log_process_thread_timer_expiry_fn(struct k_timer *timer)
@@ -52,6 +52,84 @@ static inline void z_vrfy_z_log_msg2_static_create(const void *source,
 #include <syscalls/z_log_msg2_static_create_mrsh.c>
 #endif
 
+#ifdef CONFIG_LOG2_FMT_ID
+/* Strings in the log strings section or read only memory are resolved by
+ * address, so only other strings need to be copied into the message.
+ */
+static bool is_const_str(const char *str)
+{
+	extern const char __log_strings_start[];
+	extern const char __log_strings_end[];
+
+	return ((str >= __log_strings_start) && (str < __log_strings_end)) ||
+		z_log_is_rodata(str);
+}
+
+void z_log_msg2_static_str_create(const void *source,
+				  const struct log_msg2_desc desc,
+				  uint8_t *package, const void *data)
+{
+	/* Package header holds length of arguments in words, number of
+	 * appended strings and number of string positions which follow
+	 * the arguments.
+	 */
+	uint32_t args_len = package[0] * sizeof(int);
+	uint8_t *s_idx = &package[args_len];
+	uint8_t s_cnt = package[2];
+	int s_len[16];
+	struct log_msg2_desc out_desc = desc;
+	uint32_t strs_len = 0;
+	struct log_msg2 *msg;
+
+	__ASSERT_NO_MSG(s_cnt <= ARRAY_SIZE(s_len));
+
+	for (int i = 0; i < s_cnt; i++) {
+		const char *str = *(const char **)&package[s_idx[i] * sizeof(int)];
+
+		if (is_const_str(str)) {
+			s_len[i] = -1;
+		} else {
+			s_len[i] = strlen(str);
+			/* String is preceded by its position and terminated. */
+			strs_len += s_len[i] + 2;
+		}
+	}
+
+	out_desc.package_len = args_len + strs_len;
+	if (out_desc.package_len != args_len + strs_len) {
+		/* Does not fit in the descriptor */
+		z_log_dropped();
+		return;
+	}
+
+	msg = z_log_msg2_alloc(log_msg2_get_total_wlen(out_desc));
+	if (msg) {
+		uint8_t *dst = &msg->data[args_len];
+		uint8_t str_cnt = 0;
+
+		memcpy(msg->data, package, args_len);
+
+		for (int i = 0; i < s_cnt; i++) {
+			if (s_len[i] < 0) {
+				continue;
+			}
+
+			*dst++ = s_idx[i];
+			memcpy(dst, *(const char **)&package[s_idx[i] * sizeof(int)],
+			       s_len[i]);
+			dst += s_len[i];
+			*dst++ = '\0';
+			str_cnt++;
+		}
+
+		msg->data[1] = str_cnt;
+		msg->data[2] = 0;
+	}
+
+	z_log_msg2_finalize(msg, source, out_desc, data);
+}
+#endif /* CONFIG_LOG2_FMT_ID */
+
 void z_impl_z_log_msg2_runtime_vcreate(uint8_t domain_id, const void *source,
 				uint8_t level, const void *data, size_t dlen,
 				const char *fmt, va_list ap)
@@ -24,11 +24,79 @@ static void buffer_write(log_output_func_t outf, uint8_t *buf, size_t len,
 	} while (len != 0);
 }
 
+static uint32_t source_id_get(void *source)
+{
+	return (source != NULL) ?
+		(IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ?
+			log_dynamic_source_id(source) :
+			log_const_source_id(source)) :
+		0U;
+}
+
+#ifdef CONFIG_LOG2_FMT_ID
+/* Write message with the format string address and package header replaced
+ * by the offset of the format string in the log strings section.
+ *
+ * @return False if the format string is not in the log strings section.
+ */
+static bool fmt_id_msg_process(const struct log_output *output,
+			       struct log_msg2 *msg)
+{
+	extern const char __log_strings_start[];
+	extern const char __log_strings_end[];
+	struct log_dict_output_fmt_id_msg_hdr_t output_hdr;
+	size_t len;
+	uint8_t *package = log_msg2_get_package(msg, &len);
+	/* Package starts with a header and the format string address */
+	size_t skip = 2 * sizeof(char *);
+	const char *fmt;
+	uint32_t source_id = source_id_get((void *)log_msg2_get_source(msg));
+
+	if (len < skip || source_id > UINT16_MAX) {
+		return false;
+	}
+
+	fmt = ((const char **)package)[1];
+	if ((fmt < __log_strings_start) || (fmt >= __log_strings_end)) {
+		return false;
+	}
+
+	output_hdr.type = MSG_FMT_ID;
+	output_hdr.domain = msg->hdr.desc.domain;
+	output_hdr.level = msg->hdr.desc.level;
+	output_hdr.package_len = len - skip;
+	output_hdr.data_len = msg->hdr.desc.data_len;
+	output_hdr.source = source_id;
+	output_hdr.fmt_id = fmt - __log_strings_start;
+	output_hdr.timestamp = msg->hdr.timestamp;
+	output_hdr.args_wlen = package[0] - skip / sizeof(int);
+	output_hdr.str_cnt = package[1];
+
+	buffer_write(output->func, (uint8_t *)&output_hdr, sizeof(output_hdr),
+		     (void *)output);
+
+	if (len > skip) {
+		buffer_write(output->func, &package[skip], len - skip,
+			     (void *)output);
+	}
+
+	return true;
+}
+#endif
+
 void log_dict_output_msg2_process(const struct log_output *output,
 				  struct log_msg2 *msg, uint32_t flags)
 {
 	struct log_dict_output_normal_msg_hdr_t output_hdr;
 	void *source = (void *)log_msg2_get_source(msg);
+	size_t len;
+	uint8_t *data;
+
+#ifdef CONFIG_LOG2_FMT_ID
+	if (fmt_id_msg_process(output, msg)) {
+		goto write_data;
+	}
+#endif
 
 	/* Keep sync with header in struct log_msg2 */
 	output_hdr.type = MSG_NORMAL;
@@ -38,22 +106,20 @@ void log_dict_output_msg2_process(const struct log_output *output,
 	output_hdr.data_len = msg->hdr.desc.data_len;
 	output_hdr.timestamp = msg->hdr.timestamp;
 
-	output_hdr.source = (source != NULL) ?
-				(IS_ENABLED(CONFIG_LOG_RUNTIME_FILTERING) ?
-					log_dynamic_source_id(source) :
-					log_const_source_id(source)) :
-				0U;
+	output_hdr.source = source_id_get(source);
 
 	buffer_write(output->func, (uint8_t *)&output_hdr, sizeof(output_hdr),
 		     (void *)output);
 
-	size_t len;
-	uint8_t *data = log_msg2_get_package(msg, &len);
+	data = log_msg2_get_package(msg, &len);
 
 	if (len > 0U) {
 		buffer_write(output->func, data, len, (void *)output);
 	}
 
+#ifdef CONFIG_LOG2_FMT_ID
+write_data:
+#endif
 	data = log_msg2_get_data(msg, &len);
 	if (len > 0U) {
 		buffer_write(output->func, data, len, (void *)output);
@@ -59,6 +59,181 @@ static struct net_conn conns[CONFIG_NET_MAX_CONN];
 static sys_slist_t conn_unused;
 static sys_slist_t conn_used;
 
+#if defined(CONFIG_NET_CONN_HASH)
+/** Handlers with these flags set are kept in the 4-tuple hash */
+#define NET_CONN_HASH_SPEC (NET_CONN_REMOTE_ADDR_SPEC |	\
+			    NET_CONN_REMOTE_PORT_SPEC |	\
+			    NET_CONN_LOCAL_PORT_SPEC)
+
+static sys_slist_t conn_hash[CONFIG_NET_CONN_HASH_BUCKETS];
+
+/* Writers serialize on the spinlock and make the sequence odd while
+ * they modify the table or a hashed handler. Readers do not lock,
+ * they sample the sequence before and after the lookup and discard
+ * the result if a writer was active meanwhile.
+ */
+static struct k_spinlock conn_hash_lock;
+static atomic_t conn_hash_seq;
+
+/* The list walk in net_conn_input() picks a handler by rank, and stops
+ * considering others once it has picked one with a remote port. A hash
+ * hit is only the handler the walk would pick if no UDP or TCP handler
+ * outside the table has a remote port or a rank as high as the hit's.
+ * conn_unhashed counts those handlers by rank, and a hit must rank
+ * above conn_hash_floor.
+ */
+#define NET_CONN_RANK_IDX(_flags) \
+	(NET_CONN_RANK(_flags) / NET_CONN_REMOTE_PORT_SPEC)
+
+static uint16_t conn_unhashed[NET_CONN_RANK_IDX(0xff) + 1];
+static int16_t conn_hash_floor = -1;
+
+static uint32_t conn_hash_key(sa_family_t family, uint16_t proto,
+			      const void *remote_addr,
+			      uint16_t remote_port, uint16_t local_port)
+{
+	const uint32_t *addr = remote_addr;
+	int words = family == AF_INET6 ? 4 : 1;
+	uint32_t h;
+
+	h = (((uint32_t)remote_port << 16) | local_port) ^ proto;
+
+	for (int i = 0; i < words; i++) {
+		h = (h ^ UNALIGNED_GET(&addr[i])) * 0x9E3779B1U;
+	}
+
+	/* The multiplications only carry entropy upwards, so pick the
+	 * bucket from the top bits.
+	 */
+	return ((uint64_t)h * CONFIG_NET_CONN_HASH_BUCKETS) >> 32;
+}
+
+static sys_slist_t *conn_hash_bucket(struct net_conn *conn)
+{
+	const void *addr;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) &&
+	    conn->remote_addr.sa_family == AF_INET6) {
+		addr = &net_sin6(&conn->remote_addr)->sin6_addr;
+	} else {
+		addr = &net_sin(&conn->remote_addr)->sin_addr;
+	}
+
+	return &conn_hash[conn_hash_key(conn->remote_addr.sa_family,
+					conn->proto, addr,
+					net_sin(&conn->remote_addr)->sin_port,
+					net_sin(&conn->local_addr)->sin_port)];
+}
+
+static k_spinlock_key_t conn_hash_write_begin(void)
+{
+	k_spinlock_key_t key = k_spin_lock(&conn_hash_lock);
+
+	atomic_inc(&conn_hash_seq);
+
+	return key;
+}
+
+static void conn_hash_write_end(k_spinlock_key_t key)
+{
+	atomic_inc(&conn_hash_seq);
+
+	k_spin_unlock(&conn_hash_lock, key);
+}
+
+static bool conn_is_ip(struct net_conn *conn)
+{
+	return conn->proto == IPPROTO_UDP || conn->proto == IPPROTO_TCP;
+}
+
+static bool conn_is_hashed(struct net_conn *conn)
+{
+	return (conn->flags & NET_CONN_HASH_SPEC) == NET_CONN_HASH_SPEC;
+}
+
+/* Called with conn_hash_lock held */
+static void conn_hash_floor_update(void)
+{
+	int16_t floor = -1;
+
+	for (int i = 0; i < ARRAY_SIZE(conn_unhashed); i++) {
+		uint8_t rank = i * NET_CONN_REMOTE_PORT_SPEC;
+
+		if (conn_unhashed[i] == 0U) {
+			continue;
+		}
+
+		if (rank & NET_CONN_REMOTE_PORT_SPEC) {
+			/* No hit can be trusted */
+			floor = INT16_MAX;
+			break;
+		}
+
+		floor = MAX(floor, rank);
+	}
+
+	conn_hash_floor = floor;
+}
+
+static void conn_hash_add(struct net_conn *conn)
+{
+	k_spinlock_key_t key;
+
+	if (!conn_is_ip(conn)) {
+		return;
+	}
+
+	key = conn_hash_write_begin();
+	if (conn_is_hashed(conn)) {
+		sys_slist_prepend(conn_hash_bucket(conn), &conn->hash_node);
+	} else {
+		conn_unhashed[NET_CONN_RANK_IDX(conn->flags)]++;
+		conn_hash_floor_update();
+	}
+	conn_hash_write_end(key);
+}
+
+static void conn_hash_del(struct net_conn *conn)
+{
+	k_spinlock_key_t key;
+
+	if (!conn_is_ip(conn)) {
+		return;
+	}
+
+	key = conn_hash_write_begin();
+	if (conn_is_hashed(conn)) {
+		sys_slist_find_and_remove(conn_hash_bucket(conn),
+					  &conn->hash_node);
+	} else {
+		conn_unhashed[NET_CONN_RANK_IDX(conn->flags)]--;
+		conn_hash_floor_update();
+	}
+	conn_hash_write_end(key);
+}
+
+static void conn_set_cb(struct net_conn *conn, net_conn_cb_t cb,
+			void *user_data)
+{
+	k_spinlock_key_t key = conn_hash_write_begin();
+
+	conn->cb = cb;
+	conn->user_data = user_data;
+
+	conn_hash_write_end(key);
+}
+#else
+#define conn_hash_add(...)
+#define conn_hash_del(...)
+
+static void conn_set_cb(struct net_conn *conn, net_conn_cb_t cb,
+			void *user_data)
+{
+	conn->cb = cb;
+	conn->user_data = user_data;
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
 #if (CONFIG_NET_CONN_LOG_LEVEL >= LOG_LEVEL_DBG)
 static inline
 void conn_register_debug(struct net_conn *conn,
@@ -132,6 +307,8 @@ static void conn_set_used(struct net_conn *conn)
 	conn->flags |= NET_CONN_IN_USE;
 
 	sys_slist_prepend(&conn_used, &conn->node);
+
+	conn_hash_add(conn);
 }
 
 static void conn_set_unused(struct net_conn *conn)
@@ -379,6 +556,8 @@ int net_conn_unregister(struct net_conn_handle *handle)
 
 	NET_DBG("Connection handler %p removed", conn);
 
+	conn_hash_del(conn);
+
 	sys_slist_find_and_remove(&conn_used, &conn->node);
 
 	conn_set_unused(conn);
@@ -402,8 +581,7 @@ int net_conn_change_callback(struct net_conn_handle *handle,
 	NET_DBG("[%zu] connection handler %p changed callback",
 		conn - conns, conn);
 
-	conn->cb = cb;
-	conn->user_data = user_data;
+	conn_set_cb(conn, cb, user_data);
 
 	return 0;
 }
@@ -459,6 +637,104 @@ static bool conn_addr_cmp(struct net_pkt *pkt,
 	return true;
 }
 
+#if defined(CONFIG_NET_CONN_HASH)
+/* Look up a fully specified handler for a unicast UDP or TCP packet.
+ * Returns NULL when there is none, when the list walk could pick another
+ * handler, or when the table was modified during the lookup; the caller
+ * then does the full list walk.
+ */
+static struct net_conn *conn_hash_find(struct net_pkt *pkt,
+				       union net_ip_header *ip_hdr,
+				       uint8_t proto,
+				       uint16_t src_port,
+				       uint16_t dst_port,
+				       net_conn_cb_t *cb,
+				       void **user_data)
+{
+	struct net_conn *match = NULL;
+	int16_t rank = -1;
+	int budget = CONFIG_NET_MAX_CONN;
+	atomic_val_t seq;
+	const void *src;
+	sys_slist_t *bucket;
+	sys_snode_t *node;
+
+	if (IS_ENABLED(CONFIG_NET_IPV6) && net_pkt_family(pkt) == AF_INET6) {
+		src = &ip_hdr->ipv6->src;
+	} else {
+		src = &ip_hdr->ipv4->src;
+	}
+
+	bucket = &conn_hash[conn_hash_key(net_pkt_family(pkt), proto, src,
+					  src_port, dst_port)];
+
+	/* atomic_get() is a sequentially consistent load, the reads below
+	 * are not done before it.
+	 */
+	seq = atomic_get(&conn_hash_seq);
+	if (seq & 1) {
+		return NULL;
+	}
+
+	/* A handler can be moved between buckets or to the unused list
+	 * while we walk, but all nodes live in conns[] so following them
+	 * is safe, and the budget bounds the walk if it ends up looping.
+	 */
+	for (node = sys_slist_peek_head(bucket); node && budget--;
+	     node = sys_slist_peek_next(node)) {
+		struct net_conn *conn = CONTAINER_OF(node, struct net_conn,
+						     hash_node);
+
+		if (conn->proto != proto ||
+		    conn->family != net_pkt_family(pkt)) {
+			continue;
+		}
+
+		if (net_sin(&conn->remote_addr)->sin_port != src_port ||
+		    net_sin(&conn->local_addr)->sin_port != dst_port) {
+			continue;
+		}
+
+		if (!conn_addr_cmp(pkt, ip_hdr, &conn->remote_addr, true)) {
+			continue;
+		}
+
+		if ((conn->flags & NET_CONN_LOCAL_ADDR_SET) &&
+		    !conn_addr_cmp(pkt, ip_hdr, &conn->local_addr, false)) {
+			continue;
+		}
+
+		if (conn->context != NULL &&
+		    net_context_is_bound_to_iface(conn->context) &&
+		    net_pkt_iface(pkt) != net_context_get_iface(conn->context)) {
+			continue;
+		}
+
+		/* The bucket is in the order of the list, and the walk
+		 * keeps the first match that has a remote port.
+		 */
+		rank = NET_CONN_RANK(conn->flags);
+		match = conn;
+		*cb = conn->cb;
+		*user_data = conn->user_data;
+		break;
+	}
+
+	if (rank <= conn_hash_floor) {
+		match = NULL;
+	}
+
+	/* Full barrier, pairs with the ones of the writer: the reads above
+	 * are done before the sequence is checked again.
+	 */
+	if (atomic_or(&conn_hash_seq, 0) != seq) {
+		return NULL;
+	}
+
+	return match;
+}
+#endif /* CONFIG_NET_CONN_HASH */
+
 static inline void conn_send_icmp_error(struct net_pkt *pkt)
 {
 	if (IS_ENABLED(CONFIG_NET_DISABLE_ICMP_DESTINATION_UNREACHABLE)) {
@@ -627,6 +903,32 @@ enum net_verdict net_conn_input(struct net_pkt *pkt,
 		}
 	}
 
+#if defined(CONFIG_NET_CONN_HASH)
+	if ((proto == IPPROTO_UDP || proto == IPPROTO_TCP) &&
+	    (net_pkt_family(pkt) == AF_INET ||
+	     net_pkt_family(pkt) == AF_INET6) &&
+	    !is_mcast_pkt && !is_bcast_pkt) {
+		net_conn_cb_t cb = NULL;
+		void *user_data = NULL;
+
+		conn = conn_hash_find(pkt, ip_hdr, proto, src_port, dst_port,
+				      &cb, &user_data);
+		if (conn) {
+			NET_DBG("[%p] hash match found cb %p ud %p", conn,
+				cb, user_data);
+
+			if (cb(conn, pkt, ip_hdr, proto_hdr,
+			       user_data) == NET_DROP) {
+				goto drop;
+			}
+
+			net_stats_update_per_proto_recv(pkt_iface, proto);
+
+			return NET_OK;
+		}
+	}
+#endif /* CONFIG_NET_CONN_HASH */
+
 	SYS_SLIST_FOR_EACH_CONTAINER(&conn_used, conn, node) {
 		if (conn->context != NULL &&
 		    net_context_is_bound_to_iface(conn->context) &&
@@ -860,6 +1162,12 @@ void net_conn_init(void)
 	sys_slist_init(&conn_unused);
 	sys_slist_init(&conn_used);
 
+#if defined(CONFIG_NET_CONN_HASH)
+	for (i = 0; i < CONFIG_NET_CONN_HASH_BUCKETS; i++) {
+		sys_slist_init(&conn_hash[i]);
+	}
+#endif
+
 	for (i = 0; i < CONFIG_NET_MAX_CONN; i++) {
 		sys_slist_prepend(&conn_unused, &conns[i].node);
 	}
@@ -1245,33 +1245,65 @@ static int get_context_sndtimeo(struct net_context *context,
 #endif
 }
 
+/* Write data to net_pkt, and if chksum is not NULL add the sum of it,
+ * found offset bytes into the payload, to *chksum.
+ */
+static int context_write_chunk(struct net_pkt *pkt, const void *data,
+			       size_t len, uint16_t *chksum, size_t offset)
+{
+	uint16_t sum;
+	int ret;
+
+	if (!chksum) {
+		return net_pkt_write(pkt, data, len);
+	}
+
+	ret = net_pkt_write_chksum(pkt, data, len, &sum);
+	if (ret < 0) {
+		return ret;
+	}
+
+	*chksum = net_chksum_add(*chksum, sum, offset);
+
+	return 0;
+}
+
 /* If buf is not NULL, then use it. Otherwise read the data to be written
- * to net_pkt from msghdr.
+ * to net_pkt from msghdr. If chksum is not NULL, it is set to the sum of
+ * the written data.
  */
 static int context_write_data(struct net_pkt *pkt, const void *buf,
-			      int buf_len, const struct msghdr *msghdr)
+			      int buf_len, const struct msghdr *msghdr,
+			      uint16_t *chksum)
 {
+	size_t offset = 0;
 	int ret = 0;
 
+	if (chksum) {
+		*chksum = 0U;
+	}
+
 	if (msghdr) {
 		int i;
 
 		for (i = 0; i < msghdr->msg_iovlen; i++) {
 			int len = MIN(msghdr->msg_iov[i].iov_len, buf_len);
 
-			ret = net_pkt_write(pkt, msghdr->msg_iov[i].iov_base,
-					    len);
+			ret = context_write_chunk(pkt,
+						  msghdr->msg_iov[i].iov_base,
+						  len, chksum, offset);
 			if (ret < 0) {
 				break;
 			}
 
+			offset += len;
 			buf_len -= len;
 			if (buf_len == 0) {
 				break;
 			}
 		}
 	} else {
-		ret = net_pkt_write(pkt, buf, buf_len);
+		ret = context_write_chunk(pkt, buf, buf_len, chksum, offset);
 	}
 
 	return ret;
@@ -1282,6 +1314,7 @@ static int context_setup_udp_packet(struct net_context *context,
 				    const void *buf,
 				    size_t len,
 				    const struct msghdr *msg,
+				    struct net_buf *payload,
 				    const struct sockaddr *dst_addr,
 				    socklen_t addrlen)
 {
@@ -1323,7 +1356,30 @@ static int context_setup_udp_packet(struct net_context *context,
 		return ret;
 	}
 
-	ret = context_write_data(pkt, buf, len, msg);
+	if (payload) {
+		/* The packet takes its own reference, the caller's one is
+		 * only released once the packet has been sent.
+		 */
+		net_pkt_frag_add(pkt, net_buf_ref(payload));
+
+		return 0;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_UDP_CHECKSUM_ON_COPY) &&
+	    net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
+		uint16_t chksum;
+
+		ret = context_write_data(pkt, buf, len, msg, &chksum);
+		if (ret) {
+			return ret;
+		}
+
+		net_pkt_set_payload_chksum(pkt, chksum);
+
+		return 0;
+	}
+
+	ret = context_write_data(pkt, buf, len, msg, NULL);
 	if (ret) {
 		return ret;
 	}
@@ -1403,9 +1459,11 @@ static void set_pkt_txtime(struct net_pkt *pkt, const struct msghdr *msghdr)
 	}
 }
 
+/* If payload is not NULL, it is sent as is instead of copying buf */
 static int context_sendto(struct net_context *context,
 			  const void *buf,
 			  size_t len,
+			  struct net_buf *payload,
 			  const struct sockaddr *dst_addr,
 			  socklen_t addrlen,
 			  net_context_send_cb_t cb,
@@ -1621,15 +1679,29 @@ static int context_sendto(struct net_context *context,
 		return -ENETDOWN;
 	}
 
-	pkt = context_alloc_pkt(context, len, PKT_WAIT_TIME);
+	if (payload) {
+		/* Only UDP packets can be built around a buffer chain */
+		if (!IS_ENABLED(CONFIG_NET_UDP) ||
+		    net_context_get_ip_proto(context) != IPPROTO_UDP ||
+		    (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
+		     net_if_is_ip_offloaded(iface))) {
+			return -EOPNOTSUPP;
+		}
+
+		len = net_buf_frags_len(payload);
+	}
+
+	pkt = context_alloc_pkt(context, payload ? 0 : len, PKT_WAIT_TIME);
 	if (!pkt) {
 		return -ENOBUFS;
 	}
 
-	tmp_len = net_pkt_available_payload_buffer(
+	if (!payload) {
+		tmp_len = net_pkt_available_payload_buffer(
 				pkt, net_context_get_ip_proto(context));
-	if (tmp_len < len) {
-		len = tmp_len;
+		if (tmp_len < len) {
+			len = tmp_len;
+		}
 	}
 
 	context->send_cb = cb;
@@ -1658,7 +1730,7 @@ static int context_sendto(struct net_context *context,
 
 	if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
 	    net_if_is_ip_offloaded(net_context_get_iface(context))) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1675,8 +1747,9 @@ static int context_sendto(struct net_context *context,
 		}
 	} else if (IS_ENABLED(CONFIG_NET_UDP) &&
 	    net_context_get_ip_proto(context) == IPPROTO_UDP) {
-		ret = context_setup_udp_packet(context, pkt, buf, len, msghdr,
-					       dst_addr, addrlen);
+		ret = context_setup_udp_packet(context, pkt, buf,
+					       payload ? 0 : len, msghdr,
+					       payload, dst_addr, addrlen);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1687,7 +1760,7 @@ static int context_sendto(struct net_context *context,
 	} else if (IS_ENABLED(CONFIG_NET_TCP) &&
 		   net_context_get_ip_proto(context) == IPPROTO_TCP) {
 
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1701,7 +1774,7 @@ static int context_sendto(struct net_context *context,
 		ret = net_tcp_send_data(context, cb, user_data);
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_PACKET) &&
 		   net_context_get_family(context) == AF_PACKET) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1717,7 +1790,7 @@ static int context_sendto(struct net_context *context,
 	} else if (IS_ENABLED(CONFIG_NET_SOCKETS_CAN) &&
 		   net_context_get_family(context) == AF_CAN &&
 		   net_context_get_ip_proto(context) == CAN_RAW) {
-		ret = context_write_data(pkt, buf, len, msghdr);
+		ret = context_write_data(pkt, buf, len, msghdr, NULL);
 		if (ret < 0) {
 			goto fail;
 		}
@@ -1735,6 +1808,10 @@ static int context_sendto(struct net_context *context,
 		goto fail;
 	}
 
+	if (payload) {
+		net_buf_unref(payload);
+	}
+
 	return len;
 fail:
 	net_pkt_unref(pkt);
@@ -1777,7 +1854,7 @@ int net_context_send(struct net_context *context,
 		addrlen = 0;
 	}
 
-	ret = context_sendto(context, buf, len, &context->remote,
+	ret = context_sendto(context, buf, len, NULL, &context->remote,
 			     addrlen, cb, timeout, user_data, false);
 unlock:
 	k_mutex_unlock(&context->lock);
@@ -1796,7 +1873,7 @@ int net_context_sendmsg(struct net_context *context,
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
-	ret = context_sendto(context, msghdr, 0, NULL, 0,
+	ret = context_sendto(context, msghdr, 0, NULL, NULL, 0,
 			     cb, timeout, user_data, true);
 
 	k_mutex_unlock(&context->lock);
@@ -1817,7 +1894,7 @@ int net_context_sendto(struct net_context *context,
 
 	k_mutex_lock(&context->lock, K_FOREVER);
 
-	ret = context_sendto(context, buf, len, dst_addr, addrlen,
+	ret = context_sendto(context, buf, len, NULL, dst_addr, addrlen,
 			     cb, timeout, user_data, true);
 
 	k_mutex_unlock(&context->lock);
@@ -1825,6 +1902,39 @@ int net_context_sendto(struct net_context *context,
 	return ret;
 }
 
+int net_context_sendto_buf(struct net_context *context,
+			   struct net_buf *buf,
+			   const struct sockaddr *dst_addr,
+			   socklen_t addrlen,
+			   net_context_send_cb_t cb,
+			   k_timeout_t timeout,
+			   void *user_data)
+{
+	int ret;
+
+	k_mutex_lock(&context->lock, K_FOREVER);
+
+	if (!dst_addr) {
+		if (!(context->flags & NET_CONTEXT_REMOTE_ADDR_SET) ||
+		    !net_sin(&context->remote)->sin_port) {
+			ret = -EDESTADDRREQ;
+			goto unlock;
+		}
+
+		dst_addr = &context->remote;
+		addrlen = net_context_get_family(context) == AF_INET6 ?
+			  sizeof(struct sockaddr_in6) :
+			  sizeof(struct sockaddr_in);
+	}
+
+	ret = context_sendto(context, NULL, 0, buf, dst_addr, addrlen,
+			     cb, timeout, user_data, true);
+unlock:
+	k_mutex_unlock(&context->lock);
+
+	return ret;
+}
+
 enum net_verdict net_context_packet_received(struct net_conn *conn,
 					     struct net_pkt *pkt,
 					     union net_ip_header *ip_hdr,
@@ -427,6 +427,90 @@ int net_recv_data(struct net_if *iface, struct net_pkt *pkt)
 	return 0;
 }
 
+static void net_queue_rx_burst(struct net_if *iface, struct net_pkt **pkts,
+			       size_t count)
+{
+	size_t start = 0;
+
+	for (size_t i = 0; i < count; i++) {
+		uint8_t prio = net_pkt_priority(pkts[i]);
+		uint8_t tc = net_rx_priority2tc(prio);
+
+#if defined(CONFIG_NET_STATISTICS)
+		net_stats_update_tc_recv_pkt(iface, tc);
+		net_stats_update_tc_recv_bytes(iface, tc,
+					       net_pkt_get_len(pkts[i]));
+		net_stats_update_tc_recv_priority(iface, tc, prio);
+#endif
+
+		if (NET_TC_RX_COUNT == 0) {
+			net_process_rx_packet(pkts[i]);
+			continue;
+		}
+
+		/* Queue each run of packets with the same traffic class
+		 * at once, this keeps the packet order within a class.
+		 */
+		if (i + 1 == count ||
+		    net_rx_priority2tc(net_pkt_priority(pkts[i + 1])) != tc) {
+			net_tc_submit_burst_to_rx_queue(tc, &pkts[start],
+							i + 1 - start);
+			start = i + 1;
+		}
+	}
+}
+
+int net_recv_data_burst(struct net_if *iface, struct net_pkt **pkts,
+			size_t count)
+{
+	size_t i;
+
+	if (!pkts || !iface) {
+		return -EINVAL;
+	}
+
+	if (!net_if_flag_is_set(iface, NET_IF_UP)) {
+		return -ENETDOWN;
+	}
+
+	for (i = 0; i < count; i++) {
+		struct net_pkt *pkt = pkts[i];
+
+		if (!pkt) {
+			break;
+		}
+
+		if (net_pkt_is_empty(pkt)) {
+			if (i == 0) {
+				return -ENODATA;
+			}
+
+			break;
+		}
+
+		net_pkt_set_overwrite(pkt, true);
+		net_pkt_cursor_init(pkt);
+
+		NET_DBG("prio %d iface %p pkt %p len %zu",
+			net_pkt_priority(pkt), iface, pkt,
+			net_pkt_get_len(pkt));
+
+		if (IS_ENABLED(CONFIG_NET_ROUTING)) {
+			net_pkt_set_orig_iface(pkt, iface);
+		}
+
+		net_pkt_set_iface(pkt, iface);
+	}
+
+	if (i == 0) {
+		return count ? -EINVAL : 0;
+	}
+
+	net_queue_rx_burst(iface, pkts, i);
+
+	return i;
+}
+
 static inline void l3_init(void)
 {
 	net_icmpv4_init();
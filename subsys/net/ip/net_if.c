@@ -368,6 +368,110 @@ void net_if_queue_tx(struct net_if *iface, struct net_pkt *pkt)
 	}
 }
 
+void net_if_queue_tx_burst(struct net_if *iface, struct net_pkt **pkts,
+			   size_t count)
+{
+	size_t start = 0;
+
+#if defined(CONFIG_NET_BURST)
+	bool burst = NET_TC_TX_COUNT == 0 && net_if_tx_burst_begin(iface);
+#endif
+
+	for (size_t i = 0; i < count; i++) {
+		struct net_pkt *pkt = pkts[i];
+		uint8_t prio = net_pkt_priority(pkt);
+		uint8_t tc = net_tx_priority2tc(prio);
+
+		if ((IS_ENABLED(CONFIG_NET_TC_SKIP_FOR_HIGH_PRIO) &&
+		     prio == NET_PRIORITY_CA) || NET_TC_TX_COUNT == 0) {
+			/* Queue the run collected so far first to keep
+			 * the order of the packets.
+			 */
+			if (i > start) {
+				net_tc_submit_burst_to_tx_queue(
+					net_tx_priority2tc(
+					      net_pkt_priority(pkts[start])),
+					&pkts[start], i - start);
+			}
+
+			net_if_queue_tx(iface, pkt);
+			start = i + 1;
+			continue;
+		}
+
+		net_stats_update_tc_sent_pkt(iface, tc);
+		net_stats_update_tc_sent_bytes(iface, tc, net_pkt_get_len(pkt));
+		net_stats_update_tc_sent_priority(iface, tc, prio);
+
+#if defined(CONFIG_NET_POWER_MANAGEMENT)
+		iface->tx_pending++;
+#endif
+
+		if (i + 1 == count ||
+		    net_tx_priority2tc(net_pkt_priority(pkts[i + 1])) != tc) {
+			net_tc_submit_burst_to_tx_queue(tc, &pkts[start],
+							i + 1 - start);
+			start = i + 1;
+		}
+	}
+
+#if defined(CONFIG_NET_BURST)
+	if (burst) {
+		net_if_tx_burst_end(iface);
+	}
+#endif
+}
+
+#if defined(CONFIG_NET_BURST)
+bool net_if_tx_burst_begin(struct net_if *iface)
+{
+	if (k_is_in_isr()) {
+		return false;
+	}
+
+	return atomic_ptr_cas(&iface->if_dev->tx_burst.owner, NULL,
+			      k_current_get());
+}
+
+static void tx_burst_flush(struct net_if *iface)
+{
+	struct net_if_dev *dev = iface->if_dev;
+
+	if (dev->tx_burst.count) {
+		dev->tx_burst.flush(iface, dev->tx_burst.pkts,
+				    dev->tx_burst.count);
+		dev->tx_burst.count = 0U;
+	}
+}
+
+void net_if_tx_burst_end(struct net_if *iface)
+{
+	tx_burst_flush(iface);
+
+	atomic_ptr_set(&iface->if_dev->tx_burst.owner, NULL);
+}
+
+bool net_if_tx_burst_add(struct net_if *iface, struct net_pkt *pkt,
+			 net_if_tx_burst_flush_t flush)
+{
+	struct net_if_dev *dev = iface->if_dev;
+
+	if (k_is_in_isr() ||
+	    atomic_ptr_get(&dev->tx_burst.owner) != k_current_get()) {
+		return false;
+	}
+
+	if (dev->tx_burst.count == ARRAY_SIZE(dev->tx_burst.pkts)) {
+		tx_burst_flush(iface);
+	}
+
+	dev->tx_burst.flush = flush;
+	dev->tx_burst.pkts[dev->tx_burst.count++] = pkt;
+
+	return true;
+}
+#endif /* CONFIG_NET_BURST */
+
 void net_if_stats_reset(struct net_if *iface)
 {
 #if defined(CONFIG_NET_STATISTICS_PER_INTERFACE)
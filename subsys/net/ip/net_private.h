@@ -90,6 +90,14 @@ static inline enum net_verdict net_ipv6_input(struct net_pkt *pkt,
 #endif
 extern bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt);
 extern void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt);
+extern void net_tc_submit_burst_to_tx_queue(uint8_t tc, struct net_pkt **pkts,
+					    size_t count);
+extern void net_tc_submit_burst_to_rx_queue(uint8_t tc, struct net_pkt **pkts,
+					    size_t count);
+#if defined(CONFIG_NET_BURST)
+extern bool net_if_tx_burst_begin(struct net_if *iface);
+extern void net_if_tx_burst_end(struct net_if *iface);
+#endif
 extern enum net_verdict net_promisc_mode_input(struct net_pkt *pkt);
 
 char *net_sprint_addr(sa_family_t af, const void *addr);
@@ -144,6 +152,46 @@ extern char *net_sprint_ll_addr_buf(const uint8_t *ll, uint8_t ll_len,
 				    char *buf, int buflen);
 extern uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto);
 
+/* Like net_calc_chksum(), but only hdr_len bytes after the IP header are
+ * read from the packet and payload_sum, the sum of the rest of the
+ * packet as returned by net_pkt_write_chksum(), is added to them.
+ */
+uint16_t net_calc_chksum_hdr(struct net_pkt *pkt, uint8_t proto,
+			     size_t hdr_len, uint16_t payload_sum);
+
+/* Copy len bytes from src to dst and return their one's complement sum */
+uint16_t net_calc_chksum_copy(void *dst, const void *src, size_t len);
+
+/* Add the sum of a block that starts offset bytes into the summed data */
+uint16_t net_chksum_add(uint16_t sum, uint16_t part, size_t offset);
+
+/* Write data to the packet like net_pkt_write(), and set *chksum to the
+ * one's complement sum of it, computed while copying.
+ */
+int net_pkt_write_chksum(struct net_pkt *pkt, const void *data, size_t length,
+			 uint16_t *chksum);
+
+/* Update a checksum field, in network byte order, for len bytes of the
+ * covered data changing from old_data to new_data (RFC 1624), e.g. when
+ * rewriting an address.  The offset of the data must be even.
+ */
+uint16_t net_chksum_update(uint16_t chksum, const void *old_data,
+			   const void *new_data, size_t len);
+
+/* Same as net_chksum_update() for a single 16-bit word, all in network
+ * byte order.
+ */
+static inline uint16_t net_chksum_update16(uint16_t chksum, uint16_t old_val,
+					   uint16_t new_val)
+{
+	uint32_t sum = (uint16_t)~chksum + (uint16_t)~old_val + new_val;
+
+	sum = (sum & 0xffff) + (sum >> 16);
+	sum = (sum & 0xffff) + (sum >> 16);
+
+	return ~sum;
+}
+
 /**
  * @brief Deliver the incoming packet through the recv_cb of the net_context
  *        to the upper layers
@@ -36,15 +36,59 @@ K_KERNEL_STACK_ARRAY_DEFINE(rx_stack, NET_TC_RX_COUNT,
 static struct net_traffic_class tx_classes[NET_TC_TX_COUNT];
 #endif
 
-#if NET_TC_RX_COUNT > 0
+#if defined(CONFIG_NET_TC_RX_MPMCQ)
+BUILD_ASSERT((CONFIG_NET_TC_RX_MPMCQ_LEN &
+	      (CONFIG_NET_TC_RX_MPMCQ_LEN - 1)) == 0,
+	     "Rx traffic class queue length must be a power of 2");
+
+/* Like struct net_traffic_class, with a queue in place of the fifo */
+struct net_rx_traffic_class {
+	struct k_mpmcq queue;
+	struct k_thread handler;
+};
+
+static struct net_rx_traffic_class rx_classes[NET_TC_RX_COUNT];
+static struct k_mpmcq_slot rx_slots[NET_TC_RX_COUNT]
+				   [CONFIG_NET_TC_RX_MPMCQ_LEN];
+
+static void submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
+{
+	if (k_mpmcq_put(&rx_classes[tc].queue, pkt, K_NO_WAIT) < 0) {
+		NET_DBG("Rx queue %d full, dropping pkt %p", tc, pkt);
+		net_stats_update_processing_error(net_pkt_iface(pkt));
+		net_pkt_unref(pkt);
+	}
+}
+#elif NET_TC_RX_COUNT > 0
 static struct net_traffic_class rx_classes[NET_TC_RX_COUNT];
 #endif
 
-#if NET_TC_RX_COUNT > 0 || NET_TC_TX_COUNT > 0
+#if NET_TC_TX_COUNT > 0 || \
+	(NET_TC_RX_COUNT > 0 && !defined(CONFIG_NET_TC_RX_MPMCQ))
 static void submit_to_queue(struct k_fifo *queue, struct net_pkt *pkt)
 {
 	k_fifo_put(queue, pkt);
 }
+
+/* Link the packets through their fifo reserved word and append them
+ * all at once, so that the queue lock is taken and the handler thread
+ * woken up only once.
+ */
+static void submit_burst_to_queue(struct k_fifo *queue, struct net_pkt **pkts,
+				  size_t count, bool tx)
+{
+	for (size_t i = 0; i < count; i++) {
+		if (tx) {
+			net_pkt_set_tx_stats_tick(pkts[i], k_cycle_get_32());
+		} else {
+			net_pkt_set_rx_stats_tick(pkts[i], k_cycle_get_32());
+		}
+
+		*(void **)pkts[i] = i + 1 < count ? pkts[i + 1] : NULL;
+	}
+
+	k_fifo_put_list(queue, pkts[0], pkts[count - 1]);
+}
 #endif
 
 bool net_tc_submit_to_tx_queue(uint8_t tc, struct net_pkt *pkt)
@@ -65,13 +109,47 @@ void net_tc_submit_to_rx_queue(uint8_t tc, struct net_pkt *pkt)
 #if NET_TC_RX_COUNT > 0
 	net_pkt_set_rx_stats_tick(pkt, k_cycle_get_32());
 
+#if defined(CONFIG_NET_TC_RX_MPMCQ)
+	submit_to_rx_queue(tc, pkt);
+#else
 	submit_to_queue(&rx_classes[tc].fifo, pkt);
+#endif
 #else
 	ARG_UNUSED(tc);
 	ARG_UNUSED(pkt);
 #endif
 }
 
+void net_tc_submit_burst_to_tx_queue(uint8_t tc, struct net_pkt **pkts,
+				     size_t count)
+{
+#if NET_TC_TX_COUNT > 0
+	submit_burst_to_queue(&tx_classes[tc].fifo, pkts, count, true);
+#else
+	ARG_UNUSED(tc);
+	ARG_UNUSED(pkts);
+	ARG_UNUSED(count);
+#endif
+}
+
+void net_tc_submit_burst_to_rx_queue(uint8_t tc, struct net_pkt **pkts,
+				     size_t count)
+{
+#if NET_TC_RX_COUNT > 0 && defined(CONFIG_NET_TC_RX_MPMCQ)
+	/* There is no lock to amortize, queue the packets one by one */
+	for (size_t i = 0; i < count; i++) {
+		net_pkt_set_rx_stats_tick(pkts[i], k_cycle_get_32());
+		submit_to_rx_queue(tc, pkts[i]);
+	}
+#elif NET_TC_RX_COUNT > 0
+	submit_burst_to_queue(&rx_classes[tc].fifo, pkts, count, false);
+#else
+	ARG_UNUSED(tc);
+	ARG_UNUSED(pkts);
+	ARG_UNUSED(count);
+#endif
+}
+
 int net_tx_priority2tc(enum net_priority prio)
 {
 #if NET_TC_TX_COUNT > 0
@@ -237,6 +315,21 @@ static void net_tc_rx_stats_priority_setup(struct net_if *iface,
 #endif
 
 #if NET_TC_RX_COUNT > 0
+#if defined(CONFIG_NET_TC_RX_MPMCQ)
+static void tc_rx_handler(struct k_mpmcq *queue)
+{
+	struct net_pkt *pkt;
+
+	while (1) {
+		pkt = k_mpmcq_get(queue, K_FOREVER);
+		if (pkt == NULL) {
+			continue;
+		}
+
+		net_process_rx_packet(pkt);
+	}
+}
+#else
 static void tc_rx_handler(struct k_fifo *fifo)
 {
 	struct net_pkt *pkt;
@@ -251,6 +344,7 @@ static void tc_rx_handler(struct k_fifo *fifo)
 	}
 }
 #endif
+#endif
 
 #if NET_TC_TX_COUNT > 0
 static void tc_tx_handler(struct k_fifo *fifo)
@@ -263,7 +357,38 @@ static void tc_tx_handler(struct k_fifo *fifo)
 			continue;
 		}
 
+#if defined(CONFIG_NET_BURST)
+		/* Send whatever is queued for the same interface as one
+		 * burst, the L2 hands it to the driver when we are done.
+		 */
+		struct net_if *iface = net_pkt_iface(pkt);
+		bool burst = net_if_tx_burst_begin(iface);
+		int budget = CONFIG_NET_BURST_SIZE;
+
+		while (true) {
+			net_process_tx_packet(pkt);
+
+			if (!burst || --budget == 0) {
+				break;
+			}
+
+			/* We are the only consumer of this fifo, so the
+			 * peeked packet is the one we get.
+			 */
+			pkt = k_fifo_peek_head(fifo);
+			if (pkt == NULL || net_pkt_iface(pkt) != iface) {
+				break;
+			}
+
+			pkt = k_fifo_get(fifo, K_NO_WAIT);
+		}
+
+		if (burst) {
+			net_if_tx_burst_end(iface);
+		}
+#else
 		net_process_tx_packet(pkt);
+#endif
 	}
 }
 #endif
@@ -363,12 +488,21 @@ void net_tc_rx_init(void)
 							"coop" : "preempt",
 			priority);
 
+#if defined(CONFIG_NET_TC_RX_MPMCQ)
+		void *queue = &rx_classes[i].queue;
+
+		k_mpmcq_init(&rx_classes[i].queue, rx_slots[i],
+			     CONFIG_NET_TC_RX_MPMCQ_LEN);
+#else
+		void *queue = &rx_classes[i].fifo;
+
 		k_fifo_init(&rx_classes[i].fifo);
+#endif
 
 		tid = k_thread_create(&rx_classes[i].handler, rx_stack[i],
 				      K_KERNEL_STACK_SIZEOF(rx_stack[i]),
 				      (k_thread_entry_t)tc_rx_handler,
-				      &rx_classes[i].fifo, NULL, NULL,
+				      queue, NULL, NULL,
 				      priority, 0, K_FOREVER);
 		if (!tid) {
 			NET_ERR("Cannot create TC handler thread %d", i);
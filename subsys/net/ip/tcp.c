@@ -31,6 +31,11 @@ LOG_MODULE_REGISTER(net_tcp, CONFIG_NET_TCP_LOG_LEVEL);
 #define FIN_TIMEOUT_MS MSEC_PER_SEC
 #define FIN_TIMEOUT K_MSEC(FIN_TIMEOUT_MS)
 
+/* Retransmission and teardown timers are re-armed all the time and can
+ * fire a little late, let them share timer interrupts.
+ */
+#define TIMER_SLACK(ms) K_MSEC((ms) / 8)
+
 static int tcp_rto = CONFIG_NET_TCP_INIT_RETRANSMISSION_TIMEOUT;
 static int tcp_retries = CONFIG_NET_TCP_RETRY_COUNT;
 static int tcp_window = NET_IPV6_MTU;
@@ -1035,6 +1040,17 @@ static int tcp_send_data(struct tcp *conn)
 	return ret;
 }
 
+/* The retransmission timeout may be changed at run time, so the slack
+ * is derived from it each time the timer is started
+ */
+static void tcp_send_data_timer_start(struct tcp *conn)
+{
+	k_work_delayable_slack_set(&conn->send_data_timer,
+				   TIMER_SLACK(tcp_rto));
+	k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
+				    K_MSEC(tcp_rto));
+}
+
 /* Send all queued but unsent data from the send_data packet by packet
  * until the receiver's window is full. */
 static int tcp_send_queued_data(struct tcp *conn)
@@ -1076,8 +1092,7 @@ static int tcp_send_queued_data(struct tcp *conn)
 
 	if (subscribe) {
 		conn->send_data_retries = 0;
-		k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
-					    K_MSEC(tcp_rto));
+		tcp_send_data_timer_start(conn);
 	}
  out:
 	return ret;
@@ -1145,8 +1160,7 @@ static void tcp_resend_data(struct k_work *work)
 		goto out;
 	}
 
-	k_work_reschedule_for_queue(&tcp_work_q, &conn->send_data_timer,
-				    K_MSEC(tcp_rto));
+	tcp_send_data_timer_start(conn);
 
  out:
 	k_mutex_unlock(&conn->lock);
@@ -1246,6 +1260,11 @@ static struct tcp *tcp_conn_alloc(void)
 	k_work_init_delayable(&conn->send_data_timer, tcp_resend_data);
 	k_work_init_delayable(&conn->recv_queue_timer, tcp_cleanup_recv_queue);
 
+	k_work_delayable_slack_set(&conn->timewait_timer,
+				   TIMER_SLACK(CONFIG_NET_TCP_TIME_WAIT_DELAY));
+	k_work_delayable_slack_set(&conn->fin_timer,
+				   TIMER_SLACK(FIN_TIMEOUT_MS));
+
 	tcp_conn_ref(conn);
 
 	sys_slist_append(&tcp_conns, &conn->next);
@@ -1334,6 +1353,15 @@ static enum net_verdict tcp_recv(struct net_conn *net_conn,
 	ARG_UNUSED(net_conn);
 	ARG_UNUSED(proto);
 
+	/* Established connections have their own connection handler, so
+	 * the context it was registered with normally owns the segment.
+	 * Only listeners need to search for the connection.
+	 */
+	conn = ((struct net_context *)user_data)->tcp;
+	if (conn && tcp_conn_cmp(conn, pkt)) {
+		goto in;
+	}
+
 	conn = tcp_conn_search(pkt);
 	if (conn) {
 		goto in;
@@ -2095,9 +2123,7 @@ int net_tcp_put(struct net_context *context)
 
 			/* How long to wait until all the data has been sent?
 			 */
-			k_work_reschedule_for_queue(&tcp_work_q,
-						    &conn->send_data_timer,
-						    K_MSEC(tcp_rto));
+			tcp_send_data_timer_start(conn);
 		} else {
 			int ret;
 
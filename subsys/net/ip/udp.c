@@ -52,7 +52,23 @@ int net_udp_finalize(struct net_pkt *pkt)
 	udp_hdr->len = htons(length);
 
 	if (net_if_need_calc_tx_checksum(net_pkt_iface(pkt))) {
-		udp_hdr->chksum = net_calc_chksum_udp(pkt);
+		uint16_t payload_sum;
+
+		if (net_pkt_payload_chksum(pkt, &payload_sum)) {
+			/* The payload was summed when it was written, only
+			 * the header is left.
+			 */
+			udp_hdr->chksum = net_calc_chksum_hdr(pkt, IPPROTO_UDP,
+							      NET_UDPH_LEN,
+							      payload_sum);
+			if (udp_hdr->chksum == 0U) {
+				udp_hdr->chksum = 0xffff;
+			}
+
+			net_pkt_clear_payload_chksum(pkt);
+		} else {
+			udp_hdr->chksum = net_calc_chksum_udp(pkt);
+		}
 	}
 
 	return net_pkt_set_data(pkt, &udp_access);
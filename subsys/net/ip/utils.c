@@ -487,37 +487,162 @@ int z_vrfy_net_addr_pton(sa_family_t family, const char *src,
 #include <syscalls/net_addr_pton_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
-static uint16_t calc_chksum(uint16_t sum, const uint8_t *data, size_t len)
+/* One's complement sum of a block, as big endian 16-bit words starting
+ * at the first byte.  Aligned 32-bit words are added in native byte
+ * order to a 64-bit accumulator, eight at a time, so the carries only
+ * need to be folded back once at the end.  One's complement sums do
+ * not depend on byte order, except that the result comes out byte
+ * swapped.  If copy is set the block is also copied to dst in the same
+ * pass.
+ */
+static ALWAYS_INLINE uint16_t chksum_block(uint8_t *dst, const uint8_t *src,
+					   size_t len, bool copy)
 {
-	const uint8_t *end;
-	uint16_t tmp;
+	bool odd = (uintptr_t)src & 1U;
+	uint64_t acc = 0U;
+	uint16_t sum;
+
+	if (len == 0U) {
+		return 0U;
+	}
+
+	if (odd) {
+		/* Sum from the next even address as if a zero byte came
+		 * first, which swaps the bytes of the result.
+		 */
+		uint8_t word[2] = { 0U, src[0] };
+
+		acc = UNALIGNED_GET((uint16_t *)word);
+
+		if (copy) {
+			*dst++ = *src;
+		}
+
+		src++;
+		len--;
+	}
 
-	end = data + len - 1;
+	if (((uintptr_t)src & 2U) && len >= 2U) {
+		acc += *(const uint16_t *)src;
 
-	while (data < end) {
-		tmp = (data[0] << 8) + data[1];
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
+		if (copy) {
+			UNALIGNED_PUT(*(const uint16_t *)src, (uint16_t *)dst);
+			dst += 2;
 		}
 
-		data += 2;
+		src += 2;
+		len -= 2U;
 	}
 
-	if (data == end) {
-		tmp = data[0] << 8;
-		sum += tmp;
-		if (sum < tmp) {
-			sum++;
+	for (; len >= 32U; len -= 32U) {
+		const uint32_t *w = (const uint32_t *)src;
+
+		acc += (uint64_t)w[0] + w[1] + w[2] + w[3] +
+			w[4] + w[5] + w[6] + w[7];
+
+		if (copy) {
+			for (int i = 0; i < 8; i++) {
+				UNALIGNED_PUT(w[i], (uint32_t *)dst + i);
+			}
+
+			dst += 32;
 		}
+
+		src += 32;
+	}
+
+	for (; len >= 4U; len -= 4U) {
+		acc += *(const uint32_t *)src;
+
+		if (copy) {
+			UNALIGNED_PUT(*(const uint32_t *)src, (uint32_t *)dst);
+			dst += 4;
+		}
+
+		src += 4;
+	}
+
+	if (len >= 2U) {
+		acc += *(const uint16_t *)src;
+
+		if (copy) {
+			UNALIGNED_PUT(*(const uint16_t *)src, (uint16_t *)dst);
+			dst += 2;
+		}
+
+		src += 2;
+		len -= 2U;
+	}
+
+	if (len) {
+		uint8_t word[2] = { src[0], 0U };
+
+		acc += UNALIGNED_GET((uint16_t *)word);
+
+		if (copy) {
+			*dst = *src;
+		}
+	}
+
+	acc = (acc & 0xffffffff) + (acc >> 32);
+	acc = (acc & 0xffffffff) + (acc >> 32);
+	acc = (acc & 0xffff) + (acc >> 16);
+	acc = (acc & 0xffff) + (acc >> 16);
+	acc = (acc & 0xffff) + (acc >> 16);
+
+	sum = acc;
+
+#if __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__
+	odd = !odd;
+#endif
+
+	return odd ? __bswap_16(sum) : sum;
+}
+
+uint16_t net_chksum_add(uint16_t sum, uint16_t part, size_t offset)
+{
+	/* A block starting at an odd offset has its words shifted by one
+	 * byte, so its sum is byte swapped.
+	 */
+	if (offset & 1U) {
+		part = __bswap_16(part);
+	}
+
+	sum += part;
+	if (sum < part) {
+		sum++;
 	}
 
 	return sum;
 }
 
-static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
+uint16_t net_calc_chksum_copy(void *dst, const void *src, size_t len)
+{
+	return chksum_block(dst, src, len, true);
+}
+
+uint16_t net_chksum_update(uint16_t chksum, const void *old_data,
+			   const void *new_data, size_t len)
+{
+	uint16_t sum = ~ntohs(chksum);
+
+	/* RFC 1624, eqn. 3: HC' = ~(~HC + ~m + m') */
+	sum = net_chksum_add(sum, ~chksum_block(NULL, old_data, len, false), 0);
+	sum = net_chksum_add(sum, chksum_block(NULL, new_data, len, false), 0);
+
+	return htons(~sum);
+}
+
+static uint16_t calc_chksum(uint16_t sum, const uint8_t *data, size_t len)
+{
+	return net_chksum_add(sum, chksum_block(NULL, data, len, false), 0);
+}
+
+static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum,
+				       size_t limit)
 {
 	struct net_pkt_cursor *cur = &pkt->cursor;
+	size_t offset = 0;
 	size_t len;
 
 	if (!cur->buf || !cur->pos) {
@@ -526,8 +651,12 @@ static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 
 	len = cur->buf->len - (cur->pos - cur->buf->data);
 
-	while (cur->buf) {
-		sum = calc_chksum(sum, cur->pos, len);
+	while (cur->buf && offset < limit) {
+		len = MIN(len, limit - offset);
+
+		sum = net_chksum_add(sum, chksum_block(NULL, cur->pos, len,
+						       false), offset);
+		offset += len;
 
 		cur->buf = cur->buf->frags;
 		if (!cur->buf || !cur->buf->len) {
@@ -535,24 +664,14 @@ static inline uint16_t pkt_calc_chksum(struct net_pkt *pkt, uint16_t sum)
 		}
 
 		cur->pos = cur->buf->data;
-
-		if (len % 2) {
-			sum += *cur->pos;
-			if (sum < *cur->pos) {
-				sum++;
-			}
-
-			cur->pos++;
-			len = cur->buf->len - 1;
-		} else {
-			len = cur->buf->len;
-		}
+		len = cur->buf->len;
 	}
 
 	return sum;
 }
 
-uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
+static uint16_t calc_pkt_chksum(struct net_pkt *pkt, uint8_t proto,
+				size_t limit, uint16_t payload_sum)
 {
 	size_t len = 0U;
 	uint16_t sum = 0U;
@@ -589,7 +708,8 @@ uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
 	sum = calc_chksum(sum, pkt->cursor.pos, len);
 	net_pkt_skip(pkt, len + net_pkt_ip_opts_len(pkt));
 
-	sum = pkt_calc_chksum(pkt, sum);
+	sum = pkt_calc_chksum(pkt, sum, limit);
+	sum = net_chksum_add(sum, payload_sum, 0);
 
 	sum = (sum == 0U) ? 0xffff : htons(sum);
 
@@ -600,6 +720,17 @@ uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
 	return ~sum;
 }
 
+uint16_t net_calc_chksum(struct net_pkt *pkt, uint8_t proto)
+{
+	return calc_pkt_chksum(pkt, proto, SIZE_MAX, 0U);
+}
+
+uint16_t net_calc_chksum_hdr(struct net_pkt *pkt, uint8_t proto,
+			     size_t hdr_len, uint16_t payload_sum)
+{
+	return calc_pkt_chksum(pkt, proto, hdr_len, payload_sum);
+}
+
 #if defined(CONFIG_NET_IPV4)
 uint16_t net_calc_chksum_ipv4(struct net_pkt *pkt)
 {
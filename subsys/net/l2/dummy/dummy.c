@@ -27,6 +27,24 @@ static inline enum net_verdict dummy_recv(struct net_if *iface,
 	return NET_CONTINUE;
 }
 
+#if defined(CONFIG_NET_BURST)
+static void dummy_send_burst(struct net_if *iface, struct net_pkt **pkts,
+			     size_t count)
+{
+	const struct dummy_api *api = net_if_get_device(iface)->api;
+
+	for (size_t i = 0; i < count; i++) {
+		net_capture_pkt(net_pkt_iface(pkts[i]), pkts[i]);
+	}
+
+	(void)api->send_burst(net_if_get_device(iface), pkts, count);
+
+	for (size_t i = 0; i < count; i++) {
+		net_pkt_unref(pkts[i]);
+	}
+}
+#endif
+
 static inline int dummy_send(struct net_if *iface, struct net_pkt *pkt)
 {
 	const struct dummy_api *api = net_if_get_device(iface)->api;
@@ -36,6 +54,13 @@ static inline int dummy_send(struct net_if *iface, struct net_pkt *pkt)
 		return -ENOENT;
 	}
 
+#if defined(CONFIG_NET_BURST)
+	if (api->send_burst &&
+	    net_if_tx_burst_add(iface, pkt, dummy_send_burst)) {
+		return net_pkt_get_len(pkt);
+	}
+#endif
+
 	ret = net_l2_send(api->send, net_if_get_device(iface), iface, pkt);
 	if (!ret) {
 		ret = net_pkt_get_len(pkt);
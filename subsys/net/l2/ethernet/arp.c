@@ -746,6 +746,9 @@ void net_arp_init(void)
 	}
 
 	k_work_init_delayable(&arp_request_timer, arp_request_timeout);
+	/* Pending requests only ever time out, a little late is fine */
+	k_work_delayable_slack_set(&arp_request_timer,
+				   K_MSEC(ARP_REQUEST_TIMEOUT / 8));
 
 	arp_cache_initialized = true;
 }
@@ -594,6 +594,35 @@ static void ethernet_remove_l2_header(struct net_pkt *pkt)
 	net_pkt_frag_unref(buf);
 }
 
+#if defined(CONFIG_NET_BURST)
+static void ethernet_send_burst(struct net_if *iface, struct net_pkt **pkts,
+				size_t count)
+{
+	const struct ethernet_api *api = net_if_get_device(iface)->api;
+	int sent;
+
+	for (size_t i = 0; i < count; i++) {
+		net_capture_pkt(net_pkt_iface(pkts[i]), pkts[i]);
+	}
+
+	sent = api->send_burst(net_if_get_device(iface), pkts, count);
+	sent = MAX(sent, 0);
+
+	for (size_t i = 0; i < count; i++) {
+		struct net_pkt *pkt = pkts[i];
+
+		if (i < (size_t)sent) {
+			ethernet_update_tx_stats(net_pkt_iface(pkt), pkt);
+		} else {
+			eth_stats_update_errors_tx(net_pkt_iface(pkt));
+		}
+
+		ethernet_remove_l2_header(pkt);
+		net_pkt_unref(pkt);
+	}
+}
+#endif
+
 static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 {
 	const struct ethernet_api *api = net_if_get_device(iface)->api;
@@ -710,6 +739,13 @@ static int ethernet_send(struct net_if *iface, struct net_pkt *pkt)
 	net_pkt_cursor_init(pkt);
 
 send:
+#if defined(CONFIG_NET_BURST)
+	if (api->send_burst &&
+	    net_if_tx_burst_add(iface, pkt, ethernet_send_burst)) {
+		return net_pkt_get_len(pkt);
+	}
+#endif
+
 	ret = net_l2_send(api->send, net_if_get_device(iface), iface, pkt);
 	if (ret != 0) {
 		eth_stats_update_errors_tx(iface);
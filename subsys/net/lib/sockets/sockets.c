@@ -615,9 +615,10 @@ static inline int z_vrfy_zsock_accept(int sock, struct sockaddr *addr,
 #define WAIT_BUFS K_MSEC(100)
 #define MAX_WAIT_BUFS K_SECONDS(10)
 
-ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
-			 int flags,
-			 const struct sockaddr *dest_addr, socklen_t addrlen)
+/* If payload is not NULL, it is sent without copying instead of buf */
+static ssize_t sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
+			  struct net_buf *payload, int flags,
+			  const struct sockaddr *dest_addr, socklen_t addrlen)
 {
 	k_timeout_t timeout = K_FOREVER;
 	uint64_t buf_timeout = 0;
@@ -641,7 +642,11 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 	}
 
 	while (1) {
-		if (dest_addr) {
+		if (payload) {
+			status = net_context_sendto_buf(ctx, payload, dest_addr,
+							addrlen, NULL, timeout,
+							ctx->user_data);
+		} else if (dest_addr) {
 			status = net_context_sendto(ctx, buf, len, dest_addr,
 						    addrlen, NULL, timeout,
 						    ctx->user_data);
@@ -686,6 +691,48 @@ ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
 	return status;
 }
 
+ssize_t zsock_sendto_ctx(struct net_context *ctx, const void *buf, size_t len,
+			 int flags,
+			 const struct sockaddr *dest_addr, socklen_t addrlen)
+{
+	return sendto_ctx(ctx, buf, len, NULL, flags, dest_addr, addrlen);
+}
+
+ssize_t zsock_sendto_buf_ctx(struct net_context *ctx, struct net_buf *buf,
+			     int flags, const struct sockaddr *dest_addr,
+			     socklen_t addrlen)
+{
+	return sendto_ctx(ctx, NULL, 0, buf, flags, dest_addr, addrlen);
+}
+
+ssize_t zsock_sendto_buf(int sock, struct net_buf *buf, int flags,
+			 const struct sockaddr *dest_addr, socklen_t addrlen)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	ssize_t ret;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->sendto_buf == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = vtable->sendto_buf(obj, buf, flags, dest_addr, addrlen);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
 ssize_t z_impl_zsock_sendto(int sock, const void *buf, size_t len, int flags,
 			   const struct sockaddr *dest_addr, socklen_t addrlen)
 {
@@ -827,6 +874,218 @@ fail:
 #include <syscalls/zsock_sendmsg_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+/* All the messages are sent through the socket's sendmsg method while
+ * holding the socket lock, so the socket is looked up and locked once
+ * for the whole batch.
+ */
+int z_impl_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+			  unsigned int vlen, int flags)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	unsigned int i;
+	ssize_t len;
+	void *obj;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->sendmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	for (i = 0; i < vlen; i++) {
+		len = vtable->sendmsg(obj, &msgvec[i].msg_hdr, flags);
+		if (len < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = len;
+	}
+
+	k_mutex_unlock(lock);
+
+	/* As on Linux, an error after the first message only ends the
+	 * batch early.
+	 */
+	return (i > 0 || vlen == 0) ? i : -1;
+}
+
+#ifdef CONFIG_USERSPACE
+static void mmsg_free(struct mmsghdr *msgvec, unsigned int count, bool write)
+{
+	for (unsigned int i = 0; i < count; i++) {
+		k_free(msgvec[i].msg_hdr.msg_iov);
+
+		if (!write) {
+			k_free(msgvec[i].msg_hdr.msg_name);
+		}
+	}
+
+	k_free(msgvec);
+}
+
+/* Make a kernel copy of a user message vector. The data buffers are
+ * checked to be accessible for the given access but not copied. When
+ * sending, the destination addresses are copied as the stack parses
+ * them.
+ */
+static struct mmsghdr *mmsg_from_user(struct mmsghdr *msgvec,
+				      unsigned int vlen, bool write)
+{
+	struct mmsghdr *copy;
+	struct msghdr *msg;
+	struct iovec *iov;
+	void *name;
+	unsigned int i;
+	size_t size;
+
+	if (size_mul_overflow(vlen, sizeof(*msgvec), &size)) {
+		errno = EINVAL;
+		return NULL;
+	}
+
+	copy = z_user_alloc_from_copy(msgvec, size);
+	if (!copy) {
+		errno = ENOMEM;
+		return NULL;
+	}
+
+	for (i = 0; i < vlen; i++) {
+		msg = &copy[i].msg_hdr;
+		iov = NULL;
+		name = msg->msg_name;
+
+		msg->msg_control = NULL;
+		msg->msg_controllen = 0;
+
+		if (msg->msg_iovlen > 0) {
+			if (size_mul_overflow(msg->msg_iovlen,
+					      sizeof(struct iovec), &size)) {
+				errno = EINVAL;
+				goto fail;
+			}
+
+			iov = z_user_alloc_from_copy(msg->msg_iov, size);
+			if (!iov) {
+				errno = ENOMEM;
+				goto fail;
+			}
+		}
+
+		for (size_t j = 0; j < msg->msg_iovlen; j++) {
+			if (Z_SYSCALL_MEMORY(iov[j].iov_base, iov[j].iov_len,
+					     write)) {
+				errno = EFAULT;
+				goto fail_iov;
+			}
+		}
+
+		if (name) {
+			if (msg->msg_namelen > sizeof(struct sockaddr_storage)) {
+				errno = EINVAL;
+				goto fail_iov;
+			}
+
+			if (write) {
+				if (Z_SYSCALL_MEMORY_WRITE(name,
+							   msg->msg_namelen)) {
+					errno = EFAULT;
+					goto fail_iov;
+				}
+			} else {
+				name = z_user_alloc_from_copy(name,
+							      msg->msg_namelen);
+				if (!name) {
+					errno = ENOMEM;
+					goto fail_iov;
+				}
+			}
+		}
+
+		msg->msg_iov = iov;
+		msg->msg_name = name;
+	}
+
+	return copy;
+
+fail_iov:
+	k_free(iov);
+fail:
+	mmsg_free(copy, i, write);
+
+	return NULL;
+}
+
+/* Copy the results of the first count messages back to the user
+ * message vector: the length of each, and when receiving the address
+ * and control lengths and flags. Returns the first copy error, so that
+ * the caller can free the kernel copy before faulting.
+ */
+static int mmsg_to_user(struct mmsghdr *msgvec, const struct mmsghdr *copy,
+			int count, bool write)
+{
+	int ret = 0;
+
+	for (int i = 0; i < count && ret == 0; i++) {
+		struct msghdr *msg = &msgvec[i].msg_hdr;
+
+		ret = z_user_to_copy(&msgvec[i].msg_len, &copy[i].msg_len,
+				     sizeof(copy[i].msg_len));
+		if (ret != 0 || !write) {
+			continue;
+		}
+
+		ret = z_user_to_copy(&msg->msg_namelen,
+				     &copy[i].msg_hdr.msg_namelen,
+				     sizeof(msg->msg_namelen));
+		if (ret == 0) {
+			ret = z_user_to_copy(&msg->msg_controllen,
+					     &copy[i].msg_hdr.msg_controllen,
+					     sizeof(msg->msg_controllen));
+		}
+		if (ret == 0) {
+			ret = z_user_to_copy(&msg->msg_flags,
+					     &copy[i].msg_hdr.msg_flags,
+					     sizeof(msg->msg_flags));
+		}
+	}
+
+	return ret;
+}
+
+static inline int z_vrfy_zsock_sendmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags)
+{
+	struct mmsghdr *copy;
+	int ret, err;
+
+	if (vlen == 0) {
+		return z_impl_zsock_sendmmsg(sock, NULL, 0, flags);
+	}
+
+	copy = mmsg_from_user(msgvec, vlen, false);
+	if (!copy) {
+		return -1;
+	}
+
+	ret = z_impl_zsock_sendmmsg(sock, copy, vlen, flags);
+	err = mmsg_to_user(msgvec, copy, ret, false);
+
+	mmsg_free(copy, vlen, false);
+	Z_OOPS(err);
+
+	return ret;
+}
+#include <syscalls/zsock_sendmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 static int sock_get_pkt_src_addr(struct net_pkt *pkt,
 				 enum net_ip_protocol proto,
 				 struct sockaddr *addr,
@@ -981,30 +1240,36 @@ int zsock_wait_data(struct net_context *ctx, k_timeout_t *timeout)
 	return 0;
 }
 
-static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
-				       void *buf,
-				       size_t max_len,
-				       int flags,
-				       struct sockaddr *src_addr,
-				       socklen_t *addrlen)
+static k_timeout_t sock_recv_timeout(struct net_context *ctx, int flags)
 {
 	k_timeout_t timeout = K_FOREVER;
-	size_t recv_len = 0;
-	size_t read_len;
-	struct net_pkt_cursor backup;
-	struct net_pkt *pkt;
 
 	if ((flags & ZSOCK_MSG_DONTWAIT) || sock_is_nonblock(ctx)) {
-		timeout = K_NO_WAIT;
-	} else {
-		int ret;
+		return K_NO_WAIT;
+	}
 
-		net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+	net_context_get_option(ctx, NET_OPT_RCVTIMEO, &timeout, NULL);
+
+	return timeout;
+}
+
+/* Wait up to timeout for the next datagram and fill in its source
+ * address. With ZSOCK_MSG_PEEK the packet is left in the queue.
+ */
+static struct net_pkt *recv_dgram_pkt(struct net_context *ctx, int flags,
+				      k_timeout_t timeout,
+				      struct sockaddr *src_addr,
+				      socklen_t *addrlen)
+{
+	struct net_pkt *pkt;
+
+	if (!K_TIMEOUT_EQ(timeout, K_NO_WAIT)) {
+		int ret;
 
 		ret = zsock_wait_data(ctx, &timeout);
 		if (ret < 0) {
 			errno = -ret;
-			return -1;
+			return NULL;
 		}
 	}
 
@@ -1015,7 +1280,7 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 		/* EAGAIN when timeout expired, EINTR when cancelled */
 		if (res && res != -EAGAIN && res != -EINTR) {
 			errno = -res;
-			return -1;
+			return NULL;
 		}
 
 		pkt = k_fifo_peek_head(&ctx->recv_q);
@@ -1025,11 +1290,9 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 
 	if (!pkt) {
 		errno = EAGAIN;
-		return -1;
+		return NULL;
 	}
 
-	net_pkt_cursor_backup(pkt, &backup);
-
 	if (src_addr && addrlen) {
 		if (IS_ENABLED(CONFIG_NET_OFFLOAD) &&
 		    net_if_is_ip_offloaded(net_context_get_iface(ctx))) {
@@ -1071,6 +1334,36 @@ static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
 		}
 	}
 
+	return pkt;
+
+fail:
+	if (!(flags & ZSOCK_MSG_PEEK)) {
+		net_pkt_unref(pkt);
+	}
+
+	return NULL;
+}
+
+static inline ssize_t zsock_recv_dgram(struct net_context *ctx,
+				       void *buf,
+				       size_t max_len,
+				       int flags,
+				       struct sockaddr *src_addr,
+				       socklen_t *addrlen)
+{
+	size_t recv_len = 0;
+	size_t read_len;
+	struct net_pkt_cursor backup;
+	struct net_pkt *pkt;
+
+	pkt = recv_dgram_pkt(ctx, flags, sock_recv_timeout(ctx, flags),
+			     src_addr, addrlen);
+	if (!pkt) {
+		return -1;
+	}
+
+	net_pkt_cursor_backup(pkt, &backup);
+
 	recv_len = net_pkt_remaining_data(pkt);
 	read_len = MIN(recv_len, max_len);
 
@@ -1100,6 +1393,195 @@ fail:
 	return -1;
 }
 
+/* Take the buffers holding the data after the cursor from the packet.
+ * Buffers that are also referenced elsewhere are left untouched.
+ */
+static struct net_buf *pkt_take_data(struct net_pkt *pkt)
+{
+	struct net_buf *data = pkt->cursor.buf;
+	struct net_buf *buf = pkt->buffer;
+	size_t skip = 0;
+
+	pkt->buffer = NULL;
+
+	if (data) {
+		skip = pkt->cursor.pos - data->data;
+
+		/* The cursor can be left at the very end of a fragment */
+		if (skip == data->len && data->frags) {
+			data = data->frags;
+			skip = 0;
+		}
+	}
+
+	/* Drop the fragments before the data, which only hold headers */
+	while (buf != data) {
+		struct net_buf *next = buf->frags;
+
+		if (next) {
+			next = net_buf_ref(next);
+		}
+
+		net_buf_unref(buf);
+		buf = next;
+	}
+
+	if (!data) {
+		return NULL;
+	}
+
+	if (data->ref > 1) {
+		/* Copy the first fragment instead of pulling the headers
+		 * off a buffer someone else is looking at.
+		 */
+		buf = net_buf_clone(data, K_NO_WAIT);
+		if (!buf) {
+			net_buf_unref(data);
+			return NULL;
+		}
+
+		if (data->frags) {
+			buf->frags = net_buf_ref(data->frags);
+		}
+
+		net_buf_unref(data);
+		data = buf;
+	}
+
+	net_buf_pull(data, skip);
+
+	return data;
+}
+
+static ssize_t zsock_recv_dgram_buf(struct net_context *ctx,
+				    struct net_buf **buf, int flags,
+				    struct sockaddr *src_addr,
+				    socklen_t *addrlen)
+{
+	struct net_pkt *pkt;
+	size_t recv_len;
+
+	if (flags & ZSOCK_MSG_PEEK) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	pkt = recv_dgram_pkt(ctx, flags, sock_recv_timeout(ctx, flags),
+			     src_addr, addrlen);
+	if (!pkt) {
+		return -1;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	recv_len = net_pkt_remaining_data(pkt);
+
+	*buf = pkt_take_data(pkt);
+	net_pkt_unref(pkt);
+
+	if (!*buf && recv_len) {
+		errno = ENOBUFS;
+		return -1;
+	}
+
+	return recv_len;
+}
+
+/* Receive one datagram into the scatter/gather buffers of msg */
+static ssize_t zsock_recv_dgram_msg(struct net_context *ctx,
+				    struct msghdr *msg, int flags,
+				    k_timeout_t timeout)
+{
+	struct net_pkt *pkt;
+	size_t recv_len;
+	size_t left;
+
+	pkt = recv_dgram_pkt(ctx, flags, timeout, msg->msg_name,
+			     msg->msg_name ? &msg->msg_namelen : NULL);
+	if (!pkt) {
+		return -1;
+	}
+
+	recv_len = net_pkt_remaining_data(pkt);
+	left = recv_len;
+
+	for (size_t i = 0; i < msg->msg_iovlen && left; i++) {
+		size_t len = MIN(msg->msg_iov[i].iov_len, left);
+
+		if (net_pkt_read(pkt, msg->msg_iov[i].iov_base, len)) {
+			net_pkt_unref(pkt);
+			errno = ENOBUFS;
+			return -1;
+		}
+
+		left -= len;
+	}
+
+	if (IS_ENABLED(CONFIG_NET_PKT_RXTIME_STATS)) {
+		net_socket_update_tc_rx_time(pkt, k_cycle_get_32());
+	}
+
+	net_pkt_unref(pkt);
+
+	msg->msg_controllen = 0;
+	msg->msg_flags = left ? ZSOCK_MSG_TRUNC : 0;
+
+	return (flags & ZSOCK_MSG_TRUNC) ? recv_len : recv_len - left;
+}
+
+int zsock_recvmmsg_ctx(struct net_context *ctx, struct mmsghdr *msgvec,
+		       unsigned int vlen, int flags, k_timeout_t timeout)
+{
+	uint64_t end = sys_clock_timeout_end_calc(timeout);
+	k_timeout_t sock_timeout = sock_recv_timeout(ctx, flags);
+	k_timeout_t wait;
+	unsigned int i;
+	ssize_t len;
+
+	if (net_context_get_type(ctx) != SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (flags & ZSOCK_MSG_PEEK) {
+		errno = EINVAL;
+		return -1;
+	}
+
+	for (i = 0; i < vlen; i++) {
+		if (i > 0 && (flags & ZSOCK_MSG_WAITFORONE)) {
+			wait = K_NO_WAIT;
+		} else {
+			wait = sock_timeout;
+		}
+
+		if (!K_TIMEOUT_EQ(timeout, K_FOREVER) &&
+		    !K_TIMEOUT_EQ(wait, K_NO_WAIT)) {
+			int64_t remaining = end - sys_clock_tick_get();
+
+			if (K_TIMEOUT_EQ(wait, K_FOREVER) ||
+			    remaining < (int64_t)wait.ticks) {
+				wait = K_TICKS(MAX(remaining, 0));
+			}
+		}
+
+		len = zsock_recv_dgram_msg(ctx, &msgvec[i].msg_hdr, flags,
+					   wait);
+		if (len < 0) {
+			break;
+		}
+
+		msgvec[i].msg_len = len;
+	}
+
+	/* As on Linux, an error after the first datagram only ends the
+	 * batch early.
+	 */
+	return (i > 0 || vlen == 0) ? i : -1;
+}
+
 static inline ssize_t zsock_recv_stream(struct net_context *ctx,
 					void *buf,
 					size_t max_len,
@@ -1243,12 +1725,52 @@ ssize_t zsock_recvfrom_ctx(struct net_context *ctx, void *buf, size_t max_len,
 	return 0;
 }
 
+ssize_t zsock_recvfrom_buf_ctx(struct net_context *ctx, struct net_buf **buf,
+			       int flags, struct sockaddr *src_addr,
+			       socklen_t *addrlen)
+{
+	if (net_context_get_type(ctx) != SOCK_DGRAM) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	return zsock_recv_dgram_buf(ctx, buf, flags, src_addr, addrlen);
+}
+
 ssize_t z_impl_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 			     struct sockaddr *src_addr, socklen_t *addrlen)
 {
 	VTABLE_CALL(recvfrom, sock, buf, max_len, flags, src_addr, addrlen);
 }
 
+ssize_t zsock_recvfrom_buf(int sock, struct net_buf **buf, int flags,
+			   struct sockaddr *src_addr, socklen_t *addrlen)
+{
+	const struct socket_op_vtable *vtable;
+	struct k_mutex *lock;
+	void *obj;
+	ssize_t ret;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->recvfrom_buf == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = vtable->recvfrom_buf(obj, buf, flags, src_addr, addrlen);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
 #ifdef CONFIG_USERSPACE
 ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 			      struct sockaddr *src_addr, socklen_t *addrlen)
@@ -1281,6 +1803,81 @@ ssize_t z_vrfy_zsock_recvfrom(int sock, void *buf, size_t max_len, int flags,
 #include <syscalls/zsock_recvfrom_mrsh.c>
 #endif /* CONFIG_USERSPACE */
 
+int z_impl_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+			  unsigned int vlen, int flags,
+			  struct zsock_timeval *timeout)
+{
+	const struct socket_op_vtable *vtable;
+	k_timeout_t wait = K_FOREVER;
+	struct k_mutex *lock;
+	void *obj;
+	int ret;
+
+	obj = get_sock_vtable(sock, &vtable, &lock);
+	if (obj == NULL) {
+		errno = EBADF;
+		return -1;
+	}
+
+	if (vtable->recvmmsg == NULL) {
+		errno = EOPNOTSUPP;
+		return -1;
+	}
+
+	if (timeout) {
+		if (timeout->tv_sec < 0 || timeout->tv_usec < 0) {
+			errno = EINVAL;
+			return -1;
+		}
+
+		wait = K_USEC((int64_t)timeout->tv_sec * USEC_PER_SEC +
+			      timeout->tv_usec);
+	}
+
+	(void)k_mutex_lock(lock, K_FOREVER);
+
+	ret = vtable->recvmmsg(obj, msgvec, vlen, flags, wait);
+
+	k_mutex_unlock(lock);
+
+	return ret;
+}
+
+#ifdef CONFIG_USERSPACE
+static inline int z_vrfy_zsock_recvmmsg(int sock, struct mmsghdr *msgvec,
+					unsigned int vlen, int flags,
+					struct zsock_timeval *timeout)
+{
+	struct zsock_timeval timeout_copy;
+	struct mmsghdr *copy;
+	int ret, err;
+
+	if (timeout) {
+		Z_OOPS(z_user_from_copy(&timeout_copy, timeout,
+					sizeof(timeout_copy)));
+	}
+
+	if (vlen == 0) {
+		return z_impl_zsock_recvmmsg(sock, NULL, 0, flags, NULL);
+	}
+
+	copy = mmsg_from_user(msgvec, vlen, true);
+	if (!copy) {
+		return -1;
+	}
+
+	ret = z_impl_zsock_recvmmsg(sock, copy, vlen, flags,
+				    timeout ? &timeout_copy : NULL);
+	err = mmsg_to_user(msgvec, copy, ret, true);
+
+	mmsg_free(copy, vlen, true);
+	Z_OOPS(err);
+
+	return ret;
+}
+#include <syscalls/zsock_recvmmsg_mrsh.c>
+#endif /* CONFIG_USERSPACE */
+
 /* As this is limited function, we don't follow POSIX signature, with
  * "..." instead of last arg.
  */
@@ -2165,6 +2762,28 @@ static ssize_t sock_recvfrom_vmeth(void *obj, void *buf, size_t max_len,
 				  src_addr, addrlen);
 }
 
+static ssize_t sock_sendto_buf_vmeth(void *obj, struct net_buf *buf,
+				     int flags,
+				     const struct sockaddr *dest_addr,
+				     socklen_t addrlen)
+{
+	return zsock_sendto_buf_ctx(obj, buf, flags, dest_addr, addrlen);
+}
+
+static ssize_t sock_recvfrom_buf_vmeth(void *obj, struct net_buf **buf,
+				       int flags, struct sockaddr *src_addr,
+				       socklen_t *addrlen)
+{
+	return zsock_recvfrom_buf_ctx(obj, buf, flags, src_addr, addrlen);
+}
+
+static int sock_recvmmsg_vmeth(void *obj, struct mmsghdr *msgvec,
+			       unsigned int vlen, int flags,
+			       k_timeout_t timeout)
+{
+	return zsock_recvmmsg_ctx(obj, msgvec, vlen, flags, timeout);
+}
+
 static int sock_getsockopt_vmeth(void *obj, int level, int optname,
 				 void *optval, socklen_t *optlen)
 {
@@ -2205,6 +2824,9 @@ const struct socket_op_vtable sock_fd_op_vtable = {
 	.getsockopt = sock_getsockopt_vmeth,
 	.setsockopt = sock_setsockopt_vmeth,
 	.getsockname = sock_getsockname_vmeth,
+	.sendto_buf = sock_sendto_buf_vmeth,
+	.recvfrom_buf = sock_recvfrom_buf_vmeth,
+	.recvmmsg = sock_recvmmsg_vmeth,
 };
 
 #if defined(CONFIG_NET_NATIVE)
@@ -67,6 +67,13 @@ struct socket_op_vtable {
 	ssize_t (*sendmsg)(void *obj, const struct msghdr *msg, int flags);
 	int (*getsockname)(void *obj, struct sockaddr *addr,
 			   socklen_t *addrlen);
+	ssize_t (*sendto_buf)(void *obj, struct net_buf *buf, int flags,
+			      const struct sockaddr *dest_addr,
+			      socklen_t addrlen);
+	ssize_t (*recvfrom_buf)(void *obj, struct net_buf **buf, int flags,
+				struct sockaddr *src_addr, socklen_t *addrlen);
+	int (*recvmmsg)(void *obj, struct mmsghdr *msgvec, unsigned int vlen,
+			int flags, k_timeout_t timeout);
 };
 
 #endif /* _SOCKETS_INTERNAL_H_ */
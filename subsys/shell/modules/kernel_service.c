@@ -215,6 +215,81 @@ static int cmd_kernel_stacks(const struct shell *shell,
 }
 #endif
 
+#if defined(CONFIG_SCHED_THREAD_STATS) && defined(CONFIG_THREAD_MONITOR)
+static void shell_sched_stats_dump(const struct k_thread *cthread,
+				   void *user_data)
+{
+	struct k_thread *thread = (struct k_thread *)cthread;
+	const struct shell *shell = (const struct shell *)user_data;
+	struct k_thread_sched_stats stats;
+	char hist[CONFIG_SCHED_THREAD_STATS_BUCKETS * 16];
+	const char *tname;
+	int len = 0;
+
+	if (k_thread_sched_stats_get(thread, &stats) != 0) {
+		return;
+	}
+
+	tname = k_thread_name_get(thread);
+
+	shell_print(shell, "%p %-10s wakeups: %u, preemptions: %u, "
+		    "max latency: %u us", thread, tname ? tname : "NA",
+		    stats.wakeups, stats.preemptions,
+		    stats.wakeup_latency_max_us);
+
+	/* Bucket N holds latencies below 2^N us, the last one the rest */
+	for (int i = 0; i < CONFIG_SCHED_THREAD_STATS_BUCKETS; i++) {
+		if (len >= sizeof(hist)) {
+			break;
+		}
+
+		if (i < CONFIG_SCHED_THREAD_STATS_BUCKETS - 1) {
+			len += snprintk(hist + len, sizeof(hist) - len,
+					" <%u:%u", 1U << i,
+					stats.wakeup_latency_hist[i]);
+		} else {
+			len += snprintk(hist + len, sizeof(hist) - len,
+					" >=%u:%u", 1U << (i - 1),
+					stats.wakeup_latency_hist[i]);
+		}
+	}
+
+	shell_print(shell, "\tlatency us:%s", hist);
+}
+
+static int cmd_kernel_schedstats(const struct shell *shell,
+				 size_t argc, char **argv)
+{
+	struct k_cpu_sched_stats stats;
+
+	ARG_UNUSED(argc);
+	ARG_UNUSED(argv);
+
+	shell_print(shell, "Threads:");
+	k_thread_foreach(shell_sched_stats_dump, (void *)shell);
+
+	shell_print(shell, "Run queues:");
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		if (k_cpu_sched_stats_get(i, &stats) != 0) {
+			continue;
+		}
+
+		/* Average in hundredths, %llu is not always available */
+		shell_print(shell, "\tCPU %d: samples %u, avg %u.%02u, max %u",
+			    i, stats.runq_len_samples,
+			    stats.runq_len_samples == 0U ? 0U :
+			    (uint32_t)(stats.runq_len_sum /
+				       stats.runq_len_samples),
+			    stats.runq_len_samples == 0U ? 0U :
+			    (uint32_t)((stats.runq_len_sum * 100U /
+					stats.runq_len_samples) % 100U),
+			    stats.runq_len_max);
+	}
+
+	return 0;
+}
+#endif
+
 #if defined(CONFIG_REBOOT)
 static int cmd_kernel_reboot_warm(const struct shell *shell,
 				  size_t argc, char **argv)
@@ -252,6 +327,10 @@ SHELL_STATIC_SUBCMD_SET_CREATE(sub_kernel,
 #if defined(CONFIG_REBOOT)
 	SHELL_CMD(reboot, &sub_kernel_reboot, "Reboot.", NULL),
 #endif
+#if defined(CONFIG_SCHED_THREAD_STATS) && defined(CONFIG_THREAD_MONITOR)
+	SHELL_CMD(schedstats, NULL, "Scheduler latency statistics.",
+		  cmd_kernel_schedstats),
+#endif
 #if defined(CONFIG_INIT_STACKS) && defined(CONFIG_THREAD_STACK_INFO) && \
 		defined(CONFIG_THREAD_MONITOR)
 	SHELL_CMD(stacks, NULL, "List threads stack usage.", cmd_kernel_stacks),
@@ -9,6 +9,11 @@
 #include <kernel_internal.h>
 #include <ctf_top.h>
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+#include <sys/byteorder.h>
+#include <tracing_core.h>
+#endif
+
 
 static void _get_thread_name(struct k_thread *thread,
 			     ctf_bounded_string_t *name)
@@ -295,3 +300,26 @@ void sys_trace_k_timer_status_sync_blocking(struct k_timer *timer)
 void sys_trace_k_timer_status_sync_exit(struct k_timer *timer, uint32_t result)
 {
 }
+
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+/* Packet header and context as described by the packet.header and
+ * packet.context declarations which scripts/tracing/merge_ctf_cpus.py
+ * adds to the metadata. Sizes are given in bits.
+ */
+#define CTF_PACKET_MAGIC 0xC1FC1FC1
+#define CTF_PACKET_HEADER_SIZE 13
+
+uint32_t tracing_packet_header_size(void)
+{
+	return CTF_PACKET_HEADER_SIZE;
+}
+
+void tracing_packet_header_put(uint8_t *buf, uint32_t cpu_id,
+			       uint32_t length)
+{
+	sys_put_le32(CTF_PACKET_MAGIC, &buf[0]);
+	buf[4] = (uint8_t)cpu_id;
+	sys_put_le32(length * 8U, &buf[5]);	/* content_size */
+	sys_put_le32(length * 8U, &buf[9]);	/* packet_size */
+}
+#endif
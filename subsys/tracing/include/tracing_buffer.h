@@ -22,6 +22,8 @@ void tracing_buffer_init(void);
 /**
  * @brief Tracing buffer is empty or not.
  *
+ * With per-CPU buffers, the buffers of all CPUs are checked.
+ *
  * @return true if the ring buffer is empty, or false if not.
  */
 bool tracing_buffer_is_empty(void);
@@ -104,6 +106,39 @@ int tracing_buffer_get_finish(uint32_t size);
  */
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size);
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+/**
+ * @brief Read data from the tracing buffer of a CPU to output buffer.
+ *
+ * Events are committed to the buffer as a whole, so if @a size is at
+ * least the buffer capacity, the data read ends on an event boundary.
+ *
+ * @param cpu_id CPU whose tracing buffer is read.
+ * @param data Address of the output buffer.
+ * @param size Data size (in bytes).
+ *
+ * @retval Number of bytes written to the output buffer.
+ */
+uint32_t tracing_buffer_cpu_get(uint32_t cpu_id, uint8_t *data, uint32_t size);
+
+/**
+ * @brief Lock the tracing buffer of the current CPU for a put.
+ *
+ * Masks local interrupts, so that the current CPU does not change, and
+ * takes the lock the tracing thread takes to read the buffer.
+ *
+ * @retval Key to pass to tracing_buffer_unlock().
+ */
+unsigned int tracing_buffer_lock(void);
+
+/**
+ * @brief Unlock the tracing buffer of the current CPU.
+ *
+ * @param key Key returned by tracing_buffer_lock().
+ */
+void tracing_buffer_unlock(unsigned int key);
+#endif
+
 /**
  * @brief Get buffer from tracing command buffer.
  *
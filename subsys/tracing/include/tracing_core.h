@@ -14,9 +14,22 @@
 extern "C" {
 #endif
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+/* Each CPU only writes to its own buffer, whose lock is shared with
+ * the tracing thread alone, which avoids the global lock irq_lock()
+ * takes on SMP.
+ */
+#define TRACING_LOCK()		{ unsigned int key; key = tracing_buffer_lock()
+
+#define TRACING_UNLOCK()	{ tracing_buffer_unlock(key); } }
+
+/* Room reserved in front of the data of each output packet */
+#define TRACING_PACKET_HEADER_MAX_SIZE 16
+#else
 #define TRACING_LOCK()		{ int key; key = irq_lock()
 
 #define TRACING_UNLOCK()	{ irq_unlock(key); } }
+#endif
 
 /**
  * @brief Check tracing enabled or not.
@@ -60,6 +73,30 @@ void tracing_trigger_output(bool before_put_is_empty);
  */
 bool is_tracing_thread(void);
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+/**
+ * @brief Get size of the packet header of the tracing format.
+ *
+ * Implemented by the tracing format.
+ *
+ * @return Packet header size (in bytes), at most
+ *         TRACING_PACKET_HEADER_MAX_SIZE.
+ */
+uint32_t tracing_packet_header_size(void);
+
+/**
+ * @brief Write packet header of the tracing format.
+ *
+ * Implemented by the tracing format.
+ *
+ * @param buf Packet header address.
+ * @param cpu_id CPU which emitted the packet data.
+ * @param length Packet length, including the header (in bytes).
+ */
+void tracing_packet_header_put(uint8_t *buf, uint32_t cpu_id,
+			       uint32_t length);
+#endif
+
 #ifdef __cplusplus
 }
 #endif
@@ -4,12 +4,43 @@
  * SPDX-License-Identifier: Apache-2.0
  */
 
+#include <kernel.h>
 #include <sys/ring_buffer.h>
 
-static struct ring_buf tracing_ring_buf;
-static uint8_t tracing_buffer[CONFIG_TRACING_BUFFER_SIZE + 1];
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+#define TRACING_BUFFER_COUNT CONFIG_MP_NUM_CPUS
+#else
+#define TRACING_BUFFER_COUNT 1
+#endif
+
+#define TRACING_CPU_BUFFER_SIZE (CONFIG_TRACING_BUFFER_SIZE / TRACING_BUFFER_COUNT)
+
+static struct ring_buf tracing_ring_buf[TRACING_BUFFER_COUNT];
+static uint8_t tracing_buffer[TRACING_BUFFER_COUNT][TRACING_CPU_BUFFER_SIZE + 1];
 static uint8_t tracing_cmd_buffer[CONFIG_TRACING_CMD_BUFFER_SIZE];
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+/* The ring buffer has no barriers of its own, so each CPU buffer has a
+ * lock, taken by its CPU around a put and by the tracing thread around
+ * a get. Only these two ever contend for it.
+ */
+static struct k_spinlock tracing_buf_lock[TRACING_BUFFER_COUNT];
+static k_spinlock_key_t tracing_buf_key[TRACING_BUFFER_COUNT];
+#endif
+
+/* Buffer written by the current context. With per-CPU buffers, events
+ * are only put with local interrupts masked, so the CPU cannot change
+ * between tracing_buffer_lock() and tracing_buffer_unlock().
+ */
+static inline struct ring_buf *local_ring_buf(void)
+{
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+	return &tracing_ring_buf[arch_curr_cpu()->id];
+#else
+	return &tracing_ring_buf[0];
+#endif
+}
+
 uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
 {
 	*data = &tracing_cmd_buffer[0];
@@ -19,51 +50,94 @@ uint32_t tracing_cmd_buffer_alloc(uint8_t **data)
 
 uint32_t tracing_buffer_put_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_put_claim(&tracing_ring_buf, data, size);
+	return ring_buf_put_claim(local_ring_buf(), data, size);
 }
 
 int tracing_buffer_put_finish(uint32_t size)
 {
-	return ring_buf_put_finish(&tracing_ring_buf, size);
+	return ring_buf_put_finish(local_ring_buf(), size);
 }
 
 uint32_t tracing_buffer_put(uint8_t *data, uint32_t size)
 {
-	return ring_buf_put(&tracing_ring_buf, data, size);
+	return ring_buf_put(local_ring_buf(), data, size);
 }
 
 uint32_t tracing_buffer_get_claim(uint8_t **data, uint32_t size)
 {
-	return ring_buf_get_claim(&tracing_ring_buf, data, size);
+	return ring_buf_get_claim(&tracing_ring_buf[0], data, size);
 }
 
 int tracing_buffer_get_finish(uint32_t size)
 {
-	return ring_buf_get_finish(&tracing_ring_buf, size);
+	return ring_buf_get_finish(&tracing_ring_buf[0], size);
 }
 
 uint32_t tracing_buffer_get(uint8_t *data, uint32_t size)
 {
-	return ring_buf_get(&tracing_ring_buf, data, size);
+	return ring_buf_get(&tracing_ring_buf[0], data, size);
+}
+
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+uint32_t tracing_buffer_cpu_get(uint32_t cpu_id, uint8_t *data, uint32_t size)
+{
+	k_spinlock_key_t key = k_spin_lock(&tracing_buf_lock[cpu_id]);
+	uint32_t length;
+
+	length = ring_buf_get(&tracing_ring_buf[cpu_id], data, size);
+	k_spin_unlock(&tracing_buf_lock[cpu_id], key);
+
+	return length;
+}
+
+unsigned int tracing_buffer_lock(void)
+{
+	unsigned int key = arch_irq_lock();
+	uint32_t cpu = arch_curr_cpu()->id;
+
+	tracing_buf_key[cpu] = k_spin_lock(&tracing_buf_lock[cpu]);
+
+	return key;
+}
+
+void tracing_buffer_unlock(unsigned int key)
+{
+	uint32_t cpu = arch_curr_cpu()->id;
+
+	k_spin_unlock(&tracing_buf_lock[cpu], tracing_buf_key[cpu]);
+	arch_irq_unlock(key);
 }
+#endif
 
 void tracing_buffer_init(void)
 {
-	ring_buf_init(&tracing_ring_buf,
-		      sizeof(tracing_buffer), tracing_buffer);
+	for (int i = 0; i < TRACING_BUFFER_COUNT; i++) {
+		ring_buf_init(&tracing_ring_buf[i],
+			      sizeof(tracing_buffer[i]), tracing_buffer[i]);
+	}
 }
 
+/* With per-CPU buffers, the other CPUs' buffers are read without their
+ * locks, so the result is only a hint for when to wake up the tracing
+ * thread.
+ */
 bool tracing_buffer_is_empty(void)
 {
-	return ring_buf_is_empty(&tracing_ring_buf);
+	for (int i = 0; i < TRACING_BUFFER_COUNT; i++) {
+		if (!ring_buf_is_empty(&tracing_ring_buf[i])) {
+			return false;
+		}
+	}
+
+	return true;
 }
 
 uint32_t tracing_buffer_capacity_get(void)
 {
-	return ring_buf_capacity_get(&tracing_ring_buf);
+	return ring_buf_capacity_get(local_ring_buf());
 }
 
 uint32_t tracing_buffer_space_get(void)
 {
-	return ring_buf_space_get(&tracing_ring_buf);
+	return ring_buf_space_get(local_ring_buf());
 }
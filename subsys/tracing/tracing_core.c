@@ -52,6 +52,54 @@ static K_SEM_DEFINE(tracing_thread_sem, 0, 1);
 static K_THREAD_STACK_DEFINE(tracing_thread_stack,
 			CONFIG_TRACING_THREAD_STACK_SIZE);
 
+#ifdef CONFIG_TRACING_PER_CPU_BUFFERS
+/* Large enough for the whole content of a CPU's buffer, so packets
+ * never end in the middle of an event.
+ */
+static uint8_t tracing_packet[TRACING_PACKET_HEADER_MAX_SIZE +
+			      CONFIG_TRACING_BUFFER_SIZE / CONFIG_MP_NUM_CPUS + 1];
+
+/* Output the content of each CPU's buffer as one packet, so the host
+ * can tell which CPU emitted the events.
+ */
+static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
+{
+	uint8_t *data = &tracing_packet[TRACING_PACKET_HEADER_MAX_SIZE];
+	uint32_t header_size = tracing_packet_header_size();
+	uint8_t *packet = data - header_size;
+	uint32_t length;
+	bool idle;
+
+	__ASSERT_NO_MSG(header_size <= TRACING_PACKET_HEADER_MAX_SIZE);
+
+	tracing_thread_tid = k_current_get();
+
+	while (true) {
+		/* Only sleep once a pass over the buffers, each read under
+		 * its lock, found nothing
+		 */
+		idle = true;
+
+		for (uint32_t cpu = 0; cpu < CONFIG_MP_NUM_CPUS; cpu++) {
+			length = tracing_buffer_cpu_get(cpu, data,
+				sizeof(tracing_packet) -
+				TRACING_PACKET_HEADER_MAX_SIZE);
+			if (length == 0U) {
+				continue;
+			}
+
+			idle = false;
+			tracing_packet_header_put(packet, cpu,
+						  header_size + length);
+			tracing_buffer_handle(packet, header_size + length);
+		}
+
+		if (idle) {
+			k_sem_take(&tracing_thread_sem, K_FOREVER);
+		}
+	}
+}
+#else
 static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 {
 	uint8_t *transferring_buf;
@@ -75,6 +123,7 @@ static void tracing_thread_func(void *dummy1, void *dummy2, void *dummy3)
 		}
 	}
 }
+#endif
 
 static void tracing_thread_timer_expiry_fn(struct k_timer *timer)
 {
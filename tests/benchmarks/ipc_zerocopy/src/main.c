@@ -0,0 +1,271 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <timing/timing.h>
+#include <app_memory/app_memdomain.h>
+
+/* Throughput benchmark comparing the copying k_pipe and k_msgq calls
+ * with the claim/commit calls.  FRAMES audio frames of 1 ms of 8
+ * channel, 32 bit, 48 kHz samples are passed through a pipe or message
+ * queue holding DEPTH frames.  The copy path generates each frame in a
+ * local buffer and sends it with k_pipe_put() or k_msgq_put(), and the
+ * receiver gets it into its own buffer before summing it.  The claim
+ * path generates the frame in the pipe or queue buffer and the receiver
+ * sums it there.
+ *
+ * The frames go from a producer to a consumer thread, and then from a
+ * single thread to itself, which leaves out the context switches.  With
+ * CONFIG_USERSPACE the measurement is repeated with user mode threads.
+ */
+#define CHANNELS 8
+#define SAMPLES 48
+#define FRAME_LEN (CHANNELS * SAMPLES)
+#define FRAME_SIZE (FRAME_LEN * sizeof(int32_t))
+#define FRAMES 20000
+#define DEPTH 16
+#define STACK_SIZE 2048
+
+K_APPMEM_PARTITION_DEFINE(bench_partition);
+
+K_APP_BMEM(bench_partition) static int32_t pipe_buf[DEPTH * FRAME_LEN];
+K_APP_BMEM(bench_partition) static int32_t msgq_buf[DEPTH * FRAME_LEN];
+K_APP_BMEM(bench_partition) static int32_t tx_frame[FRAME_LEN];
+K_APP_BMEM(bench_partition) static int32_t rx_frame[FRAME_LEN];
+K_APP_BMEM(bench_partition) static uint32_t checksum;
+
+static struct k_pipe pipe;
+static struct k_msgq msgq;
+
+K_THREAD_STACK_DEFINE(producer_stack, STACK_SIZE);
+K_THREAD_STACK_DEFINE(consumer_stack, STACK_SIZE);
+static struct k_thread producer_thread;
+static struct k_thread consumer_thread;
+
+struct ipc_ops {
+	void (*put)(bool claim, uint32_t seq);
+	void (*get)(bool claim);
+};
+
+/* Stand in for generating and mixing the audio */
+static void produce(int32_t *frame, uint32_t seq)
+{
+	for (int i = 0; i < FRAME_LEN; i++) {
+		frame[i] = seq + i;
+	}
+}
+
+static void consume(const int32_t *frame)
+{
+	uint32_t sum = 0;
+
+	for (int i = 0; i < FRAME_LEN; i++) {
+		sum += frame[i];
+	}
+
+	checksum += sum;
+}
+
+/* The buffers hold a whole number of frames and frames are always
+ * consumed whole, so claims never come back short of a frame.
+ */
+static void pipe_put(bool claim, uint32_t seq)
+{
+	size_t bytes = FRAME_SIZE;
+	void *ptr;
+
+	if (claim) {
+		(void)k_pipe_put_claim(&pipe, &ptr, &bytes, K_FOREVER);
+		produce(ptr, seq);
+		(void)k_pipe_put_commit(&pipe, bytes);
+	} else {
+		produce(tx_frame, seq);
+		(void)k_pipe_put(&pipe, tx_frame, FRAME_SIZE, &bytes,
+				 FRAME_SIZE, K_FOREVER);
+	}
+}
+
+static void pipe_get(bool claim)
+{
+	size_t bytes = FRAME_SIZE;
+	void *ptr;
+
+	if (claim) {
+		(void)k_pipe_get_claim(&pipe, &ptr, &bytes, K_FOREVER);
+		consume(ptr);
+		(void)k_pipe_get_commit(&pipe, bytes);
+	} else {
+		(void)k_pipe_get(&pipe, rx_frame, FRAME_SIZE, &bytes,
+				 FRAME_SIZE, K_FOREVER);
+		consume(rx_frame);
+	}
+}
+
+static void msgq_put(bool claim, uint32_t seq)
+{
+	void *ptr;
+
+	if (claim) {
+		(void)k_msgq_put_claim(&msgq, &ptr, K_FOREVER);
+		produce(ptr, seq);
+		(void)k_msgq_put_commit(&msgq);
+	} else {
+		produce(tx_frame, seq);
+		(void)k_msgq_put(&msgq, tx_frame, K_FOREVER);
+	}
+}
+
+static void msgq_get(bool claim)
+{
+	void *ptr;
+
+	if (claim) {
+		(void)k_msgq_get_claim(&msgq, &ptr, K_FOREVER);
+		consume(ptr);
+		(void)k_msgq_get_commit(&msgq);
+	} else {
+		(void)k_msgq_get(&msgq, rx_frame, K_FOREVER);
+		consume(rx_frame);
+	}
+}
+
+static const struct ipc_ops pipe_ops = { pipe_put, pipe_get };
+static const struct ipc_ops msgq_ops = { msgq_put, msgq_get };
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	const struct ipc_ops *ops = p1;
+	bool claim = (bool)(uintptr_t)p2;
+
+	for (uint32_t i = 0; i < FRAMES; i++) {
+		ops->put(claim, i);
+	}
+}
+
+static void consumer(void *p1, void *p2, void *p3)
+{
+	const struct ipc_ops *ops = p1;
+	bool claim = (bool)(uintptr_t)p2;
+
+	for (uint32_t i = 0; i < FRAMES; i++) {
+		ops->get(claim);
+	}
+}
+
+static void inline_loop(void *p1, void *p2, void *p3)
+{
+	const struct ipc_ops *ops = p1;
+	bool claim = (bool)(uintptr_t)p2;
+
+	for (uint32_t i = 0; i < FRAMES; i++) {
+		ops->put(claim, i);
+		ops->get(claim);
+	}
+}
+
+static uint32_t expected_checksum(void)
+{
+	uint32_t sum = 0;
+
+	for (uint32_t i = 0; i < FRAMES; i++) {
+		sum += i * FRAME_LEN + FRAME_LEN * (FRAME_LEN - 1) / 2;
+	}
+
+	return sum;
+}
+
+static void create(struct k_thread *thread, k_thread_stack_t *stack,
+		   k_thread_entry_t entry, const struct ipc_ops *ops,
+		   bool claim, uint32_t options)
+{
+	k_thread_create(thread, stack, STACK_SIZE, entry, (void *)ops,
+			(void *)(uintptr_t)claim, NULL, K_PRIO_PREEMPT(1),
+			options, K_FOREVER);
+
+#if defined(CONFIG_USERSPACE)
+	k_thread_access_grant(thread, &pipe, &msgq);
+#endif
+}
+
+static uint64_t run_once(const struct ipc_ops *ops, bool threads, bool claim,
+			 uint32_t options)
+{
+	timing_t start, end;
+
+	if (threads) {
+		create(&consumer_thread, consumer_stack, consumer, ops, claim,
+		       options);
+		create(&producer_thread, producer_stack, producer, ops, claim,
+		       options);
+	} else {
+		create(&producer_thread, producer_stack, inline_loop, ops,
+		       claim, options);
+	}
+
+	checksum = 0;
+	start = timing_counter_get();
+
+	if (threads) {
+		k_thread_start(&consumer_thread);
+	}
+	k_thread_start(&producer_thread);
+
+	k_thread_join(&producer_thread, K_FOREVER);
+	if (threads) {
+		k_thread_join(&consumer_thread, K_FOREVER);
+	}
+
+	end = timing_counter_get();
+
+	if (checksum != expected_checksum()) {
+		printk("checksum mismatch\n");
+	}
+
+	return MAX(timing_cycles_to_ns(timing_cycles_get(&start, &end)), 1U);
+}
+
+static uint32_t mbps(uint64_t elapsed)
+{
+	return (uint64_t)FRAME_SIZE * FRAMES * 8U * 1000U / elapsed;
+}
+
+static void run(const char *name, const struct ipc_ops *ops,
+		const char *mode, uint32_t options)
+{
+	static const char *const kinds[] = { "inline", "threads" };
+	uint64_t copy, claim;
+
+	for (int threads = 0; threads < 2; threads++) {
+		copy = run_once(ops, threads, false, options);
+		claim = run_once(ops, threads, true, options);
+
+		printk("%s %s %-7s copy_mbps %5u claim_mbps %5u\n", name, mode,
+		       kinds[threads], mbps(copy), mbps(claim));
+	}
+}
+
+void main(void)
+{
+	k_pipe_init(&pipe, (unsigned char *)pipe_buf, sizeof(pipe_buf));
+	k_msgq_init(&msgq, (char *)msgq_buf, FRAME_SIZE, DEPTH);
+
+	timing_init();
+	timing_start();
+
+	run("pipe", &pipe_ops, "kernel", 0);
+	run("msgq", &msgq_ops, "kernel", 0);
+
+#if defined(CONFIG_USERSPACE)
+	k_mem_domain_add_partition(&k_mem_domain_default, &bench_partition);
+	run("pipe", &pipe_ops, "user", K_USER);
+	run("msgq", &msgq_ops, "user", K_USER);
+#endif
+
+	timing_stop();
+
+	printk("fin\n");
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <timing/timing.h>
+
+#define HEAP_SIZE (16 * 1024)
+#define SLOTS_PER_WORKER 32
+#define OPS_PER_WORKER 20000
+#define MIN_ALLOC 8
+#define MAX_ALLOC 200
+#define STACK_SIZE 1024
+
+K_HEAP_DEFINE(plain_heap, HEAP_SIZE);
+K_HEAP_DEFINE_FLAGS(mag_heap, HEAP_SIZE, K_HEAP_MAGAZINES);
+
+struct worker_result {
+	uint64_t alloc_cycles;
+	uint64_t free_cycles;
+	uint32_t failures;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_NUM_CPUS, STACK_SIZE);
+static struct k_thread threads[CONFIG_MP_NUM_CPUS];
+static void *slots[CONFIG_MP_NUM_CPUS][SLOTS_PER_WORKER];
+static struct worker_result results[CONFIG_MP_NUM_CPUS];
+
+/* Replaces a pseudo-randomly chosen live block with a new one of
+ * pseudo-random size, and times the free and the allocation.
+ */
+static void worker(void *arg1, void *arg2, void *arg3)
+{
+	struct k_heap *h = arg1;
+	int id = POINTER_TO_INT(arg2);
+	struct worker_result *result = &results[id];
+	void **table = slots[id];
+	uint32_t rand = 12345U + id;
+	timing_t t0, t1, t2;
+
+	ARG_UNUSED(arg3);
+
+	for (int i = 0; i < OPS_PER_WORKER; i++) {
+		rand = rand * 1103515245U + 12345U;
+
+		int slot = (rand >> 8) % SLOTS_PER_WORKER;
+		size_t sz = MIN_ALLOC + (rand >> 16) % (MAX_ALLOC - MIN_ALLOC);
+
+		t0 = timing_counter_get();
+		k_heap_free(h, table[slot]);
+		t1 = timing_counter_get();
+		table[slot] = k_heap_alloc(h, sz, K_NO_WAIT);
+		t2 = timing_counter_get();
+
+		result->free_cycles += timing_cycles_get(&t0, &t1);
+		result->alloc_cycles += timing_cycles_get(&t1, &t2);
+		if (table[slot] == NULL) {
+			result->failures++;
+		}
+	}
+
+	for (int slot = 0; slot < SLOTS_PER_WORKER; slot++) {
+		k_heap_free(h, table[slot]);
+		table[slot] = NULL;
+	}
+}
+
+static void run(const char *name, struct k_heap *h, int nworkers)
+{
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+	uint64_t alloc_cycles = 0U, free_cycles = 0U;
+	uint32_t count = OPS_PER_WORKER * nworkers;
+	uint32_t failures = 0U;
+
+	for (int i = 0; i < nworkers; i++) {
+		results[i] = (struct worker_result){ 0 };
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, worker,
+				h, INT_TO_POINTER(i), NULL, prio, 0,
+				K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+		/* The magazines are per CPU, give each worker its own */
+		k_thread_cpu_mask_clear(&threads[i]);
+		k_thread_cpu_mask_enable(&threads[i], i);
+#endif
+	}
+
+	for (int i = 0; i < nworkers; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (int i = 0; i < nworkers; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		alloc_cycles += results[i].alloc_cycles;
+		free_cycles += results[i].free_cycles;
+		failures += results[i].failures;
+	}
+
+	printk("%-8s workers %d alloc %llu ns free %llu ns failed %u\n",
+	       name, nworkers,
+	       (unsigned long long)timing_cycles_to_ns_avg(alloc_cycles, count),
+	       (unsigned long long)timing_cycles_to_ns_avg(free_cycles, count),
+	       failures);
+}
+
+void main(void)
+{
+	struct k_heap_magazine_stats stats;
+
+	timing_init();
+	timing_start();
+
+	for (int nworkers = 1; nworkers <= CONFIG_MP_NUM_CPUS; nworkers++) {
+		run("plain", &plain_heap, nworkers);
+		run("magazine", &mag_heap, nworkers);
+	}
+
+	timing_stop();
+
+	k_heap_magazine_stats_get(&mag_heap, &stats);
+	printk("magazine hits %u misses %u refills %u flushes %u cached %u\n",
+	       stats.hits, stats.misses, stats.refills, stats.flushes,
+	       stats.cached_blocks);
+	printk("fin\n");
+}
@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <timing/timing.h>
+#include <app_memory/app_memdomain.h>
+
+/* System call overhead against the number of dynamic kernel objects.
+ * A growing number of semaphores is allocated with k_object_alloc(),
+ * all held by the main thread.  At each step a user thread makes
+ * SYSCALLS k_sem_count_get() calls on another dynamic semaphore, which
+ * costs a system call and the validation of the semaphore, and
+ * THREADS user threads granted only that semaphore are created, run
+ * and joined, which includes revoking their permissions when they
+ * exit.  Neither time should depend on the number of objects.
+ */
+#define SYSCALLS 100000
+#define THREADS 200
+#define STACKSIZE 1024
+#define PRIORITY 5
+
+static const uint32_t object_counts[] = { 0, 64, 512, 4096 };
+
+K_APPMEM_PARTITION_DEFINE(bench_partition);
+
+K_APP_BMEM(bench_partition) static struct k_sem *target;
+
+static K_THREAD_STACK_DEFINE(stack, STACKSIZE);
+static struct k_thread thread;
+
+static void count_get(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < SYSCALLS; i++) {
+		(void)k_sem_count_get(target);
+	}
+}
+
+static void nop(void *p1, void *p2, void *p3)
+{
+	ARG_UNUSED(p1);
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+}
+
+static uint64_t run_thread(k_thread_entry_t entry)
+{
+	timing_t start = timing_counter_get(), end;
+
+	k_thread_create(&thread, stack, STACKSIZE, entry, NULL, NULL, NULL,
+			PRIORITY, K_USER, K_FOREVER);
+	k_object_access_grant(target, &thread);
+	k_thread_start(&thread);
+	k_thread_join(&thread, K_FOREVER);
+
+	end = timing_counter_get();
+
+	return timing_cycles_to_ns(timing_cycles_get(&start, &end));
+}
+
+void main(void)
+{
+	uint64_t syscalls, exits;
+	uint32_t allocated = 0;
+
+	k_thread_system_pool_assign(k_current_get());
+	k_mem_domain_add_partition(&k_mem_domain_default, &bench_partition);
+
+	target = k_object_alloc(K_OBJ_SEM);
+	if (target == NULL) {
+		printk("allocation failed\n");
+		return;
+	}
+	k_sem_init(target, 0, 1);
+
+	timing_init();
+	timing_start();
+
+	for (int i = 0; i < ARRAY_SIZE(object_counts); i++) {
+		for (; allocated < object_counts[i]; allocated++) {
+			if (k_object_alloc(K_OBJ_SEM) == NULL) {
+				printk("allocation failed\n");
+				return;
+			}
+		}
+
+		syscalls = run_thread(count_get);
+
+		exits = 0;
+		for (int j = 0; j < THREADS; j++) {
+			exits += run_thread(nop);
+		}
+
+		printk("objects %4u syscall_ns %5u thread_exit_us %5u\n",
+		       allocated, (uint32_t)(syscalls / SYSCALLS),
+		       (uint32_t)(exits / THREADS / NSEC_PER_USEC));
+	}
+
+	timing_stop();
+
+	printk("fin\n");
+}
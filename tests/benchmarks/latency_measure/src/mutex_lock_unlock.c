@@ -14,24 +14,13 @@
 
 K_MUTEX_DEFINE(test_mutex);
 
-
-/**
- *
- * @brief Test for the multiple mutex lock/unlock time
- *
- * The routine performs multiple mutex locks and then multiple mutex
- * unlocks to measure the necessary time.
- *
- * @return 0 on success
- */
-int mutex_lock_unlock(void)
+static void lock_unlock(const char *what)
 {
 	int i;
 	uint32_t diff;
 	timing_t timestamp_start;
 	timing_t timestamp_end;
-
-	timing_start();
+	char tag[64];
 
 	timestamp_start = timing_counter_get();
 
@@ -42,7 +31,8 @@ int mutex_lock_unlock(void)
 	timestamp_end = timing_counter_get();
 
 	diff = timing_cycles_get(&timestamp_start, &timestamp_end);
-	PRINT_STATS_AVG("Average time to lock a mutex", diff, N_TEST_MUTEX);
+	snprintk(tag, sizeof(tag), "Average time to lock a %s", what);
+	PRINT_STATS_AVG(tag, diff, N_TEST_MUTEX);
 
 	timestamp_start = timing_counter_get();
 
@@ -53,7 +43,36 @@ int mutex_lock_unlock(void)
 	timestamp_end = timing_counter_get();
 	diff = timing_cycles_get(&timestamp_start, &timestamp_end);
 
-	PRINT_STATS_AVG("Average time to unlock a mutex", diff, N_TEST_MUTEX);
+	snprintk(tag, sizeof(tag), "Average time to unlock a %s", what);
+	PRINT_STATS_AVG(tag, diff, N_TEST_MUTEX);
+}
+
+/**
+ *
+ * @brief Test for the multiple mutex lock/unlock time
+ *
+ * The routine performs multiple mutex locks and then multiple mutex
+ * unlocks to measure the necessary time.  With
+ * CONFIG_MUTEX_CEILING_PROTOCOL, this is repeated with a priority
+ * ceiling set on the mutex, which raises the owner priority on the
+ * first lock and restores it on the last unlock.
+ *
+ * @return 0 on success
+ */
+int mutex_lock_unlock(void)
+{
+	timing_start();
+
+	lock_unlock("mutex");
+
+#ifdef CONFIG_MUTEX_CEILING_PROTOCOL
+	int prio = k_thread_priority_get(k_current_get());
+
+	k_mutex_ceiling_set(&test_mutex, MAX(prio - 1, K_HIGHEST_THREAD_PRIO));
+	lock_unlock("ceiling mutex");
+	k_mutex_ceiling_set(&test_mutex, K_MUTEX_NO_CEILING);
+#endif
+
 	timing_stop();
 	return 0;
 }
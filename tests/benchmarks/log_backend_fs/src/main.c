@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <sys/printk.h>
+#include <logging/log.h>
+#include <logging/log_ctrl.h>
+#include <logging/log_backend_fs.h>
+#include <stats/stats.h>
+
+LOG_MODULE_REGISTER(bench, LOG_LEVEL_INF);
+
+#define MSGS 2000
+
+static int flash_write_calls_get(struct stats_hdr *hdr, void *arg,
+				 const char *name, uint16_t off)
+{
+	if (strcmp(name, "flash_write_calls") == 0) {
+		*(uint32_t *)arg = *(uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
+static uint32_t flash_writes_get(void)
+{
+	struct stats_hdr *hdr = stats_group_find("flash_sim_stats");
+	uint32_t writes = 0;
+
+	if (hdr != NULL) {
+		(void)stats_walk(hdr, flash_write_calls_get, &writes);
+	}
+
+	return writes;
+}
+
+/* Wait until all log output is written to the log file */
+static void settle(void)
+{
+	while (log_buffered_cnt() != 0U) {
+		k_msleep(10);
+	}
+
+	k_msleep(2 * COND_CODE_1(CONFIG_LOG_BACKEND_FS_BATCH,
+				 (CONFIG_LOG_BACKEND_FS_BATCH_TIMEOUT_MS),
+				 (10)));
+}
+
+void main(void)
+{
+	struct log_backend_fs_stats start, end;
+	uint32_t flash_start, flash_end;
+	int64_t t;
+	uint32_t elapsed, bytes;
+
+	/* Let the backend open its first log file */
+	LOG_INF("start");
+	settle();
+
+	log_backend_fs_stats_get(&start);
+	flash_start = flash_writes_get();
+	t = k_uptime_get();
+
+	for (int i = 0; i < MSGS; i++) {
+		LOG_INF("message %d of %d", i, MSGS);
+	}
+
+	while (log_buffered_cnt() != 0U) {
+		k_msleep(1);
+	}
+
+	/* With batching, up to two batches may not be written yet. They are
+	 * not included in the rate, but in the write counts below.
+	 */
+	elapsed = MAX((uint32_t)k_uptime_delta(&t), 1U);
+	log_backend_fs_stats_get(&end);
+	bytes = end.bytes - start.bytes;
+
+	settle();
+	log_backend_fs_stats_get(&end);
+	flash_end = flash_writes_get();
+
+	printk("msgs %d bytes_per_sec %u fs_writes %u fs_syncs %u "
+	       "flash_writes %u (per 100 msgs)\n",
+	       MSGS,
+	       (uint32_t)((uint64_t)bytes * MSEC_PER_SEC / elapsed),
+	       (end.writes - start.writes) * 100 / MSGS,
+	       (end.syncs - start.syncs) * 100 / MSGS,
+	       (flash_end - flash_start) * 100 / MSGS);
+
+	printk("fin\n");
+}
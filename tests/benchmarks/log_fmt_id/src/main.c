@@ -0,0 +1,109 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <logging/log.h>
+#include <logging/log_backend.h>
+#include <logging/log_ctrl.h>
+
+LOG_MODULE_REGISTER(bench, LOG_LEVEL_INF);
+
+/* Each batch must fit in the log buffer, so that no message is dropped */
+#define MSGS_PER_BATCH 100
+#define BATCHES 20
+
+enum msg_kind {
+	MSG_INTS,
+	MSG_RODATA_STR,
+	MSG_RAM_STR,
+};
+
+static const char *const kind_names[] = {
+	[MSG_INTS] = "ints",
+	[MSG_RODATA_STR] = "rodata_str",
+	[MSG_RAM_STR] = "ram_str",
+};
+
+static const char *rodata_str = "rodata";
+static char ram_str[] = "ram";
+
+static uint32_t processed;
+static uint32_t dropped;
+
+static void process(const struct log_backend *const backend,
+		    union log_msg2_generic *msg)
+{
+	processed++;
+}
+
+static void backend_dropped(const struct log_backend *const backend,
+			    uint32_t cnt)
+{
+	dropped += cnt;
+}
+
+static void panic(const struct log_backend *const backend)
+{
+}
+
+static const struct log_backend_api counting_api = {
+	.process = process,
+	.dropped = backend_dropped,
+	.panic = panic,
+};
+
+LOG_BACKEND_DEFINE(counting_backend, counting_api, true);
+
+static uint32_t batch(enum msg_kind kind)
+{
+	uint32_t start = k_cycle_get_32();
+
+	for (int i = 0; i < MSGS_PER_BATCH; i++) {
+		switch (kind) {
+		case MSG_INTS:
+			LOG_INF("message %d of %d", i, MSGS_PER_BATCH);
+			break;
+		case MSG_RODATA_STR:
+			LOG_INF("message %s %d", rodata_str, i);
+			break;
+		case MSG_RAM_STR:
+			LOG_INF("message %s %d", ram_str, i);
+			break;
+		}
+	}
+
+	return k_cycle_get_32() - start;
+}
+
+static void run(enum msg_kind kind)
+{
+	uint64_t cycles = 0;
+
+	processed = 0;
+	dropped = 0;
+
+	for (int i = 0; i < BATCHES; i++) {
+		cycles += batch(kind);
+
+		while (log_process(false)) {
+		}
+	}
+
+	printk("%-10s cycles_per_msg %u processed %u dropped %u\n",
+	       kind_names[kind],
+	       (uint32_t)(cycles / (MSGS_PER_BATCH * BATCHES)),
+	       processed, dropped);
+}
+
+void main(void)
+{
+	run(MSG_INTS);
+	run(MSG_RODATA_STR);
+	run(MSG_RAM_STR);
+
+	printk("fin\n");
+}
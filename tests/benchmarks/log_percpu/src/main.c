@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <logging/log.h>
+#include <logging/log_backend.h>
+#include <logging/log_ctrl.h>
+#include <timing/timing.h>
+
+LOG_MODULE_REGISTER(bench, LOG_LEVEL_INF);
+
+#define MSGS_PER_WRITER 5000
+#define STACK_SIZE 2048
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_NUM_CPUS, STACK_SIZE);
+static struct k_thread threads[CONFIG_MP_NUM_CPUS];
+static uint64_t cycles[CONFIG_MP_NUM_CPUS];
+
+static atomic_t processed;
+static atomic_t dropped;
+
+static void process(const struct log_backend *const backend,
+		    union log_msg2_generic *msg)
+{
+	atomic_inc(&processed);
+}
+
+static void backend_dropped(const struct log_backend *const backend,
+			    uint32_t cnt)
+{
+	atomic_add(&dropped, cnt);
+}
+
+static void panic(const struct log_backend *const backend)
+{
+}
+
+static const struct log_backend_api counting_api = {
+	.process = process,
+	.dropped = backend_dropped,
+	.panic = panic,
+};
+
+LOG_BACKEND_DEFINE(counting_backend, counting_api, true);
+
+/* Each writer logs from its own CPU and times its own messages */
+static void writer(void *arg1, void *arg2, void *arg3)
+{
+	int id = POINTER_TO_INT(arg1);
+	timing_t start, end;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < MSGS_PER_WRITER; i++) {
+		LOG_INF("writer %d message %d", id, i);
+	}
+
+	end = timing_counter_get();
+	cycles[id] = timing_cycles_get(&start, &end);
+}
+
+static void run(int nwriters)
+{
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+	uint64_t total = 0U, ns;
+
+	/* Start from empty buffers */
+	while (log_buffered_cnt() != 0U) {
+		k_msleep(10);
+	}
+	atomic_set(&processed, 0);
+	atomic_set(&dropped, 0);
+
+	for (int cpu = 0; cpu < nwriters; cpu++) {
+		k_thread_create(&threads[cpu], stacks[cpu], STACK_SIZE, writer,
+				INT_TO_POINTER(cpu), NULL, NULL, prio, 0,
+				K_FOREVER);
+		k_thread_cpu_mask_clear(&threads[cpu]);
+		k_thread_cpu_mask_enable(&threads[cpu], cpu);
+	}
+
+	for (int cpu = 0; cpu < nwriters; cpu++) {
+		k_thread_start(&threads[cpu]);
+	}
+
+	for (int cpu = 0; cpu < nwriters; cpu++) {
+		k_thread_join(&threads[cpu], K_FOREVER);
+		total += cycles[cpu];
+	}
+
+	while (log_buffered_cnt() != 0U) {
+		k_msleep(10);
+	}
+
+	ns = timing_cycles_to_ns_avg(total, MSGS_PER_WRITER * nwriters);
+
+	printk("writers %d msg_ns %5llu processed %u dropped %u\n", nwriters,
+	       (unsigned long long)ns, (uint32_t)atomic_get(&processed),
+	       (uint32_t)atomic_get(&dropped));
+}
+
+void main(void)
+{
+	timing_init();
+	timing_start();
+
+	run(1);
+	run(CONFIG_MP_NUM_CPUS);
+
+	timing_stop();
+
+	printk("fin\n");
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* Throughput benchmark for allocating and freeing blocks of one slab
+ * from several CPUs, as network buffers are by the Rx, Tx and
+ * application threads.  Each worker is pinned to its own CPU, holds up
+ * to BLOCKS_PER_WORKER blocks at a time and times its own rounds, so
+ * that the aggregate rate is the sum of the workers' rates.  A single
+ * worker gives the uncontended rate to compare with.
+ */
+#define BLOCK_SIZE 64
+#define BLOCKS_PER_WORKER 16
+#define ROUNDS_PER_WORKER 2000
+#define STACKSIZE 1024
+#define PRIORITY 5
+
+/* One alloc and one free per block and round */
+#define OPS_PER_WORKER (2 * ROUNDS_PER_WORKER * BLOCKS_PER_WORKER)
+
+K_MEM_SLAB_DEFINE(slab, BLOCK_SIZE, BLOCKS_PER_WORKER * CONFIG_MP_NUM_CPUS, 4);
+
+struct worker_result {
+	uint32_t ops_per_ms;
+	uint32_t failures;
+};
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_NUM_CPUS, STACKSIZE);
+static struct k_thread threads[CONFIG_MP_NUM_CPUS];
+static void *blocks[CONFIG_MP_NUM_CPUS][BLOCKS_PER_WORKER];
+static struct worker_result results[CONFIG_MP_NUM_CPUS];
+
+static void worker(void *p1, void *p2, void *p3)
+{
+	int id = POINTER_TO_INT(p1);
+	bool batch = POINTER_TO_INT(p2) != 0;
+	struct worker_result *result = &results[id];
+	void **table = blocks[id];
+	uint32_t start = k_cycle_get_32();
+	uint64_t ns;
+
+	for (int i = 0; i < ROUNDS_PER_WORKER; i++) {
+		if (batch) {
+			if (k_mem_slab_alloc_n(&slab, table,
+					       BLOCKS_PER_WORKER) != 0) {
+				result->failures++;
+				continue;
+			}
+			k_mem_slab_free_n(&slab, table, BLOCKS_PER_WORKER);
+			continue;
+		}
+
+		for (int j = 0; j < BLOCKS_PER_WORKER; j++) {
+			if (k_mem_slab_alloc(&slab, &table[j], K_NO_WAIT) != 0) {
+				result->failures++;
+				table[j] = NULL;
+			}
+		}
+		for (int j = 0; j < BLOCKS_PER_WORKER; j++) {
+			if (table[j] != NULL) {
+				k_mem_slab_free(&slab, &table[j]);
+			}
+		}
+	}
+
+	ns = MAX(k_cyc_to_ns_floor64(k_cycle_get_32() - start), 1);
+	result->ops_per_ms = (uint32_t)((uint64_t)OPS_PER_WORKER * 1000000U /
+					ns);
+}
+
+static void run(const char *name, bool batch, int nworkers)
+{
+	uint32_t ops_per_ms = 0U, failures = 0U;
+
+	for (int cpu = 0; cpu < nworkers; cpu++) {
+		results[cpu] = (struct worker_result){ 0 };
+		k_thread_create(&threads[cpu], stacks[cpu], STACKSIZE, worker,
+				INT_TO_POINTER(cpu), INT_TO_POINTER(batch),
+				NULL, PRIORITY, 0, K_FOREVER);
+		k_thread_cpu_mask_clear(&threads[cpu]);
+		k_thread_cpu_mask_enable(&threads[cpu], cpu);
+	}
+
+	for (int cpu = 0; cpu < nworkers; cpu++) {
+		k_thread_start(&threads[cpu]);
+	}
+
+	for (int cpu = 0; cpu < nworkers; cpu++) {
+		k_thread_join(&threads[cpu], K_FOREVER);
+		ops_per_ms += results[cpu].ops_per_ms;
+		failures += results[cpu].failures;
+	}
+
+	printk("%-6s workers %d ops_per_ms %8u failed %u\n", name, nworkers,
+	       ops_per_ms, failures);
+}
+
+void main(void)
+{
+	run("single", false, 1);
+	run("single", false, CONFIG_MP_NUM_CPUS);
+	run("batch", true, 1);
+	run("batch", true, CONFIG_MP_NUM_CPUS);
+
+	printk("used %u max_used %u of %u\n", k_mem_slab_num_used_get(&slab),
+	       k_mem_slab_max_used_get(&slab),
+	       BLOCKS_PER_WORKER * CONFIG_MP_NUM_CPUS);
+	printk("fin\n");
+}
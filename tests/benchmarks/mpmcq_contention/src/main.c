@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* Throughput benchmark for handing items from producers on several CPUs
+ * to a consumer on another one, as drivers and traffic class threads do
+ * with network packets.  The consumer thread is pinned to the last CPU,
+ * one producer is pinned to each of the other CPUs, and every producer
+ * queues ITEMS items as fast as it can.  The same run is done through a
+ * k_fifo, where every put and get takes the queue's spinlock, and through
+ * a k_mpmcq, where they do not.
+ */
+#define ITEMS 20000
+#define QUEUE_LEN 64
+#define STACKSIZE 1024
+#define PRIORITY 5
+#define NUM_PRODUCERS (CONFIG_MP_NUM_CPUS - 1)
+
+struct item {
+	void *fifo_reserved;
+};
+
+static struct item items[NUM_PRODUCERS][ITEMS];
+
+static K_FIFO_DEFINE(fifo);
+K_MPMCQ_DEFINE(mpmcq, QUEUE_LEN);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_NUM_CPUS, STACKSIZE);
+static struct k_thread threads[CONFIG_MP_NUM_CPUS];
+
+static void fifo_producer(void *p1, void *p2, void *p3)
+{
+	struct item *mine = p1;
+
+	for (int i = 0; i < ITEMS; i++) {
+		k_fifo_put(&fifo, &mine[i]);
+	}
+}
+
+static void fifo_consumer(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < NUM_PRODUCERS * ITEMS; i++) {
+		(void)k_fifo_get(&fifo, K_FOREVER);
+	}
+}
+
+static void mpmcq_producer(void *p1, void *p2, void *p3)
+{
+	struct item *mine = p1;
+
+	for (int i = 0; i < ITEMS; i++) {
+		(void)k_mpmcq_put(&mpmcq, &mine[i], K_FOREVER);
+	}
+}
+
+static void mpmcq_consumer(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < NUM_PRODUCERS * ITEMS; i++) {
+		(void)k_mpmcq_get(&mpmcq, K_FOREVER);
+	}
+}
+
+static void start_pinned(int cpu, k_thread_entry_t entry, void *p1)
+{
+	k_thread_create(&threads[cpu], stacks[cpu], STACKSIZE, entry,
+			p1, NULL, NULL, PRIORITY, 0, K_FOREVER);
+	k_thread_cpu_mask_clear(&threads[cpu]);
+	k_thread_cpu_mask_enable(&threads[cpu], cpu);
+}
+
+static void run(const char *name, k_thread_entry_t producer,
+		k_thread_entry_t consumer)
+{
+	uint32_t start, cycles;
+	uint64_t ns;
+
+	for (int i = 0; i < NUM_PRODUCERS; i++) {
+		start_pinned(i, producer, items[i]);
+	}
+	start_pinned(NUM_PRODUCERS, consumer, NULL);
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	cycles = k_cycle_get_32() - start;
+	ns = MAX(k_cyc_to_ns_floor64(cycles), 1);
+
+	printk("%-7s producers %d ops_per_ms %8u\n", name, NUM_PRODUCERS,
+	       (uint32_t)((uint64_t)NUM_PRODUCERS * ITEMS * 1000000U / ns));
+}
+
+void main(void)
+{
+	run("k_fifo", fifo_producer, fifo_consumer);
+	run("k_mpmcq", mpmcq_producer, mpmcq_consumer);
+
+	printk("fin\n");
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* Lock latency benchmark for a k_mutex contended across CPUs.  One
+ * thread pinned to each CPU locks the mutex, holds it for a short busy
+ * wait, unlocks it and busy waits for the same time before locking it
+ * again, CYCLES times.  So about every other lock finds the mutex owned
+ * by a thread running on the other CPU, which releases it within the
+ * hold time.  The time spent in k_mutex_lock() is reported on average
+ * and at worst, for a range of hold times.
+ *
+ * Without CONFIG_MUTEX_ADAPTIVE_SPIN the waiter always sleeps and is
+ * woken up by the unlock.  With it, the waiter spins as long as the
+ * owner runs and CONFIG_MUTEX_SPIN_BUDGET_NS allows, so short hold
+ * times avoid the context switches and the IPI.
+ */
+#define CYCLES 2000
+#define STACKSIZE 1024
+#define PRIORITY 5
+
+static const uint32_t hold_times_us[] = { 1, 5, 20, 100 };
+
+static K_MUTEX_DEFINE(mutex);
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_NUM_CPUS, STACKSIZE);
+static struct k_thread threads[CONFIG_MP_NUM_CPUS];
+
+struct lock_stats {
+	uint64_t total;
+	uint32_t max;
+};
+
+static struct lock_stats stats[CONFIG_MP_NUM_CPUS];
+
+static void lock_unlock(void *p1, void *p2, void *p3)
+{
+	struct lock_stats *st = p1;
+	uint32_t hold_us = POINTER_TO_UINT(p2);
+	uint32_t start, cycles;
+
+	ARG_UNUSED(p3);
+
+	for (int i = 0; i < CYCLES; i++) {
+		start = k_cycle_get_32();
+		k_mutex_lock(&mutex, K_FOREVER);
+		cycles = k_cycle_get_32() - start;
+
+		k_busy_wait(hold_us);
+		k_mutex_unlock(&mutex);
+
+		st->total += cycles;
+		st->max = MAX(st->max, cycles);
+
+		k_busy_wait(hold_us);
+	}
+}
+
+static void run(uint32_t hold_us)
+{
+	uint64_t total = 0;
+	uint32_t max = 0;
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		stats[i].total = 0;
+		stats[i].max = 0;
+
+		k_thread_create(&threads[i], stacks[i], STACKSIZE, lock_unlock,
+				&stats[i], UINT_TO_POINTER(hold_us), NULL,
+				PRIORITY, 0, K_FOREVER);
+		k_thread_cpu_mask_clear(&threads[i]);
+		k_thread_cpu_mask_enable(&threads[i], i);
+	}
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (int i = 0; i < CONFIG_MP_NUM_CPUS; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+		total += stats[i].total;
+		max = MAX(max, stats[i].max);
+	}
+
+	printk("hold_us %3u lock_avg_ns %6u lock_max_ns %7u\n", hold_us,
+	       (uint32_t)k_cyc_to_ns_floor64(total /
+					    (CYCLES * CONFIG_MP_NUM_CPUS)),
+	       (uint32_t)k_cyc_to_ns_floor64(max));
+}
+
+void main(void)
+{
+	printk("adaptive spin %s\n",
+	       IS_ENABLED(CONFIG_MUTEX_ADAPTIVE_SPIN) ? "on" : "off");
+
+	for (int i = 0; i < ARRAY_SIZE(hold_times_us); i++) {
+		run(hold_times_us[i]);
+	}
+
+	printk("fin\n");
+}
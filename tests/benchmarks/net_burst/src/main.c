@@ -0,0 +1,164 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <timing/timing.h>
+#include <net/net_core.h>
+#include <net/net_if.h>
+#include <net/net_pkt.h>
+#include <net/net_ip.h>
+#include <net/dummy.h>
+
+#include "connection.h"
+#include "ipv6.h"
+#include "udp_internal.h"
+
+/* Packet rate benchmark for the batched TX/RX path.  UDP packets are
+ * sent to ourselves over the loopback interface, in bursts of a given
+ * size, and received by a connection handler.  Each packet goes
+ * through the TX traffic class queue, the dummy L2 and the loopback
+ * driver, and then through the RX traffic class queue and the IPv6
+ * and UDP input path.  A burst size of 1 uses net_if_queue_tx(),
+ * larger ones net_if_queue_tx_burst().
+ */
+#define PKTS 20000
+#define PAYLOAD_LEN 64
+#define SRC_PORT 4241
+#define DST_PORT 4242
+
+static const uint8_t burst_sizes[] = { 1, 4, 16 };
+
+static struct net_pkt *pkts[16];
+static uint32_t received;
+static uint32_t expected;
+static K_SEM_DEFINE(burst_done, 0, 1);
+
+static enum net_verdict count_pkt(struct net_conn *conn,
+				  struct net_pkt *pkt,
+				  union net_ip_header *ip_hdr,
+				  union net_proto_header *proto_hdr,
+				  void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(user_data);
+
+	net_pkt_unref(pkt);
+
+	if (++received == expected) {
+		k_sem_give(&burst_done);
+	}
+
+	return NET_OK;
+}
+
+static struct net_pkt *create_pkt(struct net_if *iface)
+{
+	static const uint8_t payload[PAYLOAD_LEN];
+	struct net_pkt *pkt;
+
+	pkt = net_pkt_alloc_with_buffer(iface, sizeof(payload), AF_INET6,
+					IPPROTO_UDP, K_FOREVER);
+
+	if (net_ipv6_create(pkt, net_ipv6_unspecified_address(),
+			    net_ipv6_unspecified_address()) ||
+	    net_udp_create(pkt, htons(SRC_PORT), htons(DST_PORT)) ||
+	    net_pkt_write(pkt, payload, sizeof(payload))) {
+		net_pkt_unref(pkt);
+		return NULL;
+	}
+
+	/* Loopback swaps the addresses, use ::1 for both */
+	net_ipv6_addr_create(&NET_IPV6_HDR(pkt)->src, 0, 0, 0, 0, 0, 0, 0, 1);
+	net_ipv6_addr_create(&NET_IPV6_HDR(pkt)->dst, 0, 0, 0, 0, 0, 0, 0, 1);
+
+	net_pkt_cursor_init(pkt);
+	net_ipv6_finalize(pkt, IPPROTO_UDP);
+
+	return pkt;
+}
+
+static void run(struct net_if *iface, uint8_t burst)
+{
+	timing_t start, end;
+	uint64_t ns;
+	uint32_t sent = 0U;
+
+	received = 0U;
+	start = timing_counter_get();
+
+	while (sent < PKTS) {
+		for (int i = 0; i < burst; i++) {
+			pkts[i] = create_pkt(iface);
+			if (!pkts[i]) {
+				printk("cannot create packet\n");
+				return;
+			}
+		}
+
+		expected = sent + burst;
+
+		if (burst == 1) {
+			net_if_queue_tx(iface, pkts[0]);
+		} else {
+			net_if_queue_tx_burst(iface, pkts, burst);
+		}
+
+		if (k_sem_take(&burst_done, K_SECONDS(1))) {
+			printk("only %u of %u packets received\n", received,
+			       expected);
+			return;
+		}
+
+		sent += burst;
+	}
+
+	end = timing_counter_get();
+	ns = MAX(timing_cycles_to_ns(timing_cycles_get(&start, &end)), 1U);
+
+	printk("burst %2u pkts %6u pps %8u\n", burst, sent,
+	       (uint32_t)((uint64_t)sent * NSEC_PER_SEC / ns));
+}
+
+void main(void)
+{
+	struct sockaddr_in6 local = { .sin6_family = AF_INET6 };
+	struct net_conn_handle *handle;
+	struct net_if *iface;
+	int ret;
+
+	iface = net_if_get_first_by_type(&NET_L2_GET_NAME(DUMMY));
+	if (!iface) {
+		printk("no loopback interface\n");
+		return;
+	}
+
+	ret = net_conn_register(IPPROTO_UDP, AF_INET6, NULL,
+				(struct sockaddr *)&local, 0, DST_PORT,
+				NULL, count_pkt, NULL, &handle);
+	if (ret < 0) {
+		printk("cannot register handler: %d\n", ret);
+		return;
+	}
+
+	timing_init();
+	timing_start();
+
+	printk("driver bursts %s\n", IS_ENABLED(CONFIG_NET_BURST) ?
+	       "on" : "off");
+
+	for (int i = 0; i < ARRAY_SIZE(burst_sizes); i++) {
+		run(iface, burst_sizes[i]);
+	}
+
+	net_conn_unregister(handle);
+
+	timing_stop();
+
+	printk("fin\n");
+}
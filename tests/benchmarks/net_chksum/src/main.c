@@ -0,0 +1,169 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <logging/log.h>
+LOG_MODULE_REGISTER(net_chksum_bench, LOG_LEVEL_NONE);
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <string.h>
+#include <random/rand32.h>
+#include <timing/timing.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_ip.h>
+
+#include "net_private.h"
+
+/* Internet checksum benchmark.  The first part computes the UDP checksum
+ * of an IPv6 packet with PAYLOAD_LEN bytes of payload, split in
+ * fragments of various sizes, with net_calc_chksum() and reports the
+ * average time per call.  Odd fragment sizes make every other fragment
+ * start at an odd offset in the summed data.  The second part compares
+ * copying a buffer and then summing it, the way the UDP send path used
+ * to work, with net_calc_chksum_copy() doing both in one pass.
+ */
+#define ROUNDS 20000
+#define PAYLOAD_LEN 1024
+
+static const uint16_t frag_sizes[] = { 256, 128, 64, 61 };
+static const uint16_t copy_lens[] = { 64, 512, 1472 };
+
+static uint8_t src[1472];
+static uint8_t dst[1472];
+static volatile uint16_t result;
+
+/* Sum 16 bits at a time, as net_calc_chksum() used to */
+static uint16_t word_chksum(uint16_t sum, const uint8_t *data, size_t len)
+{
+	const uint8_t *end = data + len - 1;
+	uint16_t tmp;
+
+	while (data < end) {
+		tmp = (data[0] << 8) + data[1];
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+
+		data += 2;
+	}
+
+	if (data == end) {
+		tmp = data[0] << 8;
+		sum += tmp;
+		if (sum < tmp) {
+			sum++;
+		}
+	}
+
+	return sum;
+}
+
+static struct net_pkt *create_pkt(uint16_t frag_size)
+{
+	size_t hdr_len = sizeof(struct net_ipv6_hdr) + sizeof(struct net_udp_hdr);
+	struct net_pkt *pkt;
+	struct net_buf *frag;
+	size_t off = 0;
+
+	pkt = net_pkt_alloc(K_FOREVER);
+	net_pkt_set_family(pkt, AF_INET6);
+	net_pkt_set_ip_hdr_len(pkt, sizeof(struct net_ipv6_hdr));
+
+	frag = net_pkt_get_frag(pkt, K_FOREVER);
+	net_buf_add_mem(frag, src, hdr_len);
+	net_pkt_frag_add(pkt, frag);
+
+	while (off < PAYLOAD_LEN) {
+		size_t len = MIN(frag_size, PAYLOAD_LEN - off);
+
+		frag = net_pkt_get_frag(pkt, K_FOREVER);
+		if (!frag) {
+			net_pkt_unref(pkt);
+			return NULL;
+		}
+
+		net_buf_add_mem(frag, src + off, len);
+		net_pkt_frag_add(pkt, frag);
+		off += len;
+	}
+
+	return pkt;
+}
+
+static void run_pkt(uint16_t frag_size)
+{
+	struct net_pkt *pkt = create_pkt(frag_size);
+	timing_t start, end;
+
+	if (!pkt) {
+		printk("cannot create packet\n");
+		return;
+	}
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		result = net_calc_chksum(pkt, IPPROTO_UDP);
+	}
+
+	end = timing_counter_get();
+
+	printk("frags %4u len %5u ns %6u\n", frag_size, PAYLOAD_LEN,
+	       (uint32_t)timing_cycles_to_ns_avg(
+		       timing_cycles_get(&start, &end), ROUNDS));
+
+	net_pkt_unref(pkt);
+}
+
+static void run_copy(uint16_t len)
+{
+	timing_t start, end;
+	uint64_t separate, fused;
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		memcpy(dst, src, len);
+		result = word_chksum(0U, dst, len);
+	}
+
+	end = timing_counter_get();
+	separate = timing_cycles_get(&start, &end);
+	start = timing_counter_get();
+
+	for (int i = 0; i < ROUNDS; i++) {
+		result = net_calc_chksum_copy(dst, src, len);
+	}
+
+	end = timing_counter_get();
+	fused = timing_cycles_get(&start, &end);
+
+	printk("copy len %5u separate_ns %6u fused_ns %6u\n", len,
+	       (uint32_t)timing_cycles_to_ns_avg(separate, ROUNDS),
+	       (uint32_t)timing_cycles_to_ns_avg(fused, ROUNDS));
+}
+
+void main(void)
+{
+	sys_rand_get(src, sizeof(src));
+
+	timing_init();
+	timing_start();
+
+	for (int i = 0; i < ARRAY_SIZE(frag_sizes); i++) {
+		run_pkt(frag_sizes[i]);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(copy_lens); i++) {
+		run_copy(copy_lens[i]);
+	}
+
+	timing_stop();
+
+	printk("fin\n");
+}
@@ -0,0 +1,137 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <timing/timing.h>
+#include <net/net_core.h>
+#include <net/net_pkt.h>
+#include <net/net_ip.h>
+#include <net/udp.h>
+
+#include "connection.h"
+
+/* Receive demultiplexing benchmark.  For each connection count, that
+ * many connected UDP handlers (same peer address, one remote port
+ * each) are registered, then net_conn_input() is called LOOKUPS times
+ * with a packet addressed to each handler in turn.  The reported time
+ * is the average cost of one net_conn_input() call, which is dominated
+ * by finding the handler.
+ */
+#define LOOKUPS 100000
+#define LOCAL_PORT 4242
+#define REMOTE_PORT_BASE 10000
+
+static const uint16_t conn_counts[] = { 1, 8, 32, 128, 256 };
+
+static struct net_conn_handle *handles[CONFIG_NET_MAX_CONN];
+static uint32_t hits;
+
+static struct sockaddr_in6 local = {
+	.sin6_family = AF_INET6,
+	.sin6_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+			   0, 0, 0, 0, 0, 0, 0, 0x1 } } },
+};
+
+static struct sockaddr_in6 remote = {
+	.sin6_family = AF_INET6,
+	.sin6_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+			   0, 0, 0, 0, 0, 0, 0, 0x2 } } },
+};
+
+static struct net_ipv6_hdr ipv6_hdr;
+static struct net_udp_hdr udp_hdr;
+
+static enum net_verdict count_hit(struct net_conn *conn,
+				  struct net_pkt *pkt,
+				  union net_ip_header *ip_hdr,
+				  union net_proto_header *proto_hdr,
+				  void *user_data)
+{
+	ARG_UNUSED(conn);
+	ARG_UNUSED(pkt);
+	ARG_UNUSED(ip_hdr);
+	ARG_UNUSED(proto_hdr);
+	ARG_UNUSED(user_data);
+
+	/* The packet is reused for every lookup, so keep it */
+	hits++;
+
+	return NET_OK;
+}
+
+static void run(struct net_pkt *pkt, uint16_t count)
+{
+	union net_ip_header ip_hdr = { .ipv6 = &ipv6_hdr };
+	union net_proto_header proto_hdr = { .udp = &udp_hdr };
+	timing_t start, end;
+	int ret;
+
+	for (int i = 0; i < count; i++) {
+		ret = net_conn_register(IPPROTO_UDP, AF_INET6,
+					(struct sockaddr *)&remote,
+					(struct sockaddr *)&local,
+					REMOTE_PORT_BASE + i, LOCAL_PORT,
+					NULL, count_hit, NULL, &handles[i]);
+		if (ret < 0) {
+			printk("cannot register handler %d: %d\n", i, ret);
+			count = i;
+			goto out;
+		}
+	}
+
+	hits = 0U;
+	start = timing_counter_get();
+
+	for (int i = 0; i < LOOKUPS; i++) {
+		udp_hdr.src_port = htons(REMOTE_PORT_BASE + (i % count));
+
+		net_conn_input(pkt, &ip_hdr, IPPROTO_UDP, &proto_hdr);
+	}
+
+	end = timing_counter_get();
+
+	if (hits != LOOKUPS) {
+		printk("only %u of %u packets delivered\n", hits, LOOKUPS);
+	}
+
+	printk("conns %4u lookup_ns %6u\n", count,
+	       (uint32_t)timing_cycles_to_ns_avg(
+		       timing_cycles_get(&start, &end), LOOKUPS));
+
+out:
+	for (int i = 0; i < count; i++) {
+		net_conn_unregister(handles[i]);
+	}
+}
+
+void main(void)
+{
+	struct net_pkt *pkt;
+
+	net_ipaddr_copy(&ipv6_hdr.src, &remote.sin6_addr);
+	net_ipaddr_copy(&ipv6_hdr.dst, &local.sin6_addr);
+	udp_hdr.dst_port = htons(LOCAL_PORT);
+
+	pkt = net_pkt_alloc(K_FOREVER);
+	net_pkt_set_family(pkt, AF_INET6);
+
+	timing_init();
+	timing_start();
+
+	printk("connection hash %s\n",
+	       IS_ENABLED(CONFIG_NET_CONN_HASH) ? "on" : "off");
+
+	for (int i = 0; i < ARRAY_SIZE(conn_counts); i++) {
+		run(pkt, MIN(conn_counts[i], CONFIG_NET_MAX_CONN));
+	}
+
+	net_pkt_unref(pkt);
+
+	timing_stop();
+
+	printk("fin\n");
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <timing/timing.h>
+#include <net/socket.h>
+#include <app_memory/app_memdomain.h>
+
+/* Datagram rate benchmark for zsock_sendmmsg() and zsock_recvmmsg().
+ * DATAGRAMS datagrams of DATAGRAM_LEN bytes are sent to ::1 over the
+ * loopback interface and received on a second socket by the same
+ * thread.  A batch size of 1 uses one zsock_sendto() and one
+ * zsock_recv() call per datagram, larger ones send and then receive
+ * that many datagrams with a single zsock_sendmmsg() and
+ * zsock_recvmmsg() call.  With CONFIG_USERSPACE the measurement is
+ * repeated from a user mode thread, where every call is a system call.
+ */
+#define DATAGRAMS 19200
+#define DATAGRAM_LEN 64
+#define MAX_BATCH 32
+#define PORT 4242
+
+static const uint8_t batch_sizes[] = { 1, 8, 32 };
+
+K_APPMEM_PARTITION_DEFINE(bench_partition);
+
+K_APP_BMEM(bench_partition) static uint8_t data[MAX_BATCH][DATAGRAM_LEN];
+K_APP_BMEM(bench_partition) static struct iovec iov[MAX_BATCH];
+K_APP_BMEM(bench_partition) static struct mmsghdr tx_msgs[MAX_BATCH];
+K_APP_BMEM(bench_partition) static struct mmsghdr rx_msgs[MAX_BATCH];
+K_APP_DMEM(bench_partition) static struct sockaddr_in6 addr = {
+	.sin6_family = AF_INET6,
+	.sin6_port = htons(PORT),
+	.sin6_addr = IN6ADDR_LOOPBACK_INIT,
+};
+
+static int run_single(int tx, int rx)
+{
+	ssize_t ret;
+
+	for (int i = 0; i < DATAGRAMS; i++) {
+		ret = zsock_sendto(tx, data[0], DATAGRAM_LEN, 0,
+				   (const struct sockaddr *)&addr,
+				   sizeof(addr));
+		if (ret != DATAGRAM_LEN) {
+			return ret < 0 ? -errno : -EMSGSIZE;
+		}
+
+		ret = zsock_recv(rx, data[0], DATAGRAM_LEN, 0);
+		if (ret != DATAGRAM_LEN) {
+			return ret < 0 ? -errno : -EMSGSIZE;
+		}
+	}
+
+	return 0;
+}
+
+static int run_batch(int tx, int rx, uint8_t batch)
+{
+	int ret;
+
+	for (int i = 0; i < batch; i++) {
+		iov[i].iov_base = data[i];
+		iov[i].iov_len = DATAGRAM_LEN;
+		tx_msgs[i].msg_hdr.msg_iov = &iov[i];
+		tx_msgs[i].msg_hdr.msg_iovlen = 1;
+		tx_msgs[i].msg_hdr.msg_name = &addr;
+		tx_msgs[i].msg_hdr.msg_namelen = sizeof(addr);
+		rx_msgs[i].msg_hdr.msg_iov = &iov[i];
+		rx_msgs[i].msg_hdr.msg_iovlen = 1;
+	}
+
+	for (int i = 0; i < DATAGRAMS; i += batch) {
+		ret = zsock_sendmmsg(tx, tx_msgs, batch, 0);
+		if (ret != batch) {
+			return ret < 0 ? -errno : -EAGAIN;
+		}
+
+		ret = zsock_recvmmsg(rx, rx_msgs, batch, 0, NULL);
+		if (ret != batch) {
+			return ret < 0 ? -errno : -EAGAIN;
+		}
+	}
+
+	return 0;
+}
+
+static void run(const char *mode)
+{
+	timing_t start, end;
+	uint64_t ns;
+	int tx, rx, ret;
+
+	tx = zsock_socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+	rx = zsock_socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+	if (tx < 0 || rx < 0) {
+		printk("cannot create sockets: %d\n", errno);
+		return;
+	}
+
+	if (zsock_bind(rx, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("cannot bind: %d\n", errno);
+		goto out;
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(batch_sizes); i++) {
+		start = timing_counter_get();
+
+		if (batch_sizes[i] == 1) {
+			ret = run_single(tx, rx);
+		} else {
+			ret = run_batch(tx, rx, batch_sizes[i]);
+		}
+
+		end = timing_counter_get();
+		ns = MAX(timing_cycles_to_ns(timing_cycles_get(&start, &end)),
+			 1U);
+
+		if (ret < 0) {
+			printk("batch %u failed: %d\n", batch_sizes[i], ret);
+			break;
+		}
+
+		printk("batch %2u %s_dps %7u\n", batch_sizes[i], mode,
+		       (uint32_t)((uint64_t)DATAGRAMS * NSEC_PER_SEC / ns));
+	}
+
+out:
+	zsock_close(tx);
+	zsock_close(rx);
+}
+
+#if defined(CONFIG_USERSPACE)
+static void user_main(void *p1, void *p2, void *p3)
+{
+	run("user");
+
+	printk("fin\n");
+}
+#endif
+
+void main(void)
+{
+	/* Left running for the user mode thread, which reads the
+	 * counter without a system call.
+	 */
+	timing_init();
+	timing_start();
+
+	run("kernel");
+
+#if defined(CONFIG_USERSPACE)
+	k_mem_domain_add_partition(&k_mem_domain_default, &bench_partition);
+	k_thread_system_pool_assign(k_current_get());
+	k_thread_user_mode_enter(user_main, NULL, NULL, NULL);
+#else
+	timing_stop();
+
+	printk("fin\n");
+#endif
+}
@@ -0,0 +1,165 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <timing/timing.h>
+#include <net/socket.h>
+#include <net/buf.h>
+
+/* Socket throughput benchmark comparing the copying and the zero-copy
+ * UDP socket calls.  For each datagram size, DATAGRAMS datagrams are
+ * sent to ::1 over the loopback interface and received on a second
+ * socket by the same thread, one at a time.  The copy path uses
+ * zsock_sendto() and zsock_recv() with flat buffers; the zero-copy path
+ * fills an application net_buf in place, hands it over with
+ * zsock_sendto_buf() and reads the data in place from the chain
+ * returned by zsock_recv_buf().
+ */
+#define DATAGRAMS 20000
+#define PORT 4242
+
+/* The largest fits in the IPv6 minimum MTU used by loopback */
+static const uint16_t sizes[] = { 64, 512, 1200 };
+
+NET_BUF_POOL_DEFINE(app_pool, 2, 1200, 0, NULL);
+
+static uint8_t tx_data[1200];
+static uint8_t rx_data[1200];
+static volatile uint32_t checksum;
+
+/* Stands in for producing and consuming the data */
+static void produce(uint8_t *data, size_t len, uint32_t seq)
+{
+	data[0] = seq;
+	data[len - 1] = seq;
+}
+
+static void consume(const uint8_t *data, size_t len)
+{
+	checksum += data[0] + data[len - 1];
+}
+
+static int run_copy(int tx, int rx, const struct sockaddr_in6 *dst,
+		    uint16_t size)
+{
+	ssize_t ret;
+
+	for (int i = 0; i < DATAGRAMS; i++) {
+		produce(tx_data, size, i);
+
+		ret = zsock_sendto(tx, tx_data, size, 0,
+				   (const struct sockaddr *)dst, sizeof(*dst));
+		if (ret != size) {
+			return ret < 0 ? -errno : -EMSGSIZE;
+		}
+
+		ret = zsock_recv(rx, rx_data, sizeof(rx_data), 0);
+		if (ret != size) {
+			return ret < 0 ? -errno : -EMSGSIZE;
+		}
+
+		consume(rx_data, size);
+	}
+
+	return 0;
+}
+
+static int run_zerocopy(int tx, int rx, const struct sockaddr_in6 *dst,
+			uint16_t size)
+{
+	struct net_buf *buf;
+	ssize_t ret;
+
+	for (int i = 0; i < DATAGRAMS; i++) {
+		buf = net_buf_alloc(&app_pool, K_FOREVER);
+		produce(net_buf_add(buf, size), size, i);
+
+		ret = zsock_sendto_buf(tx, buf, 0, (const struct sockaddr *)dst,
+				       sizeof(*dst));
+		if (ret != size) {
+			net_buf_unref(buf);
+			return ret < 0 ? -errno : -EMSGSIZE;
+		}
+
+		ret = zsock_recv_buf(rx, &buf, 0);
+		if (ret != size) {
+			return ret < 0 ? -errno : -EMSGSIZE;
+		}
+
+		for (struct net_buf *frag = buf; frag; frag = frag->frags) {
+			if (frag->len) {
+				consume(frag->data, frag->len);
+			}
+		}
+
+		net_buf_unref(buf);
+	}
+
+	return 0;
+}
+
+static uint32_t mbps(uint16_t size, uint64_t elapsed)
+{
+	return (uint64_t)size * DATAGRAMS * 8U * 1000U / MAX(elapsed, 1U);
+}
+
+void main(void)
+{
+	struct sockaddr_in6 addr = {
+		.sin6_family = AF_INET6,
+		.sin6_port = htons(PORT),
+		.sin6_addr = IN6ADDR_LOOPBACK_INIT,
+	};
+	timing_t start, end;
+	uint64_t copy, zerocopy;
+	int tx, rx, ret;
+
+	tx = zsock_socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+	rx = zsock_socket(AF_INET6, SOCK_DGRAM, IPPROTO_UDP);
+	if (tx < 0 || rx < 0) {
+		printk("cannot create sockets: %d\n", errno);
+		return;
+	}
+
+	if (zsock_bind(rx, (struct sockaddr *)&addr, sizeof(addr)) < 0) {
+		printk("cannot bind: %d\n", errno);
+		return;
+	}
+
+	timing_init();
+	timing_start();
+
+	for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		start = timing_counter_get();
+		ret = run_copy(tx, rx, &addr, sizes[i]);
+		end = timing_counter_get();
+		copy = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+		if (ret < 0) {
+			printk("copy path failed: %d\n", ret);
+			return;
+		}
+
+		start = timing_counter_get();
+		ret = run_zerocopy(tx, rx, &addr, sizes[i]);
+		end = timing_counter_get();
+		zerocopy = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+		if (ret < 0) {
+			printk("zero-copy path failed: %d\n", ret);
+			return;
+		}
+
+		printk("size %4u copy_mbps %5u zerocopy_mbps %5u\n", sizes[i],
+		       mbps(sizes[i], copy), mbps(sizes[i], zerocopy));
+	}
+
+	zsock_close(tx);
+	zsock_close(rx);
+
+	timing_stop();
+
+	printk("fin\n");
+}
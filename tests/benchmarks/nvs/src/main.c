@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <string.h>
+#include <drivers/flash.h>
+#include <storage/flash_map.h>
+#include <stats/stats.h>
+#include <fs/nvs.h>
+
+#define STORAGE_OFFSET FLASH_AREA_OFFSET(storage)
+#define STORAGE_SIZE FLASH_AREA_SIZE(storage)
+
+/* Ids start where the settings subsystem starts allocating them */
+#define FIRST_ID 0x8000
+
+static const uint16_t record_counts[] = { 25, 50, 100, 200, 400 };
+
+static struct nvs_fs fs;
+static uint32_t *read_calls;
+
+static int read_calls_find(struct stats_hdr *hdr, void *arg,
+			   const char *name, uint16_t off)
+{
+	if (!strcmp(name, "flash_read_calls")) {
+		read_calls = (uint32_t *)((uint8_t *)hdr + off);
+	}
+
+	return 0;
+}
+
+static uint32_t reads_get(void)
+{
+	return read_calls ? *read_calls : 0U;
+}
+
+static int fill(uint16_t records)
+{
+	int rc;
+
+	if (fs.ready) {
+		rc = nvs_clear(&fs);
+		if (rc) {
+			return rc;
+		}
+	}
+
+	rc = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	if (rc) {
+		return rc;
+	}
+
+	for (uint32_t i = 0; i < records; i++) {
+		uint32_t value = i;
+		ssize_t len = nvs_write(&fs, FIRST_ID + i, &value,
+					sizeof(value));
+
+		if (len != sizeof(value)) {
+			return len < 0 ? len : -EIO;
+		}
+	}
+
+	return 0;
+}
+
+static void run(uint16_t records)
+{
+	uint32_t start, init_cyc, read_cyc, reads;
+	uint32_t init_reads, lookup_reads;
+	int rc;
+
+	rc = fill(records);
+	if (rc) {
+		printk("fill of %u records failed: %d\n", records, rc);
+		return;
+	}
+
+	reads = reads_get();
+	start = k_cycle_get_32();
+	rc = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	init_cyc = k_cycle_get_32() - start;
+	init_reads = reads_get() - reads;
+	if (rc) {
+		printk("nvs_init failed: %d\n", rc);
+		return;
+	}
+
+	reads = reads_get();
+	start = k_cycle_get_32();
+	for (uint32_t i = 0; i < records; i++) {
+		uint32_t value;
+		ssize_t len = nvs_read(&fs, FIRST_ID + i, &value,
+				       sizeof(value));
+
+		if (len != sizeof(value) || value != i) {
+			printk("read of id %u failed: %d\n", FIRST_ID + i,
+			       (int)len);
+			return;
+		}
+	}
+	read_cyc = k_cycle_get_32() - start;
+	lookup_reads = reads_get() - reads;
+
+	printk("records %4u init_us %7u init_reads %7u read_ns %7u read_reads %5u\n",
+	       records, (uint32_t)k_cyc_to_us_floor64(init_cyc), init_reads,
+	       (uint32_t)(k_cyc_to_ns_floor64(read_cyc) / records),
+	       lookup_reads / records);
+}
+
+void main(void)
+{
+	struct flash_pages_info info;
+	const struct device *dev;
+	struct stats_hdr *hdr;
+	int rc;
+
+	dev = device_get_binding(DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	rc = flash_get_page_info_by_offs(dev, STORAGE_OFFSET, &info);
+	if (rc) {
+		printk("Unable to get page info: %d\n", rc);
+		return;
+	}
+
+	fs.offset = STORAGE_OFFSET;
+	fs.sector_size = info.size;
+	fs.sector_count = STORAGE_SIZE / info.size;
+
+	hdr = stats_group_find("flash_sim_stats");
+	if (hdr) {
+		stats_walk(hdr, read_calls_find, NULL);
+	}
+
+	printk("%u sectors of %u bytes, lookup cache %s\n", fs.sector_count,
+	       fs.sector_size,
+	       IS_ENABLED(CONFIG_NVS_LOOKUP_CACHE) ? "on" : "off");
+
+	for (int i = 0; i < ARRAY_SIZE(record_counts); i++) {
+		run(record_counts[i]);
+	}
+
+	printk("fin\n");
+}
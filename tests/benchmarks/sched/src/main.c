@@ -6,6 +6,7 @@
 
 #include <zephyr.h>
 #include <sys/printk.h>
+#include <timing/timing.h>
 #include <wait_q.h>
 #include <ksched.h>
 
@@ -32,6 +33,14 @@
 #define N_RUNS 1000
 #define N_SETTLE 10
 
+/* Second phase: switching scalability.  For 1 to CONFIG_MP_NUM_CPUS
+ * CPUs, a pair of threads is pinned to each CPU and hands a semaphore
+ * back and forth SCALE_HANDOFFS times, so that every handoff is a
+ * context switch local to that CPU.  The pairs share nothing but the
+ * scheduler, and the total switch rate shows how it scales.
+ */
+#define SCALE_HANDOFFS 10000
+#define SCALE_STACK_SIZE 1024
 
 static K_THREAD_STACK_DEFINE(partner_stack, 1024);
 static struct k_thread partner_thread;
@@ -49,7 +58,7 @@ enum {
 
 uint32_t stamps[NUM_STAMP_STATES];
 
-static inline int _stamp(int state)
+static inline uint32_t now(void)
 {
 	uint32_t t;
 
@@ -63,6 +72,13 @@ static inline int _stamp(int state)
 	t = k_cycle_get_32();
 #endif
 
+	return t;
+}
+
+static inline int _stamp(int state)
+{
+	uint32_t t = now();
+
 	stamps[state] = t;
 	return t;
 }
@@ -86,6 +102,69 @@ static void partner_fn(void *arg1, void *arg2, void *arg3)
 	}
 }
 
+struct pingpong {
+	struct k_sem sem[2];
+};
+
+static struct pingpong pairs[CONFIG_MP_NUM_CPUS];
+static K_THREAD_STACK_ARRAY_DEFINE(scale_stacks, 2 * CONFIG_MP_NUM_CPUS,
+				   SCALE_STACK_SIZE);
+static struct k_thread scale_threads[2 * CONFIG_MP_NUM_CPUS];
+
+static void pingpong_fn(void *arg1, void *arg2, void *arg3)
+{
+	struct pingpong *pp = arg1;
+	int side = POINTER_TO_INT(arg2);
+
+	ARG_UNUSED(arg3);
+
+	for (int i = 0; i < SCALE_HANDOFFS; i++) {
+		k_sem_take(&pp->sem[side], K_FOREVER);
+		k_sem_give(&pp->sem[!side]);
+	}
+}
+
+static void run_cpus(int ncpus, int prio)
+{
+	int nthreads = 2 * ncpus;
+	timing_t start, end;
+	uint64_t ns;
+
+	for (int i = 0; i < ncpus; i++) {
+		k_sem_init(&pairs[i].sem[0], 1, 1);
+		k_sem_init(&pairs[i].sem[1], 0, 1);
+	}
+
+	for (int t = 0; t < nthreads; t++) {
+		k_thread_create(&scale_threads[t], scale_stacks[t],
+				SCALE_STACK_SIZE, pingpong_fn,
+				&pairs[t / 2], INT_TO_POINTER(t % 2), NULL,
+				prio, 0, K_FOREVER);
+#ifdef CONFIG_SCHED_CPU_MASK
+		k_thread_cpu_mask_clear(&scale_threads[t]);
+		k_thread_cpu_mask_enable(&scale_threads[t], t / 2);
+#endif
+	}
+
+	start = timing_counter_get();
+
+	for (int t = 0; t < nthreads; t++) {
+		k_thread_start(&scale_threads[t]);
+	}
+
+	for (int t = 0; t < nthreads; t++) {
+		k_thread_join(&scale_threads[t], K_FOREVER);
+	}
+
+	end = timing_counter_get();
+	ns = timing_cycles_to_ns(timing_cycles_get(&start, &end));
+
+	/* With perfect scaling the rate grows linearly with the CPUs */
+	printk("cpus %d switches_per_ms %u\n", ncpus,
+	       (uint32_t)((uint64_t)nthreads * SCALE_HANDOFFS * 1000000U /
+			  MAX(ns, 1)));
+}
+
 void main(void)
 {
 	z_waitq_init(&waitq);
@@ -148,5 +227,17 @@ void main(void)
 		       stamps[4] - stamps[3],
 		       whole, avg);
 	}
+
+	k_thread_abort(th);
+
+	timing_init();
+	timing_start();
+
+	for (int ncpus = 1; ncpus <= CONFIG_MP_NUM_CPUS; ncpus++) {
+		run_cpus(ncpus, main_prio + 1);
+	}
+
+	timing_stop();
+
 	printk("fin\n");
 }
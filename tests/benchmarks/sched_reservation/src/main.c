@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+
+/* Isolation benchmark for CPU budget reservations.  A control loop
+ * thread needs CONTROL_WORK_MS of CPU time every PERIOD_MS, and a
+ * misbehaving thread at the same priority spins forever, pushing its
+ * deadline ahead of the control loop's all the time.  The same run is
+ * done without reservations, where the spinning thread starves the
+ * control loop, and with a reservation for each thread, where it is
+ * throttled once it has used up its budget.
+ */
+#define PERIOD_MS 100
+#define CONTROL_WORK_MS 30
+#define RESV_MS 40
+#define RUN_PERIODS 20
+#define STACKSIZE 1024
+#define PRIORITY 5
+
+static K_THREAD_STACK_DEFINE(control_stack, STACKSIZE);
+static K_THREAD_STACK_DEFINE(hog_stack, STACKSIZE);
+static struct k_thread control_thread;
+static struct k_thread hog_thread;
+
+static uint32_t periods;
+static uint32_t misses;
+
+/* Spin until the calling thread has run for ms of CPU time */
+static void work(uint32_t ms)
+{
+	k_thread_runtime_stats_t stats;
+	uint64_t end;
+
+	k_thread_runtime_stats_get(k_current_get(), &stats);
+	end = stats.execution_cycles + k_ms_to_cyc_ceil64(ms);
+
+	do {
+		k_thread_runtime_stats_get(k_current_get(), &stats);
+	} while (stats.execution_cycles < end);
+}
+
+static void control(void *p1, void *p2, void *p3)
+{
+	int64_t next = k_uptime_get();
+
+	for (; periods < RUN_PERIODS; periods++) {
+		next += PERIOD_MS;
+		k_thread_deadline_set(k_current_get(),
+				      k_ms_to_cyc_ceil32(PERIOD_MS));
+
+		work(CONTROL_WORK_MS);
+
+		if (k_uptime_get() > next) {
+			misses++;
+		}
+
+		k_sleep(K_TIMEOUT_ABS_MS(next));
+	}
+}
+
+static void hog(void *p1, void *p2, void *p3)
+{
+	while (true) {
+		/* Always the earliest deadline, unless reserved */
+		k_thread_deadline_set(k_current_get(), 1);
+	}
+}
+
+static void run(const char *name, bool reserve)
+{
+	k_thread_runtime_stats_t stats;
+	uint64_t cycles;
+
+	periods = 0U;
+	misses = 0U;
+
+	k_thread_create(&control_thread, control_stack, STACKSIZE, control,
+			NULL, NULL, NULL, PRIORITY, 0, K_FOREVER);
+	k_thread_create(&hog_thread, hog_stack, STACKSIZE, hog,
+			NULL, NULL, NULL, PRIORITY, 0, K_FOREVER);
+
+	if (reserve) {
+		k_thread_reservation_set(&control_thread,
+					 RESV_MS * USEC_PER_MSEC,
+					 PERIOD_MS * USEC_PER_MSEC);
+		k_thread_reservation_set(&hog_thread,
+					 RESV_MS * USEC_PER_MSEC,
+					 PERIOD_MS * USEC_PER_MSEC);
+	}
+
+	k_thread_start(&hog_thread);
+	k_thread_start(&control_thread);
+
+	k_msleep(RUN_PERIODS * PERIOD_MS);
+
+	k_thread_runtime_stats_get(&hog_thread, &stats);
+	k_thread_abort(&control_thread);
+	k_thread_abort(&hog_thread);
+
+	/* Periods the control loop did not even get to are missed too */
+	cycles = k_ms_to_cyc_ceil64(RUN_PERIODS * PERIOD_MS);
+	printk("%-16s control missed %2u of %u periods, hog cpu %3u%%\n",
+	       name, misses + RUN_PERIODS - periods, RUN_PERIODS,
+	       (uint32_t)(stats.execution_cycles * 100U / cycles));
+}
+
+void main(void)
+{
+	run("reservations off", false);
+	run("reservations on", true);
+
+	printk("fin\n");
+}
@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/mutex.h>
+#include <timing/timing.h>
+#include <app_memory/app_memdomain.h>
+
+/* Lock/unlock cycle benchmark for sys_mutex from user mode.  In the
+ * uncontended case one user thread locks and unlocks the mutex
+ * UNCONTENDED_CYCLES times.  In the contended case two user threads of
+ * the same priority each lock the mutex, yield while holding it and
+ * unlock it, CONTENDED_CYCLES times, so every lock after the first one
+ * finds the other thread owning the mutex and has to wait, and every
+ * unlock hands the mutex over.  The reported time is per lock/unlock
+ * cycle, including the yield in the contended case.
+ */
+#define UNCONTENDED_CYCLES 1000000
+#define CONTENDED_CYCLES 20000
+#define STACKSIZE 1024
+#define PRIORITY 5
+
+K_APPMEM_PARTITION_DEFINE(bench_partition);
+
+K_APP_BMEM(bench_partition) static SYS_MUTEX_DEFINE(mutex);
+K_APP_BMEM(bench_partition) static int errors;
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, 2, STACKSIZE);
+static struct k_thread threads[2];
+
+static void lock_unlock(void *p1, void *p2, void *p3)
+{
+	uint32_t cycles = POINTER_TO_UINT(p1);
+	bool yield = POINTER_TO_UINT(p2);
+
+	ARG_UNUSED(p3);
+
+	for (uint32_t i = 0; i < cycles; i++) {
+		if (sys_mutex_lock(&mutex, K_FOREVER) != 0) {
+			errors++;
+			return;
+		}
+
+		if (yield) {
+			k_yield();
+		}
+
+		if (sys_mutex_unlock(&mutex) != 0) {
+			errors++;
+			return;
+		}
+	}
+}
+
+static void run(const char *name, int nthreads, uint32_t cycles)
+{
+	timing_t start, end;
+
+	errors = 0;
+
+	for (int i = 0; i < nthreads; i++) {
+		k_thread_create(&threads[i], stacks[i], STACKSIZE, lock_unlock,
+				UINT_TO_POINTER(cycles),
+				UINT_TO_POINTER(nthreads > 1), NULL,
+				PRIORITY, K_USER, K_FOREVER);
+		k_object_access_grant(&mutex, &threads[i]);
+	}
+
+	start = timing_counter_get();
+
+	for (int i = 0; i < nthreads; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (int i = 0; i < nthreads; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	end = timing_counter_get();
+
+	if (errors != 0) {
+		printk("%s lock/unlock failed\n", name);
+		return;
+	}
+
+	printk("%s_ns %6u\n", name,
+	       (uint32_t)timing_cycles_to_ns_avg(timing_cycles_get(&start, &end),
+						 cycles * nthreads));
+}
+
+void main(void)
+{
+	k_mem_domain_add_partition(&k_mem_domain_default, &bench_partition);
+
+	timing_init();
+	timing_start();
+
+	printk("fast path %s priority inheritance %s\n",
+	       IS_ENABLED(CONFIG_SYS_MUTEX_FAST) ? "on" : "off",
+	       IS_ENABLED(CONFIG_SYS_MUTEX_FAST) &&
+	       !IS_ENABLED(CONFIG_SYS_MUTEX_PRIORITY_INHERITANCE) ?
+	       "off" : "on");
+
+	run("uncontended", 1, UNCONTENDED_CYCLES);
+	run("contended", 2, CONTENDED_CYCLES);
+
+	timing_stop();
+
+	printk("fin\n");
+}
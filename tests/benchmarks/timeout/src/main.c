@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <timeout_q.h>
+
+/* This is a timeout queue microbenchmark.  It works directly on the
+ * internal z_add_timeout()/z_abort_timeout() API, independent of the
+ * overhead of k_timer or thread timeouts, so the numbers reflect the
+ * cost of the queue backend itself.
+ *
+ * All timeouts are armed and cancelled with interrupts locked so the
+ * tick announcement can't run in the middle of a measurement.
+ */
+
+#define MAX_TIMEOUTS 4096
+#define MAX_SPREAD_MS 5000
+
+static const int sizes[] = { 16, 64, 256, 1024, MAX_TIMEOUTS };
+
+static struct _timeout timeouts[MAX_TIMEOUTS];
+static uint32_t durations[MAX_TIMEOUTS];
+static uint16_t cancel_order[MAX_TIMEOUTS];
+static atomic_t expired;
+
+static uint32_t rand_state = 12345;
+
+/* Deterministic LCG so every backend sees the same workload */
+static uint32_t next_rand(void)
+{
+	rand_state = rand_state * 1103515245U + 12345U;
+	return rand_state >> 8;
+}
+
+static void timeout_fn(struct _timeout *t)
+{
+	ARG_UNUSED(t);
+	atomic_inc(&expired);
+}
+
+static void setup(int n)
+{
+	for (int i = 0; i < n; i++) {
+		z_init_timeout(&timeouts[i]);
+		durations[i] = 1 + next_rand() % MAX_SPREAD_MS;
+		cancel_order[i] = i;
+	}
+
+	/* Fisher-Yates shuffle of the cancellation order */
+	for (int i = n - 1; i > 0; i--) {
+		int j = next_rand() % (i + 1);
+		uint16_t tmp = cancel_order[i];
+
+		cancel_order[i] = cancel_order[j];
+		cancel_order[j] = tmp;
+	}
+}
+
+static uint32_t arm_all(int n, bool short_timeouts)
+{
+	unsigned int key = irq_lock();
+	uint32_t start = k_cycle_get_32();
+
+	for (int i = 0; i < n; i++) {
+		uint32_t ms = short_timeouts ? 1 + (durations[i] % 10)
+			: durations[i];
+
+		z_add_timeout(&timeouts[i], timeout_fn, K_MSEC(ms));
+	}
+
+	uint32_t cycles = k_cycle_get_32() - start;
+
+	irq_unlock(key);
+	return cycles;
+}
+
+static uint32_t cancel_all(int n)
+{
+	unsigned int key = irq_lock();
+	uint32_t start = k_cycle_get_32();
+
+	for (int i = 0; i < n; i++) {
+		z_abort_timeout(&timeouts[cancel_order[i]]);
+	}
+
+	uint32_t cycles = k_cycle_get_32() - start;
+
+	irq_unlock(key);
+	return cycles;
+}
+
+static uint32_t expire_all(int n)
+{
+	uint32_t start;
+
+	atomic_set(&expired, 0);
+	arm_all(n, true);
+	start = k_cycle_get_32();
+
+	while (atomic_get(&expired) < n) {
+		k_msleep(1);
+	}
+
+	/* This includes the time spent sleeping, which is the same
+	 * for every backend, so only differences are meaningful.
+	 */
+	return k_cycle_get_32() - start;
+}
+
+void main(void)
+{
+	for (int i = 0; i < ARRAY_SIZE(sizes); i++) {
+		int n = sizes[i];
+		uint32_t arm, cancel, expire;
+
+		setup(n);
+		arm = arm_all(n, false);
+		cancel = cancel_all(n);
+		expire = expire_all(n);
+
+		printk("n %5d arm %6u cancel %6u expire %8u\n", n,
+		       arm / n, cancel / n, expire / n);
+	}
+	printk("fin\n");
+}
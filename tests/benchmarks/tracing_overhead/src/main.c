@@ -0,0 +1,97 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <string.h>
+#include <sys/printk.h>
+#include <tracing_core.h>
+#include <tracing_buffer.h>
+
+/* Each k_sem_give() emits a semaphore_give_enter and a
+ * semaphore_give_exit CTF event of 9 bytes each.  The calls of all
+ * workers must fit in the tracing buffer, so that no event is dropped.
+ */
+#define EVENTS_PER_CALL 2
+#define CALLS_PER_WORKER 400
+#define STACK_SIZE 1024
+
+static K_THREAD_STACK_ARRAY_DEFINE(stacks, CONFIG_MP_NUM_CPUS, STACK_SIZE);
+static struct k_thread threads[CONFIG_MP_NUM_CPUS];
+static struct k_sem sems[CONFIG_MP_NUM_CPUS];
+
+static atomic_t total_cycles;
+
+static void worker(void *arg1, void *arg2, void *arg3)
+{
+	struct k_sem *sem = arg1;
+	uint32_t start;
+
+	ARG_UNUSED(arg2);
+	ARG_UNUSED(arg3);
+
+	start = k_cycle_get_32();
+
+	for (int i = 0; i < CALLS_PER_WORKER; i++) {
+		k_sem_give(sem);
+	}
+
+	atomic_add(&total_cycles, k_cycle_get_32() - start);
+}
+
+static void tracing_set(bool enable)
+{
+	char *cmd = enable ? "enable" : "disable";
+
+	tracing_cmd_handle((uint8_t *)cmd, strlen(cmd));
+}
+
+/* Average cycles of one k_sem_give() with ncpus CPUs calling it */
+static uint32_t run(int ncpus, bool trace)
+{
+	int prio = k_thread_priority_get(k_current_get()) + 1;
+
+	/* Start from empty tracing buffers */
+	while (!tracing_buffer_is_empty()) {
+		k_msleep(10);
+	}
+	atomic_set(&total_cycles, 0);
+
+	for (int i = 0; i < ncpus; i++) {
+		k_sem_init(&sems[i], 0, K_SEM_MAX_LIMIT);
+		k_thread_create(&threads[i], stacks[i], STACK_SIZE, worker,
+				&sems[i], NULL, NULL, prio, 0, K_FOREVER);
+		k_thread_cpu_mask_clear(&threads[i]);
+		k_thread_cpu_mask_enable(&threads[i], i);
+	}
+
+	tracing_set(trace);
+
+	for (int i = 0; i < ncpus; i++) {
+		k_thread_start(&threads[i]);
+	}
+
+	for (int i = 0; i < ncpus; i++) {
+		k_thread_join(&threads[i], K_FOREVER);
+	}
+
+	tracing_set(false);
+
+	return (uint32_t)atomic_get(&total_cycles) / (CALLS_PER_WORKER * ncpus);
+}
+
+void main(void)
+{
+	for (int ncpus = 1; ncpus <= CONFIG_MP_NUM_CPUS; ncpus++) {
+		uint32_t untraced = run(ncpus, false);
+		uint32_t traced = run(ncpus, true);
+
+		printk("cpus %d cycles_per_call %u cycles_per_event %u\n",
+		       ncpus, traced,
+		       (traced - MIN(untraced, traced)) / EVENTS_PER_CALL);
+	}
+
+	printk("fin\n");
+}
@@ -0,0 +1,133 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <sys/printk.h>
+#include <sys/work_pool.h>
+#include <timing/timing.h>
+
+/* Parallel speedup benchmark for k_work_pool_parallel_for().  A frame
+ * of WIDTH x HEIGHT pixels is filtered ROUNDS times with a 3x3 box
+ * filter, each round filtering the output of the previous one, first by
+ * the main thread alone and then with the rows split across a pool of
+ * one worker per CPU, for several grain sizes (rows per call).  The
+ * speedup is the serial time over the pool time.
+ */
+#define WIDTH 256
+#define HEIGHT 128
+#define ROUNDS 20
+#define STACKSIZE 2048
+
+static const uint8_t grains[] = { 1, 4, 16 };
+
+K_WORK_POOL_DEFINE(pool, CONFIG_MP_NUM_CPUS, STACKSIZE, K_PRIO_PREEMPT(1));
+
+static uint8_t frames[2][HEIGHT][WIDTH];
+
+static void filter_rows(void *arg, size_t begin, size_t end)
+{
+	int round = POINTER_TO_INT(arg);
+	uint8_t (*in)[WIDTH] = frames[round & 1];
+	uint8_t (*out)[WIDTH] = frames[(round + 1) & 1];
+
+	for (size_t y = MAX(begin, 1); y < MIN(end, HEIGHT - 1); y++) {
+		for (size_t x = 1; x < WIDTH - 1; x++) {
+			uint32_t sum = 0U;
+
+			for (int dy = -1; dy <= 1; dy++) {
+				for (int dx = -1; dx <= 1; dx++) {
+					sum += in[y + dy][x + dx];
+				}
+			}
+
+			out[y][x] = sum / 9U;
+		}
+	}
+}
+
+static uint64_t run_serial(void)
+{
+	timing_t start = timing_counter_get(), end;
+
+	for (int i = 0; i < ROUNDS; i++) {
+		filter_rows(INT_TO_POINTER(i), 0, HEIGHT);
+	}
+
+	end = timing_counter_get();
+
+	return MAX(timing_cycles_to_ns(timing_cycles_get(&start, &end)), 1U);
+}
+
+static uint64_t run_pool(size_t grain)
+{
+	timing_t start = timing_counter_get(), end;
+
+	for (int i = 0; i < ROUNDS; i++) {
+		k_work_pool_parallel_for(&pool, 0, HEIGHT, grain, filter_rows,
+					 INT_TO_POINTER(i));
+	}
+
+	end = timing_counter_get();
+
+	return MAX(timing_cycles_to_ns(timing_cycles_get(&start, &end)), 1U);
+}
+
+static void init_frame(void)
+{
+	for (int y = 0; y < HEIGHT; y++) {
+		for (int x = 0; x < WIDTH; x++) {
+			frames[0][y][x] = x * 7 + y * 13;
+			frames[1][y][x] = 0;
+		}
+	}
+}
+
+static uint32_t frame_sum(void)
+{
+	uint32_t sum = 0U;
+
+	for (int y = 0; y < HEIGHT; y++) {
+		for (int x = 0; x < WIDTH; x++) {
+			sum = sum * 31U + frames[ROUNDS & 1][y][x];
+		}
+	}
+
+	return sum;
+}
+
+void main(void)
+{
+	uint64_t serial, pooled;
+	uint32_t expected;
+
+	timing_init();
+	timing_start();
+
+	printk("cpus %d workers %d\n", CONFIG_MP_NUM_CPUS, CONFIG_MP_NUM_CPUS);
+
+	init_frame();
+	serial = run_serial();
+	expected = frame_sum();
+
+	printk("serial_us %8u\n", (uint32_t)(serial / NSEC_PER_USEC));
+
+	for (int i = 0; i < ARRAY_SIZE(grains); i++) {
+		init_frame();
+		pooled = run_pool(grains[i]);
+
+		if (frame_sum() != expected) {
+			printk("grain %u: wrong result\n", grains[i]);
+		}
+
+		printk("grain %2u pool_us %8u speedup_x100 %4u\n", grains[i],
+		       (uint32_t)(pooled / NSEC_PER_USEC),
+		       (uint32_t)(serial * 100U / pooled));
+	}
+
+	timing_stop();
+
+	printk("fin\n");
+}
@@ -13,6 +13,7 @@ K_THREAD_STACK_DEFINE(tstack, STACK_SIZE);
 struct k_thread tdata;
 
 K_HEAP_DEFINE(k_heap_test, HEAP_SIZE);
+K_HEAP_DEFINE_FLAGS(k_heap_mag_test, HEAP_SIZE, K_HEAP_MAGAZINES);
 
 #define ALLOC_SIZE_1 1024
 #define ALLOC_SIZE_2 1536
@@ -229,3 +230,67 @@ void test_k_heap_alloc_pending_null(void)
 	k_thread_join(tid, K_FOREVER);
 	k_heap_free(&k_heap_test, p);
 }
+
+/**
+ * @brief Validate k_heap magazine caching
+ *
+ * @details Allocate and free small blocks from a heap created with
+ * K_HEAP_MAGAZINES, check that they are recycled through the
+ * magazine, and that a large allocation which only fits once the
+ * cached blocks are returned to the heap still succeeds.
+ *
+ * @ingroup kernel_heap_tests
+ */
+void test_k_heap_magazines(void)
+{
+#ifdef CONFIG_HEAP_MAGAZINES
+	struct k_heap_magazine_stats stats;
+	void *blocks[16];
+	void *p, *big;
+
+	zassert_equal(k_heap_magazine_stats_get(NULL, &stats), -EINVAL, NULL);
+
+	/* First allocation refills the magazine, the second one is
+	 * then served from it, and a free/alloc pair of the same
+	 * size class returns the same block.
+	 */
+	p = k_heap_alloc(&k_heap_mag_test, 20, K_NO_WAIT);
+	zassert_not_null(p, "k_heap_alloc operation failed");
+	k_heap_free(&k_heap_mag_test, p);
+	zassert_equal(k_heap_alloc(&k_heap_mag_test, 32, K_NO_WAIT), p,
+		      "block not recycled through magazine");
+
+	zassert_ok(k_heap_magazine_stats_get(&k_heap_mag_test, &stats), NULL);
+	zassert_equal(stats.misses, 1, "unexpected misses %u", stats.misses);
+	zassert_equal(stats.hits, 1, "unexpected hits %u", stats.hits);
+	zassert_equal(stats.refills, 1, "unexpected refills %u", stats.refills);
+	zassert_true(stats.cached_blocks > 0, "nothing cached after refill");
+	k_heap_free(&k_heap_mag_test, p);
+
+	/* Overflow the magazine so it flushes back to the heap */
+	for (int i = 0; i < ARRAY_SIZE(blocks); i++) {
+		blocks[i] = k_heap_alloc(&k_heap_mag_test, 16, K_NO_WAIT);
+		zassert_not_null(blocks[i], "k_heap_alloc operation failed");
+	}
+	for (int i = 0; i < ARRAY_SIZE(blocks); i++) {
+		k_heap_free(&k_heap_mag_test, blocks[i]);
+	}
+	zassert_ok(k_heap_magazine_stats_get(&k_heap_mag_test, &stats), NULL);
+	zassert_true(stats.flushes > 0, "full magazine did not flush");
+	zassert_true(stats.cached_blocks <= CONFIG_HEAP_MAGAZINE_DEPTH *
+		     CONFIG_HEAP_MAGAZINE_CLASSES * CONFIG_MP_NUM_CPUS, NULL);
+
+	/* Blocks stranded in magazines must not make a large
+	 * allocation fail
+	 */
+	big = k_heap_alloc(&k_heap_mag_test, ALLOC_SIZE_2, K_NO_WAIT);
+	zassert_not_null(big, "cached blocks not returned to the heap");
+	k_heap_free(&k_heap_mag_test, big);
+
+	k_heap_magazine_flush(&k_heap_mag_test);
+	zassert_ok(k_heap_magazine_stats_get(&k_heap_mag_test, &stats), NULL);
+	zassert_equal(stats.cached_blocks, 0, "flush left blocks cached");
+#else
+	ztest_test_skip();
+#endif
+}
@@ -10,6 +10,8 @@
 #include <kernel_internal.h>
 
 #define SEM_ARRAY_SIZE	16
+#define DYN_OBJ_COUNT	128
+#define STACK_SIZE	(512 + CONFIG_TEST_EXTRA_STACKSIZE)
 
 /* Show that extern declarations don't interfere with detecting kernel
  * objects, this was at one point a problem.
@@ -20,6 +22,10 @@ static struct k_sem semarray[SEM_ARRAY_SIZE];
 static struct k_sem *dyn_sem[SEM_ARRAY_SIZE];
 
 static struct k_mutex *test_dyn_mutex;
+static struct k_sem *dyn_objs[DYN_OBJ_COUNT];
+
+K_THREAD_STACK_DEFINE(child_stack, STACK_SIZE);
+static struct k_thread child_thread;
 
 K_SEM_DEFINE(sem1, 0, 1);
 static struct k_sem sem2;
@@ -183,6 +189,92 @@ void test_no_ref_dyn_kobj_release_mem(void)
 	zassert_true(ret == -EBADF, "Dynamic kernel object not released");
 }
 
+/**
+ * @brief Test lookup of many dynamically allocated kernel objects
+ *
+ * @details Allocate more objects than the initial size of the dynamic
+ * object table so that it has to grow, then check that every object is
+ * still found while half of them are freed.
+ *
+ * @ingroup kernel_memprotect_tests
+ *
+ * @see k_object_alloc(), k_object_free()
+ */
+void test_many_dyn_objects(void)
+{
+	for (int i = 0; i < DYN_OBJ_COUNT; i++) {
+		dyn_objs[i] = k_object_alloc(K_OBJ_SEM);
+		zassert_not_null(dyn_objs[i], "couldn't allocate semaphore");
+	}
+
+	for (int i = 0; i < DYN_OBJ_COUNT; i++) {
+		zassert_false(test_object(dyn_objs[i], -EINVAL), NULL);
+	}
+
+	for (int i = 0; i < DYN_OBJ_COUNT; i += 2) {
+		k_object_free(dyn_objs[i]);
+	}
+
+	for (int i = 0; i < DYN_OBJ_COUNT; i++) {
+		zassert_false(test_object(dyn_objs[i],
+					  (i % 2) == 0 ? -EBADF : -EINVAL), NULL);
+	}
+
+	for (int i = 1; i < DYN_OBJ_COUNT; i += 2) {
+		k_object_free(dyn_objs[i]);
+		zassert_false(test_object(dyn_objs[i], -EBADF), NULL);
+	}
+}
+
+static void child_entry(void *p1, void *p2, void *p3)
+{
+}
+
+/**
+ * @brief Test dynamic objects are released when the last thread having
+ * access to them exits
+ *
+ * @details Grant a thread access to dynamic objects, some of which are
+ * only referenced by that thread, and check that only those are released
+ * when the thread exits.
+ *
+ * @ingroup kernel_memprotect_tests
+ *
+ * @see k_object_alloc(), k_object_access_grant()
+ */
+void test_thread_exit_releases_dyn_objects(void)
+{
+	k_tid_t tid;
+
+	tid = k_thread_create(&child_thread, child_stack, STACK_SIZE,
+			      child_entry, NULL, NULL, NULL,
+			      K_PRIO_PREEMPT(0), 0, K_FOREVER);
+
+	for (int i = 0; i < SEM_ARRAY_SIZE; i++) {
+		dyn_objs[i] = k_object_alloc(K_OBJ_SEM);
+		zassert_not_null(dyn_objs[i], "couldn't allocate semaphore");
+		k_object_access_grant(dyn_objs[i], tid);
+
+		/* The child holds the only reference on even ones */
+		if ((i % 2) == 0) {
+			k_object_access_revoke(dyn_objs[i], k_current_get());
+		}
+	}
+
+	k_thread_start(tid);
+	k_thread_join(tid, K_FOREVER);
+
+	for (int i = 0; i < SEM_ARRAY_SIZE; i++) {
+		if ((i % 2) == 0) {
+			zassert_is_null(z_object_find(dyn_objs[i]),
+					"object not released on thread exit");
+		} else {
+			zassert_false(test_object(dyn_objs[i], -EINVAL), NULL);
+			k_object_free(dyn_objs[i]);
+		}
+	}
+}
+
 void test_main(void)
 {
 	k_thread_system_pool_assign(k_current_get());
@@ -190,7 +282,9 @@ void test_main(void)
 	ztest_test_suite(object_validation,
 			 ztest_unit_test(test_generic_object),
 			 ztest_unit_test(test_kobj_assign_perms_on_alloc_obj),
-			 ztest_unit_test(test_no_ref_dyn_kobj_release_mem)
+			 ztest_unit_test(test_no_ref_dyn_kobj_release_mem),
+			 ztest_unit_test(test_many_dyn_objects),
+			 ztest_unit_test(test_thread_exit_releases_dyn_objects)
 			 );
 	ztest_run_test_suite(object_validation);
 }
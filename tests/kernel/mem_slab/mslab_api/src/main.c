@@ -14,6 +14,7 @@ extern void test_mslab_alloc_align(void);
 extern void test_mslab_alloc_timeout(void);
 extern void test_mslab_used_get(void);
 extern void test_mslab_pending(void);
+extern void test_mslab_alloc_free_n(void);
 
 /*test case main entry*/
 void test_main(void)
@@ -26,6 +27,7 @@ void test_main(void)
 			 ztest_unit_test(test_mslab_alloc_align),
 			 ztest_1cpu_unit_test(test_mslab_alloc_timeout),
 			 ztest_unit_test(test_mslab_used_get),
-			 ztest_unit_test(test_mslab_pending));
+			 ztest_unit_test(test_mslab_pending),
+			 ztest_unit_test(test_mslab_alloc_free_n));
 	ztest_run_test_suite(mslab_api);
 }
@@ -328,3 +328,51 @@ void test_mslab_pending(void)
 	/* Free memory block */
 	k_mem_slab_free(&kmslab, &b);
 }
+
+/**
+ * @brief Verify batch alloc and free of blocks
+ *
+ * @details Allocate all blocks of the memory slab with
+ * @see k_mem_slab_alloc_n(), check that a batch larger than
+ * the number of free blocks fails without allocating anything,
+ * and that blocks allocated one at a time and in a batch can be
+ * freed in a batch with @see k_mem_slab_free_n(). The used and
+ * free block counts must be exact throughout.
+ *
+ * @ingroup kernel_memory_slab_tests
+ */
+void test_mslab_alloc_free_n(void)
+{
+	void *block[BLK_NUM];
+
+	zassert_equal(k_mem_slab_alloc_n(&mslab, block, BLK_NUM + 1),
+		      -ENOMEM, NULL);
+	zassert_equal(k_mem_slab_num_used_get(&mslab), 0, NULL);
+
+	zassert_equal(k_mem_slab_alloc_n(&mslab, block, BLK_NUM), 0, NULL);
+	for (int i = 0; i < BLK_NUM; i++) {
+		zassert_not_null(block[i], NULL);
+		for (int j = 0; j < i; j++) {
+			zassert_not_equal(block[i], block[j], NULL);
+		}
+	}
+	zassert_equal(k_mem_slab_num_used_get(&mslab), BLK_NUM, NULL);
+	zassert_equal(k_mem_slab_num_free_get(&mslab), 0, NULL);
+	zassert_equal(k_mem_slab_alloc_n(&mslab, block, 1), -ENOMEM, NULL);
+
+	k_mem_slab_free_n(&mslab, block, BLK_NUM);
+	zassert_equal(k_mem_slab_num_used_get(&mslab), 0, NULL);
+	zassert_equal(k_mem_slab_num_free_get(&mslab), BLK_NUM, NULL);
+
+	zassert_equal(k_mem_slab_alloc(&mslab, &block[0], K_NO_WAIT), 0,
+		      NULL);
+	zassert_equal(k_mem_slab_alloc_n(&mslab, &block[1], BLK_NUM),
+		      -ENOMEM, NULL);
+	zassert_equal(k_mem_slab_alloc_n(&mslab, &block[1], BLK_NUM - 1), 0,
+		      NULL);
+	zassert_equal(k_mem_slab_num_used_get(&mslab), BLK_NUM, NULL);
+
+	k_mem_slab_free_n(&mslab, block, BLK_NUM);
+	zassert_equal(k_mem_slab_num_used_get(&mslab), 0, NULL);
+	zassert_equal(k_mem_slab_num_free_get(&mslab), BLK_NUM, NULL);
+}
@@ -0,0 +1,232 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <irq_offload.h>
+
+#define QUEUE_LEN 4
+#define STACK_SIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define TIMEOUT K_MSEC(100)
+#define NUM_PRODUCERS 2
+#define ITEMS_PER_PRODUCER 1000
+
+K_MPMCQ_DEFINE(static_q, QUEUE_LEN);
+
+static struct k_mpmcq q;
+static struct k_mpmcq_slot slots[QUEUE_LEN];
+
+static K_THREAD_STACK_ARRAY_DEFINE(tstacks, NUM_PRODUCERS, STACK_SIZE);
+static struct k_thread tdata[NUM_PRODUCERS];
+
+static uint32_t items[QUEUE_LEN + 1];
+
+static void fill_and_drain(struct k_mpmcq *pq)
+{
+	zassert_true(k_mpmcq_is_empty(pq), NULL);
+	zassert_is_null(k_mpmcq_get(pq, K_NO_WAIT), NULL);
+
+	/**TESTPOINT: items come out in order, the queue holds QUEUE_LEN */
+	for (int i = 0; i < QUEUE_LEN; i++) {
+		zassert_equal(k_mpmcq_put(pq, &items[i], K_NO_WAIT), 0, NULL);
+		zassert_equal(k_mpmcq_num_used_get(pq), i + 1, NULL);
+	}
+	zassert_equal(k_mpmcq_put(pq, &items[QUEUE_LEN], K_NO_WAIT), -ENOMSG,
+		      NULL);
+	zassert_equal(k_mpmcq_put(pq, &items[QUEUE_LEN], TIMEOUT), -EAGAIN,
+		      NULL);
+	zassert_false(k_mpmcq_is_empty(pq), NULL);
+
+	for (int i = 0; i < QUEUE_LEN; i++) {
+		zassert_equal(k_mpmcq_get(pq, K_NO_WAIT), &items[i], NULL);
+	}
+	zassert_true(k_mpmcq_is_empty(pq), NULL);
+	zassert_is_null(k_mpmcq_get(pq, TIMEOUT), NULL);
+}
+
+/**
+ * @brief Test put and get on static and runtime defined queues
+ *
+ * @ingroup kernel_mpmcq_tests
+ */
+void test_mpmcq_put_get(void)
+{
+	k_mpmcq_init(&q, slots, QUEUE_LEN);
+
+	fill_and_drain(&static_q);
+	fill_and_drain(&q);
+
+	/**TESTPOINT: positions keep working past the end of the slots */
+	for (int i = 0; i < 3 * QUEUE_LEN; i++) {
+		zassert_equal(k_mpmcq_put(&q, &items[0], K_NO_WAIT), 0, NULL);
+		zassert_equal(k_mpmcq_get(&q, K_NO_WAIT), &items[0], NULL);
+	}
+	fill_and_drain(&q);
+}
+
+static void isr_put(const void *p)
+{
+	zassert_equal(k_mpmcq_put((struct k_mpmcq *)p, &items[0], K_NO_WAIT),
+		      0, NULL);
+}
+
+static void isr_get(const void *p)
+{
+	zassert_equal(k_mpmcq_get((struct k_mpmcq *)p, K_NO_WAIT), &items[0],
+		      NULL);
+}
+
+/**
+ * @brief Test put and get from ISR
+ *
+ * @ingroup kernel_mpmcq_tests
+ */
+void test_mpmcq_isr(void)
+{
+	k_mpmcq_init(&q, slots, QUEUE_LEN);
+
+	irq_offload(isr_put, &q);
+	zassert_equal(k_mpmcq_get(&q, K_NO_WAIT), &items[0], NULL);
+
+	zassert_equal(k_mpmcq_put(&q, &items[0], K_NO_WAIT), 0, NULL);
+	irq_offload(isr_get, &q);
+	zassert_true(k_mpmcq_is_empty(&q), NULL);
+}
+
+static void delayed_put(void *p1, void *p2, void *p3)
+{
+	k_msleep(10);
+	zassert_equal(k_mpmcq_put(p1, p2, K_NO_WAIT), 0, NULL);
+}
+
+static void delayed_get(void *p1, void *p2, void *p3)
+{
+	k_msleep(10);
+	zassert_equal(k_mpmcq_get(p1, K_NO_WAIT), p2, NULL);
+}
+
+/**
+ * @brief Test that waiting getters and putters are woken up
+ *
+ * @ingroup kernel_mpmcq_tests
+ */
+void test_mpmcq_wait(void)
+{
+	k_mpmcq_init(&q, slots, QUEUE_LEN);
+
+	/**TESTPOINT: a put wakes up a thread waiting for an item */
+	k_thread_create(&tdata[0], tstacks[0], STACK_SIZE, delayed_put,
+			&q, &items[1], NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	zassert_equal(k_mpmcq_get(&q, K_FOREVER), &items[1], NULL);
+	k_thread_join(&tdata[0], K_FOREVER);
+
+	/**TESTPOINT: a get wakes up a thread waiting for a slot */
+	for (int i = 0; i < QUEUE_LEN; i++) {
+		zassert_equal(k_mpmcq_put(&q, &items[i], K_NO_WAIT), 0, NULL);
+	}
+	k_thread_create(&tdata[0], tstacks[0], STACK_SIZE, delayed_get,
+			&q, &items[0], NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	zassert_equal(k_mpmcq_put(&q, &items[QUEUE_LEN], TIMEOUT), 0, NULL);
+	k_thread_join(&tdata[0], K_FOREVER);
+
+	for (int i = 1; i <= QUEUE_LEN; i++) {
+		zassert_equal(k_mpmcq_get(&q, K_NO_WAIT), &items[i], NULL);
+	}
+}
+
+/**
+ * @brief Test k_poll() on an MPMC queue
+ *
+ * @ingroup kernel_mpmcq_tests
+ */
+void test_mpmcq_poll(void)
+{
+	struct k_poll_event event;
+
+	k_mpmcq_init(&q, slots, QUEUE_LEN);
+	k_poll_event_init(&event, K_POLL_TYPE_MPMCQ_DATA_AVAILABLE,
+			  K_POLL_MODE_NOTIFY_ONLY, &q);
+
+	zassert_equal(k_poll(&event, 1, K_NO_WAIT), -EAGAIN, NULL);
+
+	/**TESTPOINT: a put signals a thread polling the queue */
+	k_thread_create(&tdata[0], tstacks[0], STACK_SIZE, delayed_put,
+			&q, &items[0], NULL, K_PRIO_PREEMPT(0), 0, K_NO_WAIT);
+	event.state = K_POLL_STATE_NOT_READY;
+	zassert_equal(k_poll(&event, 1, K_FOREVER), 0, NULL);
+	zassert_equal(event.state, K_POLL_STATE_MPMCQ_DATA_AVAILABLE, NULL);
+	k_thread_join(&tdata[0], K_FOREVER);
+
+	/**TESTPOINT: an item queued before k_poll() is seen right away */
+	event.state = K_POLL_STATE_NOT_READY;
+	zassert_equal(k_poll(&event, 1, K_NO_WAIT), 0, NULL);
+	zassert_equal(event.state, K_POLL_STATE_MPMCQ_DATA_AVAILABLE, NULL);
+	zassert_equal(k_mpmcq_get(&q, K_NO_WAIT), &items[0], NULL);
+}
+
+static uint32_t produced[NUM_PRODUCERS][ITEMS_PER_PRODUCER];
+
+static void producer(void *p1, void *p2, void *p3)
+{
+	uint32_t *mine = p1;
+
+	for (int i = 0; i < ITEMS_PER_PRODUCER; i++) {
+		mine[i] = i;
+		zassert_equal(k_mpmcq_put(&q, &mine[i], K_FOREVER), 0, NULL);
+	}
+}
+
+/**
+ * @brief Test concurrent producers against a blocking consumer
+ *
+ * Each producer's items must be received exactly once and in the order
+ * that producer queued them.
+ *
+ * @ingroup kernel_mpmcq_tests
+ */
+void test_mpmcq_producers(void)
+{
+	int next[NUM_PRODUCERS] = { 0 };
+	uint32_t *item;
+
+	k_mpmcq_init(&q, slots, QUEUE_LEN);
+
+	for (int i = 0; i < NUM_PRODUCERS; i++) {
+		k_thread_create(&tdata[i], tstacks[i], STACK_SIZE, producer,
+				produced[i], NULL, NULL, K_PRIO_PREEMPT(1), 0,
+				K_NO_WAIT);
+	}
+
+	for (int n = 0; n < NUM_PRODUCERS * ITEMS_PER_PRODUCER; n++) {
+		item = k_mpmcq_get(&q, K_FOREVER);
+		zassert_not_null(item, NULL);
+
+		for (int i = 0; i < NUM_PRODUCERS; i++) {
+			if (item >= produced[i] &&
+			    item < produced[i] + ITEMS_PER_PRODUCER) {
+				zassert_equal(*item, next[i], NULL);
+				next[i]++;
+			}
+		}
+	}
+
+	for (int i = 0; i < NUM_PRODUCERS; i++) {
+		k_thread_join(&tdata[i], K_FOREVER);
+		zassert_equal(next[i], ITEMS_PER_PRODUCER, NULL);
+	}
+	zassert_true(k_mpmcq_is_empty(&q), NULL);
+}
+
+/*test case main entry*/
+void test_main(void)
+{
+	ztest_test_suite(mpmcq_api,
+			 ztest_unit_test(test_mpmcq_put_get),
+			 ztest_unit_test(test_mpmcq_isr),
+			 ztest_1cpu_unit_test(test_mpmcq_wait),
+			 ztest_1cpu_unit_test(test_mpmcq_poll),
+			 ztest_unit_test(test_mpmcq_producers));
+	ztest_run_test_suite(mpmcq_api);
+}
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include "test_msgq.h"
+#include <ztest_error_hook.h>
+
+K_THREAD_STACK_EXTERN(tstack);
+extern struct k_thread tdata;
+extern struct k_msgq msgq;
+extern struct k_sem end_sema;
+static ZTEST_BMEM char __aligned(4) tbuffer[MSG_SIZE * MSGQ_LEN];
+static ZTEST_DMEM uint32_t data[MSGQ_LEN] = { MSG0, MSG1 };
+
+static void claim_msgq(struct k_msgq *q)
+{
+	uint32_t rx_data;
+	void *slot;
+
+	zassert_equal(k_msgq_put_commit(q), -EINVAL, NULL);
+	zassert_equal(k_msgq_get_commit(q), -EINVAL, NULL);
+
+	/**TESTPOINT: claim a slot and write the message in place */
+	zassert_equal(k_msgq_put_claim(q, &slot, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_msgq_put_claim(q, &slot, K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_msgq_put(q, &data[1], K_NO_WAIT), -EBUSY, NULL);
+	*(uint32_t *)slot = data[0];
+	zassert_equal(k_msgq_num_used_get(q), 0, NULL);
+	zassert_equal(k_msgq_get_claim(q, &slot, K_NO_WAIT), -ENOMSG, NULL);
+	zassert_equal(k_msgq_put_commit(q), 0, NULL);
+	zassert_equal(k_msgq_num_used_get(q), 1, NULL);
+
+	zassert_equal(k_msgq_put(q, &data[1], K_NO_WAIT), 0, NULL);
+	zassert_equal(k_msgq_put_claim(q, &slot, K_NO_WAIT), -ENOMSG, NULL);
+
+	/**TESTPOINT: claim the first message and read it in place */
+	zassert_equal(k_msgq_get_claim(q, &slot, K_NO_WAIT), 0, NULL);
+	zassert_equal(*(uint32_t *)slot, data[0], NULL);
+	zassert_equal(k_msgq_get_claim(q, &slot, K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_msgq_get(q, &rx_data, K_NO_WAIT), -EBUSY, NULL);
+	zassert_equal(k_msgq_peek(q, &rx_data), 0, NULL);
+	zassert_equal(rx_data, data[0], NULL);
+	zassert_equal(k_msgq_get_commit(q), 0, NULL);
+	zassert_equal(k_msgq_num_used_get(q), 1, NULL);
+
+	zassert_equal(k_msgq_get(q, &rx_data, K_NO_WAIT), 0, NULL);
+	zassert_equal(rx_data, data[1], NULL);
+
+	/**TESTPOINT: a claimer giving up waiting releases its end */
+	zassert_equal(k_msgq_get_claim(q, &slot, TIMEOUT), -EAGAIN, NULL);
+	zassert_equal(k_msgq_get_claim(q, &slot, K_NO_WAIT), -ENOMSG, NULL);
+}
+
+static void put_claim_entry(void *p1, void *p2, void *p3)
+{
+	void *slot;
+
+	zassert_equal(k_msgq_put_claim(p1, &slot, K_NO_WAIT), 0, NULL);
+	*(uint32_t *)slot = data[1];
+	zassert_equal(k_msgq_put_commit(p1), 0, NULL);
+}
+
+static void get_entry(void *p1, void *p2, void *p3)
+{
+	uint32_t rx_data;
+
+	zassert_equal(k_msgq_get(p1, &rx_data, K_FOREVER), 0, NULL);
+	zassert_equal(rx_data, data[0], NULL);
+	k_sem_give(&end_sema);
+}
+
+static void claim_msgq_pend(struct k_msgq *q)
+{
+	uint32_t rx_data;
+	void *slot;
+
+	/**TESTPOINT: a waiting claimer gets the next message */
+	k_thread_create(&tdata, tstack, STACK_SIZE, put_claim_entry, q,
+			NULL, NULL, K_PRIO_PREEMPT(0),
+			K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+	zassert_equal(k_msgq_get_claim(q, &slot, K_FOREVER), 0, NULL);
+	zassert_equal(*(uint32_t *)slot, data[1], NULL);
+	zassert_equal(k_msgq_get_commit(q), 0, NULL);
+	k_thread_join(&tdata, K_FOREVER);
+
+	/**TESTPOINT: a waiting claimer gets the next free slot */
+	for (int i = 0; i < MSGQ_LEN; i++) {
+		zassert_equal(k_msgq_put(q, &data[0], K_NO_WAIT), 0, NULL);
+	}
+	k_thread_create(&tdata, tstack, STACK_SIZE, get_entry, q,
+			NULL, NULL, K_PRIO_PREEMPT(0),
+			K_USER | K_INHERIT_PERMS, K_NO_WAIT);
+	zassert_equal(k_msgq_put_claim(q, &slot, K_FOREVER), 0, NULL);
+	k_sem_take(&end_sema, K_FOREVER);
+	k_thread_join(&tdata, K_FOREVER);
+	*(uint32_t *)slot = data[1];
+	zassert_equal(k_msgq_put_commit(q), 0, NULL);
+
+	zassert_equal(k_msgq_get(q, &rx_data, K_NO_WAIT), 0, NULL);
+	zassert_equal(rx_data, data[0], NULL);
+	zassert_equal(k_msgq_get(q, &rx_data, K_NO_WAIT), 0, NULL);
+	zassert_equal(rx_data, data[1], NULL);
+
+	/**TESTPOINT: purge keeps the claimed message */
+	for (int i = 0; i < MSGQ_LEN; i++) {
+		zassert_equal(k_msgq_put(q, &data[i], K_NO_WAIT), 0, NULL);
+	}
+	zassert_equal(k_msgq_get_claim(q, &slot, K_NO_WAIT), 0, NULL);
+	k_msgq_purge(q);
+	zassert_equal(k_msgq_num_used_get(q), 1, NULL);
+	zassert_equal(*(uint32_t *)slot, data[0], NULL);
+	zassert_equal(k_msgq_get_commit(q), 0, NULL);
+	zassert_equal(k_msgq_num_used_get(q), 0, NULL);
+}
+
+/**
+ * @addtogroup kernel_message_queue_tests
+ * @{
+ */
+
+/**
+ * @brief Test writing and reading messages in place
+ * @see k_msgq_put_claim(), k_msgq_put_commit(), k_msgq_get_claim(),
+ * k_msgq_get_commit()
+ */
+void test_msgq_claim(void)
+{
+	k_msgq_init(&msgq, tbuffer, MSG_SIZE, MSGQ_LEN);
+
+	claim_msgq(&msgq);
+	claim_msgq_pend(&msgq);
+}
+
+#ifdef CONFIG_USERSPACE
+/**
+ * @brief Test writing and reading messages in place from user mode
+ *
+ * @details The message queue is the one initialized by test_msgq_claim(),
+ * its buffer is in the ztest memory partition.
+ *
+ * @see k_msgq_put_claim(), k_msgq_put_commit(), k_msgq_get_claim(),
+ * k_msgq_get_commit()
+ */
+void test_msgq_user_claim(void)
+{
+	claim_msgq(&msgq);
+}
+
+/**
+ * @brief Test claiming a message slot the caller cannot access
+ *
+ * @details The buffer of an allocated queue is not accessible from user
+ * mode, so the claim must fault rather than hand out its address.
+ *
+ * @see k_msgq_put_claim()
+ */
+void test_msgq_user_claim_unreach(void)
+{
+	struct k_msgq *q;
+	void *slot;
+
+	q = k_object_alloc(K_OBJ_MSGQ);
+	zassert_not_null(q, "couldn't alloc message queue");
+	zassert_false(k_msgq_alloc_init(q, MSG_SIZE, MSGQ_LEN), NULL);
+
+	ztest_set_fault_valid(true);
+	k_msgq_put_claim(q, &slot, K_NO_WAIT);
+}
+#endif
+
+/**
+ * @}
+ */
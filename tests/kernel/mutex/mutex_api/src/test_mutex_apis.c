@@ -386,6 +386,98 @@ void test_mutex_priority_inheritance(void)
 	k_msleep(TIMEOUT+1000);
 }
 
+#ifdef CONFIG_MUTEX_CEILING_PROTOCOL
+static struct k_mutex nested_mutex;
+static int ceiling_prio_seen;
+
+static void tThread_lock_ceiling(void *p1, void *p2, void *p3)
+{
+	struct k_mutex *pmutex = p1;
+
+	zassert_equal(k_mutex_lock(pmutex, K_FOREVER), 0, NULL);
+	ceiling_prio_seen = k_thread_priority_get(k_current_get());
+	zassert_equal(k_mutex_unlock(pmutex), 0, NULL);
+	zassert_equal(k_thread_priority_get(k_current_get()),
+		      K_PRIO_PREEMPT(THREAD_LOW_PRIORITY), NULL);
+}
+
+/**
+ * @brief Test mutex priority ceiling protocol
+ * @details
+ * - The owner of a mutex with a ceiling runs at the ceiling priority,
+ *   until it has unlocked it as many times as it locked it.
+ * - Threads of a higher priority than the ceiling can't lock it, where
+ *   the priority doesn't include boosts from mutexes they hold.
+ * - A waiter the mutex is handed over to also runs at the ceiling.
+ * @ingroup kernel_mutex_tests
+ * @see k_mutex_ceiling_set()
+ */
+void test_mutex_priority_ceiling(void)
+{
+	int prio = K_PRIO_PREEMPT(THREAD_MID_PRIORITY);
+	int ceiling = K_PRIO_PREEMPT(THREAD_HIGH_PRIORITY);
+	int old_prio = k_thread_priority_get(k_current_get());
+
+	k_thread_priority_set(k_current_get(), prio);
+	k_mutex_init(&mutex);
+
+	zassert_equal(k_mutex_ceiling_set(&mutex, K_HIGHEST_THREAD_PRIO - 1),
+		      -EINVAL, NULL);
+
+	/**TESTPOINT: the owner runs at the ceiling priority */
+	zassert_equal(k_mutex_ceiling_set(&mutex, ceiling), 0, NULL);
+	zassert_equal(k_mutex_lock(&mutex, K_FOREVER), 0, NULL);
+	zassert_equal(k_thread_priority_get(k_current_get()), ceiling, NULL);
+	zassert_equal(k_mutex_ceiling_set(&mutex, prio), -EBUSY, NULL);
+	zassert_equal(k_mutex_lock(&mutex, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_mutex_unlock(&mutex), 0, NULL);
+	zassert_equal(k_thread_priority_get(k_current_get()), ceiling, NULL);
+	zassert_equal(k_mutex_unlock(&mutex), 0, NULL);
+	zassert_equal(k_thread_priority_get(k_current_get()), prio, NULL);
+
+	/**TESTPOINT: a nested mutex with a lower ceiling can be locked */
+	k_mutex_init(&nested_mutex);
+	zassert_equal(k_mutex_ceiling_set(&nested_mutex, prio), 0, NULL);
+	zassert_equal(k_mutex_lock(&mutex, K_FOREVER), 0, NULL);
+	zassert_equal(k_mutex_lock(&nested_mutex, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_thread_priority_get(k_current_get()), ceiling, NULL);
+	zassert_equal(k_mutex_unlock(&nested_mutex), 0, NULL);
+	zassert_equal(k_mutex_unlock(&mutex), 0, NULL);
+	zassert_equal(k_thread_priority_get(k_current_get()), prio, NULL);
+
+	/**TESTPOINT: a thread above the ceiling can't lock the mutex */
+	zassert_equal(k_mutex_ceiling_set(&mutex,
+					  K_PRIO_PREEMPT(THREAD_LOW_PRIORITY)),
+		      0, NULL);
+	zassert_equal(k_mutex_lock(&mutex, K_NO_WAIT), -EINVAL, NULL);
+
+	/**TESTPOINT: the mutex is handed over at the ceiling priority */
+	zassert_equal(k_mutex_ceiling_set(&mutex, ceiling), 0, NULL);
+	zassert_equal(k_mutex_lock(&mutex, K_FOREVER), 0, NULL);
+	k_thread_create(&tdata, tstack, STACK_SIZE, tThread_lock_ceiling,
+			&mutex, NULL, NULL,
+			K_PRIO_PREEMPT(THREAD_LOW_PRIORITY), 0, K_NO_WAIT);
+	k_msleep(100);
+	zassert_equal(k_mutex_unlock(&mutex), 0, NULL);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(ceiling_prio_seen, ceiling, NULL);
+
+	/**TESTPOINT: without a ceiling the priority is left alone */
+	zassert_equal(k_mutex_ceiling_set(&mutex, K_MUTEX_NO_CEILING), 0,
+		      NULL);
+	zassert_equal(k_mutex_lock(&mutex, K_FOREVER), 0, NULL);
+	zassert_equal(k_thread_priority_get(k_current_get()), prio, NULL);
+	zassert_equal(k_mutex_unlock(&mutex), 0, NULL);
+
+	k_thread_priority_set(k_current_get(), old_prio);
+}
+#else
+void test_mutex_priority_ceiling(void)
+{
+	ztest_test_skip();
+}
+#endif
+
 /*test case main entry*/
 void test_main(void)
 {
@@ -400,7 +492,8 @@ void test_main(void)
 		 ztest_user_unit_test(test_mutex_reent_lock_timeout_fail),
 		 ztest_1cpu_user_unit_test(test_mutex_reent_lock_timeout_pass),
 		 ztest_user_unit_test(test_mutex_recursive),
-		 ztest_user_unit_test(test_mutex_priority_inheritance)
+		 ztest_user_unit_test(test_mutex_priority_inheritance),
+		 ztest_1cpu_unit_test(test_mutex_priority_ceiling)
 		 );
 	ztest_run_test_suite(mutex_api);
 }
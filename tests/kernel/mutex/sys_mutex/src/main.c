@@ -49,6 +49,7 @@
 #include <zephyr.h>
 #include <ztest.h>
 #include <sys/mutex.h>
+#include <ztest_error_hook.h>
 
 #define STACKSIZE (512 + CONFIG_TEST_EXTRA_STACKSIZE)
 
@@ -386,7 +387,12 @@ void test_supervisor_access(void)
 
 void test_user_access(void)
 {
-#ifdef CONFIG_USERSPACE
+#if defined(CONFIG_SYS_MUTEX_FAST)
+	/* The mutex is accessed directly from user mode */
+	ztest_set_fault_valid(true);
+	sys_mutex_lock(&no_access_mutex, K_NO_WAIT);
+	ztest_test_fail();
+#elif defined(CONFIG_USERSPACE)
 	int rv;
 
 	rv = sys_mutex_lock(&no_access_mutex, K_NO_WAIT);
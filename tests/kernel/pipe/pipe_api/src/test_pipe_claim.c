@@ -0,0 +1,242 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <ztest.h>
+#include <ztest_error_hook.h>
+
+#define STACK_SIZE	(1024 + CONFIG_TEST_EXTRA_STACKSIZE)
+#define TIMEOUT		K_MSEC(100)
+#define PIPE_LEN	64
+#define CHUNK		16
+
+static ZTEST_DMEM unsigned char __aligned(4) data[] =
+"abcd1234$%^&PIPEefgh5678!/?*EPIPijkl9012[]<>PEPImnop3456{}()IPEP";
+BUILD_ASSERT(sizeof(data) >= PIPE_LEN);
+
+static ZTEST_BMEM unsigned char __aligned(4) claim_buf[PIPE_LEN];
+struct k_pipe claim_pipe;
+
+K_THREAD_STACK_EXTERN(tstack);
+extern struct k_thread tdata;
+
+static void claim_pipe_basic(struct k_pipe *p)
+{
+	unsigned char rx_data[CHUNK];
+	size_t size, bytes;
+	void *ptr;
+
+	zassert_equal(k_pipe_put_commit(p, 0), -EINVAL, NULL);
+	zassert_equal(k_pipe_get_commit(p, 0), -EINVAL, NULL);
+
+	size = 0;
+	zassert_equal(k_pipe_put_claim(p, &ptr, &size, K_NO_WAIT), -EINVAL,
+		      NULL);
+	size = PIPE_LEN;
+	zassert_equal(k_pipe_get_claim(p, &ptr, &size, K_NO_WAIT), -EIO, NULL);
+
+	/**TESTPOINT: claim space and write data in place */
+	size = 2 * PIPE_LEN;
+	zassert_equal(k_pipe_put_claim(p, &ptr, &size, K_NO_WAIT), 0, NULL);
+	zassert_equal(size, PIPE_LEN, NULL);
+	zassert_equal(k_pipe_put_claim(p, &ptr, &size, K_NO_WAIT), -EBUSY,
+		      NULL);
+	zassert_equal(k_pipe_put(p, data, CHUNK, &bytes, 0, K_NO_WAIT), -EBUSY,
+		      NULL);
+	memcpy(ptr, data, 3 * CHUNK);
+	zassert_equal(k_pipe_put_commit(p, PIPE_LEN + 1), -EINVAL, NULL);
+	zassert_equal(k_pipe_put_commit(p, 3 * CHUNK), 0, NULL);
+	zassert_equal(k_pipe_read_avail(p), 3 * CHUNK, NULL);
+
+	/**TESTPOINT: claim data and read it in place */
+	size = CHUNK;
+	zassert_equal(k_pipe_get_claim(p, &ptr, &size, K_NO_WAIT), 0, NULL);
+	zassert_equal(size, CHUNK, NULL);
+	zassert_mem_equal(ptr, data, CHUNK, NULL);
+	zassert_equal(k_pipe_get(p, rx_data, CHUNK, &bytes, 0, K_NO_WAIT),
+		      -EBUSY, NULL);
+	zassert_equal(k_pipe_get_commit(p, CHUNK), 0, NULL);
+
+	/**TESTPOINT: claims stop at the end of the buffer */
+	size = PIPE_LEN;
+	zassert_equal(k_pipe_put_claim(p, &ptr, &size, K_NO_WAIT), 0, NULL);
+	zassert_equal(size, CHUNK, NULL);
+	memcpy(ptr, &data[3 * CHUNK], CHUNK);
+	zassert_equal(k_pipe_put_commit(p, CHUNK), 0, NULL);
+
+	size = PIPE_LEN;
+	zassert_equal(k_pipe_put_claim(p, &ptr, &size, K_NO_WAIT), 0, NULL);
+	zassert_equal(size, CHUNK, NULL);
+	memcpy(ptr, data, CHUNK);
+	zassert_equal(k_pipe_put_commit(p, CHUNK), 0, NULL);
+	zassert_equal(k_pipe_put_claim(p, &ptr, &size, K_NO_WAIT), -EIO, NULL);
+
+	size = PIPE_LEN;
+	zassert_equal(k_pipe_get_claim(p, &ptr, &size, K_NO_WAIT), 0, NULL);
+	zassert_equal(size, PIPE_LEN - CHUNK, NULL);
+	zassert_mem_equal(ptr, &data[CHUNK], PIPE_LEN - CHUNK, NULL);
+	zassert_equal(k_pipe_get_commit(p, size), 0, NULL);
+
+	/**TESTPOINT: committing nothing leaves the data in the pipe */
+	size = PIPE_LEN;
+	zassert_equal(k_pipe_get_claim(p, &ptr, &size, K_NO_WAIT), 0, NULL);
+	zassert_equal(size, CHUNK, NULL);
+	zassert_equal(k_pipe_get_commit(p, 0), 0, NULL);
+	zassert_equal(k_pipe_get(p, rx_data, CHUNK, &bytes, CHUNK, K_NO_WAIT),
+		      0, NULL);
+	zassert_mem_equal(rx_data, data, CHUNK, NULL);
+
+	/**TESTPOINT: a claimer giving up waiting releases its end */
+	size = PIPE_LEN;
+	zassert_equal(k_pipe_get_claim(p, &ptr, &size, TIMEOUT), -EAGAIN, NULL);
+	zassert_equal(k_pipe_get_claim(p, &ptr, &size, K_NO_WAIT), -EIO, NULL);
+}
+
+static void put_entry(void *p1, void *p2, void *p3)
+{
+	size_t bytes;
+
+	zassert_equal(k_pipe_put(p1, data, CHUNK, &bytes, CHUNK, K_FOREVER),
+		      0, NULL);
+}
+
+static void get_entry(void *p1, void *p2, void *p3)
+{
+	unsigned char rx_data[CHUNK];
+	size_t bytes;
+
+	zassert_equal(k_pipe_get(p1, rx_data, CHUNK, &bytes, CHUNK, K_FOREVER),
+		      0, NULL);
+	zassert_mem_equal(rx_data, data, CHUNK, NULL);
+}
+
+static void start_thread(struct k_pipe *p, k_thread_entry_t entry)
+{
+	k_thread_create(&tdata, tstack, STACK_SIZE, entry, p, NULL, NULL,
+			K_PRIO_PREEMPT(0), K_INHERIT_PERMS, K_NO_WAIT);
+}
+
+static void claim_pipe_pend(struct k_pipe *p)
+{
+	size_t size, bytes;
+	void *ptr;
+
+	/**TESTPOINT: a waiting get claimer is woken by a writer */
+	start_thread(p, put_entry);
+	size = PIPE_LEN;
+	zassert_equal(k_pipe_get_claim(p, &ptr, &size, K_FOREVER), 0, NULL);
+	zassert_equal(size, CHUNK, NULL);
+	zassert_mem_equal(ptr, data, CHUNK, NULL);
+	zassert_equal(k_pipe_get_commit(p, CHUNK), 0, NULL);
+	k_thread_join(&tdata, K_FOREVER);
+
+	/**TESTPOINT: a waiting put claimer is woken by a reader */
+	zassert_equal(k_pipe_put(p, data, PIPE_LEN, &bytes, PIPE_LEN,
+				 K_NO_WAIT), 0, NULL);
+	start_thread(p, get_entry);
+	size = PIPE_LEN;
+	zassert_equal(k_pipe_put_claim(p, &ptr, &size, K_FOREVER), 0, NULL);
+	zassert_equal(size, CHUNK, NULL);
+	zassert_equal(k_pipe_put_commit(p, 0), 0, NULL);
+	k_thread_join(&tdata, K_FOREVER);
+
+	/**TESTPOINT: releasing claimed data takes in waiting writers' data */
+	zassert_equal(k_pipe_put(p, &data[CHUNK], CHUNK, &bytes, CHUNK,
+				 K_NO_WAIT), 0, NULL);
+	start_thread(p, put_entry);
+	k_sleep(K_MSEC(10));
+	size = PIPE_LEN;
+	zassert_equal(k_pipe_get_claim(p, &ptr, &size, K_NO_WAIT), 0, NULL);
+	zassert_equal(k_pipe_get_commit(p, size), 0, NULL);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(k_pipe_read_avail(p), PIPE_LEN, NULL);
+
+	/**TESTPOINT: committed data goes to waiting readers */
+	size = PIPE_LEN;
+	while (k_pipe_get_claim(p, &ptr, &size, K_NO_WAIT) == 0) {
+		zassert_equal(k_pipe_get_commit(p, size), 0, NULL);
+		size = PIPE_LEN;
+	}
+	start_thread(p, get_entry);
+	k_sleep(K_MSEC(10));
+	size = CHUNK;
+	zassert_equal(k_pipe_put_claim(p, &ptr, &size, K_NO_WAIT), 0, NULL);
+	memcpy(ptr, data, CHUNK);
+	zassert_equal(k_pipe_put_commit(p, CHUNK), 0, NULL);
+	k_thread_join(&tdata, K_FOREVER);
+	zassert_equal(k_pipe_read_avail(p), 0, NULL);
+}
+
+/**
+ * @brief Test writing and reading pipe data in place
+ * @ingroup kernel_pipe_tests
+ * @see k_pipe_put_claim(), k_pipe_put_commit(), k_pipe_get_claim(),
+ * k_pipe_get_commit()
+ */
+void test_pipe_claim(void)
+{
+	k_pipe_init(&claim_pipe, claim_buf, PIPE_LEN);
+
+	claim_pipe_basic(&claim_pipe);
+	claim_pipe_pend(&claim_pipe);
+}
+
+/**
+ * @brief Test claims on an unbuffered pipe
+ * @ingroup kernel_pipe_tests
+ * @see k_pipe_put_claim(), k_pipe_get_claim()
+ */
+void test_pipe_claim_no_buffer(void)
+{
+	struct k_pipe p;
+	size_t size = PIPE_LEN;
+	void *ptr;
+
+	k_pipe_init(&p, NULL, 0);
+
+	zassert_equal(k_pipe_put_claim(&p, &ptr, &size, K_NO_WAIT), -EINVAL,
+		      NULL);
+	zassert_equal(k_pipe_get_claim(&p, &ptr, &size, K_NO_WAIT), -EINVAL,
+		      NULL);
+}
+
+#ifdef CONFIG_USERSPACE
+/**
+ * @brief Test writing and reading pipe data in place from user mode
+ *
+ * @details The pipe is the one initialized by test_pipe_claim(), its
+ * buffer is in the ztest memory partition.
+ *
+ * @ingroup kernel_pipe_tests
+ * @see k_pipe_put_claim(), k_pipe_put_commit(), k_pipe_get_claim(),
+ * k_pipe_get_commit()
+ */
+void test_pipe_user_claim(void)
+{
+	claim_pipe_basic(&claim_pipe);
+}
+
+/**
+ * @brief Test claiming pipe space the caller cannot access
+ *
+ * @details The buffer of an allocated pipe is not accessible from user
+ * mode, so the claim must fault rather than hand out its address.
+ *
+ * @ingroup kernel_pipe_tests
+ * @see k_pipe_put_claim()
+ */
+void test_pipe_user_claim_unreach(void)
+{
+	struct k_pipe *p = k_object_alloc(K_OBJ_PIPE);
+	size_t size = PIPE_LEN;
+	void *ptr;
+
+	zassert_true(p != NULL, NULL);
+	zassert_false(k_pipe_alloc_init(p, PIPE_LEN), NULL);
+
+	ztest_set_fault_valid(true);
+	k_pipe_put_claim(p, &ptr, &size, K_NO_WAIT);
+}
+#endif
@@ -211,11 +211,87 @@ void test_unqueued(void)
 	}
 }
 
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+static volatile uint32_t spin_count[2];
+
+static void spin_worker(void *p1, void *p2, void *p3)
+{
+	volatile uint32_t *count = p1;
+
+	ARG_UNUSED(p2);
+	ARG_UNUSED(p3);
+
+	while (1) {
+		(*count)++;
+	}
+}
+#endif
+
+/**
+ * @brief Validate admission control and budget enforcement of
+ * k_thread_reservation_set()
+ *
+ * @details Two threads that never block get reservations of 20% and 60%
+ * of the CPU.  Each must get about its reserved share of the time they
+ * run together, the spinning loop counts telling how much CPU time each
+ * of them got.
+ *
+ * @ingroup kernel_sched_tests
+ */
+void test_reservation(void)
+{
+#ifdef CONFIG_SCHED_DEADLINE_RESERVATION
+	uint32_t share;
+
+	for (int i = 0; i < 2; i++) {
+		spin_count[i] = 0;
+		worker_tids[i] = k_thread_create(&worker_threads[i],
+				worker_stacks[i], STACK_SIZE,
+				spin_worker, (void *)&spin_count[i], NULL, NULL,
+				K_LOWEST_APPLICATION_THREAD_PRIO,
+				0, K_FOREVER);
+	}
+
+	/**TESTPOINT: invalid reservations and admission control */
+	zassert_equal(k_thread_reservation_set(worker_tids[0], 2000, 1000),
+		      -EINVAL, NULL);
+	zassert_equal(k_thread_reservation_set(worker_tids[0], 60000, 100000),
+		      0, NULL);
+	zassert_equal(k_thread_reservation_set(worker_tids[1], 40000, 100000),
+		      -EBUSY, NULL);
+	zassert_equal(k_thread_reservation_set(worker_tids[0], 20000, 100000),
+		      0, NULL);
+	zassert_equal(k_thread_reservation_set(worker_tids[1], 60000, 100000),
+		      0, NULL);
+
+	/**TESTPOINT: each thread gets its reserved share */
+	k_thread_start(worker_tids[0]);
+	k_thread_start(worker_tids[1]);
+	k_sleep(K_MSEC(1000));
+	k_thread_abort(worker_tids[0]);
+	k_thread_abort(worker_tids[1]);
+
+	share = (uint32_t)((uint64_t)spin_count[0] * 100U /
+			   (spin_count[0] + spin_count[1]));
+	zassert_true(share >= 15U && share <= 35U,
+		     "reserved 25%% of the shared time, got %u%%", share);
+
+	/**TESTPOINT: aborted threads give their share back */
+	zassert_equal(k_thread_reservation_set(k_current_get(), 90000, 100000),
+		      0, NULL);
+	zassert_equal(k_thread_reservation_set(k_current_get(), 0, 0), 0,
+		      NULL);
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(suite_deadline,
 			 ztest_unit_test(test_deadline),
 			 ztest_unit_test(test_yield),
-			 ztest_unit_test(test_unqueued));
+			 ztest_unit_test(test_unqueued),
+			 ztest_unit_test(test_reservation));
 	ztest_run_test_suite(suite_deadline);
 }
@@ -567,6 +567,62 @@ void test_thread_runtime_stats_get(void)
 	zassert_true(stats.execution_cycles <= stats_all.execution_cycles, NULL);
 }
 
+#ifdef CONFIG_SCHED_THREAD_STATS
+static void sched_stats_entry(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < 3; i++) {
+		k_msleep(10);
+	}
+}
+#endif
+
+/**
+ * @ingroup kernel_thread_tests
+ * @brief Test scheduler statistics of a thread woken up by timeouts
+ * @see k_thread_sched_stats_get(), k_cpu_sched_stats_get()
+ */
+void test_thread_sched_stats_get(void)
+{
+#ifdef CONFIG_SCHED_THREAD_STATS
+	struct k_thread_sched_stats stats;
+	struct k_cpu_sched_stats cpu_stats;
+	uint32_t sum = 0;
+
+	/* Check invalid parameters */
+	zassert_equal(k_thread_sched_stats_get(k_current_get(), NULL), -EINVAL,
+		      NULL);
+	zassert_equal(k_cpu_sched_stats_get(-1, &cpu_stats), -EINVAL, NULL);
+	zassert_equal(k_cpu_sched_stats_get(CONFIG_MP_NUM_CPUS, &cpu_stats),
+		      -EINVAL, NULL);
+	zassert_equal(k_cpu_sched_stats_get(0, NULL), -EINVAL, NULL);
+
+	k_tid_t tid = k_thread_create(&tdata, tstack, STACK_SIZE,
+				      sched_stats_entry, NULL, NULL, NULL,
+				      K_PRIO_PREEMPT(0), 0, K_FOREVER);
+
+	k_thread_sched_stats_reset(tid);
+	k_thread_start(tid);
+	k_thread_join(tid, K_FOREVER);
+
+	/** TESTPOINT: every wakeup lands in one histogram bucket */
+	zassert_equal(k_thread_sched_stats_get(tid, &stats), 0, NULL);
+	zassert_true(stats.wakeups >= 3, NULL);
+	for (int i = 0; i < CONFIG_SCHED_THREAD_STATS_BUCKETS; i++) {
+		sum += stats.wakeup_latency_hist[i];
+	}
+	zassert_equal(sum, stats.wakeups, NULL);
+
+	/** TESTPOINT: run queue length was sampled at context switches */
+	zassert_equal(k_cpu_sched_stats_get(0, &cpu_stats), 0, NULL);
+	zassert_true(cpu_stats.runq_len_samples > 0, NULL);
+	zassert_true(cpu_stats.runq_len_sum <=
+		     (uint64_t)cpu_stats.runq_len_max *
+		     cpu_stats.runq_len_samples, NULL);
+#else
+	ztest_test_skip();
+#endif /* CONFIG_SCHED_THREAD_STATS */
+}
+
 void test_k_busy_wait(void)
 {
 	uint64_t cycles, dt;
@@ -669,6 +725,7 @@ void test_main(void)
 
 	ztest_test_suite(threads_lifecycle,
 			 ztest_unit_test(test_thread_runtime_stats_get),
+			 ztest_1cpu_unit_test(test_thread_sched_stats_get),
 			 ztest_user_unit_test(test_k_thread_stack_space_get_user),
 			 ztest_user_unit_test(test_threads_spawn_params),
 			 ztest_unit_test(test_threads_spawn_priority),
@@ -811,6 +811,57 @@ void test_sleep_abs(void)
 		     start + sleep_ticks, end, late);
 }
 
+#ifdef CONFIG_TIMEOUT_SLACK
+static struct k_timer exact_timer;
+static struct k_timer slack_timer;
+static int64_t exact_ticks;
+static int64_t slack_ticks;
+
+static void slack_expire(struct k_timer *timer)
+{
+	*(int64_t *)k_timer_user_data_get(timer) = k_uptime_ticks();
+}
+#endif
+
+/**
+ * @brief Test that a timer with slack shares the expiry of another one
+ *
+ * @ingroup kernel_timer_tests
+ *
+ * @see k_timer_slack_set(), sys_clock_slack_stats_get()
+ */
+void test_timer_slack(void)
+{
+#ifdef CONFIG_TIMEOUT_SLACK
+	struct sys_clock_slack_stats before, after;
+
+	k_timer_init(&exact_timer, slack_expire, NULL);
+	k_timer_user_data_set(&exact_timer, &exact_ticks);
+	k_timer_init(&slack_timer, slack_expire, NULL);
+	k_timer_user_data_set(&slack_timer, &slack_ticks);
+	k_timer_slack_set(&slack_timer, K_MSEC(DURATION));
+
+	k_usleep(1); /* tick align */
+
+	sys_clock_slack_stats_get(&before);
+	k_timer_start(&exact_timer, K_MSEC(DURATION), K_NO_WAIT);
+	k_timer_start(&slack_timer, K_MSEC(DURATION / 2), K_NO_WAIT);
+	sys_clock_slack_stats_get(&after);
+
+	/** TESTPOINT: the earlier timer was moved onto the later one */
+	zassert_equal(after.coalesced, before.coalesced + 1, NULL);
+	zassert_equal(after.reprograms_saved, before.reprograms_saved + 1,
+		      NULL);
+
+	k_timer_status_sync(&exact_timer);
+	k_timer_status_sync(&slack_timer);
+	zassert_equal(slack_ticks, exact_ticks, "expired at %lld and %lld",
+		      slack_ticks, exact_ticks);
+#else
+	ztest_test_skip();
+#endif
+}
+
 static void timer_init(struct k_timer *timer, k_timer_expiry_t expiry_fn,
 		       k_timer_stop_t stop_fn)
 {
@@ -853,6 +904,7 @@ void test_main(void)
 			 ztest_user_unit_test(test_timer_user_data),
 			 ztest_user_unit_test(test_timer_remaining),
 			 ztest_user_unit_test(test_timeout_abs),
-			 ztest_user_unit_test(test_sleep_abs));
+			 ztest_user_unit_test(test_sleep_abs),
+			 ztest_unit_test(test_timer_slack));
 	ztest_run_test_suite(timer_api);
 }
@@ -0,0 +1,143 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+#include <zephyr.h>
+#include <ztest.h>
+#include <sys/work_pool.h>
+
+#define NUM_WORKERS (CONFIG_MP_NUM_CPUS * 2)
+#define RANGE 10000
+#define NUM_TASKS (CONFIG_WORK_POOL_DEQUE_SIZE * 4)
+
+K_WORK_POOL_DEFINE(pool, NUM_WORKERS, 2048, K_PRIO_PREEMPT(1));
+
+static atomic_t visits[RANGE];
+static atomic_t calls;
+
+struct test_task {
+	struct k_work_pool_task task;
+	atomic_t *counter;
+};
+
+static struct test_task tasks[NUM_TASKS];
+static struct test_task parent;
+
+static void visit(void *arg, size_t begin, size_t end)
+{
+	zassert_equal(arg, visits, "wrong argument");
+	zassert_true(begin < end, "empty subrange");
+	zassert_true(end - begin <= 7, "subrange larger than grain");
+
+	for (size_t i = begin; i < end; i++) {
+		atomic_inc(&visits[i]);
+	}
+
+	atomic_inc(&calls);
+}
+
+static void check_visits(int expected)
+{
+	for (int i = 0; i < RANGE; i++) {
+		zassert_equal(atomic_get(&visits[i]), expected,
+			      "index %d visited %d times", i,
+			      (int)atomic_get(&visits[i]));
+	}
+}
+
+static void count_handler(struct k_work_pool_task *task)
+{
+	struct test_task *t = CONTAINER_OF(task, struct test_task, task);
+
+	atomic_inc(t->counter);
+}
+
+/**
+ * @brief Test that parallel_for covers the range exactly once
+ */
+void test_parallel_for(void)
+{
+	memset(visits, 0, sizeof(visits));
+	atomic_clear(&calls);
+
+	k_work_pool_parallel_for(&pool, 0, RANGE, 7, visit, visits);
+
+	check_visits(1);
+	zassert_true(atomic_get(&calls) >= RANGE / 7, "too few calls");
+
+	/* Empty ranges don't call anything */
+	atomic_clear(&calls);
+	k_work_pool_parallel_for(&pool, 5, 5, 7, visit, visits);
+	zassert_equal(atomic_get(&calls), 0, "called for empty range");
+}
+
+static void nested(void *arg, size_t begin, size_t end)
+{
+	ARG_UNUSED(arg);
+
+	for (size_t i = begin; i < end; i++) {
+		k_work_pool_parallel_for(&pool, i * 100, (i + 1) * 100, 7,
+					 visit, visits);
+	}
+}
+
+/**
+ * @brief Test parallel_for called from tasks of the same pool
+ */
+void test_parallel_for_nested(void)
+{
+	memset(visits, 0, sizeof(visits));
+
+	k_work_pool_parallel_for(&pool, 0, RANGE / 100, 1, nested, NULL);
+
+	check_visits(1);
+}
+
+static void spawn_handler(struct k_work_pool_task *task)
+{
+	atomic_t *counter = CONTAINER_OF(task, struct test_task, task)->counter;
+
+	/* More tasks than fit on the deque of this worker */
+	for (int i = 0; i < NUM_TASKS; i++) {
+		tasks[i].task.handler = count_handler;
+		tasks[i].counter = counter;
+		k_work_pool_submit(&pool, &tasks[i].task);
+	}
+
+	for (int i = 0; i < NUM_TASKS; i++) {
+		k_work_pool_join(&pool, &tasks[i].task);
+	}
+
+	atomic_inc(counter);
+}
+
+/**
+ * @brief Test submit and join from inside and outside of the pool
+ */
+void test_submit_join(void)
+{
+	atomic_t counter = ATOMIC_INIT(0);
+
+	parent.task.handler = spawn_handler;
+	parent.counter = &counter;
+
+	k_work_pool_submit(&pool, &parent.task);
+	k_work_pool_join(&pool, &parent.task);
+
+	zassert_equal(atomic_get(&counter), NUM_TASKS + 1,
+		      "not all tasks ran");
+
+	/* Joining a finished task returns at once */
+	k_work_pool_join(&pool, &parent.task);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(lib_work_pool_test,
+			 ztest_unit_test(test_parallel_for),
+			 ztest_unit_test(test_parallel_for_nested),
+			 ztest_unit_test(test_submit_join));
+
+	ztest_run_test_suite(lib_work_pool_test);
+}
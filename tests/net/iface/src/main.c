@@ -134,6 +134,22 @@ static int sender_iface(const struct device *dev, struct net_pkt *pkt)
 	return 0;
 }
 
+#if defined(CONFIG_NET_BURST)
+static size_t max_burst;
+
+static int sender_iface_burst(const struct device *dev,
+			      struct net_pkt **pkts, size_t count)
+{
+	max_burst = MAX(max_burst, count);
+
+	for (size_t i = 0; i < count; i++) {
+		sender_iface(dev, pkts[i]);
+	}
+
+	return count;
+}
+#endif
+
 struct net_if_test net_iface1_data;
 struct net_if_test net_iface2_data;
 struct net_if_test net_iface3_data;
@@ -141,6 +157,9 @@ struct net_if_test net_iface3_data;
 static struct dummy_api net_iface_api = {
 	.iface_api.init = net_iface_init,
 	.send = sender_iface,
+#if defined(CONFIG_NET_BURST)
+	.send_burst = sender_iface_burst,
+#endif
 };
 
 #define _ETH_L2_LAYER DUMMY_L2
@@ -508,6 +527,35 @@ static void test_send_iface1_up(void)
 	zassert_true(ret, "iface 1 up again");
 }
 
+static void test_send_iface_burst(void)
+{
+	static uint8_t data[] = { 't', 'e', 's', 't', '\0' };
+	struct net_pkt *pkts[4];
+
+	for (int i = 0; i < ARRAY_SIZE(pkts); i++) {
+		pkts[i] = net_pkt_alloc_with_buffer(iface2, sizeof(data),
+						    AF_UNSPEC, 0, K_FOREVER);
+		zassert_not_null(pkts[i], "Cannot allocate pkt");
+
+		net_pkt_write(pkts[i], data, sizeof(data));
+		net_pkt_cursor_init(pkts[i]);
+	}
+
+	net_if_queue_tx_burst(iface2, pkts, ARRAY_SIZE(pkts));
+
+	for (int i = 0; i < ARRAY_SIZE(pkts); i++) {
+		zassert_equal(k_sem_take(&wait_data, K_MSEC(WAIT_TIME)), 0,
+			      "Timeout while waiting packet %d", i);
+	}
+
+	zassert_false(test_failed, "Packet sent to wrong iface");
+
+#if defined(CONFIG_NET_BURST) && NET_TC_TX_COUNT > 0
+	zassert_equal(max_burst, ARRAY_SIZE(pkts),
+		      "Packets not sent as one burst (%zu)", max_burst);
+#endif
+}
+
 static void test_select_src_iface(void)
 {
 	struct in6_addr dst_addr1 = { { { 0x20, 0x01, 0x0d, 0xb8, 1, 0, 0, 0,
@@ -853,6 +901,7 @@ void test_main(void)
 			 ztest_unit_test(test_send_iface3),
 			 ztest_unit_test(test_send_iface1_down),
 			 ztest_unit_test(test_send_iface1_up),
+			 ztest_unit_test(test_send_iface_burst),
 			 ztest_unit_test(test_select_src_iface),
 			 ztest_unit_test(test_check_promisc_mode_off),
 			 ztest_unit_test(test_set_promisc_mode_on),
@@ -1212,6 +1212,232 @@ void test_v6_msg_trunc(void)
 		       (struct sockaddr *)&server_addr, sizeof(server_addr));
 }
 
+NET_BUF_POOL_DEFINE(test_buf_pool, 4, 128, 0, NULL);
+
+void test_send_recv_buf(int sock_c, int sock_s, struct sockaddr *addr_c,
+			socklen_t addrlen_c, struct sockaddr *addr_s,
+			socklen_t addrlen_s)
+{
+	struct net_buf *bufs[4];
+	struct net_buf *buf;
+	struct sockaddr addr;
+	socklen_t addrlen;
+	int rv;
+
+	rv = bind(sock_s, addr_s, addrlen_s);
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = bind(sock_c, addr_c, addrlen_c);
+	zassert_equal(rv, 0, "client bind failed");
+
+	/* Zero-copy send of a two fragment chain, copying receive */
+	buf = net_buf_alloc(&test_buf_pool, K_NO_WAIT);
+	zassert_not_null(buf, "cannot allocate buffer");
+	net_buf_add_mem(buf, TEST_STR2, 100);
+
+	net_buf_frag_add(buf, net_buf_alloc(&test_buf_pool, K_NO_WAIT));
+	zassert_not_null(buf->frags, "cannot allocate buffer");
+	net_buf_add_mem(buf->frags, TEST_STR2 + 100, 100);
+
+	rv = zsock_sendto_buf(sock_c, buf, 0, addr_s, addrlen_s);
+	zassert_equal(rv, 200, "sendto_buf failed");
+
+	clear_buf(rx_buf);
+	rv = recv(sock_s, rx_buf, sizeof(rx_buf), 0);
+	zassert_equal(rv, 200, "recv failed");
+	zassert_mem_equal(rx_buf, TEST_STR2, 200, "invalid rx data");
+
+	/* The sent buffers have been released */
+	for (int i = 0; i < ARRAY_SIZE(bufs); i++) {
+		bufs[i] = net_buf_alloc(&test_buf_pool, K_NO_WAIT);
+		zassert_not_null(bufs[i], "buffer %d not released", i);
+	}
+
+	for (int i = 0; i < ARRAY_SIZE(bufs); i++) {
+		net_buf_unref(bufs[i]);
+	}
+
+	/* Copying send, zero-copy receive */
+	rv = sendto(sock_c, BUF_AND_SIZE(TEST_STR2), 0, addr_s, addrlen_s);
+	zassert_equal(rv, STRLEN(TEST_STR2), "sendto failed");
+
+	addrlen = sizeof(addr);
+	rv = zsock_recvfrom_buf(sock_s, &buf, 0, &addr, &addrlen);
+	zassert_equal(rv, STRLEN(TEST_STR2), "recvfrom_buf failed");
+	zassert_equal(net_buf_frags_len(buf), STRLEN(TEST_STR2),
+		      "wrong buffer length");
+	zassert_equal(addrlen, addrlen_c, "wrong address length");
+	zassert_equal(addr.sa_family, addr_c->sa_family, "wrong family");
+
+	clear_buf(rx_buf);
+	net_buf_linearize(rx_buf, sizeof(rx_buf), buf, 0, STRLEN(TEST_STR2));
+	zassert_mem_equal(rx_buf, BUF_AND_SIZE(TEST_STR2), "invalid rx data");
+
+	net_buf_unref(buf);
+
+	rv = zsock_recv_buf(sock_s, &buf, ZSOCK_MSG_PEEK);
+	zassert_equal(rv, -1, "MSG_PEEK should fail");
+	zassert_equal(errno, EINVAL, "incorrect errno value");
+
+	rv = zsock_recv_buf(sock_s, &buf, ZSOCK_MSG_DONTWAIT);
+	zassert_equal(rv, -1, "recv_buf should fail");
+	zassert_equal(errno, EAGAIN, "incorrect errno value");
+
+	rv = close(sock_c);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(sock_s);
+	zassert_equal(rv, 0, "close failed");
+}
+
+void test_v4_send_recv_buf(void)
+{
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, CLIENT_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	test_send_recv_buf(client_sock, server_sock,
+			   (struct sockaddr *)&client_addr, sizeof(client_addr),
+			   (struct sockaddr *)&server_addr, sizeof(server_addr));
+}
+
+void test_v6_send_recv_buf(void)
+{
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in6 client_addr;
+	struct sockaddr_in6 server_addr;
+
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, CLIENT_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	test_send_recv_buf(client_sock, server_sock,
+			   (struct sockaddr *)&client_addr, sizeof(client_addr),
+			   (struct sockaddr *)&server_addr, sizeof(server_addr));
+}
+
+void test_sendmmsg_recvmmsg(int sock_c, int sock_s, struct sockaddr *addr_c,
+			    socklen_t addrlen_c, struct sockaddr *addr_s,
+			    socklen_t addrlen_s)
+{
+	static const char * const data[] = { "a", "bc", TEST_STR_SMALL };
+	struct zsock_timeval timeout = { .tv_usec = 100000 };
+	struct sockaddr_storage src[4];
+	struct mmsghdr msgs[4];
+	struct iovec iov[4];
+	char rx[4][3];
+	int rv;
+
+	rv = bind(sock_s, addr_s, addrlen_s);
+	zassert_equal(rv, 0, "server bind failed");
+
+	rv = bind(sock_c, addr_c, addrlen_c);
+	zassert_equal(rv, 0, "client bind failed");
+
+	memset(msgs, 0, sizeof(msgs));
+	for (int i = 0; i < ARRAY_SIZE(data); i++) {
+		iov[i].iov_base = (void *)data[i];
+		iov[i].iov_len = strlen(data[i]);
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = addr_s;
+		msgs[i].msg_hdr.msg_namelen = addrlen_s;
+	}
+
+	rv = sendmmsg(sock_c, msgs, ARRAY_SIZE(data), 0);
+	zassert_equal(rv, ARRAY_SIZE(data), "sendmmsg failed (%d)", -errno);
+
+	for (int i = 0; i < ARRAY_SIZE(data); i++) {
+		zassert_equal(msgs[i].msg_len, strlen(data[i]),
+			      "wrong sent length");
+	}
+
+	memset(msgs, 0, sizeof(msgs));
+	memset(rx, 0, sizeof(rx));
+	for (int i = 0; i < ARRAY_SIZE(msgs); i++) {
+		iov[i].iov_base = rx[i];
+		iov[i].iov_len = sizeof(rx[i]);
+		msgs[i].msg_hdr.msg_iov = &iov[i];
+		msgs[i].msg_hdr.msg_iovlen = 1;
+		msgs[i].msg_hdr.msg_name = &src[i];
+		msgs[i].msg_hdr.msg_namelen = sizeof(src[i]);
+	}
+
+	/* Only the first datagram is waited for, the batch ends early */
+	rv = recvmmsg(sock_s, msgs, ARRAY_SIZE(msgs), MSG_WAITFORONE, NULL);
+	zassert_equal(rv, ARRAY_SIZE(data), "recvmmsg failed (%d)", -errno);
+
+	for (int i = 0; i < ARRAY_SIZE(data); i++) {
+		size_t len = MIN(strlen(data[i]), sizeof(rx[i]));
+
+		zassert_equal(msgs[i].msg_len, len, "wrong received length");
+		zassert_mem_equal(rx[i], data[i], len, "wrong data");
+		zassert_equal(msgs[i].msg_hdr.msg_namelen, addrlen_c,
+			      "unexpected addrlen");
+		zassert_equal(net_sin(addr_c)->sin_port,
+			      net_sin((struct sockaddr *)&src[i])->sin_port,
+			      "unexpected client port");
+		zassert_equal(msgs[i].msg_hdr.msg_flags,
+			      len < strlen(data[i]) ? ZSOCK_MSG_TRUNC : 0,
+			      "wrong message flags");
+	}
+
+	/* Nothing left, the timeout bounds the wait */
+	rv = recvmmsg(sock_s, msgs, ARRAY_SIZE(msgs), 0, &timeout);
+	zassert_equal(rv, -1, "recvmmsg should have timed out");
+	zassert_equal(errno, EAGAIN, "incorrect errno value");
+
+	rv = close(sock_c);
+	zassert_equal(rv, 0, "close failed");
+	rv = close(sock_s);
+	zassert_equal(rv, 0, "close failed");
+}
+
+void test_v4_sendmmsg_recvmmsg(void)
+{
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in client_addr;
+	struct sockaddr_in server_addr;
+
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, CLIENT_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v4(CONFIG_NET_CONFIG_MY_IPV4_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	test_sendmmsg_recvmmsg(client_sock, server_sock,
+			       (struct sockaddr *)&client_addr,
+			       sizeof(client_addr),
+			       (struct sockaddr *)&server_addr,
+			       sizeof(server_addr));
+}
+
+void test_v6_sendmmsg_recvmmsg(void)
+{
+	int client_sock;
+	int server_sock;
+	struct sockaddr_in6 client_addr;
+	struct sockaddr_in6 server_addr;
+
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, CLIENT_PORT,
+			    &client_sock, &client_addr);
+	prepare_sock_udp_v6(CONFIG_NET_CONFIG_MY_IPV6_ADDR, SERVER_PORT,
+			    &server_sock, &server_addr);
+
+	test_sendmmsg_recvmmsg(client_sock, server_sock,
+			       (struct sockaddr *)&client_addr,
+			       sizeof(client_addr),
+			       (struct sockaddr *)&server_addr,
+			       sizeof(server_addr));
+}
+
 void test_main(void)
 {
 	k_thread_system_pool_assign(k_current_get());
@@ -1242,7 +1468,13 @@ void test_main(void)
 			 ztest_unit_test(test_v6_sendmsg_with_txtime),
 			 ztest_user_unit_test(test_v6_sendmsg_with_txtime),
 			 ztest_unit_test(test_v4_msg_trunc),
-			 ztest_unit_test(test_v6_msg_trunc)
+			 ztest_unit_test(test_v6_msg_trunc),
+			 ztest_unit_test(test_v4_send_recv_buf),
+			 ztest_unit_test(test_v6_send_recv_buf),
+			 ztest_unit_test(test_v4_sendmmsg_recvmmsg),
+			 ztest_user_unit_test(test_v4_sendmmsg_recvmmsg),
+			 ztest_unit_test(test_v6_sendmmsg_recvmmsg),
+			 ztest_user_unit_test(test_v6_sendmmsg_recvmmsg)
 		);
 
 	ztest_run_test_suite(socket_udp);
@@ -19,6 +19,8 @@ LOG_MODULE_REGISTER(net_test, CONFIG_NET_UTILS_LOG_LEVEL);
 #include <device.h>
 #include <init.h>
 #include <sys/printk.h>
+#include <sys/byteorder.h>
+#include <random/rand32.h>
 #include <net/net_core.h>
 #include <net/net_ip.h>
 #include <net/ethernet.h>
@@ -848,11 +850,104 @@ void test_addr_parse(void)
 #endif
 }
 
+/* Reference implementation, one big endian word at a time */
+static uint16_t ref_chksum(const uint8_t *data, size_t len)
+{
+	uint32_t sum = 0U;
+
+	for (size_t i = 0; i < len; i++) {
+		sum += (i & 1U) ? data[i] : data[i] << 8;
+	}
+
+	while (sum >> 16) {
+		sum = (sum & 0xffff) + (sum >> 16);
+	}
+
+	return sum;
+}
+
+void test_chksum(void)
+{
+	static uint8_t src[300 + 4];
+	static uint8_t dst[300 + 4];
+	static const size_t lens[] = { 0, 1, 2, 3, 5, 31, 32, 33, 63, 64,
+				       65, 127, 300 };
+
+	for (int i = 0; i < sizeof(src); i++) {
+		src[i] = sys_rand32_get();
+	}
+
+	/* Every length at every source and destination alignment */
+	for (int i = 0; i < ARRAY_SIZE(lens); i++) {
+		for (int s = 0; s < 4; s++) {
+			for (int d = 0; d < 4; d++) {
+				uint16_t sum;
+
+				(void)memset(dst, 0, sizeof(dst));
+
+				sum = net_calc_chksum_copy(dst + d, src + s,
+							   lens[i]);
+
+				zassert_equal(sum, ref_chksum(src + s, lens[i]),
+					      "len %zu src %d dst %d", lens[i],
+					      s, d);
+				zassert_mem_equal(dst + d, src + s, lens[i],
+						  "copy len %zu", lens[i]);
+			}
+		}
+	}
+
+	/* Blocks summed separately and combined by offset */
+	for (size_t split = 0; split <= 65; split++) {
+		uint16_t sum = net_calc_chksum_copy(dst, src, split);
+
+		sum = net_chksum_add(sum, net_calc_chksum_copy(dst, src + split,
+							       200 - split),
+				     split);
+
+		zassert_equal(sum, ref_chksum(src, 200), "split %zu", split);
+	}
+}
+
+void test_chksum_update(void)
+{
+	struct in6_addr old_addr = { { { 0x20, 0x01, 0x0d, 0xb8, 0, 0, 0, 0,
+					 0, 0, 0, 0, 0, 0, 0, 0x1 } } };
+	struct in6_addr new_addr = { { { 0xfe, 0x80, 0, 0, 0, 0, 0, 0,
+					 0x02, 0x00, 0x5e, 0xff, 0xfe, 0x00,
+					 0x53, 0x01 } } };
+	uint8_t data[sizeof(struct in6_addr) + 16];
+	uint16_t chksum, word;
+
+	for (int i = 0; i < sizeof(data); i++) {
+		data[i] = sys_rand32_get();
+	}
+
+	memcpy(data, &old_addr, sizeof(old_addr));
+	chksum = htons(~ref_chksum(data, sizeof(data)));
+
+	chksum = net_chksum_update(chksum, &old_addr, &new_addr,
+				   sizeof(new_addr));
+	memcpy(data, &new_addr, sizeof(new_addr));
+
+	zassert_equal(chksum, htons((uint16_t)~ref_chksum(data, sizeof(data))),
+		      "address update");
+
+	memcpy(&word, &data[20], sizeof(word));
+	chksum = net_chksum_update16(chksum, word, htons(0x1234));
+	sys_put_be16(0x1234, &data[20]);
+
+	zassert_equal(chksum, htons((uint16_t)~ref_chksum(data, sizeof(data))),
+		      "word update");
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_utils_fn,
 			 ztest_user_unit_test(test_net_addr),
-			 ztest_unit_test(test_addr_parse));
+			 ztest_unit_test(test_addr_parse),
+			 ztest_unit_test(test_chksum),
+			 ztest_unit_test(test_chksum_update));
 
 	ztest_run_test_suite(test_utils_fn);
 }
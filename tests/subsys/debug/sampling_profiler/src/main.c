@@ -0,0 +1,99 @@
+/*
+ * Copyright (c) 2021 Intel Corporation
+ *
+ * SPDX-License-Identifier: Apache-2.0
+ */
+
+#include <zephyr.h>
+#include <ztest.h>
+#include <debug/sampling_profiler.h>
+
+#define PERIOD_US 1000
+
+/* Time between samples, the period is rounded up to the system tick */
+static uint32_t sample_us(void)
+{
+	return k_ticks_to_us_ceil32(k_us_to_ticks_ceil32(PERIOD_US));
+}
+
+static void sample_count(unsigned int cpu, const uintptr_t *addrs, int depth,
+			 void *user_data)
+{
+	uint32_t *count = user_data;
+
+	zassert_true(cpu < CONFIG_MP_NUM_CPUS, "Invalid CPU %u", cpu);
+	zassert_true((depth > 0) && (depth <= CONFIG_SAMPLING_PROFILER_DEPTH),
+		     "Invalid depth %d", depth);
+	zassert_not_equal(addrs[0], 0, "No program counter");
+
+	(*count)++;
+}
+
+static void test_start_stop(void)
+{
+	zassert_equal(sampling_profiler_reset(), 0, NULL);
+
+	zassert_equal(sampling_profiler_start(0), -EINVAL, NULL);
+	zassert_equal(sampling_profiler_stop(), -EALREADY, NULL);
+
+	zassert_equal(sampling_profiler_start(PERIOD_US), 0, NULL);
+	zassert_equal(sampling_profiler_start(PERIOD_US), -EALREADY, NULL);
+	zassert_equal(sampling_profiler_reset(), -EBUSY, NULL);
+	zassert_equal(sampling_profiler_foreach(sample_count, NULL), -EBUSY,
+		      NULL);
+
+	zassert_equal(sampling_profiler_stop(), 0, NULL);
+	zassert_equal(sampling_profiler_stop(), -EALREADY, NULL);
+}
+
+static void test_samples(void)
+{
+	struct sampling_profiler_stats stats;
+	uint32_t count = 0;
+
+	zassert_equal(sampling_profiler_reset(), 0, NULL);
+	zassert_equal(sampling_profiler_start(PERIOD_US), 0, NULL);
+	/* Long enough to overflow the buffer of this CPU */
+	k_busy_wait(4 * CONFIG_SAMPLING_PROFILER_SAMPLES * sample_us());
+	zassert_equal(sampling_profiler_stop(), 0, NULL);
+
+	sampling_profiler_stats_get(&stats);
+	zassert_true(stats.samples > 0, "No samples");
+	zassert_true(stats.samples <=
+		     CONFIG_SAMPLING_PROFILER_SAMPLES * CONFIG_MP_NUM_CPUS,
+		     "Too many samples (%u)", stats.samples);
+	zassert_true(stats.dropped > 0, "Full buffer not detected");
+
+	zassert_equal(sampling_profiler_foreach(sample_count, &count), 0, NULL);
+	zassert_equal(count, stats.samples, "Got %u samples out of %u",
+		      count, stats.samples);
+}
+
+static void test_reset(void)
+{
+	struct sampling_profiler_stats stats;
+	uint32_t count = 0;
+
+	zassert_equal(sampling_profiler_start(PERIOD_US), 0, NULL);
+	k_busy_wait(10 * sample_us());
+	zassert_equal(sampling_profiler_stop(), 0, NULL);
+
+	zassert_equal(sampling_profiler_reset(), 0, NULL);
+
+	sampling_profiler_stats_get(&stats);
+	zassert_equal(stats.samples, 0, NULL);
+	zassert_equal(stats.dropped, 0, NULL);
+	zassert_equal(stats.missed, 0, NULL);
+
+	zassert_equal(sampling_profiler_foreach(sample_count, &count), 0, NULL);
+	zassert_equal(count, 0, NULL);
+}
+
+void test_main(void)
+{
+	ztest_test_suite(sampling_profiler,
+			 ztest_unit_test(test_start_stop),
+			 ztest_unit_test(test_samples),
+			 ztest_unit_test(test_reset));
+	ztest_run_test_suite(sampling_profiler);
+}
@@ -40,7 +40,7 @@ void setup(void)
 	sim_thresholds = stats_group_find("flash_sim_thresholds");
 
 	/* Verify if NVS is initialized. */
-	if (fs.sector_count != 0) {
+	if (fs.ready) {
 		int err;
 
 		err = nvs_clear(&fs);
@@ -706,6 +706,182 @@ void test_nvs_gc_corrupt_ate(void)
 	zassert_true(err == 0,  "nvs_init call failure: %d", err);
 }
 
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+static uint32_t cache_copy[CONFIG_NVS_LOOKUP_CACHE_SIZE];
+
+/* Check that the incrementally maintained lookup cache matches the one
+ * rebuilt from flash by nvs_init().
+ */
+static void check_cache_rebuild(void)
+{
+	int err;
+
+	memcpy(cache_copy, fs.lookup_cache, sizeof(cache_copy));
+
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	zassert_mem_equal(cache_copy, fs.lookup_cache, sizeof(cache_copy),
+			  "lookup cache differs from the rebuilt one");
+}
+#endif
+
+/*
+ * Test that the lookup cache stays coherent through writes, deletes and
+ * garbage collection, including ids that share a cache slot.
+ */
+void test_nvs_cache(void)
+{
+#ifdef CONFIG_NVS_LOOKUP_CACHE
+	int err;
+	ssize_t len;
+	uint8_t buf[32];
+	/* with a cache smaller than max_id some of the ids collide, a power
+	 * of two keeps the data pattern of write_content() valid on wrap
+	 */
+	const uint16_t max_id = 8;
+	uint16_t next = max_id;
+
+	fs.sector_count = 3;
+
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	for (size_t i = 0; i < ARRAY_SIZE(fs.lookup_cache); i++) {
+		zassert_equal(fs.lookup_cache[i], NVS_LOOKUP_CACHE_NO_ADDR,
+			      "lookup cache of empty fs should be empty");
+	}
+
+	len = nvs_read(&fs, 0, buf, sizeof(buf));
+	zassert_true(len == -ENOENT, "nvs_read shouldn't find the entry: %d",
+		     len);
+
+	write_content(max_id, 0, max_id, &fs);
+	check_content(max_id, &fs);
+	check_cache_rebuild();
+
+	/* delete an id, possibly sharing its slot with a live one */
+	err = nvs_delete(&fs, 0);
+	zassert_true(err == 0,  "nvs_delete call failure: %d", err);
+	len = nvs_read(&fs, 0, buf, sizeof(buf));
+	zassert_true(len == -ENOENT, "nvs_read shouldn't find the entry: %d",
+		     len);
+	len = nvs_read(&fs, max_id - 1, buf, sizeof(buf));
+	zassert_true(len == sizeof(buf), "nvs_read unexpected failure: %d",
+		     len);
+	check_cache_rebuild();
+
+	/* keep writing until every sector has been garbage collected */
+	for (uint16_t round = 0; round < 2 * fs.sector_count; round++) {
+		uint32_t sector = fs.ate_wra >> ADDR_SECT_SHIFT;
+
+		while ((fs.ate_wra >> ADDR_SECT_SHIFT) == sector) {
+			write_content(max_id, next, next + max_id, &fs);
+			next += max_id;
+		}
+		check_content(max_id, &fs);
+		check_cache_rebuild();
+	}
+#else
+	ztest_test_skip();
+#endif
+}
+
+/*
+ * Test that with incremental garbage collection the number of flash
+ * operations done by a single nvs_write() stays bounded by the step budget
+ * while a sector full of long-lived entries is collected, and that a
+ * pending gc is resumed by nvs_init().
+ */
+void test_nvs_gc_incremental(void)
+{
+#ifdef CONFIG_NVS_GC_INCREMENTAL
+	int err;
+	ssize_t len;
+	uint32_t *flash_write_stat;
+	uint32_t *flash_erase_stat;
+	uint32_t writes, erases, max_writes = 0U;
+	uint8_t buf[32];
+	bool resumed = false;
+	/* ids written once, followed by a frequently written one */
+	const uint16_t static_ids = 12;
+	const uint16_t hot_id = 100;
+	/* own data and ate, sector close ate, gc done ate, plus a data and
+	 * an ate write per copied entry for at most two gc steps.
+	 */
+	const uint32_t write_bound = 4 + 2 * 2 * CONFIG_NVS_GC_STEP_BUDGET;
+
+	stats_walk(sim_stats, flash_sim_write_calls_find, &flash_write_stat);
+	stats_walk(sim_stats, flash_sim_erase_calls_find, &flash_erase_stat);
+
+	fs.sector_count = 3;
+
+	err = nvs_init(&fs, DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+	zassert_true(err == 0,  "nvs_init call failure: %d", err);
+
+	for (uint16_t id = 0; id < static_ids; id++) {
+		memset(buf, id, sizeof(buf));
+		len = nvs_write(&fs, id, buf, sizeof(buf));
+		zassert_true(len == sizeof(buf), "nvs_write failed: %d", len);
+	}
+
+	for (uint16_t i = 0; i < 8 * fs.sector_size / sizeof(buf); i++) {
+		memset(buf, i, sizeof(buf));
+
+		writes = *flash_write_stat;
+		erases = *flash_erase_stat;
+		len = nvs_write(&fs, hot_id, buf, sizeof(buf));
+		zassert_true(len == sizeof(buf), "nvs_write failed: %d", len);
+		writes = *flash_write_stat - writes;
+		erases = *flash_erase_stat - erases;
+
+		max_writes = MAX(max_writes, writes);
+		zassert_true(erases <= 1, "more than one erase in a write");
+
+		if (fs.gc.pending && !resumed) {
+			/* simulate a reset in the middle of the gc */
+			err = nvs_init(&fs,
+				       DT_CHOSEN_ZEPHYR_FLASH_CONTROLLER_LABEL);
+			zassert_true(err == 0,  "nvs_init call failure: %d",
+				     err);
+			zassert_false(fs.gc.pending, "gc not completed");
+			resumed = true;
+		}
+
+		for (uint16_t id = 0; id < static_ids; id++) {
+			uint8_t rd_buf[sizeof(buf)];
+			uint8_t exp[sizeof(buf)];
+
+			memset(exp, id, sizeof(exp));
+			len = nvs_read(&fs, id, rd_buf, sizeof(rd_buf));
+			zassert_true(len == sizeof(rd_buf),
+				     "nvs_read unexpected failure: %d", len);
+			zassert_mem_equal(exp, rd_buf, sizeof(rd_buf),
+					  "static entry lost during gc");
+		}
+	}
+
+	zassert_true(resumed, "no gc was pending during the test");
+	zassert_true(max_writes <= write_bound,
+		     "nvs_write did %u flash writes, bound is %u", max_writes,
+		     write_bound);
+
+	/* drain a pending gc explicitly */
+	while (!fs.gc.pending) {
+		len = nvs_write(&fs, hot_id, &fs.ate_wra, sizeof(fs.ate_wra));
+		zassert_true(len == sizeof(fs.ate_wra), "nvs_write failed: %d",
+			     len);
+	}
+	do {
+		err = nvs_gc_step(&fs, 1);
+		zassert_true(err >= 0, "nvs_gc_step call failure: %d", err);
+	} while (err > 0);
+	zassert_false(fs.gc.pending, "gc not completed");
+#else
+	ztest_test_skip();
+#endif
+}
+
 void test_main(void)
 {
 	ztest_test_suite(test_nvs,
@@ -729,7 +905,11 @@ void test_main(void)
 			 ztest_unit_test_setup_teardown(
 				 test_nvs_gc_corrupt_close_ate, setup, teardown),
 			 ztest_unit_test_setup_teardown(
-				 test_nvs_gc_corrupt_ate, setup, teardown)
+				 test_nvs_gc_corrupt_ate, setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				 test_nvs_cache, setup, teardown),
+			 ztest_unit_test_setup_teardown(
+				 test_nvs_gc_incremental, setup, teardown)
 			);
 
 	ztest_run_test_suite(test_nvs);
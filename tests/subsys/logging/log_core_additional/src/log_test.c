@@ -53,6 +53,9 @@ struct backend_cb {
 	uint16_t exp_severity[4];
 	/* inform put() to check domain_id of message */
 	bool check_domain_id;
+	/* inform process() to check that timestamps never go backwards */
+	bool check_order;
+	uint32_t last_timestamp;
 	/* How many messages have been logged.
 	 * used in async mode, to make sure all logs have been handled by compare
 	 * counter with total_logs
@@ -78,6 +81,14 @@ static void process(const struct log_backend *const backend,
 			      "Unexpected message index");
 	}
 
+	if (cb->check_order) {
+		uint32_t timestamp = log_msg2_get_timestamp(&(msg->log));
+
+		zassert_true(timestamp >= cb->last_timestamp,
+			     "Message out of timestamp order");
+		cb->last_timestamp = timestamp;
+	}
+
 	if (cb->check_severity) {
 		zassert_equal(log_msg2_get_level(&(msg->log)),
 			      cb->exp_severity[cb->counter],
@@ -392,6 +403,67 @@ void test_log_timestamping(void)
 		      "Unexpected amount of messages received by the backend.");
 }
 
+#define ORDER_LOGS 8
+static K_THREAD_STACK_DEFINE(order_stack, 1024);
+static struct k_thread order_thread;
+
+/* timestamp_get() is not safe against concurrent callers */
+static atomic_t order_stamp;
+static uint32_t order_timestamp_get(void)
+{
+	return (uint32_t)atomic_inc(&order_stamp) + 1U;
+}
+
+static void order_thread_entry(void *p1, void *p2, void *p3)
+{
+	for (int i = 0; i < ORDER_LOGS; i++) {
+		LOG_INF("helper %d", i);
+	}
+}
+
+/**
+ * @brief Messages from several threads are processed in timestamp order
+ *
+ * @details Two threads, which run on different CPUs when
+ *          CONFIG_LOG_BUFFER_PER_CPU is enabled, log at the same time.
+ *          The backend checks that timestamps never go backwards and
+ *          that no message is lost.
+ *
+ * @addtogroup logging
+ */
+void test_log_timestamp_order(void)
+{
+	if (!IS_ENABLED(CONFIG_LOG2_MODE_DEFERRED) ||
+	    IS_ENABLED(CONFIG_LOG_PROCESS_THREAD)) {
+		ztest_test_skip();
+		return;
+	}
+
+	log_setup(false);
+	zassert_equal(0, log_set_timestamp_func(order_timestamp_get,
+						TIMESTAMP_FREC),
+		      "Expects successful timestamp function setting.");
+	backend1_cb.check_order = true;
+	backend1_cb.total_logs = 2 * ORDER_LOGS;
+
+	k_thread_create(&order_thread, order_stack,
+			K_THREAD_STACK_SIZEOF(order_stack), order_thread_entry,
+			NULL, NULL, NULL, k_thread_priority_get(k_current_get()),
+			0, K_NO_WAIT);
+
+	for (int i = 0; i < ORDER_LOGS; i++) {
+		LOG_INF("main %d", i);
+	}
+
+	k_thread_join(&order_thread, K_FOREVER);
+
+	while (log_test_process(false)) {
+	}
+
+	zassert_equal(backend1_cb.total_logs, backend1_cb.counter,
+		      "Unexpected amount of messages received by the backend.");
+}
+
 /**
  * @brief Multiple logging backends
  *
@@ -595,7 +667,8 @@ void test_main(void)
 			 ztest_unit_test(test_log_early_logging),
 			 ztest_unit_test(test_log_sync),
 			 ztest_unit_test(test_log_thread),
-			 ztest_unit_test(test_log_msg2_create)
+			 ztest_unit_test(test_log_msg2_create),
+			 ztest_unit_test(test_log_timestamp_order)
 			 );
 	ztest_run_test_suite(test_log_core_additional);
 #endif
@@ -493,13 +493,15 @@ void test_mode_size_str_with_2strings(void)
 			   1 /* accept one string pointer*/,
 			   domain, source, level,
 			   NULL, 0, TEST_STR, prefix, "sufix");
-	zassert_equal(mode, EXP_MODE(RUNTIME),
+	zassert_equal(mode, IS_ENABLED(CONFIG_LOG2_FMT_ID) ?
+			EXP_MODE(FROM_STACK_STR) : EXP_MODE(RUNTIME),
 			"Unexpected creation mode");
 	Z_LOG_MSG2_CREATE2(0, mode,
 			   1 /* accept one string pointer*/,
 			   domain, source, level,
 			   NULL, 0, TEST_STR, prefix, "sufix");
-	zassert_equal(mode, EXP_MODE(RUNTIME),
+	zassert_equal(mode, IS_ENABLED(CONFIG_LOG2_FMT_ID) ?
+			EXP_MODE(FROM_STACK_STR) : EXP_MODE(RUNTIME),
 			"Unexpected creation mode");
 
 	/* Calculate expected message length. Message consists of:
@@ -523,6 +525,66 @@ void test_mode_size_str_with_2strings(void)
 	get_msg_validate_length(exp_len);
 }
 
+void test_mode_size_str_with_ram_string(void)
+{
+#undef TEST_STR
+#define TEST_STR "test %s %d"
+
+	static const uint8_t domain = 3;
+	static const uint8_t level = 2;
+	const void *source = (const void *)123;
+	uint32_t exp_len;
+	int mode;
+	char str[] = "ram";
+	union log_msg2_generic *msg;
+	size_t len;
+	uint8_t *package;
+	char buf[32];
+	struct test_buf tbuf = { .buf = buf, .idx = 0 };
+	int rv;
+
+	if (!IS_ENABLED(CONFIG_LOG2_FMT_ID)) {
+		ztest_test_skip();
+	}
+
+	test_init();
+
+	Z_LOG_MSG2_CREATE2(0, mode, 0, domain, source, level,
+			   NULL, 0, TEST_STR, str, 10);
+	zassert_equal(mode, EXP_MODE(FROM_STACK_STR),
+			"Unexpected creation mode");
+
+	/* String is copied into the message. */
+	strcpy(str, "new");
+
+	/* Calculate expected message length. Message consists of:
+	 * - header
+	 * - package: header + fmt pointer + pointer + int
+	 * - string: position + string + null
+	 *
+	 * Message size is rounded up to the required alignment.
+	 */
+	exp_len = sizeof(struct log_msg2_hdr) +
+			 /* package */3 * sizeof(const char *) + sizeof(int) +
+			 strlen("ram") + 2 /* null + header */;
+	exp_len = ROUND_UP(exp_len, Z_LOG_MSG2_ALIGNMENT) / sizeof(int);
+
+	msg = z_log_msg2_claim();
+	zassert_true(msg, "Unexpected null message");
+	zassert_equal(log_msg2_generic_get_wlen((union mpsc_pbuf_generic *)msg),
+		      exp_len, "Unexpected message length");
+
+	package = log_msg2_get_package(&msg->log, &len);
+	rv = cbpprintf(out, &tbuf, package);
+	zassert_true(rv > 0, NULL);
+	buf[rv] = '\0';
+
+	rv = strcmp(buf, "test ram 10");
+	zassert_equal(rv, 0, "Unexpected output: %s", buf);
+
+	z_log_msg2_free(msg);
+}
+
 static log_timestamp_t timestamp_get_inc(void)
 {
 	return timestamp++;
@@ -581,6 +643,7 @@ void test_main(void)
 		ztest_unit_test(test_mode_size_data_only),
 		ztest_unit_test(test_mode_size_plain_str_data),
 		ztest_unit_test(test_mode_size_str_with_2strings),
+		ztest_unit_test(test_mode_size_str_with_ram_string),
 		ztest_unit_test(test_saturate)
 		);
 	ztest_run_test_suite(test_log_msg2);